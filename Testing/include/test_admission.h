@@ -0,0 +1,32 @@
+// Testing/include/test_admission.h
+//
+// Declaraciones de las pruebas de la cola de admisión.
+
+#ifndef TEST_ADMISSION_H
+#define TEST_ADMISSION_H
+
+/**
+ * @brief Prueba que con `admission -j 1` los trabajos en segundo plano
+ * esperen en la cola y `wait` espere también a los encolados.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_admission_job_limit(void);
+
+/**
+ * @brief Prueba `kill`, `fg` y `bg` sobre trabajos en cola y los argumentos
+ * inválidos de `admission`.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_admission_queued_commands(void);
+
+/**
+ * @brief Prueba que un trabajo en cola con `&` dentro de un grupo o de una
+ * subshell se lance cuando le toca.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_admission_queued_background_list(void);
+
+#endif // TEST_ADMISSION_H
@@ -0,0 +1,28 @@
+// Testing/include/test_alloc_config.h
+//
+// Declaraciones de las pruebas de configuración del asignador, tanto de la
+// cadena `clave:valor` que interpreta lib/memory como de la exportación de
+// `allocation_method` desde config.json.
+
+#ifndef TEST_ALLOC_CONFIG_H
+#define TEST_ALLOC_CONFIG_H
+
+/**
+ * @brief Prueba que malloc_configure aplique la política y rechace opciones
+ * inválidas.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_malloc_configure_policy(void);
+
+/**
+ * @brief Prueba la exportación de allocation_method a MYMALLOC_CONF.
+ *
+ * Verifica que se exporte la política de config.json y que una variable de
+ * entorno ya definida tenga prioridad.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_export_allocator_config(void);
+
+#endif // TEST_ALLOC_CONFIG_H
@@ -0,0 +1,63 @@
+// Testing/include/test_ast.h
+//
+// Declaraciones de las pruebas del analizador de líneas de comandos y del
+// ejecutor del árbol sintáctico.
+
+#ifndef TEST_AST_H
+#define TEST_AST_H
+
+/**
+ * @brief Prueba que las comillas y los escapes se resuelvan al separar las
+ * palabras.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parse_quoting(void);
+
+/**
+ * @brief Prueba la forma del árbol para `;`, `&&`, `||`, `|`, `&`, `( )` y
+ * `{ }`, incluida la precedencia entre operadores.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parse_operators(void);
+
+/**
+ * @brief Prueba que las líneas mal formadas se rechacen.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parse_syntax_errors(void);
+
+/**
+ * @brief Prueba que el texto de node_source() vuelva a leerse como el mismo
+ * árbol, incluidos los comandos con nombre de palabra reservada.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_node_source_round_trip(void);
+
+/**
+ * @brief Prueba la ejecución de listas, grupos, subshells y pipelines con
+ * comandos internos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_execute_tree(void);
+
+/**
+ * @brief Prueba una línea de 1 MB: un argumento de 1 MiB y 200000 argumentos
+ * cortos se analizan y se ejecutan completos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_long_command_line(void);
+
+/**
+ * @brief Prueba una pipeline de 1000 etapas.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_long_pipeline(void);
+
+#endif // TEST_AST_H
@@ -0,0 +1,23 @@
+// Testing/include/test_cgroup.h
+//
+// Declaraciones de las pruebas del prefijo `cgroup`.
+
+#ifndef TEST_CGROUP_H
+#define TEST_CGROUP_H
+
+/**
+ * @brief Prueba que los procesos de un prefijo `cgroup` corran en un cgroup
+ * propio cuando hay cgroup v2, y que sin él corran igual.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_cgroup_prefix(void);
+
+/**
+ * @brief Prueba los límites inválidos del prefijo `cgroup`.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_cgroup_invalid(void);
+
+#endif // TEST_CGROUP_H
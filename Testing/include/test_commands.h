@@ -78,12 +78,20 @@ void test_echo_command_args_with_quotes(void);
 void test_echo_command_mixed_args(void);
 
 /**
- * @brief Prueba el manejo de un buffer excedido en echo_command.
+ * @brief Prueba echo_command con argumentos que superan MAX_BUFFER_SIZE y
+ * IOV_MAX.
  *
- * Verifica que se muestre un mensaje de error cuando los argumentos superan
- * el tamaño máximo del buffer.
+ * Verifica que la salida se escriba completa, sin truncarse.
  */
-void test_echo_command_exceed_buffer(void);
+void test_echo_command_long_args(void);
+
+/**
+ * @brief Prueba que los comandos internos con redirección corran en la shell.
+ *
+ * Verifica que `cd` con la salida redirigida cambie el directorio de la
+ * propia shell.
+ */
+void test_builtin_redirect_in_process(void);
 
 /**
  * @brief Prueba la ejecución de un comando en segundo plano en execute_command.
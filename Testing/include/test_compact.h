@@ -0,0 +1,27 @@
+// Testing/include/test_compact.h
+//
+// Declaraciones de las pruebas de asignaciones movibles (handles) y de la
+// compactación incremental del heap.
+
+#ifndef TEST_COMPACT_H
+#define TEST_COMPACT_H
+
+/**
+ * @brief Prueba que la compactación conserve los datos de los handles.
+ *
+ * Verifica que los bloques movidos mantengan su contenido, que los bloques
+ * fijados con hlock no cambien de dirección y que la fragmentación no
+ * aumente tras compactar.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_compact_preserves_handles(void);
+
+/**
+ * @brief Prueba que un handle fijado no pueda liberarse.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_hfree_pinned_handle(void);
+
+#endif // TEST_COMPACT_H
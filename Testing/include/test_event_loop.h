@@ -0,0 +1,32 @@
+// Testing/include/test_event_loop.h
+//
+// Declaraciones de las pruebas del bucle de eventos de la shell.
+
+#ifndef TEST_EVENT_LOOP_H
+#define TEST_EVENT_LOOP_H
+
+/**
+ * @brief Prueba que el bucle recolecte muchos trabajos en segundo plano, con
+ * un aviso por cada uno, mientras espera a un proceso en primer plano.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_event_loop_reaps_background(void);
+
+/**
+ * @brief Prueba que la espera de un hijo obtenga su estado aunque el bucle ya
+ * lo haya recolectado, y que falle con un proceso que no es hijo.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_event_loop_wait_child(void);
+
+/**
+ * @brief Prueba el comando interno `wait` sin argumentos, con un PID y con un
+ * número de trabajo.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_wait_command(void);
+
+#endif // TEST_EVENT_LOOP_H
@@ -0,0 +1,31 @@
+// Testing/include/test_jobs.h
+//
+// Declaraciones de las pruebas de la tabla de trabajos.
+
+#ifndef TEST_JOBS_H
+#define TEST_JOBS_H
+
+/**
+ * @brief Prueba la búsqueda de trabajos por número y por PID con miles de
+ * trabajos en segundo plano, y que los números se reutilicen.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_job_table_lookup(void);
+
+/**
+ * @brief Prueba que un trabajo suspendido se informe y que `bg` lo continúe.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_job_stop_and_bg(void);
+
+/**
+ * @brief Prueba que todas las etapas de una pipeline compartan un grupo de
+ * procesos propio.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_pipeline_process_group(void);
+
+#endif // TEST_JOBS_H
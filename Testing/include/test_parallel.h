@@ -0,0 +1,24 @@
+// Testing/include/test_parallel.h
+//
+// Declaraciones de las pruebas del comando interno `parallel`.
+
+#ifndef TEST_PARALLEL_H
+#define TEST_PARALLEL_H
+
+/**
+ * @brief Prueba que `parallel -k` muestre las salidas en el orden de los
+ * elementos, tomados de `:::` o de la entrada estándar.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parallel_keep_order(void);
+
+/**
+ * @brief Prueba el límite de tareas simultáneas, el estado de salida y los
+ * argumentos inválidos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parallel_limit_and_status(void);
+
+#endif // TEST_PARALLEL_H
@@ -0,0 +1,25 @@
+// Testing/include/test_path_cache.h
+//
+// Declaraciones de las pruebas de la tabla de rutas de comandos y del
+// comando interno `hash`.
+
+#ifndef TEST_PATH_CACHE_H
+#define TEST_PATH_CACHE_H
+
+/**
+ * @brief Prueba que una ruta resuelta se recuerde y se descarte al cambiar
+ * PATH o al dejar de existir el programa.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_path_cache_lookup(void);
+
+/**
+ * @brief Prueba que los fallos se recuerden y que `hash` los resuelva de
+ * nuevo, liste y vacíe la tabla.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_path_cache_negative_and_hash(void);
+
+#endif // TEST_PATH_CACHE_H
@@ -0,0 +1,26 @@
+// Testing/include/test_region.h
+//
+// Declaraciones de las pruebas del respaldo del heap con páginas enormes.
+
+#ifndef TEST_REGION_H
+#define TEST_REGION_H
+
+/**
+ * @brief Prueba asignar, recortar y devolver páginas con el heap respaldado
+ * por la región de páginas enormes.
+ *
+ * Como el respaldo solo puede cambiarse antes de la primera asignación, la
+ * prueba se ejecuta en un proceso hijo con el heap vacío.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_region_hugepages(void);
+
+/**
+ * @brief Prueba que el respaldo no pueda cambiarse con el heap en uso.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_region_hugepages_in_use(void);
+
+#endif // TEST_REGION_H
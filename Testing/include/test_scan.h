@@ -0,0 +1,26 @@
+// Testing/include/test_scan.h
+//
+// Declaraciones de las pruebas de la búsqueda vectorizada de caracteres
+// especiales.
+
+#ifndef TEST_SCAN_H
+#define TEST_SCAN_H
+
+/**
+ * @brief Prueba que todas las implementaciones soportadas encuentren el mismo
+ * carácter que la escalar, para cada valor de byte en cada posición de un
+ * bloque y en la parte final que no completa un bloque.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scan_implementations_agree(void);
+
+/**
+ * @brief Prueba que el lexer produzca las mismas palabras con todas las
+ * implementaciones.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scan_lexer_agree(void);
+
+#endif // TEST_SCAN_H
@@ -0,0 +1,35 @@
+// Testing/include/test_scavenge.h
+//
+// Declaraciones de las pruebas del scavenger, que devuelve al sistema las
+// páginas de los bloques libres grandes.
+
+#ifndef TEST_SCAVENGE_H
+#define TEST_SCAVENGE_H
+
+/**
+ * @brief Prueba la liberación de páginas mediante una pasada explícita.
+ *
+ * Verifica que heap_scavenge libere las páginas de un bloque libre grande,
+ * que una segunda pasada no vuelva a liberarlas y que el bloque pueda
+ * reutilizarse normalmente.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scavenge_periodic(void);
+
+/**
+ * @brief Prueba la liberación de páginas al llamar a my_free.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scavenge_on_free(void);
+
+/**
+ * @brief Prueba que un bloque liberado conserve sus bytes liberados al
+ * fusionarse con un vecino residente.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scavenge_fusion_keeps_released(void);
+
+#endif // TEST_SCAVENGE_H
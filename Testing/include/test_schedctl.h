@@ -0,0 +1,23 @@
+// Testing/include/test_schedctl.h
+//
+// Declaraciones de las pruebas de los prefijos de planificación.
+
+#ifndef TEST_SCHEDCTL_H
+#define TEST_SCHEDCTL_H
+
+/**
+ * @brief Prueba que `idle` y `pin` lleguen a todas las etapas de una
+ * pipeline y a lo que lanza un grupo, y no a lo que sigue.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_schedctl_pipeline(void);
+
+/**
+ * @brief Prueba los argumentos inválidos de los prefijos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_schedctl_invalid(void);
+
+#endif // TEST_SCHEDCTL_H
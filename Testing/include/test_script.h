@@ -0,0 +1,24 @@
+// Testing/include/test_script.h
+//
+// Declaraciones de las pruebas de la lectura de archivos de comandos.
+
+#ifndef TEST_SCRIPT_H
+#define TEST_SCRIPT_H
+
+/**
+ * @brief Prueba que las líneas de un archivo regular (proyectado en memoria)
+ * se entreguen completas, incluida una última línea sin salto de línea.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_script_regular_file(void);
+
+/**
+ * @brief Prueba la lectura por bloques de un archivo que no puede
+ * proyectarse (una tubería con nombre) y de un archivo vacío.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_script_fifo_and_empty(void);
+
+#endif // TEST_SCRIPT_H
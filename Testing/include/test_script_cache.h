@@ -0,0 +1,23 @@
+// Testing/include/test_script_cache.h
+//
+// Declaraciones de las pruebas de la caché de scripts analizados.
+
+#ifndef TEST_SCRIPT_CACHE_H
+#define TEST_SCRIPT_CACHE_H
+
+/**
+ * @brief Prueba que una entrada guardada devuelva el texto de cada línea y
+ * los mismos árboles que el análisis directo.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_script_cache_roundtrip(void);
+
+/**
+ * @brief Prueba que una entrada desactualizada o dañada se descarte.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_script_cache_stale(void);
+
+#endif // TEST_SCRIPT_CACHE_H
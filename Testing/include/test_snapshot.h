@@ -0,0 +1,25 @@
+// Testing/include/test_snapshot.h
+//
+// Declaraciones de las pruebas de instantáneas del heap y reporte de fugas.
+
+#ifndef TEST_SNAPSHOT_H
+#define TEST_SNAPSHOT_H
+
+/**
+ * @brief Prueba la diferencia entre dos instantáneas.
+ *
+ * Verifica que se cuenten los bloques asignados y liberados entre ambas y que
+ * las asignaciones queden agrupadas por sitio de llamada.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_heap_diff(void);
+
+/**
+ * @brief Prueba el reporte de fugas de los bloques seguidos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_heap_leak_report(void);
+
+#endif // TEST_SNAPSHOT_H
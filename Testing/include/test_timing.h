@@ -0,0 +1,23 @@
+// Testing/include/test_timing.h
+//
+// Declaraciones de las pruebas de `time`.
+
+#ifndef TEST_TIMING_H
+#define TEST_TIMING_H
+
+/**
+ * @brief Prueba el informe en JSON de `time` para una pipeline, con los
+ * números de cada etapa.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_timing_json(void);
+
+/**
+ * @brief Prueba que `time` devuelva el estado de lo que mide.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_timing_status(void);
+
+#endif // TEST_TIMING_H
@@ -0,0 +1,32 @@
+// Testing/include/test_verify.h
+//
+// Declaraciones de las pruebas del verificador incremental del heap.
+
+#ifndef TEST_VERIFY_H
+#define TEST_VERIFY_H
+
+/**
+ * @brief Prueba que un heap sano se recorra en pasos acotados sin errores.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_verify_clean_heap(void);
+
+/**
+ * @brief Prueba la detección de un enlace corrupto.
+ *
+ * Rompe el puntero `prev` de un bloque y verifica que el verificador invoque
+ * la función registrada con HEAP_ERR_LINK y aumente el contador de errores.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_verify_detects_corruption(void);
+
+/**
+ * @brief Prueba la verificación periódica cada N asignaciones.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_verify_every_allocations(void);
+
+#endif // TEST_VERIFY_H
@@ -0,0 +1,26 @@
+// Testing/include/test_workload.h
+//
+// Declaraciones de las pruebas del generador de cargas sintéticas.
+
+#ifndef TEST_WORKLOAD_H
+#define TEST_WORKLOAD_H
+
+/**
+ * @brief Prueba que una carga con la misma semilla sea reproducible.
+ *
+ * Ejecuta dos veces una carga de dos fases y verifica que los contadores de
+ * cada fase coincidan, que la fase con `free_all` no deje objetos vivos y que
+ * la fragmentación reportada sea una proporción válida.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_workload_deterministic(void);
+
+/**
+ * @brief Prueba la carga de una especificación JSON.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_workload_load_spec(void);
+
+#endif // TEST_WORKLOAD_H
@@ -0,0 +1,23 @@
+// Testing/include/test_xargs.h
+//
+// Declaraciones de las pruebas del comando interno `xargs`.
+
+#ifndef TEST_XARGS_H
+#define TEST_XARGS_H
+
+/**
+ * @brief Prueba que `xargs` agrupe miles de elementos en pocas invocaciones
+ * y respete `-n`.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_xargs_packs_arguments(void);
+
+/**
+ * @brief Prueba la entrada separada por '\0' y los estados de salida.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_xargs_null_and_status(void);
+
+#endif // TEST_XARGS_H
@@ -0,0 +1,17 @@
+// Testing/include/test_zygote.h
+//
+// Declaraciones de las pruebas del zygote, el proceso auxiliar que lanza los
+// comandos de la shell.
+
+#ifndef TEST_ZYGOTE_H
+#define TEST_ZYGOTE_H
+
+/**
+ * @brief Prueba que el zygote lance un proceso hijo de la shell con los
+ * descriptores, el entorno y el directorio pedidos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_zygote_spawn(void);
+
+#endif // TEST_ZYGOTE_H
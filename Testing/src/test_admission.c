@@ -0,0 +1,142 @@
+// Testing/src/test_admission.c
+//
+// Pruebas de la cola de admisión de los trabajos en segundo plano: límite de
+// trabajos, `wait` y comandos sobre trabajos en cola.
+
+#include "test_admission.h"
+#include "admission.h"
+#include "arena.h"
+#include "ast.h"
+#include "event_loop.h"
+#include "executor.h"
+#include "jobs.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+/** Ejecuta una línea de la shell y devuelve su estado. */
+static int run_line(const char *line) {
+  struct s_arena arena;
+  int running = 1;
+
+  arena_init(&arena);
+  struct s_node *tree = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(tree);
+  int status = execute_node(tree, &running);
+  arena_destroy(&arena);
+  return status;
+}
+
+/** Indica si el archivo contiene el texto. */
+static int file_contains(const char *path, const char *text) {
+  char line[256];
+  int found = 0;
+  FILE *fp = fopen(path, "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  while (!found && fgets(line, sizeof(line), fp) != NULL) {
+    found = strstr(line, text) != NULL;
+  }
+  fclose(fp);
+  return found;
+}
+
+/**
+ * @brief Prueba que con `admission -j 1` los trabajos en segundo plano
+ * esperen en la cola y `wait` espere también a los encolados.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_admission_job_limit(void) {
+  struct timespec start, end;
+
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+  TEST_ASSERT_EQUAL_INT(0, run_line("admission -j 1"));
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  TEST_ASSERT_EQUAL_INT(0, run_line("sleep 0.3 &"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("sleep 0.2 &"));
+  TEST_ASSERT_EQUAL_INT(1, running_jobs());
+  TEST_ASSERT_EQUAL_INT(1, admission_queued());
+
+  // `wait` también espera a los que todavía no se lanzaron
+  TEST_ASSERT_EQUAL_INT(0, run_line("wait"));
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double elapsed =
+      (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+  TEST_ASSERT_TRUE(elapsed >= 0.45);
+  TEST_ASSERT_EQUAL_INT(0, admission_queued());
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+
+  TEST_ASSERT_EQUAL_INT(0, run_line("admission off"));
+  event_loop_shutdown();
+}
+
+/**
+ * @brief Prueba `kill`, `fg` y `bg` sobre trabajos en cola y los argumentos
+ * inválidos de `admission`.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_admission_queued_commands(void) {
+  TEST_ASSERT_EQUAL_INT(2, run_line("admission -j 0"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("admission -c 150"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("admission -j 2 -m"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("admission -x 1"));
+
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+  // Los avisos pendientes de otras pruebas liberan sus números
+  FILE *null = fopen("/dev/null", "w");
+  TEST_ASSERT_NOT_NULL(null);
+  report_jobs(null);
+  fclose(null);
+
+  TEST_ASSERT_EQUAL_INT(0, run_line("admission -j 1"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("sleep 0.3 &"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("sleep 5 &"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("echo 'cola; x' > admission2.txt &"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("sh -c 'exit 3' &"));
+  TEST_ASSERT_EQUAL_INT(3, admission_queued());
+
+  // Un trabajo en cola se quita sin haberse lanzado
+  TEST_ASSERT_EQUAL_INT(0, run_line("kill %2"));
+  TEST_ASSERT_EQUAL_INT(2, admission_queued());
+  TEST_ASSERT_EQUAL_INT(1, running_jobs());
+
+  // `bg` lo lanza sin esperar su turno, con las comillas de la línea, y `fg`
+  // además lo espera
+  TEST_ASSERT_EQUAL_INT(0, run_line("bg %3"));
+  TEST_ASSERT_EQUAL_INT(1, admission_queued());
+  TEST_ASSERT_EQUAL_INT(3, run_line("fg %4"));
+  TEST_ASSERT_EQUAL_INT(0, admission_queued());
+
+  TEST_ASSERT_EQUAL_INT(0, run_line("wait"));
+  TEST_ASSERT_TRUE(file_contains("admission2.txt", "cola; x"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("admission off"));
+  event_loop_shutdown();
+  remove("admission2.txt");
+}
+
+/**
+ * @brief Prueba que un trabajo en cola con `&` dentro de un grupo o de una
+ * subshell se lance cuando le toca.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_admission_queued_background_list(void) {
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+  TEST_ASSERT_EQUAL_INT(0, run_line("admission -j 1"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("sleep 0.2 &"));
+  TEST_ASSERT_EQUAL_INT(
+      0, run_line("{ true & echo grupo > admission3.txt; } &"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("(true & echo sub > admission4.txt) &"));
+  TEST_ASSERT_EQUAL_INT(2, admission_queued());
+
+  TEST_ASSERT_EQUAL_INT(0, run_line("wait"));
+  TEST_ASSERT_EQUAL_INT(0, admission_queued());
+  TEST_ASSERT_TRUE(file_contains("admission3.txt", "grupo"));
+  TEST_ASSERT_TRUE(file_contains("admission4.txt", "sub"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("admission off"));
+  event_loop_shutdown();
+  remove("admission3.txt");
+  remove("admission4.txt");
+}
@@ -0,0 +1,60 @@
+// Testing/src/test_alloc_config.c
+//
+// Pruebas de configuración del asignador desde el entorno y desde
+// config.json.
+
+#include "test_alloc_config.h"
+#include "alloc_config.h"
+#include "memory.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief Prueba que malloc_configure aplique la política y rechace opciones
+ * inválidas.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_malloc_configure_policy(void) {
+  int previous = get_method();
+
+  TEST_ASSERT_EQUAL_INT(0, malloc_configure("policy:best_fit,log_sample:1"));
+  TEST_ASSERT_EQUAL_INT(BEST_FIT, get_method());
+
+  TEST_ASSERT_EQUAL_INT(0, malloc_configure("policy=worst_fit"));
+  TEST_ASSERT_EQUAL_INT(WORST_FIT, get_method());
+
+  // Una opción inválida no impide aplicar las demás
+  TEST_ASSERT_EQUAL_INT(2, malloc_configure("policy:bogus,arenas,policy:first_fit"));
+  TEST_ASSERT_EQUAL_INT(FIRST_FIT, get_method());
+
+  malloc_control(previous);
+}
+
+/**
+ * @brief Prueba la exportación de allocation_method a MYMALLOC_CONF.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_export_allocator_config(void) {
+  const char *path = "test_alloc_config.json";
+  FILE *file = fopen(path, "w");
+  TEST_ASSERT_NOT_NULL(file);
+  fprintf(file, "{ \"sampling_interval\": 1, \"allocation_method\": \"worst_fit\" }\n");
+  fclose(file);
+
+  unsetenv(ALLOC_CONF_ENV);
+  TEST_ASSERT_EQUAL_INT(1, export_allocator_config(path));
+  TEST_ASSERT_EQUAL_STRING("policy:worst_fit", getenv(ALLOC_CONF_ENV));
+
+  // Una variable ya definida no se sobrescribe
+  setenv(ALLOC_CONF_ENV, "policy:first_fit", 1);
+  TEST_ASSERT_EQUAL_INT(0, export_allocator_config(path));
+  TEST_ASSERT_EQUAL_STRING("policy:first_fit", getenv(ALLOC_CONF_ENV));
+
+  unsetenv(ALLOC_CONF_ENV);
+  TEST_ASSERT_EQUAL_INT(-1, export_allocator_config("no_existe.json"));
+
+  remove(path);
+}
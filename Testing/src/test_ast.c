@@ -0,0 +1,391 @@
+// Testing/src/test_ast.c
+//
+// Pruebas del analizador de líneas de comandos (lexer y árbol sintáctico) y
+// del ejecutor del árbol.
+
+#include "test_ast.h"
+#include "arena.h"
+#include "ast.h"
+#include "executor.h"
+#include "globals.h"
+#include "unity.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static char *read_file(const char *path) {
+  static char content[256];
+  FILE *fp = fopen(path, "r");
+  if (fp == NULL) {
+    return NULL;
+  }
+  size_t size = fread(content, 1, sizeof(content) - 1, fp);
+  content[size] = '\0';
+  fclose(fp);
+  return content;
+}
+
+/** Analiza y ejecuta una línea como lo hace el bucle principal. */
+static int run_line(const char *line) {
+  struct s_arena arena;
+  int running = 1;
+  int status = -1;
+
+  arena_init(&arena);
+  struct s_node *tree = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(tree);
+  if (tree) {
+    status = execute_node(tree, &running);
+  }
+  arena_destroy(&arena);
+  return status;
+}
+
+/**
+ * @brief Prueba que las comillas y los escapes se resuelvan al separar las
+ * palabras.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parse_quoting(void) {
+  struct s_arena arena;
+  arena_init(&arena);
+
+  struct s_node *node =
+      parse_line("echo 'a  b' \"c \\\"d\\\" $x\" e\\ f \"g\"'h'i", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_COMMAND, node->type);
+  TEST_ASSERT_EQUAL_INT(5, node->argc);
+  TEST_ASSERT_EQUAL_STRING("echo", node->argv[0]);
+  TEST_ASSERT_EQUAL_STRING("a  b", node->argv[1]);
+  TEST_ASSERT_EQUAL_STRING("c \"d\" $x", node->argv[2]);
+  TEST_ASSERT_EQUAL_STRING("e f", node->argv[3]);
+  TEST_ASSERT_EQUAL_STRING("ghi", node->argv[4]);
+  TEST_ASSERT_NULL(node->argv[5]);
+
+  // Los operadores entre comillas son palabras; '#' solo comenta al inicio
+  // de una palabra
+  node = parse_line("echo '|' \"&&\" a#b ; # comentario", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_COMMAND, node->type);
+  TEST_ASSERT_EQUAL_INT(4, node->argc);
+  TEST_ASSERT_EQUAL_STRING("|", node->argv[1]);
+  TEST_ASSERT_EQUAL_STRING("&&", node->argv[2]);
+  TEST_ASSERT_EQUAL_STRING("a#b", node->argv[3]);
+
+  // Redirecciones con descriptor explícito y destino entre comillas
+  node = parse_line("cmd <in 2>\"mi error\" >>out", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(1, node->argc);
+  struct s_redirect *r = node->redirects;
+  TEST_ASSERT_NOT_NULL(r);
+  TEST_ASSERT_EQUAL_INT(REDIRECT_IN, r->type);
+  TEST_ASSERT_EQUAL_INT(0, r->fd);
+  TEST_ASSERT_EQUAL_STRING("in", r->target);
+  r = r->next;
+  TEST_ASSERT_EQUAL_INT(REDIRECT_OUT, r->type);
+  TEST_ASSERT_EQUAL_INT(2, r->fd);
+  TEST_ASSERT_EQUAL_STRING("mi error", r->target);
+  r = r->next;
+  TEST_ASSERT_EQUAL_INT(REDIRECT_APPEND, r->type);
+  TEST_ASSERT_EQUAL_INT(1, r->fd);
+  TEST_ASSERT_NULL(r->next);
+
+  // Una línea delimitada por su longitud no lee más allá de ella
+  node = parse_buffer("echo a; echo b", 6, &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_COMMAND, node->type);
+  TEST_ASSERT_EQUAL_INT(2, node->argc);
+  TEST_ASSERT_EQUAL_STRING("a", node->argv[1]);
+  TEST_ASSERT_NULL(parse_buffer("echo 'x' y", 7, &arena));
+
+  // Las líneas vacías no producen árbol
+  TEST_ASSERT_NULL(parse_line("   ", &arena));
+  TEST_ASSERT_NULL(parse_line("# solo un comentario", &arena));
+
+  arena_destroy(&arena);
+}
+
+/**
+ * @brief Prueba la forma del árbol para `;`, `&&`, `||`, `|`, `&`, `( )` y
+ * `{ }`, incluida la precedencia entre operadores.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parse_operators(void) {
+  struct s_arena arena;
+  arena_init(&arena);
+
+  // `&&` y `||` tienen la misma precedencia y asocian a la izquierda; `;` y
+  // `&` separan elementos de la lista
+  struct s_node *node = parse_line("a && b || c ; d &", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_SEQUENCE, node->type);
+  TEST_ASSERT_EQUAL_INT(NODE_OR, node->left->type);
+  TEST_ASSERT_EQUAL_INT(NODE_AND, node->left->left->type);
+  TEST_ASSERT_EQUAL_STRING("a", node->left->left->left->argv[0]);
+  TEST_ASSERT_EQUAL_STRING("c", node->left->right->argv[0]);
+  TEST_ASSERT_EQUAL_INT(NODE_BACKGROUND, node->right->type);
+  TEST_ASSERT_EQUAL_STRING("d", node->right->body->argv[0]);
+
+  // `|` tiene más precedencia que `&&`
+  node = parse_line("a | b x | c && d", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_AND, node->type);
+  TEST_ASSERT_EQUAL_INT(NODE_PIPELINE, node->left->type);
+  TEST_ASSERT_EQUAL_INT(3, node->left->num_stages);
+  TEST_ASSERT_EQUAL_STRING("x", node->left->stages[1]->argv[1]);
+
+  // Subshell con redirección y grupo dentro de una pipeline
+  node = parse_line("( a ; b ) > f | { c; d; }", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_PIPELINE, node->type);
+  TEST_ASSERT_EQUAL_INT(NODE_SUBSHELL, node->stages[0]->type);
+  TEST_ASSERT_EQUAL_INT(NODE_SEQUENCE, node->stages[0]->body->type);
+  TEST_ASSERT_NOT_NULL(node->stages[0]->redirects);
+  TEST_ASSERT_EQUAL_STRING("f", node->stages[0]->redirects->target);
+  TEST_ASSERT_EQUAL_INT(NODE_GROUP, node->stages[1]->type);
+
+  // Las llaves fuera de la posición de comando son palabras
+  node = parse_line("echo { }", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_COMMAND, node->type);
+  TEST_ASSERT_EQUAL_STRING("}", node->argv[2]);
+
+  // Los prefijos abarcan la pipeline entera; entre comillas son palabras
+  node = parse_line("idle pin 0-3 a | b && 'idle' c", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_AND, node->type);
+  TEST_ASSERT_EQUAL_INT(NODE_SCHED, node->left->type);
+  TEST_ASSERT_EQUAL_INT(3, node->left->argc);
+  TEST_ASSERT_EQUAL_STRING("0-3", node->left->argv[2]);
+  TEST_ASSERT_EQUAL_INT(NODE_PIPELINE, node->left->body->type);
+  TEST_ASSERT_EQUAL_INT(NODE_COMMAND, node->right->type);
+  TEST_ASSERT_EQUAL_STRING("idle", node->right->argv[0]);
+
+  // `time` abarca la pipeline con sus prefijos
+  node = parse_line("time -j idle a | b; 'time' c", &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_SEQUENCE, node->type);
+  TEST_ASSERT_EQUAL_INT(NODE_TIME, node->left->type);
+  TEST_ASSERT_EQUAL_INT(2, node->left->argc);
+  TEST_ASSERT_EQUAL_STRING("-j", node->left->argv[1]);
+  TEST_ASSERT_EQUAL_INT(NODE_SCHED, node->left->body->type);
+  TEST_ASSERT_EQUAL_INT(NODE_COMMAND, node->right->type);
+  TEST_ASSERT_EQUAL_STRING("time", node->right->argv[0]);
+
+  arena_destroy(&arena);
+}
+
+/**
+ * @brief Prueba que las líneas mal formadas se rechacen.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parse_syntax_errors(void) {
+  const char *invalid[] = {"| a",    "a &&",      "a | | b", "( a",
+                           "a )",    "echo 'x",   "a >",     "{ a }",
+                           "; a",    "( )",       "a && ;",  "echo \"x\\",
+                           "idle",   "pin | a",   "idle &",  "time",
+                           "time -j"};
+  struct s_arena arena;
+  arena_init(&arena);
+
+  for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+    TEST_ASSERT_NULL(parse_line(invalid[i], &arena));
+    arena_reset(&arena);
+  }
+
+  arena_destroy(&arena);
+}
+
+/**
+ * @brief Prueba que el texto de node_source() vuelva a leerse como el mismo
+ * árbol, incluidos los comandos con nombre de palabra reservada.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_node_source_round_trip(void) {
+  // Así vuelve a leer la cola de admisión un trabajo en segundo plano
+  const char *lines[] = {"'time' ls &",
+                         "'pin' 0 ls",
+                         "\\idle ls",
+                         "'cgroup' a b",
+                         "time '-j' x",
+                         "> f 'batch' y",
+                         "idle 'ionice' x | 'time' y",
+                         "time -j pin 0 echo 'a b' '{' \"c'd\"",
+                         "a & b",
+                         "{ a & }",
+                         "a & b &"};
+  struct s_arena arena;
+  arena_init(&arena);
+
+  for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    struct s_node *tree = parse_line(lines[i], &arena);
+    TEST_ASSERT_NOT_NULL(tree);
+    char *source = node_source(tree);
+    TEST_ASSERT_NOT_NULL(source);
+    struct s_node *again = parse_line(source, &arena);
+    TEST_ASSERT_NOT_NULL(again);
+    TEST_ASSERT_EQUAL_INT(tree->type, again->type);
+    char *source_again = node_source(again);
+    TEST_ASSERT_EQUAL_STRING(source, source_again);
+    free(source_again);
+    free(source);
+    arena_reset(&arena);
+  }
+
+  // Las palabras reservadas entre comillas siguen siendo comandos
+  struct s_node *tree = parse_line("'time' ls &", &arena);
+  char *source = node_source(tree);
+  struct s_node *again = parse_line(source, &arena);
+  TEST_ASSERT_EQUAL_INT(NODE_COMMAND, again->body->type);
+  TEST_ASSERT_EQUAL_STRING("time", again->body->argv[0]);
+  free(source);
+
+  tree = parse_line("time '-j' x", &arena);
+  source = node_source(tree);
+  again = parse_line(source, &arena);
+  TEST_ASSERT_EQUAL_INT(NODE_TIME, again->type);
+  TEST_ASSERT_EQUAL_INT(1, again->argc);
+  TEST_ASSERT_EQUAL_STRING("-j", again->body->argv[0]);
+  free(source);
+
+  arena_destroy(&arena);
+}
+
+/**
+ * @brief Prueba la ejecución de listas, grupos, subshells y pipelines con
+ * comandos internos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_execute_tree(void) {
+  char before[PATH_MAX], after[PATH_MAX];
+  int saved_job_control = job_control;
+  job_control = 0; // Las pruebas no corren en una terminal
+
+  // `&&` y `||` según el estado de salida; `;` siempre continúa
+  TEST_ASSERT_EQUAL_INT(
+      0, run_line("false || echo ok > ast1.txt; true && echo si >> ast1.txt;"
+                  " false && echo no >> ast1.txt; true"));
+  TEST_ASSERT_EQUAL_STRING("ok\nsi\n", read_file("ast1.txt"));
+  TEST_ASSERT_EQUAL_INT(1, run_line("true && false"));
+
+  // Un grupo redirige todos sus comandos, internos y externos
+  TEST_ASSERT_EQUAL_INT(0,
+                        run_line("{ echo \"a  b\"; printf 'c\\n'; } > ast2.txt"));
+  TEST_ASSERT_EQUAL_STRING("a  b\nc\n", read_file("ast2.txt"));
+
+  // Una subshell no cambia el directorio de la shell y devuelve su estado
+  TEST_ASSERT_NOT_NULL(getcwd(before, sizeof(before)));
+  TEST_ASSERT_EQUAL_INT(3, run_line("( cd / && sh -c 'exit 3' )"));
+  TEST_ASSERT_NOT_NULL(getcwd(after, sizeof(after)));
+  TEST_ASSERT_EQUAL_STRING(before, after);
+
+  // Los comandos internos pueden formar parte de una pipeline y la pipeline
+  // devuelve el estado de la última etapa
+  TEST_ASSERT_EQUAL_INT(0, run_line("echo hola mundo | tr a-z A-Z > ast3.txt"));
+  TEST_ASSERT_EQUAL_STRING("HOLA MUNDO\n", read_file("ast3.txt"));
+  TEST_ASSERT_EQUAL_INT(1, run_line("true | false"));
+  TEST_ASSERT_EQUAL_INT(0, run_line("false | { cat; echo fin; } > ast3.txt"));
+  TEST_ASSERT_EQUAL_STRING("fin\n", read_file("ast3.txt"));
+
+  job_control = saved_job_control;
+  remove("ast1.txt");
+  remove("ast2.txt");
+  remove("ast3.txt");
+}
+
+/**
+ * @brief Prueba una línea de 1 MB: un argumento de 1 MiB y 200000 argumentos
+ * cortos se analizan y se ejecutan completos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_long_command_line(void) {
+  const size_t word_len = 1 << 20;
+  const int words = 200000;
+  struct s_arena arena;
+  size_t length = 0;
+
+  char *line = malloc(word_len + 5 * words + 64);
+  TEST_ASSERT_NOT_NULL(line);
+  arena_init(&arena);
+
+  // Un único argumento de 1 MiB entre comillas
+  length = sprintf(line, "echo '");
+  memset(line + length, 'A', word_len);
+  length += word_len;
+  strcpy(line + length, "' fin");
+  struct s_node *node = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(3, node->argc);
+  TEST_ASSERT_EQUAL_size_t(word_len, strlen(node->argv[1]));
+  TEST_ASSERT_EQUAL_STRING("fin", node->argv[2]);
+  arena_reset(&arena);
+
+  // 200000 argumentos de 4 caracteres (1 MB) ejecutados con echo
+  length = sprintf(line, "echo");
+  for (int i = 0; i < words; i++) {
+    memcpy(line + length, " abcd", 5);
+    length += 5;
+  }
+  strcpy(line + length, " > ast4.txt");
+  node = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(words + 1, node->argc);
+  TEST_ASSERT_EQUAL_STRING("abcd", node->argv[words]);
+  TEST_ASSERT_NULL(node->argv[words + 1]);
+
+  int running = 1;
+  TEST_ASSERT_EQUAL_INT(0, execute_node(node, &running));
+  FILE *fp = fopen("ast4.txt", "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  fseek(fp, 0, SEEK_END);
+  TEST_ASSERT_EQUAL_INT(5 * words, ftell(fp));
+  fclose(fp);
+
+  arena_destroy(&arena);
+  free(line);
+  remove("ast4.txt");
+}
+
+/**
+ * @brief Prueba una pipeline de 1000 etapas.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_long_pipeline(void) {
+  const int stages = 1000;
+  int saved_job_control = job_control;
+  struct s_arena arena;
+  size_t length;
+
+  char *line = malloc(16 + 6 * stages + 16);
+  TEST_ASSERT_NOT_NULL(line);
+  length = sprintf(line, "echo hola");
+  for (int i = 1; i < stages; i++) {
+    length += sprintf(line + length, " | cat");
+  }
+  strcpy(line + length, " > ast5.txt");
+
+  arena_init(&arena);
+  struct s_node *node = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  TEST_ASSERT_EQUAL_INT(NODE_PIPELINE, node->type);
+  TEST_ASSERT_EQUAL_INT(stages, node->num_stages);
+
+  job_control = 0;
+  int running = 1;
+  TEST_ASSERT_EQUAL_INT(0, execute_node(node, &running));
+  job_control = saved_job_control;
+  TEST_ASSERT_EQUAL_STRING("hola\n", read_file("ast5.txt"));
+
+  arena_destroy(&arena);
+  free(line);
+  remove("ast5.txt");
+}
@@ -0,0 +1,80 @@
+// Testing/src/test_cgroup.c
+//
+// Pruebas del prefijo `cgroup`: dónde corren sus procesos y sus límites
+// inválidos.
+
+#include "test_cgroup.h"
+#include "arena.h"
+#include "ast.h"
+#include "executor.h"
+#include "schedctl.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+/** Ejecuta una línea de la shell y devuelve su estado. */
+static int run_line(const char *line) {
+  struct s_arena arena;
+  int running = 1;
+
+  arena_init(&arena);
+  struct s_node *tree = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(tree);
+  int status = execute_node(tree, &running);
+  arena_destroy(&arena);
+  return status;
+}
+
+/** Lee la línea de cgroup v2 ("0::/...") de un archivo como /proc/PID/cgroup. */
+static void read_cgroup(const char *path, char *line, size_t size) {
+  FILE *fp = fopen(path, "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  line[0] = '\0';
+  while (fgets(line, size, fp) != NULL && strncmp(line, "0::", 3) != 0) {
+    line[0] = '\0';
+  }
+  fclose(fp);
+}
+
+/**
+ * @brief Prueba que los procesos de un prefijo `cgroup` corran en un cgroup
+ * propio cuando hay cgroup v2, y que sin él corran igual.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_cgroup_prefix(void) {
+  char child[4096], shell[4096];
+
+  TEST_ASSERT_EQUAL_INT(
+      0, run_line("cgroup acct sh -c 'cat /proc/$$/cgroup' > cgroup1.txt"));
+  TEST_ASSERT_FALSE(schedctl_active());
+  read_cgroup("cgroup1.txt", child, sizeof(child));
+  read_cgroup("/proc/self/cgroup", shell, sizeof(shell));
+  // Sin cgroup v2 disponible el comando corre en el de la shell
+  if (strstr(child, "/job-") != NULL) {
+    TEST_ASSERT_NULL(strstr(shell, "/job-"));
+  } else {
+    TEST_ASSERT_EQUAL_STRING(shell, child);
+  }
+
+  // Los controladores que faltan se omiten; el trabajo corre igual
+  TEST_ASSERT_EQUAL_INT(0, run_line("cgroup memory=64M,cpu=50,pids=16 true"));
+  TEST_ASSERT_EQUAL_INT(1, run_line("idle cgroup acct false"));
+  TEST_ASSERT_FALSE(schedctl_active());
+  remove("cgroup1.txt");
+}
+
+/**
+ * @brief Prueba los límites inválidos del prefijo `cgroup`.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_cgroup_invalid(void) {
+  TEST_ASSERT_EQUAL_INT(2, run_line("cgroup memory=12Q true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("cgroup cpu=0 true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("cgroup pids=x true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("cgroup swap=1G true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("cgroup acct,,pids=3 true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("pin x cgroup acct true"));
+  TEST_ASSERT_FALSE(schedctl_active());
+}
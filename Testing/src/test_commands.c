@@ -20,6 +20,7 @@
 #include <stdio.h>     // Para entrada/salida estándar
 #include <stdlib.h>    // Para manejo de memoria
 #include <string.h>    // Para manipulación de cadenas
+#include <sys/stat.h>  // Para fstat
 #include <sys/types.h> // Para tipos de datos del sistema
 #include <sys/wait.h>  // Para manipulación de procesos y waitpid
 #include <unistd.h>    // Para llamadas al sistema relacionadas con procesos
@@ -125,63 +126,125 @@ void test_execute_command_invalid(void) {
   TEST_ASSERT_NOT_EQUAL(NULL, strstr(buffer, "No such file or directory"));
 }
 
+/**
+ * @brief Lee un archivo completo en memoria terminada en '\0'.
+ *
+ * @param path Ruta del archivo.
+ * @param size Donde se guarda la cantidad de bytes leídos.
+ * @return char* Contenido del archivo (liberar con free), o NULL.
+ */
+static char *read_whole_file(const char *path, size_t *size) {
+  FILE *fp = fopen(path, "r");
+  if (fp == NULL) {
+    return NULL;
+  }
+  fseek(fp, 0, SEEK_END);
+  long length = ftell(fp);
+  rewind(fp);
+  char *content = malloc(length + 1);
+  *size = fread(content, 1, length, fp);
+  content[*size] = '\0';
+  fclose(fp);
+  return content;
+}
+
 /**
  * @brief Prueba la función echo_command con un solo argumento.
  *
  * Verifica que echo_command concatene y muestre correctamente los argumentos
- * dados, en este caso "Hello, world!", con un salto de línea al final.
+ * dados, en este caso "Hello, world!", con un salto de línea al final, y que
+ * la redirección aplicada a la shell se deshaga al terminar.
  *
  * @param void No recibe parámetros.
  */
 void test_echo_command_single_arg(void) {
-  // Limpiar el buffer antes de la prueba
-  clear_printf_buffer();
+  struct stat before, after;
+  int running = 1;
+  size_t size;
 
-  // Ejemplo de entrada
-  char *args[] = {"echo", "Hello,", "world!", NULL};
-  echo_command(args);
+  fstat(STDOUT_FILENO, &before);
 
-  // Verificar el contenido del buffer
-  TEST_ASSERT_EQUAL_STRING("Hello, world!\n", get_printf_buffer());
+  char *args[] = {"echo", "Hello,", "world!", ">", "echo.txt", NULL};
+  execute_command(args, &running);
+
+  fstat(STDOUT_FILENO, &after);
+  TEST_ASSERT_EQUAL(before.st_dev, after.st_dev);
+  TEST_ASSERT_EQUAL(before.st_ino, after.st_ino);
+
+  char *content = read_whole_file("echo.txt", &size);
+  TEST_ASSERT_NOT_NULL(content);
+  TEST_ASSERT_EQUAL_STRING("Hello, world!\n", content);
+  free(content);
+  remove("echo.txt");
 }
 
 /**
- * @brief Prueba la función echo_command cuando el argumento excede el tamaño
- * del buffer.
+ * @brief Prueba la función echo_command con argumentos que superan
+ * MAX_BUFFER_SIZE y IOV_MAX.
  *
- * Verifica que echo_command detecte y maneje correctamente un caso en el que la
- * longitud de los argumentos excede el tamaño máximo del buffer, imprimiendo un
- * mensaje de error en stderr.
+ * Verifica que echo_command no trunque ni rechace argumentos largos: un
+ * argumento de 1 MiB seguido de 2000 argumentos cortos se escribe completo.
  *
  * @param void No recibe parámetros.
  */
-void test_echo_command_exceed_buffer(void) {
-  char long_arg[MAX_BUFFER_SIZE] = {0};
-  memset(long_arg, 'A',
-         MAX_BUFFER_SIZE - 10); // Crea un argumento largo que excede el buffer
+void test_echo_command_long_args(void) {
+  const size_t long_len = 1 << 20;
+  const int short_args = 2000;
+  char **args = calloc(short_args + 5, sizeof(char *));
+  char *long_arg = malloc(long_len + 1);
+  int running = 1;
+  size_t size;
 
-  char *args[] = {"echo", long_arg, "extra", NULL};
+  memset(long_arg, 'A', long_len);
+  long_arg[long_len] = '\0';
 
-  // Redirigir stderr a un archivo temporal para capturar el mensaje de error
-  freopen("temp_output_error.txt", "w+", stderr);
-  echo_command(args);
+  args[0] = "echo";
+  args[1] = long_arg;
+  for (int i = 0; i < short_args; i++) {
+    args[i + 2] = "b";
+  }
+  args[short_args + 2] = ">";
+  args[short_args + 3] = "echo_largo.txt";
 
-  // Asegurar que el mensaje se haya escrito en el archivo y restaurar stderr
-  fflush(stderr);
-  freopen("/dev/tty", "a", stderr);
+  execute_command(args, &running);
 
-  // Leer el contenido del archivo para verificar el mensaje de error
-  FILE *fp = fopen("temp_output_error.txt", "r");
-  TEST_ASSERT_NOT_NULL_MESSAGE(fp, "No se pudo abrir temp_output_error.txt");
+  char *content = read_whole_file("echo_largo.txt", &size);
+  TEST_ASSERT_NOT_NULL(content);
+  TEST_ASSERT_EQUAL_size_t(long_len + 2 * short_args + 1, size);
+  TEST_ASSERT_EQUAL_INT('A', content[long_len - 1]);
+  TEST_ASSERT_EQUAL_STRING(" b b\n", content + size - 5);
 
-  char error_buffer[256];
-  fgets(error_buffer, sizeof(error_buffer), fp);
-  fclose(fp);
-  remove("temp_output_error.txt");
+  free(content);
+  free(long_arg);
+  free(args);
+  remove("echo_largo.txt");
+}
 
-  TEST_ASSERT_EQUAL_STRING("Error: El buffer es demasiado pequeño para "
-                           "concatenar todos los argumentos.\n",
-                           error_buffer);
+/**
+ * @brief Prueba que los comandos internos con redirección corran en la shell.
+ *
+ * `cd` con su salida redirigida debe cambiar el directorio de la propia
+ * shell, lo que no ocurriría si se ejecutara en un proceso hijo.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_builtin_redirect_in_process(void) {
+  char cwd_before[PATH_MAX], cwd_after[PATH_MAX];
+  char out_path[PATH_MAX + 16];
+  int running = 1;
+
+  getcwd(cwd_before, sizeof(cwd_before));
+  snprintf(out_path, sizeof(out_path), "%s/cd.txt", cwd_before);
+
+  char *args[] = {"cd", "/", ">", out_path, NULL};
+  execute_command(args, &running);
+
+  getcwd(cwd_after, sizeof(cwd_after));
+  TEST_ASSERT_EQUAL_STRING("/", cwd_after);
+
+  chdir(cwd_before);
+  TEST_ASSERT_EQUAL_INT(0, access("cd.txt", F_OK));
+  remove("cd.txt");
 }
 
 /**
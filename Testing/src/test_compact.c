@@ -0,0 +1,94 @@
+// Testing/src/test_compact.c
+//
+// Pruebas de asignaciones movibles mediante handles y de la compactación
+// incremental del heap.
+
+#include "test_compact.h"
+#include "handle.h"
+#include "memory.h"
+#include "unity.h"
+#include <stdint.h>
+#include <string.h>
+
+#define NUM_TEST_HANDLES 16
+
+static void fill(t_handle h, unsigned char value, size_t size) {
+  unsigned char *p = hlock(h);
+  memset(p, value, size);
+  hunlock(h);
+}
+
+/**
+ * @brief Prueba que la compactación conserve los datos de los handles.
+ *
+ * Asigna varios handles, libera uno de cada dos para dejar huecos, fija uno
+ * de los restantes y compacta. Los datos deben conservarse y el bloque
+ * fijado no debe moverse.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_compact_preserves_handles(void) {
+  t_handle handles[NUM_TEST_HANDLES];
+  size_t sizes[NUM_TEST_HANDLES];
+
+  for (int i = 0; i < NUM_TEST_HANDLES; i++) {
+    sizes[i] = 32 + 24 * i;
+    handles[i] = hmalloc(sizes[i]);
+    TEST_ASSERT_NOT_EQUAL(INVALID_HANDLE, handles[i]);
+    fill(handles[i], (unsigned char)i, sizes[i]);
+  }
+
+  for (int i = 0; i < NUM_TEST_HANDLES; i += 2) {
+    hfree(handles[i]);
+    handles[i] = INVALID_HANDLE;
+  }
+
+  void *pinned = hlock(handles[7]);
+  TEST_ASSERT_NOT_NULL(pinned);
+  TEST_ASSERT_EQUAL_INT(1, hpins(handles[7]));
+
+  double before = calculate_memory_fragmentation();
+  size_t moves = 0;
+  size_t step;
+  do {
+    step = heap_compact(4);
+    moves += step;
+  } while (step == 4);
+  double after = calculate_memory_fragmentation();
+
+  TEST_ASSERT_TRUE(moves > 0);
+  TEST_ASSERT_TRUE(after <= before);
+  TEST_ASSERT_EQUAL_PTR(pinned, hlock(handles[7]));
+  hunlock(handles[7]);
+  hunlock(handles[7]);
+
+  for (int i = 1; i < NUM_TEST_HANDLES; i += 2) {
+    unsigned char *p = hlock(handles[i]);
+    TEST_ASSERT_NOT_NULL(p);
+    for (size_t j = 0; j < sizes[i]; j++) {
+      TEST_ASSERT_EQUAL_INT(i, p[j]);
+    }
+    hunlock(handles[i]);
+    hfree(handles[i]);
+  }
+}
+
+/**
+ * @brief Prueba que un handle fijado no pueda liberarse.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_hfree_pinned_handle(void) {
+  t_handle h = hmalloc(64);
+  TEST_ASSERT_NOT_EQUAL(INVALID_HANDLE, h);
+
+  TEST_ASSERT_NOT_NULL(hlock(h));
+  hfree(h);
+  TEST_ASSERT_NOT_NULL(hlock(h));
+  TEST_ASSERT_EQUAL_INT(2, hpins(h));
+
+  hunlock(h);
+  hunlock(h);
+  hfree(h);
+  TEST_ASSERT_NULL(hlock(h));
+}
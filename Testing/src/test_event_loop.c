@@ -0,0 +1,142 @@
+// Testing/src/test_event_loop.c
+//
+// Pruebas del bucle de eventos: recolección de procesos hijos en contexto
+// normal, sin avisos perdidos ni repetidos.
+
+#include "test_event_loop.h"
+#include "children.h"
+#include "event_loop.h"
+#include "jobs.h"
+#include "unity.h"
+#include <stdio.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BACKGROUND_CHILDREN 500
+
+/** Crea un hijo que termina con `code` después de `delay_us` microsegundos. */
+static pid_t spawn_child(int code, useconds_t delay_us) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    if (delay_us) {
+      usleep(delay_us);
+    }
+    _exit(code);
+  }
+  TEST_ASSERT_TRUE(pid > 0);
+  return pid;
+}
+
+/** Sigue a un hijo como trabajo en segundo plano; devuelve su número. */
+static int start_job(pid_t pid) {
+  struct s_job *job = job_create("hijo");
+  TEST_ASSERT_NOT_NULL(job);
+  TEST_ASSERT_EQUAL_INT(0, job_add_process(job, pid));
+  return job_id(job);
+}
+
+/**
+ * @brief Prueba que el bucle recolecte muchos trabajos en segundo plano, con
+ * un aviso por cada uno, mientras espera a un proceso en primer plano.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_event_loop_reaps_background(void) {
+  FILE *sink = fopen("/dev/null", "w");
+  TEST_ASSERT_NOT_NULL(sink);
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+
+  for (int i = 0; i < BACKGROUND_CHILDREN; i++) {
+    start_job(spawn_child(0, 0));
+  }
+  pid_t foreground = spawn_child(3, 100000);
+
+  int status = 0;
+  TEST_ASSERT_EQUAL_INT(foreground,
+                        wait_child(foreground, &status, WUNTRACED));
+  TEST_ASSERT_TRUE(WIFEXITED(status));
+  TEST_ASSERT_EQUAL_INT(3, WEXITSTATUS(status));
+
+  // Los que todavía no terminaron llegan en las próximas vueltas del bucle
+  int reported = report_jobs(sink);
+  time_t deadline = time(NULL) + 10;
+  while (running_jobs() > 0 && time(NULL) < deadline) {
+    event_loop_wait(0);
+    reported += report_jobs(sink);
+  }
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+  TEST_ASSERT_EQUAL_INT(BACKGROUND_CHILDREN, reported);
+  TEST_ASSERT_EQUAL_INT(0, report_jobs(sink));
+
+  event_loop_shutdown();
+  fclose(sink);
+}
+
+/**
+ * @brief Prueba que la espera de un hijo obtenga su estado aunque el bucle ya
+ * lo haya recolectado, y que falle con un proceso que no es hijo.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_event_loop_wait_child(void) {
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+
+  // Terminado antes de que alguien lo espere
+  pid_t early = spawn_child(7, 0);
+  siginfo_t info;
+  TEST_ASSERT_EQUAL_INT(0, waitid(P_PID, (id_t)early, &info,
+                                  WEXITED | WNOWAIT));
+  event_loop_poll();
+
+  int status = 0;
+  TEST_ASSERT_EQUAL_INT(early, wait_child(early, &status, 0));
+  TEST_ASSERT_EQUAL_INT(7, WEXITSTATUS(status));
+
+  // Ni el mismo hijo otra vez ni un proceso ajeno bloquean la espera
+  TEST_ASSERT_EQUAL_INT(-1, wait_child(early, &status, 0));
+  TEST_ASSERT_EQUAL_INT(-1, wait_child(1, &status, 0));
+
+  event_loop_shutdown();
+  TEST_ASSERT_FALSE(event_loop_active());
+}
+
+/**
+ * @brief Prueba el comando interno `wait` sin argumentos, con un PID y con un
+ * número de trabajo.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_wait_command(void) {
+  FILE *sink = fopen("/dev/null", "w");
+  TEST_ASSERT_NOT_NULL(sink);
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+
+  // Sin argumentos: todos los trabajos, que terminan en cualquier orden
+  for (int i = 0; i < BACKGROUND_CHILDREN; i++) {
+    start_job(spawn_child(i % 3, (useconds_t)(i % 7) * 1000));
+  }
+  TEST_ASSERT_EQUAL_INT(0, wait_command((char *[]){"wait", NULL}));
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+  TEST_ASSERT_EQUAL_INT(BACKGROUND_CHILDREN, report_jobs(sink));
+
+  // Con un trabajo y un PID: el estado es el del último, sin avisos. La
+  // tabla quedó vacía, así que los números vuelven a empezar en 1
+  pid_t by_job = spawn_child(5, 20000);
+  pid_t by_pid = spawn_child(6, 0);
+  TEST_ASSERT_EQUAL_INT(1, start_job(by_job));
+  TEST_ASSERT_EQUAL_INT(2, start_job(by_pid));
+  char pid_text[16];
+  snprintf(pid_text, sizeof(pid_text), "%d", by_pid);
+  TEST_ASSERT_EQUAL_INT(5, wait_command((char *[]){"wait", "%1", NULL}));
+  TEST_ASSERT_EQUAL_INT(6, wait_command((char *[]){"wait", pid_text, NULL}));
+  TEST_ASSERT_EQUAL_INT(0, report_jobs(sink));
+
+  // Procesos que no son hijos y argumentos inválidos
+  TEST_ASSERT_EQUAL_INT(127, wait_command((char *[]){"wait", "1", NULL}));
+  TEST_ASSERT_EQUAL_INT(127, wait_command((char *[]){"wait", "%99", NULL}));
+  TEST_ASSERT_EQUAL_INT(2, wait_command((char *[]){"wait", "x", NULL}));
+
+  event_loop_shutdown();
+  fclose(sink);
+}
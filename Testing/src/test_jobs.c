@@ -0,0 +1,176 @@
+// Testing/src/test_jobs.c
+//
+// Pruebas de la tabla de trabajos: números, búsqueda por PID, suspensión y
+// grupos de procesos de las pipelines.
+
+#include "test_jobs.h"
+#include "arena.h"
+#include "ast.h"
+#include "event_loop.h"
+#include "executor.h"
+#include "jobs.h"
+#include "test_mocks.h"
+#include "unity.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MANY_JOBS 2000
+
+/** Crea un hijo que termina con `code` después de `delay_us` microsegundos. */
+static pid_t spawn_child(int code, useconds_t delay_us) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    if (delay_us) {
+      usleep(delay_us);
+    }
+    _exit(code);
+  }
+  TEST_ASSERT_TRUE(pid > 0);
+  return pid;
+}
+
+/** Sigue a un hijo como trabajo en segundo plano; devuelve su número. */
+static int start_job(pid_t pid) {
+  struct s_job *job = job_create("hijo");
+  TEST_ASSERT_NOT_NULL(job);
+  TEST_ASSERT_EQUAL_INT(0, job_add_process(job, pid));
+  return job_id(job);
+}
+
+/**
+ * @brief Prueba la búsqueda de trabajos por número y por PID con miles de
+ * trabajos en segundo plano, y que los números se reutilicen.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_job_table_lookup(void) {
+  static pid_t pids[MANY_JOBS + 1];
+  FILE *sink = fopen("/dev/null", "w");
+  TEST_ASSERT_NOT_NULL(sink);
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+
+  for (int i = 1; i <= MANY_JOBS; i++) {
+    pids[i] = spawn_child(i % 5, 200000);
+    TEST_ASSERT_EQUAL_INT(i, start_job(pids[i]));
+  }
+
+  // `kill %n` llega al grupo del trabajo
+  kill_called = 0;
+  TEST_ASSERT_EQUAL_INT(0,
+                        kill_command((char *[]){"kill", "-s", "USR1", "%1500",
+                                                NULL}));
+  TEST_ASSERT_TRUE(kill_called);
+  TEST_ASSERT_EQUAL_INT(-pids[1500], kill_pid);
+  TEST_ASSERT_EQUAL_INT(SIGUSR1, kill_sig);
+  TEST_ASSERT_EQUAL_INT(0, kill_command((char *[]){"kill", "%%", NULL}));
+  TEST_ASSERT_EQUAL_INT(-pids[MANY_JOBS], kill_pid);
+  TEST_ASSERT_EQUAL_INT(SIGTERM, kill_sig);
+  TEST_ASSERT_EQUAL_INT(1, kill_command((char *[]){"kill", "%9999", NULL}));
+  TEST_ASSERT_EQUAL_INT(2, kill_command((char *[]){"kill", "-XYZ", "%1",
+                                                   NULL}));
+
+  // Por PID y por número, en medio de la tabla
+  char pid_text[16];
+  snprintf(pid_text, sizeof(pid_text), "%d", pids[1234]);
+  TEST_ASSERT_EQUAL_INT(1234 % 5,
+                        wait_command((char *[]){"wait", pid_text, NULL}));
+  TEST_ASSERT_EQUAL_INT(777 % 5, wait_command((char *[]){"wait", "%777", NULL}));
+  TEST_ASSERT_EQUAL_INT(127, wait_command((char *[]){"wait", "%777", NULL}));
+
+  // El resto se informa; los esperados con `wait` no
+  TEST_ASSERT_EQUAL_INT(0, wait_command((char *[]){"wait", NULL}));
+  TEST_ASSERT_EQUAL_INT(MANY_JOBS - 2, report_jobs(sink));
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+
+  // Con la tabla vacía, los números vuelven a empezar
+  TEST_ASSERT_EQUAL_INT(1, start_job(spawn_child(0, 0)));
+  TEST_ASSERT_EQUAL_INT(0, wait_command((char *[]){"wait", "%1", NULL}));
+
+  event_loop_shutdown();
+  fclose(sink);
+}
+
+/**
+ * @brief Prueba que un trabajo suspendido se informe y que `bg` lo continúe.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_job_stop_and_bg(void) {
+  FILE *sink = fopen("/dev/null", "w");
+  TEST_ASSERT_NOT_NULL(sink);
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    raise(SIGSTOP);
+    _exit(4);
+  }
+  TEST_ASSERT_TRUE(pid > 0);
+  int id = start_job(pid);
+
+  // El aviso de la suspensión llega por SIGCHLD
+  int reported = 0;
+  time_t deadline = time(NULL) + 10;
+  while (reported == 0 && time(NULL) < deadline) {
+    event_loop_wait(0);
+    reported = report_jobs(sink);
+  }
+  TEST_ASSERT_EQUAL_INT(1, reported);
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+
+  // kill es un mock: bg envía SIGCONT al grupo, y la prueba lo envía de verdad
+  kill_called = 0;
+  TEST_ASSERT_EQUAL_INT(0, bg_command((char *[]){"bg", NULL}));
+  TEST_ASSERT_TRUE(kill_called);
+  TEST_ASSERT_EQUAL_INT(-pid, kill_pid);
+  TEST_ASSERT_EQUAL_INT(SIGCONT, kill_sig);
+  TEST_ASSERT_EQUAL_INT(1, running_jobs());
+  TEST_ASSERT_EQUAL_INT(0, syscall(SYS_kill, pid, SIGCONT));
+
+  char spec[16];
+  snprintf(spec, sizeof(spec), "%%%d", id);
+  TEST_ASSERT_EQUAL_INT(4, wait_command((char *[]){"wait", spec, NULL}));
+  TEST_ASSERT_EQUAL_INT(0, report_jobs(sink));
+  TEST_ASSERT_EQUAL_INT(1, bg_command((char *[]){"bg", NULL}));
+
+  event_loop_shutdown();
+  fclose(sink);
+}
+
+/**
+ * @brief Prueba que todas las etapas de una pipeline compartan un grupo de
+ * procesos propio.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_pipeline_process_group(void) {
+  struct s_arena arena;
+  int running = 1;
+
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+  arena_init(&arena);
+  // El quinto campo de /proc/PID/stat es el grupo de procesos
+  struct s_node *tree = parse_line(
+      "sh -c 'cut -d\" \" -f5 /proc/$$/stat' | "
+      "sh -c 'cat; cut -d\" \" -f5 /proc/$$/stat' > jobs1.txt",
+      &arena);
+  TEST_ASSERT_NOT_NULL(tree);
+  TEST_ASSERT_EQUAL_INT(0, execute_node(tree, &running));
+  arena_destroy(&arena);
+  event_loop_shutdown();
+
+  FILE *fp = fopen("jobs1.txt", "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  long first = 0, second = 0;
+  TEST_ASSERT_EQUAL_INT(2, fscanf(fp, "%ld %ld", &first, &second));
+  fclose(fp);
+  remove("jobs1.txt");
+
+  TEST_ASSERT_EQUAL_INT(first, second);
+  TEST_ASSERT_NOT_EQUAL(getpgrp(), (pid_t)first);
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+}
@@ -5,6 +5,14 @@
 // módulos, incluyendo el parser, comandos, manejo de monitor y señales.
 
 #include "test_commands.h"
+#include "test_event_loop.h"
+#include "test_jobs.h"
+#include "test_parallel.h"
+#include "test_xargs.h"
+#include "test_admission.h"
+#include "test_schedctl.h"
+#include "test_cgroup.h"
+#include "test_timing.h"
 #include "test_mocks.h"
 #include "test_monitorHandle.h"
 #include "test_parser.h"
@@ -14,6 +22,19 @@
 #include "test_malloc.h"
 #include "test_fusion.h"
 #include "test_worst_fit.h"
+#include "test_compact.h"
+#include "test_scavenge.h"
+#include "test_region.h"
+#include "test_alloc_config.h"
+#include "test_ast.h"
+#include "test_workload.h"
+#include "test_verify.h"
+#include "test_snapshot.h"
+#include "test_path_cache.h"
+#include "test_scan.h"
+#include "test_script.h"
+#include "test_script_cache.h"
+#include "test_zygote.h"
 #include "unity.h"
 
 //#include "test_printf.h"
@@ -77,11 +98,27 @@ int main(void) {
   // Pruebas del parser
   RUN_TEST(test_divisor_input);
   RUN_TEST(test_parse_pipeline);
+  RUN_TEST(test_parse_quoting);
+  RUN_TEST(test_parse_operators);
+  RUN_TEST(test_parse_syntax_errors);
+  RUN_TEST(test_node_source_round_trip);
+  RUN_TEST(test_scan_implementations_agree);
+  RUN_TEST(test_scan_lexer_agree);
+  RUN_TEST(test_script_regular_file);
+  RUN_TEST(test_script_fifo_and_empty);
+  RUN_TEST(test_script_cache_roundtrip);
+  RUN_TEST(test_script_cache_stale);
 
   // Pruebas de commands
   RUN_TEST(test_change_directory);
   RUN_TEST(test_execute_command_valid);
   RUN_TEST(test_execute_command_invalid);
+  RUN_TEST(test_echo_command_single_arg);
+  RUN_TEST(test_echo_command_long_args);
+  RUN_TEST(test_builtin_redirect_in_process);
+  RUN_TEST(test_execute_tree);
+  RUN_TEST(test_long_command_line);
+  RUN_TEST(test_long_pipeline);
 
   // Test de Monitor.
   RUN_TEST(test_start_monitor);
@@ -91,6 +128,25 @@ int main(void) {
   RUN_TEST(test_shell_signal_handler_SIGTSTP_with_foreground_pid);
   RUN_TEST(test_shell_signal_handler_SIGINT_no_foreground_pid);
   RUN_TEST(test_shell_signal_handler_SIGTSTP_no_foreground_pid);
+  RUN_TEST(test_event_loop_reaps_background);
+  RUN_TEST(test_event_loop_wait_child);
+  RUN_TEST(test_wait_command);
+  RUN_TEST(test_job_table_lookup);
+  RUN_TEST(test_job_stop_and_bg);
+  RUN_TEST(test_pipeline_process_group);
+  RUN_TEST(test_parallel_keep_order);
+  RUN_TEST(test_parallel_limit_and_status);
+  RUN_TEST(test_xargs_packs_arguments);
+  RUN_TEST(test_xargs_null_and_status);
+  RUN_TEST(test_admission_job_limit);
+  RUN_TEST(test_admission_queued_commands);
+  RUN_TEST(test_admission_queued_background_list);
+  RUN_TEST(test_schedctl_pipeline);
+  RUN_TEST(test_schedctl_invalid);
+  RUN_TEST(test_cgroup_prefix);
+  RUN_TEST(test_cgroup_invalid);
+  RUN_TEST(test_timing_json);
+  RUN_TEST(test_timing_status);
 
   // Pruebas Redireccion.
   RUN_TEST(test_cat_redireccion_entrada);
@@ -101,6 +157,29 @@ int main(void) {
   RUN_TEST(test_fusion_of_adjacent_blocks);
   RUN_TEST(test_worst_fit_allocation);
   RUN_TEST(test_malloc_simple);
+  RUN_TEST(test_compact_preserves_handles);
+  RUN_TEST(test_hfree_pinned_handle);
+  RUN_TEST(test_scavenge_periodic);
+  RUN_TEST(test_scavenge_on_free);
+  RUN_TEST(test_scavenge_fusion_keeps_released);
+  RUN_TEST(test_region_hugepages);
+  RUN_TEST(test_region_hugepages_in_use);
+  RUN_TEST(test_malloc_configure_policy);
+  RUN_TEST(test_export_allocator_config);
+  RUN_TEST(test_workload_deterministic);
+  RUN_TEST(test_workload_load_spec);
+  RUN_TEST(test_verify_clean_heap);
+  RUN_TEST(test_verify_detects_corruption);
+  RUN_TEST(test_verify_every_allocations);
+  RUN_TEST(test_heap_diff);
+  RUN_TEST(test_heap_leak_report);
+
+  // Pruebas de la tabla de rutas de comandos
+  RUN_TEST(test_path_cache_lookup);
+  RUN_TEST(test_path_cache_negative_and_hash);
+
+  // Pruebas del zygote
+  RUN_TEST(test_zygote_spawn);
 
   return UNITY_END();
 }
@@ -0,0 +1,108 @@
+// Testing/src/test_parallel.c
+//
+// Pruebas del comando interno `parallel`: orden de las salidas, límite de
+// tareas simultáneas y estado de salida.
+
+#include "test_parallel.h"
+#include "arena.h"
+#include "ast.h"
+#include "event_loop.h"
+#include "executor.h"
+#include "jobs.h"
+#include "parallel.h"
+#include "unity.h"
+#include <stdio.h>
+#include <time.h>
+
+/** Ejecuta una línea de la shell y devuelve su estado. */
+static int run_line(const char *line) {
+  struct s_arena arena;
+  int running = 1;
+
+  arena_init(&arena);
+  struct s_node *tree = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(tree);
+  int status = execute_node(tree, &running);
+  arena_destroy(&arena);
+  return status;
+}
+
+/** Lee un archivo completo (a lo sumo 255 bytes) y lo borra. */
+static void read_and_remove(const char *path, char *buffer, size_t size) {
+  FILE *fp = fopen(path, "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  size_t n = fread(buffer, 1, size - 1, fp);
+  buffer[n] = '\0';
+  fclose(fp);
+  remove(path);
+}
+
+/**
+ * @brief Prueba que `parallel -k` muestre las salidas en el orden de los
+ * elementos, tomados de `:::` o de la entrada estándar.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parallel_keep_order(void) {
+  char output[256];
+
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+
+  // La primera tarea es la que más tarda
+  TEST_ASSERT_EQUAL_INT(0, run_line("parallel -k -j 3 sh -c 'sleep 0.{}; "
+                                    "echo {}' ::: 3 2 1 > parallel1.txt"));
+  read_and_remove("parallel1.txt", output, sizeof(output));
+  TEST_ASSERT_EQUAL_STRING("3\n2\n1\n", output);
+
+  FILE *fp = fopen("parallel2.txt", "w");
+  TEST_ASSERT_NOT_NULL(fp);
+  fputs("a\nb b\nc\n", fp);
+  fclose(fp);
+  TEST_ASSERT_EQUAL_INT(0, run_line("parallel -k echo x{}y < parallel2.txt "
+                                    "> parallel3.txt"));
+  remove("parallel2.txt");
+  read_and_remove("parallel3.txt", output, sizeof(output));
+  TEST_ASSERT_EQUAL_STRING("xay\nxb by\nxcy\n", output);
+
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+  event_loop_shutdown();
+}
+
+/**
+ * @brief Prueba el límite de tareas simultáneas, el estado de salida y los
+ * argumentos inválidos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_parallel_limit_and_status(void) {
+  struct timespec start, end;
+
+  // Sin bucle de eventos: cuatro tareas de 0,2 s de a dos tardan al menos
+  // 0,4 s, y el estado es la cantidad de tareas con error
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  TEST_ASSERT_EQUAL_INT(
+      2, parallel_command((char *[]){"parallel", "-j", "2", "sh", "-c",
+                                     "sleep 0.2; exit {}", ":::", "0", "1",
+                                     "0", "3", NULL}));
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double elapsed = (double)(end.tv_sec - start.tv_sec) +
+                   (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+  TEST_ASSERT_TRUE(elapsed >= 0.39);
+
+  // Con el bucle, un comando que no existe cuenta como error
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+  TEST_ASSERT_EQUAL_INT(
+      1, parallel_command((char *[]){"parallel", "-j4", "true", ":::", "a",
+                                     "b", NULL}) +
+             parallel_command((char *[]){"parallel", "no_existe_parallel",
+                                         ":::", "a", NULL}));
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+  event_loop_shutdown();
+
+  TEST_ASSERT_EQUAL_INT(2, parallel_command((char *[]){"parallel", "-j", "0",
+                                                       "true", NULL}));
+  TEST_ASSERT_EQUAL_INT(2, parallel_command((char *[]){"parallel", "-x",
+                                                       NULL}));
+  TEST_ASSERT_EQUAL_INT(2, parallel_command((char *[]){"parallel", ":::",
+                                                       "a", NULL}));
+}
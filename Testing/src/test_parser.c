@@ -6,6 +6,7 @@
 #include "globals.h"
 #include "parser.h"
 #include "unity.h"
+#include <stdlib.h>
 #include <string.h>
 
 /**
@@ -20,10 +21,9 @@
  */
 void test_divisor_input(void) {
   char input[] = "ls -l /home/user";
-  char *args[MAX_ARGS];
 
   // Llama a divisor_input para dividir la entrada en argumentos
-  divisor_input(input, args);
+  char **args = divisor_input(input);
 
   // Verificaciones de los argumentos
   TEST_ASSERT_NOT_NULL(args[0]);
@@ -31,6 +31,7 @@ void test_divisor_input(void) {
   TEST_ASSERT_EQUAL_STRING("-l", args[1]);
   TEST_ASSERT_EQUAL_STRING("/home/user", args[2]);
   TEST_ASSERT_NULL(args[3]);
+  free(args);
 }
 
 /**
@@ -44,11 +45,11 @@ void test_divisor_input(void) {
  */
 void test_parse_pipeline(void) {
   char input[] = "ls -l | grep txt | sort";
-  char *commands[MAX_PIPELINE];
+  int num_commands;
 
   // Llama a parse_pipeline para dividir la entrada en una secuencia de
   // pipelines
-  int num_commands = parse_pipeline(input, commands);
+  char **commands = parse_pipeline(input, &num_commands);
 
   // Verificaciones de los comandos y el número total
   TEST_ASSERT_EQUAL_INT(3, num_commands);
@@ -56,4 +57,5 @@ void test_parse_pipeline(void) {
   TEST_ASSERT_EQUAL_STRING("grep txt", commands[1]);
   TEST_ASSERT_EQUAL_STRING("sort", commands[2]);
   TEST_ASSERT_NULL(commands[3]);
+  free(commands);
 }
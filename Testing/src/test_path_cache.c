@@ -0,0 +1,140 @@
+// Testing/src/test_path_cache.c
+//
+// Pruebas de la tabla de rutas de comandos resueltas en PATH.
+
+#include "test_path_cache.h"
+#include "path_cache.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define DIR_A "test_path_a"
+#define DIR_B "test_path_b"
+
+static void make_program(const char *path) {
+  FILE *file = fopen(path, "w");
+  TEST_ASSERT_NOT_NULL(file);
+  fprintf(file, "#!/bin/sh\n");
+  fclose(file);
+  chmod(path, 0755);
+}
+
+/** Define PATH con rutas absolutas a los directorios de prueba. */
+static void set_path(const char *dirs[], int count) {
+  char cwd[1024], path[4096] = "";
+  TEST_ASSERT_NOT_NULL(getcwd(cwd, sizeof(cwd)));
+  for (int i = 0; i < count; i++) {
+    snprintf(path + strlen(path), sizeof(path) - strlen(path), "%s%s/%s",
+             i ? ":" : "", cwd, dirs[i]);
+  }
+  setenv("PATH", path, 1);
+}
+
+/**
+ * @brief Prueba que una ruta resuelta se recuerde y se descarte al cambiar
+ * PATH o al dejar de existir el programa.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_path_cache_lookup(void) {
+  char *saved_path = strdup(getenv("PATH"));
+  const char *both[] = {DIR_A, DIR_B};
+  const char *only_b[] = {DIR_B};
+
+  mkdir(DIR_A, 0755);
+  mkdir(DIR_B, 0755);
+  make_program(DIR_A "/herramienta");
+  make_program(DIR_B "/herramienta");
+  path_cache_clear();
+
+  set_path(both, 2);
+  const char *found = path_cache_lookup("herramienta");
+  TEST_ASSERT_NOT_NULL(found);
+  TEST_ASSERT_NOT_NULL(strstr(found, DIR_A "/herramienta"));
+
+  // Los nombres con '/' no se buscan
+  TEST_ASSERT_EQUAL_STRING("./x", path_cache_lookup("./x"));
+
+  // Si el programa desaparece se vuelve a recorrer PATH
+  remove(DIR_A "/herramienta");
+  found = path_cache_lookup("herramienta");
+  TEST_ASSERT_NOT_NULL(found);
+  TEST_ASSERT_NOT_NULL(strstr(found, DIR_B "/herramienta"));
+
+  // Un cambio de PATH invalida la tabla
+  make_program(DIR_A "/herramienta");
+  set_path(both, 2);
+  TEST_ASSERT_NOT_NULL(strstr(path_cache_lookup("herramienta"), DIR_B));
+  set_path(only_b, 1);
+  TEST_ASSERT_NOT_NULL(strstr(path_cache_lookup("herramienta"), DIR_B));
+  set_path(both, 2);
+  TEST_ASSERT_NOT_NULL(strstr(path_cache_lookup("herramienta"), DIR_A));
+
+  remove(DIR_A "/herramienta");
+  remove(DIR_B "/herramienta");
+  rmdir(DIR_A);
+  rmdir(DIR_B);
+  setenv("PATH", saved_path, 1);
+  free(saved_path);
+  path_cache_clear();
+}
+
+/**
+ * @brief Prueba que los fallos se recuerden y que `hash` los resuelva de
+ * nuevo, liste y vacíe la tabla.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_path_cache_negative_and_hash(void) {
+  char *saved_path = strdup(getenv("PATH"));
+  const char *dirs[] = {DIR_A};
+  char buffer[512] = "";
+
+  mkdir(DIR_A, 0755);
+  remove(DIR_A "/nuevo"); // Restos de una ejecución interrumpida
+  set_path(dirs, 1);
+  path_cache_clear();
+
+  TEST_ASSERT_NULL(path_cache_lookup("nuevo"));
+
+  // El fallo sigue guardado aunque el programa aparezca enseguida
+  make_program(DIR_A "/nuevo");
+  TEST_ASSERT_NULL(path_cache_lookup("nuevo"));
+
+  // `hash nombre` lo busca de nuevo sin esperar al vencimiento
+  char *add[] = {"hash", "nuevo", NULL};
+  TEST_ASSERT_EQUAL_INT(0, hash_command(add));
+  TEST_ASSERT_NOT_NULL(path_cache_lookup("nuevo"));
+
+  char *missing[] = {"hash", "no_existe", NULL};
+  TEST_ASSERT_EQUAL_INT(1, hash_command(missing));
+
+  FILE *out = tmpfile();
+  TEST_ASSERT_NOT_NULL(out);
+  TEST_ASSERT_EQUAL_size_t(1, path_cache_print(out));
+  rewind(out);
+  fread(buffer, 1, sizeof(buffer) - 1, out);
+  fclose(out);
+  TEST_ASSERT_NOT_NULL(strstr(buffer, "   1\t"));
+  TEST_ASSERT_NOT_NULL(strstr(buffer, DIR_A "/nuevo"));
+
+  char *forget[] = {"hash", "-d", "nuevo", NULL};
+  TEST_ASSERT_EQUAL_INT(0, hash_command(forget));
+  TEST_ASSERT_EQUAL_INT(1, hash_command(forget));
+
+  char *clear[] = {"hash", "-r", NULL};
+  path_cache_add("nuevo");
+  TEST_ASSERT_EQUAL_INT(0, hash_command(clear));
+  out = tmpfile();
+  TEST_ASSERT_EQUAL_size_t(0, path_cache_print(out));
+  fclose(out);
+
+  remove(DIR_A "/nuevo");
+  rmdir(DIR_A);
+  setenv("PATH", saved_path, 1);
+  free(saved_path);
+  path_cache_clear();
+}
@@ -0,0 +1,109 @@
+// Testing/src/test_region.c
+//
+// Pruebas del respaldo del heap con una región alineada a páginas enormes.
+
+#include "test_region.h"
+#include "memory.h"
+#include "unity.h"
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/** Definido en memory.c: primer bloque del heap. */
+extern void *base;
+
+/** Cuenta las páginas residentes de un tramo alineado a página. */
+static size_t resident_pages(void *start, size_t len) {
+  static unsigned char vec[HUGEPAGE_SIZE / PAGESIZE];
+  size_t pages = len / PAGESIZE;
+  size_t count = 0;
+
+  if (pages > sizeof(vec) || mincore(start, len, vec) == -1) {
+    return (size_t)-1;
+  }
+  for (size_t i = 0; i < pages; i++) {
+    count += vec[i] & 1;
+  }
+  return count;
+}
+
+/**
+ * Ejecuta la prueba en el hijo; devuelve 0 si todo salió bien o el número
+ * del paso que falló.
+ */
+static int hugepage_child(void) {
+  // El heap del padre queda abandonado: el hijo empieza uno nuevo.
+  base = NULL;
+  if (malloc_hugepages(1) != 0) {
+    return 1;
+  }
+
+  char *first = my_malloc(3 * HUGEPAGE_SIZE);
+  if (!first) {
+    return 2;
+  }
+  char *region = (char *)get_block(first);
+  if ((uintptr_t)region % HUGEPAGE_SIZE != 0) {
+    return 3;
+  }
+  memset(first, 0x5a, 3 * HUGEPAGE_SIZE);
+  if (resident_pages(region, HUGEPAGE_SIZE) == 0) {
+    return 4;
+  }
+
+  // El único bloque queda al final: se recorta y sus tramos se devuelven.
+  my_free(first);
+  if (heap_trim() != BLOCK_SIZE + 3 * HUGEPAGE_SIZE || base != NULL) {
+    return 5;
+  }
+  if (resident_pages(region, HUGEPAGE_SIZE) != 0) {
+    return 6;
+  }
+
+  // La región se vuelve a habilitar al crecer de nuevo.
+  char *again = my_malloc(HUGEPAGE_SIZE);
+  if (again != first) {
+    return 7;
+  }
+  memset(again, 0x33, HUGEPAGE_SIZE);
+  if (again[HUGEPAGE_SIZE - 1] != 0x33) {
+    return 8;
+  }
+  my_free(again);
+  return 0;
+}
+
+/**
+ * @brief Prueba asignar, recortar y devolver páginas con el heap respaldado
+ * por la región de páginas enormes, en un proceso hijo con el heap vacío.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_region_hugepages(void) {
+  fflush(NULL); // Que el hijo no repita la salida pendiente
+  pid_t pid = fork();
+  if (pid == 0) {
+    _exit(hugepage_child());
+  }
+  TEST_ASSERT_TRUE(pid > 0);
+
+  int status = 0;
+  TEST_ASSERT_EQUAL_INT(pid, waitpid(pid, &status, 0));
+  TEST_ASSERT_TRUE(WIFEXITED(status));
+  TEST_ASSERT_EQUAL_INT_MESSAGE(0, WEXITSTATUS(status),
+                                "Paso fallido en el hijo");
+}
+
+/**
+ * @brief Prueba que el respaldo no pueda cambiarse con el heap en uso.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_region_hugepages_in_use(void) {
+  void *ptr = my_malloc(16);
+  TEST_ASSERT_NOT_NULL(ptr);
+  TEST_ASSERT_EQUAL_INT(-1, malloc_hugepages(1));
+  my_free(ptr);
+}
@@ -0,0 +1,106 @@
+// Testing/src/test_scan.c
+//
+// Pruebas de la búsqueda vectorizada de caracteres especiales.
+
+#include "test_scan.h"
+#include "arena.h"
+#include "ast.h"
+#include "scan.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SCAN_BUFFER 80 // Más de dos bloques de AVX2 y una parte final
+
+static const enum e_scan_impl all_impls[] = {SCAN_SCALAR, SCAN_SSE2,
+                                             SCAN_AVX2};
+
+/**
+ * @brief Prueba que todas las implementaciones soportadas encuentren el mismo
+ * carácter que la escalar, para cada valor de byte en cada posición de un
+ * bloque y en la parte final que no completa un bloque.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scan_implementations_agree(void) {
+  enum e_scan_impl saved = scan_current();
+  char buffer[SCAN_BUFFER];
+
+  for (size_t k = 0; k < sizeof(all_impls) / sizeof(all_impls[0]); k++) {
+    if (scan_select(all_impls[k]) == -1) {
+      continue; // La CPU no la soporta
+    }
+    for (int c = 0; c < 256; c++) {
+      int word_special = strchr(" \t\n\v\f\r'\"|&;()<>$\\", c) != NULL && c;
+      int dquote_special = c == '"' || c == '\\';
+
+      for (size_t pos = 0; pos < SCAN_BUFFER; pos++) {
+        memset(buffer, 'a', sizeof(buffer));
+        buffer[pos] = (char)c;
+        for (size_t len = pos; len <= SCAN_BUFFER; len += 7) {
+          size_t expected_word = word_special ? pos : len;
+          size_t expected_dquote = dquote_special ? pos : len;
+          if (scan_word(buffer, len) != expected_word ||
+              scan_dquote(buffer, len) != expected_dquote) {
+            char message[96];
+            snprintf(message, sizeof(message), "%s: byte 0x%02x en %zu/%zu",
+                     scan_name(all_impls[k]), c, pos, len);
+            TEST_FAIL_MESSAGE(message);
+          }
+        }
+      }
+    }
+  }
+  scan_select(saved);
+}
+
+/** Concatena las palabras de un árbol de un comando, separadas por '|'. */
+static void describe(const char *line, char *out, size_t size) {
+  struct s_arena arena;
+  arena_init(&arena);
+  struct s_node *node = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(node);
+  out[0] = '\0';
+  for (int i = 0; i < node->argc; i++) {
+    snprintf(out + strlen(out), size - strlen(out), "%s|", node->argv[i]);
+  }
+  arena_destroy(&arena);
+}
+
+/**
+ * @brief Prueba que el lexer produzca las mismas palabras con todas las
+ * implementaciones.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scan_lexer_agree(void) {
+  static const char *lines[] = {
+      "echo palabra_larga_de_mas_de_treinta_y_dos_caracteres_sin_pausa x",
+      "echo \"texto entre comillas dobles con \\\"escapes\\\" y \\n sin "
+      "escapar que supera los treinta y dos bytes\" fin",
+      "printf '%s\\n' 'comillas simples largas, con | y & adentro' $HOME",
+      "a\\ b\\ c_d_e_f_g_h_i_j_k_l_m_n_o_p_q_r_s_t_u_v_w_x_y_z\\;fin",
+  };
+  enum e_scan_impl saved = scan_current();
+  char expected[512], actual[512];
+
+  for (size_t i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+    scan_select(SCAN_SCALAR);
+    describe(lines[i], expected, sizeof(expected));
+    for (size_t k = 1; k < sizeof(all_impls) / sizeof(all_impls[0]); k++) {
+      if (scan_select(all_impls[k]) == 0) {
+        describe(lines[i], actual, sizeof(actual));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+      }
+    }
+  }
+
+  // Los resultados esperados no dependen de la implementación
+  scan_select(SCAN_SCALAR);
+  describe(lines[1], expected, sizeof(expected));
+  TEST_ASSERT_EQUAL_STRING("echo|texto entre comillas dobles con \"escapes\" y "
+                           "\\n sin escapar que supera los treinta y dos "
+                           "bytes|fin|",
+                           expected);
+  scan_select(saved);
+}
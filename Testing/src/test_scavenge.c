@@ -0,0 +1,109 @@
+// Testing/src/test_scavenge.c
+//
+// Pruebas del scavenger de páginas de bloques libres grandes.
+
+#include "test_scavenge.h"
+#include "memory.h"
+#include "unity.h"
+#include <string.h>
+
+#define LARGE_BLOCK (1024 * 1024)
+
+/**
+ * @brief Prueba la liberación de páginas mediante una pasada explícita.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scavenge_periodic(void) {
+  malloc_scavenge_control(SCAVENGE_THRESHOLD, 0);
+
+  char *large = my_malloc(LARGE_BLOCK);
+  void *guard = my_malloc(16); // Evita que el bloque quede al final del heap
+  TEST_ASSERT_NOT_NULL(large);
+  TEST_ASSERT_NOT_NULL(guard);
+  memset(large, 0x5a, LARGE_BLOCK);
+
+  my_free(large);
+  TEST_ASSERT_TRUE(heap_scavenge() >= LARGE_BLOCK - 2 * PAGESIZE);
+  TEST_ASSERT_EQUAL_INT(0, heap_scavenge());
+
+  char *reused = my_malloc(LARGE_BLOCK);
+  TEST_ASSERT_NOT_NULL(reused);
+  memset(reused, 0x33, LARGE_BLOCK);
+  TEST_ASSERT_EQUAL_INT(0x33, reused[LARGE_BLOCK / 2]);
+
+  my_free(reused);
+  my_free(guard);
+}
+
+/**
+ * @brief Prueba la liberación de páginas al llamar a my_free.
+ *
+ * Con SCAVENGE_ON_FREE el bloque se libera durante my_free, por lo que una
+ * pasada posterior no encuentra nada pendiente.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scavenge_on_free(void) {
+  malloc_scavenge_control(SCAVENGE_THRESHOLD, SCAVENGE_ON_FREE);
+
+  char *large = my_malloc(LARGE_BLOCK);
+  void *guard = my_malloc(16);
+  TEST_ASSERT_NOT_NULL(large);
+  TEST_ASSERT_NOT_NULL(guard);
+  memset(large, 0x5a, LARGE_BLOCK);
+
+  my_free(large);
+  TEST_ASSERT_EQUAL_INT(0, heap_scavenge());
+
+  my_free(guard);
+  malloc_scavenge_control(SCAVENGE_THRESHOLD, 0);
+}
+
+/**
+ * @brief Prueba que las páginas liberadas sigan contándose al partir y al
+ * fusionar bloques.
+ *
+ * Un bloque liberado se parte al reutilizar su comienzo: el resto conserva
+ * sus páginas liberadas. Al liberar el comienzo, ya residente, la fusión
+ * suma los bytes liberados del resto y una nueva pasada solo devuelve lo
+ * que estaba residente.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_scavenge_fusion_keeps_released(void) {
+  malloc_scavenge_control(SCAVENGE_THRESHOLD, 0);
+
+  // Reserva el hueco de una vez y lo achica, para que el bloque grande
+  // quede detrás de un bloque ocupado y no se fusione hacia atrás
+  char *guard = my_malloc(16 + BLOCK_SIZE + 2 * LARGE_BLOCK);
+  TEST_ASSERT_NOT_NULL(guard);
+  TEST_ASSERT_EQUAL_PTR(guard, my_realloc(guard, 16));
+  char *large = my_malloc(2 * LARGE_BLOCK);
+  TEST_ASSERT_EQUAL_PTR(get_block(guard)->next->data, large);
+  t_block block = get_block(large);
+  memset(large, 0x5a, 2 * LARGE_BLOCK);
+
+  my_free(large);
+  TEST_ASSERT_TRUE(heap_scavenge() >= 2 * LARGE_BLOCK - 2 * PAGESIZE);
+  TEST_ASSERT_TRUE(released_bytes(block) >= 2 * LARGE_BLOCK - 2 * PAGESIZE);
+
+  char *front = my_malloc(LARGE_BLOCK);
+  TEST_ASSERT_EQUAL_PTR(large, front);
+  t_block rest = block->next;
+  TEST_ASSERT_TRUE(rest->free);
+  TEST_ASSERT_TRUE(rest->flags & BLOCK_RELEASED);
+  size_t rest_released = released_bytes(rest);
+  TEST_ASSERT_TRUE(rest_released >= LARGE_BLOCK - 2 * PAGESIZE);
+  memset(front, 0x33, LARGE_BLOCK);
+
+  my_free(front);
+  TEST_ASSERT_TRUE(block->flags & BLOCK_RELEASED);
+  TEST_ASSERT_EQUAL_size_t(rest_released, released_bytes(block));
+
+  size_t more = heap_scavenge();
+  TEST_ASSERT_TRUE(more >= LARGE_BLOCK - PAGESIZE && more <= LARGE_BLOCK + PAGESIZE);
+  TEST_ASSERT_EQUAL_size_t(rest_released + more, released_bytes(block));
+
+  my_free(guard);
+}
@@ -0,0 +1,91 @@
+// Testing/src/test_schedctl.c
+//
+// Pruebas de los prefijos `pin`, `idle`, `batch` e `ionice`: su alcance en
+// pipelines y grupos y sus argumentos inválidos.
+
+#include "test_schedctl.h"
+#include "arena.h"
+#include "ast.h"
+#include "executor.h"
+#include "schedctl.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+/** Ejecuta una línea de la shell y devuelve su estado. */
+static int run_line(const char *line) {
+  struct s_arena arena;
+  int running = 1;
+
+  arena_init(&arena);
+  struct s_node *tree = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(tree);
+  int status = execute_node(tree, &running);
+  arena_destroy(&arena);
+  return status;
+}
+
+/** Lee las políticas (campo 41 de /proc/PID/stat) que escribió cada etapa. */
+static int read_policies(const char *path, int *policies, int max) {
+  int count = 0;
+  FILE *fp = fopen(path, "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  while (count < max && fscanf(fp, "%d", &policies[count]) == 1) {
+    count++;
+  }
+  fclose(fp);
+  return count;
+}
+
+/**
+ * @brief Prueba que `idle` y `pin` lleguen a todas las etapas de una
+ * pipeline y a lo que lanza un grupo, y no a lo que sigue.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_schedctl_pipeline(void) {
+  int policies[4];
+
+  // Cada etapa informa su propia política; la segunda también lo que recibe
+  TEST_ASSERT_EQUAL_INT(
+      0, run_line("idle pin 0 sh -c 'cut -d\" \" -f41 /proc/$$/stat' | "
+                  "sh -c 'cat; cut -d\" \" -f41 /proc/$$/stat' > sched1.txt"));
+  TEST_ASSERT_EQUAL_INT(2, read_policies("sched1.txt", policies, 4));
+  TEST_ASSERT_EQUAL_INT(5, policies[0]); // SCHED_IDLE
+  TEST_ASSERT_EQUAL_INT(5, policies[1]);
+
+  // En un grupo rige para cada comando; el más interno manda
+  TEST_ASSERT_EQUAL_INT(
+      0, run_line("batch { sh -c 'cut -d\" \" -f41 /proc/$$/stat'; "
+                  "idle sh -c 'cut -d\" \" -f41 /proc/$$/stat'; } "
+                  "> sched1.txt"));
+  TEST_ASSERT_EQUAL_INT(2, read_policies("sched1.txt", policies, 4));
+  TEST_ASSERT_EQUAL_INT(3, policies[0]); // SCHED_BATCH
+  TEST_ASSERT_EQUAL_INT(5, policies[1]);
+
+  // Fuera del prefijo no queda nada
+  TEST_ASSERT_FALSE(schedctl_active());
+  TEST_ASSERT_EQUAL_INT(
+      0, run_line("sh -c 'cut -d\" \" -f41 /proc/$$/stat' > sched1.txt"));
+  TEST_ASSERT_EQUAL_INT(1, read_policies("sched1.txt", policies, 4));
+  TEST_ASSERT_EQUAL_INT(0, policies[0]); // SCHED_OTHER
+  remove("sched1.txt");
+}
+
+/**
+ * @brief Prueba los argumentos inválidos de los prefijos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_schedctl_invalid(void) {
+  TEST_ASSERT_EQUAL_INT(2, run_line("pin x true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("pin 3-1 true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("pin 100000 true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("ionice rt true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("ionice idle:3 true"));
+  TEST_ASSERT_EQUAL_INT(2, run_line("ionice best-effort:8 true"));
+  TEST_ASSERT_FALSE(schedctl_active());
+
+  TEST_ASSERT_EQUAL_INT(0, run_line("ionice 2:7 pin 0 true"));
+  TEST_ASSERT_FALSE(schedctl_active());
+}
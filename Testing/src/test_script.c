@@ -0,0 +1,108 @@
+// Testing/src/test_script.c
+//
+// Pruebas de la lectura de archivos de comandos.
+
+#include "test_script.h"
+#include "script.h"
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define SCRIPT_FILE "test_script.txt"
+#define SCRIPT_FIFO "test_script.fifo"
+
+/** Compara la próxima línea del script con `expected`. */
+static void expect_line(struct s_script *script, const char *expected) {
+  const char *line;
+  size_t len;
+  TEST_ASSERT_EQUAL_INT(1, script_next_line(script, &line, &len));
+  TEST_ASSERT_EQUAL_size_t(strlen(expected), len);
+  TEST_ASSERT_EQUAL_INT(0, memcmp(expected, line, len));
+}
+
+/**
+ * @brief Prueba que las líneas de un archivo regular (proyectado en memoria)
+ * se entreguen completas, incluida una última línea sin salto de línea.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_script_regular_file(void) {
+  struct s_script script;
+  const char *line;
+  size_t len;
+
+  FILE *file = fopen(SCRIPT_FILE, "w");
+  TEST_ASSERT_NOT_NULL(file);
+  fputs("echo uno\n\necho 'dos tres'\n", file);
+  for (int i = 0; i < 2000; i++) {
+    fputc('x', file); // Una línea más larga que una página
+  }
+  fputs("\nfin", file);
+  fclose(file);
+
+  TEST_ASSERT_EQUAL_INT(0, script_open(&script, SCRIPT_FILE));
+  TEST_ASSERT_EQUAL_INT(1, script.mapped);
+  expect_line(&script, "echo uno");
+  expect_line(&script, "");
+  expect_line(&script, "echo 'dos tres'");
+  TEST_ASSERT_EQUAL_INT(1, script_next_line(&script, &line, &len));
+  TEST_ASSERT_EQUAL_size_t(2000, len);
+  expect_line(&script, "fin");
+  TEST_ASSERT_EQUAL_INT(0, script_next_line(&script, &line, &len));
+  script_close(&script);
+
+  TEST_ASSERT_EQUAL_INT(-1, script_open(&script, "no_existe.txt"));
+  remove(SCRIPT_FILE);
+}
+
+/**
+ * @brief Prueba la lectura por bloques de un archivo que no puede
+ * proyectarse (una tubería con nombre) y de un archivo vacío.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_script_fifo_and_empty(void) {
+  struct s_script script;
+  const char *line;
+  size_t len;
+
+  // Más de un bloque de lectura, para que el buffer tenga que crecer
+  remove(SCRIPT_FIFO);
+  TEST_ASSERT_EQUAL_INT(0, mkfifo(SCRIPT_FIFO, 0600));
+  pid_t pid = fork();
+  if (pid == 0) {
+    FILE *fifo = fopen(SCRIPT_FIFO, "w");
+    for (int i = 0; i < 20000; i++) {
+      fprintf(fifo, "echo %05d\n", i);
+    }
+    fclose(fifo);
+    _exit(0);
+  }
+  TEST_ASSERT_TRUE(pid > 0);
+
+  TEST_ASSERT_EQUAL_INT(0, script_open(&script, SCRIPT_FIFO));
+  TEST_ASSERT_EQUAL_INT(0, script.mapped);
+  TEST_ASSERT_EQUAL_size_t(20000 * 11, script.size);
+  expect_line(&script, "echo 00000");
+  int lines = 1;
+  while (script_next_line(&script, &line, &len)) {
+    lines++;
+  }
+  TEST_ASSERT_EQUAL_INT(20000, lines);
+  TEST_ASSERT_EQUAL_INT(0, memcmp("echo 19999", line, len));
+  script_close(&script);
+  waitpid(pid, NULL, 0);
+  remove(SCRIPT_FIFO);
+
+  FILE *file = fopen(SCRIPT_FILE, "w");
+  TEST_ASSERT_NOT_NULL(file);
+  fclose(file);
+  TEST_ASSERT_EQUAL_INT(0, script_open(&script, SCRIPT_FILE));
+  TEST_ASSERT_EQUAL_INT(0, script_next_line(&script, &line, &len));
+  script_close(&script);
+  remove(SCRIPT_FILE);
+}
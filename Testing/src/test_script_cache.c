@@ -0,0 +1,211 @@
+// Testing/src/test_script_cache.c
+//
+// Pruebas de la caché de scripts analizados.
+
+#include "test_script_cache.h"
+#include "script_cache.h"
+#include "unity.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CACHE_DIR "test_cache_dir"
+#define CACHE_SCRIPT "test_cache_script.txt"
+
+static const char *script_lines[] = {
+    "echo 'a  b' \"c\" > salida.txt",
+    "",
+    "a && ( b | c x ) ; { d; } 2>e <f &",
+    "echo 'sin cerrar",
+    "# comentario",
+    "x | y | z >> w || true",
+};
+
+#define SCRIPT_LINE_COUNT (sizeof(script_lines) / sizeof(script_lines[0]))
+
+static void write_script(const char *extra) {
+  FILE *file = fopen(CACHE_SCRIPT, "w");
+  TEST_ASSERT_NOT_NULL(file);
+  for (size_t i = 0; i < SCRIPT_LINE_COUNT; i++) {
+    fprintf(file, "%s\n", script_lines[i]);
+  }
+  fputs(extra, file);
+  fclose(file);
+}
+
+/** Usa un directorio de caché propio de las pruebas. */
+static void use_test_cache_dir(void) {
+  char cwd[PATH_MAX], dir[PATH_MAX + 32];
+  TEST_ASSERT_NOT_NULL(getcwd(cwd, sizeof(cwd)));
+  snprintf(dir, sizeof(dir), "%s/%s", cwd, CACHE_DIR);
+  setenv(SCRIPT_CACHE_ENV, dir, 1);
+}
+
+static void remove_test_cache_dir(void) {
+  DIR *dir = opendir(CACHE_DIR);
+  if (dir != NULL) {
+    struct dirent *entry;
+    char path[PATH_MAX];
+    while ((entry = readdir(dir)) != NULL) {
+      if (entry->d_name[0] != '.') {
+        snprintf(path, sizeof(path), "%s/%s", CACHE_DIR, entry->d_name);
+        unlink(path);
+      }
+    }
+    closedir(dir);
+  }
+  rmdir(CACHE_DIR);
+  unsetenv(SCRIPT_CACHE_ENV);
+}
+
+/** Guarda el script en la caché a partir de su contenido actual. */
+static int store_script(void) {
+  struct s_script script;
+  TEST_ASSERT_EQUAL_INT(0, script_open(&script, CACHE_SCRIPT));
+  int result = script_cache_store(CACHE_SCRIPT, &script);
+  script_close(&script);
+  return result;
+}
+
+static void assert_same_tree(const struct s_node *a, const struct s_node *b) {
+  if (a == NULL || b == NULL) {
+    TEST_ASSERT_TRUE(a == b);
+    return;
+  }
+  TEST_ASSERT_EQUAL_INT(a->type, b->type);
+  TEST_ASSERT_EQUAL_INT(a->argc, b->argc);
+  for (int i = 0; i < a->argc; i++) {
+    TEST_ASSERT_EQUAL_STRING(a->argv[i], b->argv[i]);
+  }
+  if (a->argv != NULL) {
+    TEST_ASSERT_NULL(b->argv[b->argc]);
+  }
+  TEST_ASSERT_EQUAL_INT(a->num_stages, b->num_stages);
+  for (int i = 0; i < a->num_stages; i++) {
+    assert_same_tree(a->stages[i], b->stages[i]);
+  }
+  assert_same_tree(a->left, b->left);
+  assert_same_tree(a->right, b->right);
+  assert_same_tree(a->body, b->body);
+
+  const struct s_redirect *ra = a->redirects, *rb = b->redirects;
+  for (; ra != NULL && rb != NULL; ra = ra->next, rb = rb->next) {
+    TEST_ASSERT_EQUAL_INT(ra->type, rb->type);
+    TEST_ASSERT_EQUAL_INT(ra->fd, rb->fd);
+    TEST_ASSERT_EQUAL_STRING(ra->target, rb->target);
+  }
+  TEST_ASSERT_TRUE(ra == NULL && rb == NULL);
+}
+
+/**
+ * @brief Prueba que una entrada guardada devuelva el texto de cada línea y
+ * los mismos árboles que el análisis directo.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_script_cache_roundtrip(void) {
+  struct s_script_cache cache;
+  struct s_arena arena, expected_arena;
+  const char *line;
+  size_t len;
+  struct s_node *tree;
+
+  use_test_cache_dir();
+  write_script("");
+
+  // Sin entrada todavía
+  TEST_ASSERT_EQUAL_INT(-1, script_cache_load(&cache, CACHE_SCRIPT));
+  TEST_ASSERT_EQUAL_INT(0, store_script());
+  TEST_ASSERT_EQUAL_INT(0, script_cache_load(&cache, CACHE_SCRIPT));
+  TEST_ASSERT_EQUAL_INT(SCRIPT_LINE_COUNT, cache.line_count);
+
+  arena_init(&arena);
+  arena_init(&expected_arena);
+  for (size_t i = 0; i < SCRIPT_LINE_COUNT; i++) {
+    TEST_ASSERT_EQUAL_INT(1, script_cache_next(&cache, &line, &len, &tree,
+                                               &arena));
+    TEST_ASSERT_EQUAL_size_t(strlen(script_lines[i]), len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(script_lines[i], line, len));
+
+    // Las líneas vacías o con errores no tienen árbol
+    struct s_node *expected =
+        parse_buffer_silent(script_lines[i], len, &expected_arena);
+    assert_same_tree(expected, tree);
+    arena_reset(&arena);
+    arena_reset(&expected_arena);
+  }
+  TEST_ASSERT_EQUAL_INT(0, script_cache_next(&cache, &line, &len, &tree,
+                                             &arena));
+  script_cache_close(&cache);
+  arena_destroy(&arena);
+  arena_destroy(&expected_arena);
+
+  // Con la variable vacía la caché está desactivada
+  setenv(SCRIPT_CACHE_ENV, "", 1);
+  TEST_ASSERT_EQUAL_INT(-1, store_script());
+  TEST_ASSERT_EQUAL_INT(-1, script_cache_load(&cache, CACHE_SCRIPT));
+
+  remove(CACHE_SCRIPT);
+  remove_test_cache_dir();
+}
+
+/** Devuelve la ruta del único archivo del directorio de caché. */
+static void find_entry(char *path, size_t size) {
+  DIR *dir = opendir(CACHE_DIR);
+  struct dirent *entry;
+  TEST_ASSERT_NOT_NULL(dir);
+  path[0] = '\0';
+  while ((entry = readdir(dir)) != NULL) {
+    if (strstr(entry->d_name, ".ast") != NULL) {
+      snprintf(path, size, "%s/%s", CACHE_DIR, entry->d_name);
+    }
+  }
+  closedir(dir);
+  TEST_ASSERT_TRUE(path[0] != '\0');
+}
+
+/**
+ * @brief Prueba que una entrada desactualizada o dañada se descarte.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_script_cache_stale(void) {
+  struct s_script_cache cache;
+  struct stat st;
+  char entry[PATH_MAX];
+
+  use_test_cache_dir();
+
+  // Un cambio en el contenido invalida la entrada
+  write_script("");
+  TEST_ASSERT_EQUAL_INT(0, store_script());
+  TEST_ASSERT_EQUAL_INT(0, script_cache_load(&cache, CACHE_SCRIPT));
+  script_cache_close(&cache);
+  write_script("echo nueva\n");
+  TEST_ASSERT_EQUAL_INT(-1, script_cache_load(&cache, CACHE_SCRIPT));
+
+  // También solo la fecha de modificación, aunque el contenido sea igual
+  TEST_ASSERT_EQUAL_INT(0, store_script());
+  TEST_ASSERT_EQUAL_INT(0, script_cache_load(&cache, CACHE_SCRIPT));
+  script_cache_close(&cache);
+  TEST_ASSERT_EQUAL_INT(0, stat(CACHE_SCRIPT, &st));
+  struct timespec times[2] = {st.st_atim, st.st_mtim};
+  times[1].tv_sec -= 10;
+  TEST_ASSERT_EQUAL_INT(0, utimensat(AT_FDCWD, CACHE_SCRIPT, times, 0));
+  TEST_ASSERT_EQUAL_INT(-1, script_cache_load(&cache, CACHE_SCRIPT));
+
+  // Una entrada truncada se descarta sin leer fuera del archivo
+  TEST_ASSERT_EQUAL_INT(0, store_script());
+  find_entry(entry, sizeof(entry));
+  TEST_ASSERT_EQUAL_INT(0, stat(entry, &st));
+  TEST_ASSERT_EQUAL_INT(0, truncate(entry, st.st_size / 2));
+  TEST_ASSERT_EQUAL_INT(-1, script_cache_load(&cache, CACHE_SCRIPT));
+
+  remove(CACHE_SCRIPT);
+  remove_test_cache_dir();
+}
@@ -0,0 +1,128 @@
+// Testing/src/test_snapshot.c
+//
+// Pruebas de instantáneas del heap y reporte de fugas.
+
+#include "test_snapshot.h"
+#include "snapshot.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SITE_A_BLOCKS 10
+#define SITE_B_BLOCKS 5
+
+// Con optimización, GCC unificaría los dos sitios, que son idénticos
+#if defined(__GNUC__) && !defined(__clang__)
+#define ALLOC_SITE __attribute__((noinline, noipa))
+#else
+#define ALLOC_SITE __attribute__((noinline))
+#endif
+
+// Dos sitios de llamada distintos para el agrupamiento. La barrera después de
+// la llamada impide que se compilen como un salto a my_malloc (llamada de
+// cola): la dirección de retorno sería la de quien los llama, distinta en
+// cada llamada
+ALLOC_SITE static void *alloc_site_a(size_t size) {
+  void *ptr = my_malloc(size);
+  __asm__ volatile("" ::: "memory");
+  return ptr;
+}
+
+ALLOC_SITE static void *alloc_site_b(size_t size) {
+  void *ptr = my_malloc(size);
+  __asm__ volatile("" ::: "memory");
+  return ptr;
+}
+
+/** Lee un reporte escrito en un archivo temporal. */
+static void read_report(FILE *file, char *buffer, size_t size) {
+  rewind(file);
+  size_t n = fread(buffer, 1, size - 1, file);
+  buffer[n] = '\0';
+  fclose(file);
+}
+
+/**
+ * @brief Prueba la diferencia entre dos instantáneas.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_heap_diff(void) {
+  void *a[SITE_A_BLOCKS], *b[SITE_B_BLOCKS];
+  char report[2048];
+
+  TEST_ASSERT_EQUAL_INT(0, heap_track(1));
+  void *old = my_malloc(128);
+  void *guard = my_malloc(16);
+
+  struct s_heap_snapshot *before = heap_snapshot();
+  TEST_ASSERT_NOT_NULL(before);
+
+  for (int i = 0; i < SITE_A_BLOCKS; i++) {
+    a[i] = alloc_site_a(32);
+  }
+  for (int i = 0; i < SITE_B_BLOCKS; i++) {
+    b[i] = alloc_site_b(64);
+  }
+  my_free(old);
+
+  struct s_heap_snapshot *after = heap_snapshot();
+  TEST_ASSERT_NOT_NULL(after);
+
+  FILE *file = tmpfile();
+  TEST_ASSERT_NOT_NULL(file);
+  struct s_heap_diff d = heap_diff(before, after, file);
+  read_report(file, report, sizeof(report));
+
+  TEST_ASSERT_EQUAL_UINT(SITE_A_BLOCKS + SITE_B_BLOCKS, d.new_blocks);
+  TEST_ASSERT_EQUAL_UINT(SITE_A_BLOCKS * 32 + SITE_B_BLOCKS * 64, d.new_bytes);
+  TEST_ASSERT_EQUAL_UINT(1, d.freed_blocks);
+  TEST_ASSERT_EQUAL_UINT(128, d.freed_bytes);
+  TEST_ASSERT_NOT_NULL(strstr(report, "heap diff: +15 blocks (+640 bytes), -1 blocks (-128 bytes)"));
+  TEST_ASSERT_NOT_NULL(strstr(report, "+320 bytes (+10 blocks) -0 bytes (-0 blocks)"));
+  TEST_ASSERT_NOT_NULL(strstr(report, "+320 bytes (+5 blocks) -0 bytes (-0 blocks)"));
+
+  // Sin cambios entre una instantánea y sí misma
+  d = heap_diff(after, after, NULL);
+  TEST_ASSERT_EQUAL_UINT(0, d.new_blocks + d.freed_blocks);
+
+  heap_snapshot_free(before);
+  heap_snapshot_free(after);
+  for (int i = 0; i < SITE_A_BLOCKS; i++) {
+    my_free(a[i]);
+  }
+  for (int i = 0; i < SITE_B_BLOCKS; i++) {
+    my_free(b[i]);
+  }
+  my_free(guard);
+  heap_track(0);
+}
+
+/**
+ * @brief Prueba el reporte de fugas de los bloques seguidos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_heap_leak_report(void) {
+  char report[2048];
+  void *untracked = my_malloc(48); // Anterior al seguimiento: no se reporta
+
+  TEST_ASSERT_EQUAL_INT(0, heap_track(1));
+  void *leak1 = alloc_site_a(200);
+  void *leak2 = alloc_site_a(200);
+  void *freed = alloc_site_b(100);
+  my_free(freed);
+
+  FILE *file = tmpfile();
+  TEST_ASSERT_NOT_NULL(file);
+  TEST_ASSERT_EQUAL_UINT(2, heap_leak_report(file));
+  read_report(file, report, sizeof(report));
+
+  TEST_ASSERT_NOT_NULL(strstr(report, "Leak report: 400 bytes in 2 blocks still allocated"));
+  TEST_ASSERT_NOT_NULL(strstr(report, "400 bytes in 2 blocks from"));
+
+  my_free(leak1);
+  my_free(leak2);
+  my_free(untracked);
+  heap_track(0);
+}
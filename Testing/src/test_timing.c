@@ -0,0 +1,94 @@
+// Testing/src/test_timing.c
+//
+// Pruebas de `time`: el informe en JSON con las etapas de una pipeline y el
+// estado que devuelve.
+
+#include "test_timing.h"
+#include "arena.h"
+#include "ast.h"
+#include "executor.h"
+#include "unity.h"
+#include <cjson/cJSON.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/** Ejecuta una línea de la shell y devuelve su estado. */
+static int run_line(const char *line) {
+  struct s_arena arena;
+  int running = 1;
+
+  arena_init(&arena);
+  struct s_node *tree = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(tree);
+  int status = execute_node(tree, &running);
+  arena_destroy(&arena);
+  return status;
+}
+
+/** Lee un archivo de JSON. */
+static cJSON *read_json(const char *path) {
+  char buffer[8192];
+  FILE *fp = fopen(path, "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  size_t length = fread(buffer, 1, sizeof(buffer) - 1, fp);
+  fclose(fp);
+  buffer[length] = '\0';
+  return cJSON_Parse(buffer);
+}
+
+/** Devuelve un número de un objeto JSON, que tiene que estar. */
+static double number(const cJSON *object, const char *name) {
+  cJSON *item = cJSON_GetObjectItem(object, name);
+  TEST_ASSERT_TRUE(cJSON_IsNumber(item));
+  return item->valuedouble;
+}
+
+/** Devuelve un texto de un objeto JSON, o NULL si no está. */
+static const char *string(const cJSON *object, const char *name) {
+  return cJSON_GetStringValue(cJSON_GetObjectItem(object, name));
+}
+
+/**
+ * @brief Prueba el informe en JSON de `time` para una pipeline, con los
+ * números de cada etapa.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_timing_json(void) {
+  TEST_ASSERT_EQUAL_INT(
+      0, run_line("{ time -j sh -c 'exit 3' | cat; } 2> timing1.json"));
+
+  cJSON *json = read_json("timing1.json");
+  TEST_ASSERT_NOT_NULL(json);
+  TEST_ASSERT_EQUAL_STRING("sh -c exit 3 | cat", string(json, "command"));
+  TEST_ASSERT_EQUAL_INT(0, (int)number(json, "status"));
+  TEST_ASSERT_TRUE(number(json, "real") >= 0);
+  TEST_ASSERT_TRUE(number(json, "maxrss_kb") > 0);
+
+  // Una entrada por etapa, en orden y con su propio texto y estado
+  cJSON *stages = cJSON_GetObjectItem(json, "stages");
+  TEST_ASSERT_EQUAL_INT(2, cJSON_GetArraySize(stages));
+  cJSON *first = cJSON_GetArrayItem(stages, 0);
+  TEST_ASSERT_EQUAL_STRING("sh -c exit 3", string(first, "command"));
+  TEST_ASSERT_EQUAL_INT(3, (int)number(first, "status"));
+  TEST_ASSERT_TRUE(number(first, "pid") > 0);
+  TEST_ASSERT_TRUE(number(first, "maxrss_kb") > 0);
+  TEST_ASSERT_TRUE(number(first, "minor_faults") > 0);
+  cJSON *second = cJSON_GetArrayItem(stages, 1);
+  TEST_ASSERT_EQUAL_STRING("cat", string(second, "command"));
+  TEST_ASSERT_EQUAL_INT(0, (int)number(second, "status"));
+
+  cJSON_Delete(json);
+  remove("timing1.json");
+}
+
+/**
+ * @brief Prueba que `time` devuelva el estado de lo que mide.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_timing_status(void) {
+  TEST_ASSERT_EQUAL_INT(4, run_line("{ time sh -c 'exit 4'; } 2> /dev/null"));
+  TEST_ASSERT_EQUAL_INT(
+      0, run_line("{ time { sh -c 'exit 4' || true; }; } 2> /dev/null"));
+}
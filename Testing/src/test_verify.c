@@ -0,0 +1,127 @@
+// Testing/src/test_verify.c
+//
+// Pruebas del verificador incremental del heap.
+
+#include "test_verify.h"
+#include "memory.h"
+#include "unity.h"
+
+#define NUM_BLOCKS 16
+
+static int last_error;
+static t_block last_block;
+
+static void record_error(int error, t_block block, void *arg) {
+  (*(int *)arg)++;
+  last_error = error;
+  last_block = block;
+}
+
+/** Completa la pasada en curso para que la siguiente empiece en base. */
+static void finish_pass(void) {
+  size_t passes = heap_verify_passes();
+  while (heap_verify_passes() == passes) {
+    heap_verify_step(64);
+  }
+}
+
+/**
+ * @brief Prueba que un heap sano se recorra en pasos acotados sin errores.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_verify_clean_heap(void) {
+  void *ptrs[NUM_BLOCKS];
+  for (int i = 0; i < NUM_BLOCKS; i++) {
+    ptrs[i] = my_malloc(32 + i * 8);
+    TEST_ASSERT_NOT_NULL(ptrs[i]);
+  }
+  for (int i = 0; i < NUM_BLOCKS; i += 2) {
+    my_free(ptrs[i]);
+  }
+
+  // Reducir un bloque seguido de uno libre no debe dejar libres sin fusionar
+  void *shrunk = my_malloc(256);
+  void *next = my_malloc(64);
+  void *guard = my_malloc(16);
+  my_free(next);
+  TEST_ASSERT_EQUAL_PTR(shrunk, my_realloc(shrunk, 16));
+
+  finish_pass();
+  size_t errors = heap_verify_errors();
+  size_t passes = heap_verify_passes();
+
+  // Con presupuesto de un bloque por llamada se necesitan varias llamadas
+  int steps = 0;
+  while (heap_verify_passes() == passes) {
+    TEST_ASSERT_EQUAL_UINT(0, heap_verify_step(1));
+    steps++;
+  }
+  TEST_ASSERT_TRUE(steps >= NUM_BLOCKS);
+  TEST_ASSERT_EQUAL_UINT(errors, heap_verify_errors());
+
+  for (int i = 1; i < NUM_BLOCKS; i += 2) {
+    my_free(ptrs[i]);
+  }
+  my_free(shrunk);
+  my_free(guard);
+}
+
+/**
+ * @brief Prueba la detección de un enlace corrupto.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_verify_detects_corruption(void) {
+  int calls = 0;
+  void *a = my_malloc(64);
+  void *b = my_malloc(64);
+  void *c = my_malloc(64);
+  TEST_ASSERT_NOT_NULL(c);
+
+  t_block blk_a = get_block(a);
+  t_block blk_b = get_block(b);
+  t_block saved = blk_b->prev;
+  size_t errors = heap_verify_errors();
+
+  heap_verify_handler(record_error, &calls);
+  finish_pass();
+  blk_b->prev = blk_b; // Corrupción
+  finish_pass();
+  blk_b->prev = saved;
+  heap_verify_handler(NULL, NULL);
+
+  TEST_ASSERT_EQUAL_INT(1, calls);
+  TEST_ASSERT_EQUAL_INT(HEAP_ERR_LINK, last_error);
+  TEST_ASSERT_EQUAL_PTR(blk_a, last_block);
+  TEST_ASSERT_EQUAL_UINT(errors + 1, heap_verify_errors());
+  TEST_ASSERT_EQUAL_STRING("next->prev does not point back",
+                           heap_verify_strerror(HEAP_ERR_LINK));
+
+  my_free(a);
+  my_free(b);
+  my_free(c);
+}
+
+/**
+ * @brief Prueba la verificación periódica cada N asignaciones.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_verify_every_allocations(void) {
+  void *ptrs[NUM_BLOCKS];
+  size_t passes = heap_verify_passes();
+
+  heap_verify_every(2, 1000000);
+  for (int i = 0; i < NUM_BLOCKS; i++) {
+    ptrs[i] = my_malloc(48);
+  }
+  heap_verify_every(0, 0);
+
+  // Cada ejecución periódica completa una pasada con este presupuesto
+  TEST_ASSERT_EQUAL_UINT(passes + NUM_BLOCKS / 2, heap_verify_passes());
+
+  for (int i = 0; i < NUM_BLOCKS; i++) {
+    my_free(ptrs[i]);
+  }
+}
@@ -0,0 +1,90 @@
+// Testing/src/test_workload.c
+//
+// Pruebas del generador de cargas sintéticas.
+
+#include "test_workload.h"
+#include "memory.h"
+#include "unity.h"
+#include "workload.h"
+#include <stdio.h>
+
+/**
+ * @brief Prueba que una carga con la misma semilla sea reproducible.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_workload_deterministic(void) {
+  struct s_phase phases[2] = {
+      {.name = "churn",
+       .allocations = 5000,
+       .size = {.type = DIST_LOGNORMAL, .min = 8, .max = 4096, .mu = 4.0, .sigma = 1.0},
+       .lifetime = {.type = DIST_EXPONENTIAL, .mu = 100}},
+      {.name = "burst",
+       .allocations = 2000,
+       .size = {.type = DIST_BIMODAL, .min = 8, .mu = 32, .sigma = 8, .mu2 = 2048,
+                .sigma2 = 256, .weight = 0.8},
+       .lifetime = {.type = DIST_PERMANENT},
+       .free_all = 1},
+  };
+  struct s_workload w = {.seed = 7, .policy = -1, .num_phases = 2, .phases = phases};
+  struct s_phase_result first[2], second[2];
+
+  TEST_ASSERT_EQUAL_INT(0, workload_run(&w, first));
+  TEST_ASSERT_EQUAL_INT(0, workload_run(&w, second));
+
+  for (int i = 0; i < 2; i++) {
+    TEST_ASSERT_EQUAL_UINT(phases[i].allocations, first[i].allocations);
+    TEST_ASSERT_EQUAL_UINT(first[i].frees, second[i].frees);
+    TEST_ASSERT_EQUAL_UINT(first[i].live_bytes, second[i].live_bytes);
+    TEST_ASSERT_TRUE(first[i].fragmentation >= 0.0 && first[i].fragmentation <= 1.0);
+  }
+  TEST_ASSERT_TRUE(first[0].frees > 0);
+  TEST_ASSERT_EQUAL_UINT(0, first[1].live_objects);
+  // Con free_all se libera lo que quedó vivo de la fase anterior y todo lo
+  // asignado en la fase
+  TEST_ASSERT_EQUAL_UINT(first[0].live_objects + phases[1].allocations, first[1].frees);
+}
+
+/**
+ * @brief Prueba la carga de una especificación JSON.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_workload_load_spec(void) {
+  const char *path = "test_workload.json";
+  struct s_workload w;
+
+  FILE *file = fopen(path, "w");
+  TEST_ASSERT_NOT_NULL(file);
+  fprintf(file, "{ \"seed\": 3, \"policy\": \"best_fit\", \"phases\": ["
+                " { \"name\": \"a\", \"allocations\": 10,"
+                "   \"size\": { \"distribution\": \"fixed\", \"value\": 64 },"
+                "   \"lifetime\": { \"distribution\": \"exponential\", \"mean\": 5 } },"
+                " { \"allocations\": 20, \"free_all\": true,"
+                "   \"size\": { \"distribution\": \"powerlaw\", \"alpha\": 1.5, \"min\": 16 },"
+                "   \"lifetime\": { \"distribution\": \"permanent\" } } ] }\n");
+  fclose(file);
+
+  TEST_ASSERT_EQUAL_INT(0, workload_load(path, &w));
+  TEST_ASSERT_EQUAL_UINT(3, w.seed);
+  TEST_ASSERT_EQUAL_INT(BEST_FIT, w.policy);
+  TEST_ASSERT_EQUAL_UINT(2, w.num_phases);
+  TEST_ASSERT_EQUAL_STRING("a", w.phases[0].name);
+  TEST_ASSERT_EQUAL_INT(DIST_FIXED, w.phases[0].size.type);
+  TEST_ASSERT_TRUE(w.phases[0].size.mu == 64.0);
+  TEST_ASSERT_TRUE(w.phases[0].lifetime.mu == 5.0);
+  TEST_ASSERT_EQUAL_STRING("phase1", w.phases[1].name);
+  TEST_ASSERT_EQUAL_INT(DIST_POWERLAW, w.phases[1].size.type);
+  TEST_ASSERT_TRUE(w.phases[1].free_all);
+  workload_free(&w);
+
+  file = fopen(path, "w");
+  TEST_ASSERT_NOT_NULL(file);
+  fprintf(file, "{ \"phases\": [ { \"allocations\": 1,"
+                " \"size\": { \"distribution\": \"zipf\" },"
+                " \"lifetime\": { \"distribution\": \"permanent\" } } ] }\n");
+  fclose(file);
+  TEST_ASSERT_EQUAL_INT(-1, workload_load(path, &w));
+
+  remove(path);
+}
@@ -0,0 +1,129 @@
+// Testing/src/test_xargs.c
+//
+// Pruebas del comando interno `xargs`: agrupación de los elementos en
+// invocaciones, entrada separada por '\0' y estados de salida.
+
+#include "test_xargs.h"
+#include "arena.h"
+#include "ast.h"
+#include "event_loop.h"
+#include "executor.h"
+#include "jobs.h"
+#include "unity.h"
+#include "xargs.h"
+#include <stdio.h>
+#include <string.h>
+
+#define XARGS_ITEMS 100000
+
+/** Ejecuta una línea de la shell y devuelve su estado. */
+static int run_line(const char *line) {
+  struct s_arena arena;
+  int running = 1;
+
+  arena_init(&arena);
+  struct s_node *tree = parse_line(line, &arena);
+  TEST_ASSERT_NOT_NULL(tree);
+  int status = execute_node(tree, &running);
+  arena_destroy(&arena);
+  return status;
+}
+
+/**
+ * @brief Prueba que `xargs` agrupe miles de elementos en pocas invocaciones
+ * y respete `-n`.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_xargs_packs_arguments(void) {
+  FILE *fp = fopen("xargs1.txt", "w");
+  TEST_ASSERT_NOT_NULL(fp);
+  for (int i = 0; i < XARGS_ITEMS; i++) {
+    fprintf(fp, "%d%c", i, i % 7 ? ' ' : '\n');
+  }
+  fclose(fp);
+
+  // Cada invocación informa cuántos argumentos recibió
+  TEST_ASSERT_EQUAL_INT(0, event_loop_init());
+  TEST_ASSERT_EQUAL_INT(0, run_line("xargs -a xargs1.txt sh -c 'echo $#' x "
+                                    "> xargs2.txt"));
+  fp = fopen("xargs2.txt", "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  long count, total = 0, invocations = 0;
+  while (fscanf(fp, "%ld", &count) == 1) {
+    total += count;
+    invocations++;
+  }
+  fclose(fp);
+  TEST_ASSERT_EQUAL_INT(XARGS_ITEMS, total);
+  TEST_ASSERT_TRUE(invocations >= 1 && invocations <= 10);
+
+  TEST_ASSERT_EQUAL_INT(0, run_line("xargs -P 2 -n 30000 -a xargs1.txt "
+                                    "sh -c 'echo $#' x > xargs2.txt"));
+  fp = fopen("xargs2.txt", "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  long counts[4] = {0};
+  for (int i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL_INT(1, fscanf(fp, "%ld", &counts[i]));
+  }
+  TEST_ASSERT_EQUAL_INT(EOF, fscanf(fp, "%ld", &count));
+  fclose(fp);
+  // Con -P el orden de las salidas no está garantizado
+  TEST_ASSERT_EQUAL_INT(XARGS_ITEMS,
+                        counts[0] + counts[1] + counts[2] + counts[3]);
+  TEST_ASSERT_TRUE(counts[0] <= 30000 && counts[1] <= 30000 &&
+                   counts[2] <= 30000 && counts[3] <= 30000);
+
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+  event_loop_shutdown();
+  remove("xargs1.txt");
+  remove("xargs2.txt");
+}
+
+/**
+ * @brief Prueba la entrada separada por '\0' y los estados de salida.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_xargs_null_and_status(void) {
+  static char long_item[200000];
+  char output[64] = {0};
+
+  FILE *fp = fopen("xargs3.txt", "w");
+  TEST_ASSERT_NOT_NULL(fp);
+  fwrite("a\0b c\0\0d", 1, 8, fp);
+  fclose(fp);
+  TEST_ASSERT_EQUAL_INT(0, run_line("xargs -0 -a xargs3.txt sh -c "
+                                    "'printf \"<%s>\" \"$@\"' x > xargs4.txt"));
+  fp = fopen("xargs4.txt", "r");
+  TEST_ASSERT_NOT_NULL(fp);
+  TEST_ASSERT_NOT_NULL(fgets(output, sizeof(output), fp));
+  fclose(fp);
+  TEST_ASSERT_EQUAL_STRING("<a><b c><><d>", output);
+
+  TEST_ASSERT_EQUAL_INT(123, xargs_command((char *[]){"xargs", "-a",
+                                                      "xargs3.txt", "-0", "sh",
+                                                      "-c", "exit 3", NULL}));
+  TEST_ASSERT_EQUAL_INT(127, xargs_command((char *[]){"xargs", "-a",
+                                                      "xargs3.txt",
+                                                      "no_existe_xargs",
+                                                      NULL}));
+
+  // Un argumento no puede superar las 32 páginas de MAX_ARG_STRLEN
+  memset(long_item, 'x', sizeof(long_item) - 1);
+  fp = fopen("xargs3.txt", "w");
+  TEST_ASSERT_NOT_NULL(fp);
+  fputs(long_item, fp);
+  fclose(fp);
+  TEST_ASSERT_EQUAL_INT(1, xargs_command((char *[]){"xargs", "-a",
+                                                    "xargs3.txt", "true",
+                                                    NULL}));
+
+  TEST_ASSERT_EQUAL_INT(1, xargs_command((char *[]){"xargs", "-a",
+                                                    "no_existe.txt", NULL}));
+  TEST_ASSERT_EQUAL_INT(2, xargs_command((char *[]){"xargs", "-n", "0",
+                                                    NULL}));
+  TEST_ASSERT_EQUAL_INT(0, running_jobs());
+  remove("xargs3.txt");
+  remove("xargs4.txt");
+}
@@ -0,0 +1,70 @@
+// Testing/src/test_zygote.c
+//
+// Pruebas del zygote: el proceso lanzado debe ser hijo de quien hizo el
+// pedido y recibir sus descriptores, su entorno y su directorio actual.
+
+#include "test_zygote.h"
+#include "zygote.h"
+#include "unity.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/**
+ * @brief Prueba que el zygote lance un proceso hijo de la shell con los
+ * descriptores, el entorno y el directorio pedidos.
+ *
+ * @param void No recibe parámetros.
+ */
+void test_zygote_spawn(void) {
+  char cwd[PATH_MAX], buffer[64] = "";
+  pid_t pid;
+  int status;
+
+  TEST_ASSERT_EQUAL_INT(0, zygote_start());
+  TEST_ASSERT_TRUE(zygote_running());
+
+  // El zygote ya existe: el entorno y el directorio se envían en el pedido
+  getcwd(cwd, sizeof(cwd));
+  setenv("ZYGOTE_TEST", "valor", 1);
+  chdir("/");
+
+  int out = open("/tmp/test_zygote.txt", O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  TEST_ASSERT_TRUE(out >= 0);
+  char *argv[] = {"sh", "-c", "echo \"$ZYGOTE_TEST $PWD\"; exit 7", NULL};
+  struct s_launch launch = {argv, -1, out, -1, -1, 0, 0};
+
+  TEST_ASSERT_EQUAL_INT(0, zygote_spawn(&launch, "/bin/sh", &pid));
+  close(out);
+  chdir(cwd);
+  unsetenv("ZYGOTE_TEST");
+
+  // El hijo es de este proceso, no del zygote
+  TEST_ASSERT_TRUE(pid > 0);
+  TEST_ASSERT_EQUAL_INT(pid, waitpid(pid, &status, 0));
+  TEST_ASSERT_TRUE(WIFEXITED(status));
+  TEST_ASSERT_EQUAL_INT(7, WEXITSTATUS(status));
+
+  FILE *file = fopen("/tmp/test_zygote.txt", "r");
+  TEST_ASSERT_NOT_NULL(file);
+  fgets(buffer, sizeof(buffer), file);
+  fclose(file);
+  remove("/tmp/test_zygote.txt");
+  TEST_ASSERT_EQUAL_STRING("valor /\n", buffer);
+
+  // Un programa inexistente se informa sin dejar procesos sin recoger
+  char *missing[] = {"no_existe", NULL};
+  struct s_launch bad = {missing, -1, -1, -1, -1, 0, 0};
+  TEST_ASSERT_EQUAL_INT(0, zygote_spawn(&bad, "/no/existe", &pid));
+  TEST_ASSERT_EQUAL_INT(-1, pid);
+  TEST_ASSERT_TRUE(waitpid(-1, NULL, WNOHANG) <= 0);
+
+  zygote_stop();
+  TEST_ASSERT_FALSE(zygote_running());
+  struct s_launch again = {argv, -1, -1, -1, -1, 0, 0};
+  TEST_ASSERT_EQUAL_INT(-1, zygote_spawn(&again, "/bin/sh", &pid));
+}
@@ -0,0 +1,164 @@
+// bench_lexer.c
+//
+// Mide la velocidad del lexer y del parser, en GB/s, sobre scripts
+// sintéticos, con cada implementación de la búsqueda de caracteres especiales
+// que soporta la CPU: escalar, SSE2 y AVX2.
+//
+// Uso: bench_lexer [MiB por script] [repeticiones]
+
+#include "arena.h"
+#include "ast.h"
+#include "lexer.h"
+#include "scan.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define DEFAULT_MIB 16
+#define DEFAULT_ROUNDS 5
+
+/** Líneas con las que se arma cada script sintético. */
+static const char *const commands[] = {
+    "ls -la /usr/local/bin | grep -v total > /tmp/listado.txt\n",
+    "cd /var/log && tail -n 100 syslog | sort | uniq -c ; echo listo\n",
+    "gcc -O2 -Wall -Wextra -o programa main.c util.c parser.c 2>> errores\n",
+};
+static const char *const long_words[] = {
+    "echo /home/usuario/proyectos/compilacion/salida/objetos/modulo_de_"
+    "pruebas_con_un_nombre_largo.o /usr/share/documentacion/paquete/"
+    "referencia_completa_de_la_biblioteca_estandar.html\n",
+};
+static const char *const quoted[] = {
+    "echo \"mensaje entre comillas dobles con varias palabras y un "
+    "\\\"escape\\\" en el medio del texto\" 'y otro entre comillas simples "
+    "que tampoco se separa en palabras'\n",
+};
+
+static const struct {
+  const char *name;
+  const char *const *lines;
+  size_t count;
+} scripts[] = {
+    {"comandos", commands, sizeof(commands) / sizeof(commands[0])},
+    {"palabras largas", long_words, sizeof(long_words) / sizeof(long_words[0])},
+    {"comillas", quoted, sizeof(quoted) / sizeof(quoted[0])},
+};
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/** Arma un script de al menos `size` bytes repitiendo las líneas. */
+static char *build_script(const char *const *lines, size_t count, size_t size,
+                          size_t *len) {
+  size_t longest = 0;
+  for (size_t i = 0; i < count; i++) {
+    size_t l = strlen(lines[i]);
+    longest = l > longest ? l : longest;
+  }
+  char *script = malloc(size + longest);
+  if (!script) {
+    return NULL;
+  }
+  size_t used = 0;
+  for (size_t i = 0; used < size; i = (i + 1) % count) {
+    size_t l = strlen(lines[i]);
+    memcpy(script + used, lines[i], l);
+    used += l;
+  }
+  *len = used;
+  return script;
+}
+
+/** Separa el script en tokens, línea por línea, como lo lee la shell. */
+static int tokenize(const char *script, size_t len, struct s_arena *arena) {
+  const char *end = script + len;
+  for (const char *line = script; line < end;) {
+    const char *newline = memchr(line, '\n', (size_t)(end - line));
+    size_t line_len = newline ? (size_t)(newline - line) : (size_t)(end - line);
+    struct s_lexer lexer;
+    struct s_token token;
+
+    if (lexer_init(&lexer, line, line_len, arena) == -1) {
+      return -1;
+    }
+    while (lexer_next(&lexer, &token) != TOKEN_END) {
+      if (token.type == TOKEN_ERROR) {
+        return -1;
+      }
+    }
+    arena_reset(arena);
+    line += line_len + 1;
+  }
+  return 0;
+}
+
+/** Analiza el script completo, línea por línea. */
+static int parse(const char *script, size_t len, struct s_arena *arena) {
+  const char *end = script + len;
+  for (const char *line = script; line < end;) {
+    const char *newline = memchr(line, '\n', (size_t)(end - line));
+    size_t line_len = newline ? (size_t)(newline - line) : (size_t)(end - line);
+
+    if (parse_buffer(line, line_len, arena) == NULL) {
+      return -1;
+    }
+    arena_reset(arena);
+    line += line_len + 1;
+  }
+  return 0;
+}
+
+/** Mejor velocidad de `rounds` pasadas, en GB/s. */
+static double gigabytes_per_second(int (*pass)(const char *, size_t,
+                                               struct s_arena *),
+                                   const char *script, size_t len, int rounds) {
+  struct s_arena arena;
+  double best = 0;
+
+  arena_init(&arena);
+  for (int r = 0; r < rounds; r++) {
+    double start = now();
+    if (pass(script, len, &arena) == -1) {
+      arena_destroy(&arena);
+      return 0;
+    }
+    double rate = len / (now() - start) / 1e9;
+    best = rate > best ? rate : best;
+  }
+  arena_destroy(&arena);
+  return best;
+}
+
+int main(int argc, char *argv[]) {
+  static const enum e_scan_impl impls[] = {SCAN_SCALAR, SCAN_SSE2, SCAN_AVX2};
+  size_t mib = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_MIB;
+  int rounds = argc > 2 ? atoi(argv[2]) : DEFAULT_ROUNDS;
+
+  printf("implementación por defecto: %s\n", scan_name(scan_current()));
+  printf("%-16s %-8s %14s %14s\n", "script", "impl", "lexer GB/s",
+         "parser GB/s");
+  for (size_t s = 0; s < sizeof(scripts) / sizeof(scripts[0]); s++) {
+    size_t len;
+    char *script = build_script(scripts[s].lines, scripts[s].count, mib << 20,
+                                &len);
+    if (!script) {
+      perror("malloc");
+      return EXIT_FAILURE;
+    }
+    for (size_t i = 0; i < sizeof(impls) / sizeof(impls[0]); i++) {
+      if (scan_select(impls[i]) == -1) {
+        continue; // La CPU no la soporta
+      }
+      double lexed = gigabytes_per_second(tokenize, script, len, rounds);
+      double parsed = gigabytes_per_second(parse, script, len, rounds);
+      printf("%-16s %-8s %14.3f %14.3f\n", scripts[s].name,
+             scan_name(impls[i]), lexed, parsed);
+    }
+    free(script);
+  }
+  return EXIT_SUCCESS;
+}
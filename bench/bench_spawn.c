@@ -0,0 +1,78 @@
+// bench_spawn.c
+//
+// Mide cuántas veces por segundo la shell puede lanzar `true` con fork +
+// execv, con posix_spawn y a través del zygote, con distintos tamaños de heap
+// residente. El costo de fork crece con las tablas de páginas a copiar; el
+// de posix_spawn no, y el zygote hace fork desde la imagen pequeña que tenía
+// el proceso al arrancar.
+//
+// Uso: bench_spawn [lanzamientos] [MiB de heap...]
+
+#include "launcher.h"
+#include "zygote.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+
+#define DEFAULT_LAUNCHES 2000
+
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static double launches_per_second(int mode, int launches) {
+  char *argv[] = {"true", NULL};
+  struct s_launch launch = {argv, -1, -1, -1, -1, 0, 0};
+
+  launch_set_mode(mode);
+  double start = now();
+  for (int i = 0; i < launches; i++) {
+    pid_t pid = launch_process(&launch);
+    if (pid < 0 || waitpid(pid, NULL, 0) == -1) {
+      return 0;
+    }
+  }
+  return launches / (now() - start);
+}
+
+int main(int argc, char *argv[]) {
+  static const size_t default_sizes[] = {0, 64, 256, 1024};
+  int launches = argc > 1 ? atoi(argv[1]) : DEFAULT_LAUNCHES;
+  size_t num_sizes = argc > 2 ? (size_t)argc - 2 : sizeof(default_sizes) / sizeof(default_sizes[0]);
+  char *heap = NULL;
+  size_t heap_mib = 0;
+
+  // Como en la shell, el zygote se crea antes de que crezca el heap
+  int have_zygote = zygote_start() == 0;
+
+  printf("%10s %12s %12s %12s\n", "heap MiB", "fork/s", "spawn/s", "zygote/s");
+  for (size_t i = 0; i < num_sizes; i++) {
+    size_t mib = argc > 2 ? strtoul(argv[i + 2], NULL, 10) : default_sizes[i];
+
+    // Heap residente: cada página se toca para que tenga su entrada en la
+    // tabla de páginas
+    if (mib > heap_mib) {
+      char *grown = realloc(heap, mib << 20);
+      if (!grown) {
+        perror("realloc");
+        break;
+      }
+      heap = grown;
+      memset(heap + (heap_mib << 20), 1, (mib - heap_mib) << 20);
+      heap_mib = mib;
+    }
+
+    double forked = launches_per_second(LAUNCH_FORK, launches);
+    double spawned = launches_per_second(LAUNCH_SPAWN, launches);
+    double zygote = have_zygote ? launches_per_second(LAUNCH_ZYGOTE, launches) : 0;
+    printf("%10zu %12.0f %12.0f %12.0f\n", heap_mib, forked, spawned, zygote);
+  }
+
+  zygote_stop();
+  free(heap);
+  return EXIT_SUCCESS;
+}
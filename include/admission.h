@@ -0,0 +1,90 @@
+/**
+ * @file admission.h
+ * @brief Cola de admisión de los trabajos en segundo plano.
+ *
+ * Lanzar muchos trabajos con `&` a la vez sobrecarga la máquina. Con el
+ * comando interno `admission` se configuran límites para la cantidad de
+ * trabajos en ejecución, el uso de CPU y la memoria libre; mientras alguno
+ * está configurado, un trabajo en segundo plano que no entra en los límites
+ * queda en una cola y `jobs` lo muestra "En cola". La cola se atiende en
+ * orden cada vez que el bucle de eventos despierta, y periódicamente mientras
+ * no está vacía.
+ *
+ * El uso de CPU y la memoria libre se toman de los mensajes del monitor
+ * (`cpu_usage` y `free_memory`, ver monitorHandle.h) mientras está en
+ * ejecución, y si no, de /proc/stat y /proc/meminfo. Una muestra todavía no
+ * refleja los trabajos recién lanzados, así que con esos límites se admite a
+ * lo sumo un trabajo por muestra.
+ */
+
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include "ast.h"
+
+struct s_job;
+
+/**
+ * @brief Decide si un trabajo en segundo plano se lanza ya o entra en la
+ * cola. Si entra en la cola, se crea en la tabla de trabajos con el texto de
+ * `body` y se muestra su número.
+ *
+ * @param body Contenido de `lista &`.
+ * @return int 1 si quedó en la cola, 0 si hay que lanzarlo.
+ */
+int admission_defer(struct s_node *body);
+
+/**
+ * @brief Lanza los trabajos de la cola que entran en los límites.
+ *
+ * La llama el bucle de eventos cada vez que atiende eventos.
+ *
+ * @return int Cantidad de trabajos lanzados.
+ */
+int admit_jobs(void);
+
+/**
+ * @brief Cada cuánto debe despertar el bucle de eventos para revisar la
+ * cola, aunque no lleguen eventos.
+ *
+ * @return int Milisegundos, o -1 si la cola está vacía.
+ */
+int admission_timeout(void);
+
+/**
+ * @brief Cantidad de trabajos en la cola.
+ *
+ * @return int Trabajos que esperan su turno.
+ */
+int admission_queued(void);
+
+/**
+ * @brief Lanza en segundo plano un trabajo de la cola sin esperar su turno
+ * (`bg %n` o `fg %n`).
+ *
+ * @param job Trabajo en cola.
+ * @return int 0 si se lanzó; si no, el trabajo ya no está en la tabla.
+ */
+int admission_start(struct s_job *job);
+
+/**
+ * @brief Quita un trabajo de la cola, si está en ella.
+ *
+ * @param job Trabajo.
+ */
+void admission_forget(struct s_job *job);
+
+/**
+ * @brief Comando interno `admission [-j N] [-c %CPU] [-m MB] | admission off`.
+ *
+ * Sin argumentos muestra los límites, las últimas métricas y la cantidad de
+ * trabajos en cola. `-j` limita los trabajos en ejecución, `-c` el uso de
+ * CPU y `-m` fija la memoria libre mínima; `off` quita los límites y lanza
+ * los trabajos en cola.
+ *
+ * @param args Argumentos del comando (args[0] es "admission").
+ * @return int 0, o 2 si los argumentos no son válidos.
+ */
+int admission_command(char **args);
+
+#endif // ADMISSION_H
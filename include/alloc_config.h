@@ -0,0 +1,32 @@
+/**
+ * @file alloc_config.h
+ * @brief Configuración del asignador de memoria desde la shell.
+ *
+ * Traduce la clave `allocation_method` de config.json a la variable de
+ * entorno que lee el asignador de `lib/memory`, de modo que los procesos
+ * lanzados desde la shell (como el monitor) usen la política configurada.
+ */
+
+#ifndef ALLOC_CONFIG_H
+#define ALLOC_CONFIG_H
+
+/**
+ * @brief Nombre de la variable de entorno leída por el asignador.
+ */
+#define ALLOC_CONF_ENV "MYMALLOC_CONF"
+
+/**
+ * @brief Exporta la política de asignación definida en un config.json.
+ *
+ * Lee la clave `allocation_method` del archivo y, si la variable de entorno
+ * ALLOC_CONF_ENV no está definida, la define como `policy:<método>`. Una
+ * variable ya definida tiene prioridad y no se modifica, lo que permite
+ * probar otra política por despliegue sin editar el archivo.
+ *
+ * @param config_path Ruta al archivo de configuración JSON.
+ * @return int 1 si se exportó la política, 0 si no había nada que exportar,
+ * -1 si el archivo no pudo leerse o el método no es válido.
+ */
+int export_allocator_config(const char *config_path);
+
+#endif // ALLOC_CONFIG_H
@@ -0,0 +1,70 @@
+/**
+ * @file arena.h
+ * @brief Arena de memoria para los datos de una línea de comandos.
+ *
+ * Los tokens y los nodos del árbol sintáctico de una línea viven lo mismo que
+ * la línea: se piden a la arena con un simple incremento de puntero y se
+ * liberan todos juntos con `arena_reset` antes de leer la siguiente. El primer
+ * bloque se conserva entre líneas, por lo que una línea típica no llama a
+ * malloc.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+/** Tamaño mínimo de cada bloque de la arena. */
+#define ARENA_CHUNK_SIZE 4096
+
+struct s_arena_chunk;
+
+/**
+ * @struct s_arena
+ * @brief Lista de bloques de memoria de los que se reparten asignaciones.
+ */
+struct s_arena {
+  struct s_arena_chunk *head; /**< Bloque en uso (el más reciente). */
+};
+
+/**
+ * @brief Inicializa una arena vacía.
+ *
+ * @param arena Arena a inicializar.
+ */
+void arena_init(struct s_arena *arena);
+
+/**
+ * @brief Reserva memoria alineada de la arena.
+ *
+ * @param arena Arena de la que se reserva.
+ * @param size Cantidad de bytes.
+ * @return void* Memoria sin inicializar, o NULL si no hubo memoria.
+ */
+void *arena_alloc(struct s_arena *arena, size_t size);
+
+/**
+ * @brief Copia los primeros `len` bytes de una cadena en la arena.
+ *
+ * @param arena Arena de la que se reserva.
+ * @param s Cadena de origen.
+ * @param len Cantidad de bytes a copiar.
+ * @return char* Copia terminada en '\0', o NULL si no hubo memoria.
+ */
+char *arena_strndup(struct s_arena *arena, const char *s, size_t len);
+
+/**
+ * @brief Libera todas las asignaciones, conservando el primer bloque.
+ *
+ * @param arena Arena a vaciar.
+ */
+void arena_reset(struct s_arena *arena);
+
+/**
+ * @brief Libera todos los bloques de la arena.
+ *
+ * @param arena Arena a destruir.
+ */
+void arena_destroy(struct s_arena *arena);
+
+#endif // ARENA_H
@@ -0,0 +1,140 @@
+/**
+ * @file ast.h
+ * @brief Árbol sintáctico de una línea de comandos y su analizador.
+ *
+ * Gramática reconocida (analizador descendente recursivo):
+ *
+ *     lista     := and_or ((';' | '&') and_or)* [';' | '&']
+ *     and_or    := pipeline (('&&' | '||') pipeline)*
+ *     pipeline  := 'time' ['-j'] pipeline | prefijo* comando ('|' comando)*
+ *     prefijo   := 'pin' PALABRA | 'idle' | 'batch' | 'ionice' PALABRA
+ *                | 'cgroup' PALABRA
+ *     comando   := simple | '(' lista ')' redir* | '{' lista '}' redir*
+ *     simple    := (PALABRA | redir)+
+ *     redir     := [n]('<' | '>' | '>>') PALABRA
+ *
+ * `{` y `}` son palabras reservadas: solo delimitan un grupo cuando aparecen
+ * sin comillas en posición de comando. Los prefijos también lo son al
+ * comienzo de una pipeline (ver schedctl.h). Todos los nodos viven en la arena de
+ * la línea.
+ */
+
+#ifndef AST_H
+#define AST_H
+
+#include "arena.h"
+
+/**
+ * @brief Tipos de nodo.
+ */
+enum e_node_type {
+  NODE_COMMAND,    /**< Comando simple: `argv` y `redirects`. */
+  NODE_PIPELINE,   /**< `a | b | c`: `stages`. */
+  NODE_AND,        /**< `left && right`. */
+  NODE_OR,         /**< `left || right`. */
+  NODE_SEQUENCE,   /**< `left ; right`. */
+  NODE_BACKGROUND, /**< `body &`. */
+  NODE_SUBSHELL,   /**< `( body )` con `redirects`, en un proceso hijo. */
+  NODE_GROUP,      /**< `{ body; }` con `redirects`, en la propia shell. */
+  NODE_SCHED,      /**< Prefijos en `argv` que abarcan la pipeline `body`. */
+  NODE_TIME        /**< `time` y sus opciones en `argv`, que miden `body`. */
+};
+
+/**
+ * @brief Tipos de redirección.
+ */
+enum e_redirect_type {
+  REDIRECT_IN,    /**< `[n]<archivo` */
+  REDIRECT_OUT,   /**< `[n]>archivo` */
+  REDIRECT_APPEND /**< `[n]>>archivo` */
+};
+
+/**
+ * @struct s_redirect
+ * @brief Una redirección, en el orden en que aparece en la línea.
+ */
+struct s_redirect {
+  enum e_redirect_type type; /**< Tipo de redirección. */
+  int fd;                    /**< Descriptor redirigido. */
+  char *target;              /**< Archivo. */
+  struct s_redirect *next;   /**< Siguiente redirección. */
+};
+
+/**
+ * @struct s_node
+ * @brief Nodo del árbol sintáctico. Cada tipo usa solo algunos campos.
+ */
+struct s_node {
+  enum e_node_type type;        /**< Tipo de nodo. */
+  char **argv;                  /**< Argumentos terminados en NULL. */
+  int argc;                     /**< Cantidad de argumentos. */
+  struct s_node **stages;       /**< Comandos de la pipeline. */
+  int num_stages;               /**< Cantidad de comandos de la pipeline. */
+  struct s_node *left;          /**< Operando izquierdo. */
+  struct s_node *right;         /**< Operando derecho. */
+  struct s_node *body;          /**< Contenido de (), {}, `&` o prefijos. */
+  struct s_redirect *redirects; /**< Redirecciones del comando o grupo. */
+};
+
+/**
+ * @brief Analiza una línea de comandos.
+ *
+ * Los errores de sintaxis se informan en stderr.
+ *
+ * @param line Línea a analizar (no se modifica).
+ * @param arena Arena donde se crean los nodos.
+ * @return struct s_node* Raíz del árbol, o NULL si la línea está vacía o
+ * tiene errores.
+ */
+struct s_node *parse_line(const char *line, struct s_arena *arena);
+
+/**
+ * @brief Analiza una línea delimitada por su longitud.
+ *
+ * Igual que `parse_line`, pero la línea no necesita terminar en '\0'.
+ *
+ * @param line Comienzo de la línea (no se modifica).
+ * @param len Longitud de la línea, sin el salto de línea final.
+ * @param arena Arena donde se crean los nodos.
+ * @return struct s_node* Raíz del árbol, o NULL si la línea está vacía o
+ * tiene errores.
+ */
+struct s_node *parse_buffer(const char *line, size_t len,
+                            struct s_arena *arena);
+
+/**
+ * @brief Igual que `parse_buffer`, pero sin informar errores.
+ *
+ * Sirve para analizar líneas por adelantado (por ejemplo, al compilar un
+ * script) sin mostrar errores de líneas que todavía no se ejecutan.
+ *
+ * @param line Comienzo de la línea (no se modifica).
+ * @param len Longitud de la línea, sin el salto de línea final.
+ * @param arena Arena donde se crean los nodos.
+ * @return struct s_node* Raíz del árbol, o NULL si la línea está vacía o
+ * tiene errores.
+ */
+struct s_node *parse_buffer_silent(const char *line, size_t len,
+                                   struct s_arena *arena);
+
+/**
+ * @brief Reconstruye el texto de un árbol, por ejemplo para mostrar un
+ * trabajo en `jobs`.
+ *
+ * Las palabras se muestran ya sin comillas, como quedaron en `argv`.
+ *
+ * @param node Raíz del árbol.
+ * @return char* Texto reservado con malloc, o NULL si no hubo memoria.
+ */
+char *node_text(const struct s_node *node);
+
+/**
+ * @brief Como node_text(), pero con comillas donde hacen falta: al volver a
+ * analizarlo con parse_line() se obtiene el mismo árbol.
+ *
+ * @param node Raíz del árbol.
+ * @return char* Texto reservado con malloc, o NULL si no hubo memoria.
+ */
+char *node_source(const struct s_node *node);
+
+#endif // AST_H
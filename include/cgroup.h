@@ -0,0 +1,66 @@
+/**
+ * @file cgroup.h
+ * @brief Un cgroup v2 por trabajo, con límites y contabilidad de recursos.
+ *
+ * El prefijo `cgroup LÍMITES` (ver schedctl.h) crea un cgroup para la
+ * pipeline que abarca y pone en él a todos sus procesos, hijos incluidos:
+ *
+ *     cgroup memory=512M,cpu=150,pids=64 make -j8
+ *     cgroup acct { tar c . | gzip > copia.tgz; }
+ *
+ * - `memory=N[K|M|G]`: memory.max, en bytes.
+ * - `cpu=P`: cpu.max, en porcentaje de una CPU (150 es una CPU y media).
+ * - `pids=N`: pids.max.
+ * - `acct`: sin límites, solo contabilidad.
+ *
+ * Cuando el trabajo termina se informan en stderr el uso de CPU
+ * (cpu.stat), la memoria máxima (memory.peak) y los bytes leídos y
+ * escritos (io.stat), y el cgroup se borra.
+ *
+ * Los cgroups se crean debajo del de la shell, en la jerarquía cgroup2 que
+ * figura en /proc/self/mountinfo. Para habilitar controladores en él, la
+ * shell se muda a una hoja propia si hace falta. Si no hay cgroup v2 con
+ * permiso de escritura el trabajo corre igual, sin cgroup; si falta un
+ * controlador, sin ese límite. En ambos casos se avisa.
+ */
+
+#ifndef CGROUP_H
+#define CGROUP_H
+
+struct s_cgroup;
+
+/**
+ * @brief Crea un cgroup con los límites de `spec`.
+ *
+ * @param spec Límites separados por comas, como "memory=512M,pids=64".
+ * @param cgroup Donde se guarda el cgroup, o NULL si no pudo crearse (ya
+ * avisado). Su única referencia es la de quien lo crea.
+ * @return int 0 si `spec` es válido, -1 si no (ya informado).
+ */
+int cgroup_create(const char *spec, struct s_cgroup **cgroup);
+
+/**
+ * @brief Agrega una referencia a un cgroup, por ejemplo la de un trabajo.
+ *
+ * @param cgroup Cgroup.
+ */
+void cgroup_hold(struct s_cgroup *cgroup);
+
+/**
+ * @brief Quita una referencia. Con la última se informa el consumo del
+ * cgroup y se borra.
+ *
+ * @param cgroup Cgroup.
+ */
+void cgroup_release(struct s_cgroup *cgroup);
+
+/**
+ * @brief Mueve el propio proceso al cgroup. Se llama en el hijo antes de
+ * exec, así sus propios hijos ya nacen en él.
+ *
+ * @param cgroup Cgroup.
+ * @return int 0 si tuvo éxito, -1 si no (con errno).
+ */
+int cgroup_enter(const struct s_cgroup *cgroup);
+
+#endif // CGROUP_H
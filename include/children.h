@@ -0,0 +1,102 @@
+/**
+ * @file children.h
+ * @brief Seguimiento de los procesos hijos de la shell con pidfd.
+ *
+ * Cada hijo que la shell espera o que pertenece a un trabajo tiene un
+ * registro, buscado por PID en una tabla hash, y un `pidfd` (`pidfd_open`)
+ * registrado en el bucle de eventos. Cuando el pidfd queda listo el hijo terminó y se
+ * recolecta con `wait4` sobre ese PID: nunca con `waitpid(-1)`, que podría
+ * quitarle el hijo a quien lo espera. SIGCHLD solo se usa para detectar los
+ * hijos suspendidos, y para recolectar los que no tienen pidfd (el kernel no
+ * lo soporta o se agotaron los descriptores).
+ */
+
+#ifndef CHILDREN_H
+#define CHILDREN_H
+
+#include <sys/types.h>
+
+/**
+ * @brief Opciones de un hijo registrado.
+ */
+enum e_child_flags {
+  CHILD_QUIET = 1, /**< Nadie lo espera: se recolecta sin avisos (por
+                        ejemplo, el monitor). */
+};
+
+struct s_child;
+
+/**
+ * @brief Registra un proceso hijo.
+ *
+ * Los cambios de estado de un hijo que pertenece a un trabajo se informan a
+ * la tabla de trabajos (ver jobs.h), y su registro se conserva hasta que el
+ * trabajo lo libera con `release_child`. Un hijo sin trabajo lo espera quien
+ * lo lanzó con `wait_child`, salvo con CHILD_QUIET.
+ *
+ * @param pid PID del proceso.
+ * @param job Número del trabajo al que pertenece (0 si no tiene).
+ * @param flags Combinación de e_child_flags.
+ * @return int 0 si tuvo éxito, -1 si no hubo memoria.
+ */
+int track_child(pid_t pid, int job, int flags);
+
+/**
+ * @brief Número del trabajo de un hijo registrado.
+ *
+ * @param pid PID del proceso.
+ * @return int Número del trabajo, o 0 si el proceso no está registrado o no
+ * pertenece a ninguno.
+ */
+int child_job(pid_t pid);
+
+/**
+ * @brief Olvida el registro de un hijo de un trabajo.
+ *
+ * @param pid PID del proceso.
+ */
+void release_child(pid_t pid);
+
+/**
+ * @brief Recolecta un hijo cuyo pidfd quedó listo.
+ *
+ * La llama el bucle de eventos con el registro asociado al pidfd.
+ *
+ * @param child Registro del hijo.
+ */
+void child_ready(struct s_child *child);
+
+/**
+ * @brief Atiende SIGCHLD: registra los hijos suspendidos y recolecta los que
+ * terminaron sin tener pidfd.
+ *
+ * @param stopped Distinto de 0 si alguna SIGCHLD informó un hijo suspendido.
+ * Buscarlos recorre en el kernel la lista completa de hijos, así que solo se
+ * hace entonces; quien espera a un hijo en primer plano consulta el suyo.
+ */
+void reap_children(int stopped);
+
+/**
+ * @brief Registra los hijos suspendidos de un grupo de procesos.
+ *
+ * Varias SIGCHLD pueden llegar como una sola; quien espera a un trabajo en
+ * primer plano consulta así su grupo en lugar de depender de la señal.
+ *
+ * @param pgid Grupo de procesos.
+ */
+void reap_stopped(pid_t pgid);
+
+/**
+ * @brief Espera a un proceso hijo, como `waitpid(pid, status, options)`.
+ *
+ * Con el bucle de eventos activo la espera atiende mientras tanto las
+ * señales y los demás hijos; si no, llama directamente a `waitpid`.
+ *
+ * @param pid Proceso a esperar.
+ * @param status Donde se guarda su estado.
+ * @param options 0 o WUNTRACED.
+ * @return pid_t `pid`, o -1 si no es un hijo de la shell o hubo un error.
+ */
+pid_t wait_child(pid_t pid, int *status, int options);
+
+#endif // CHILDREN_H
@@ -36,30 +36,23 @@ void execute_command(char **args, int *running);
  *
  * @param args Array de cadenas que contiene "cd" seguido del directorio de
  * destino.
+ * @return int 0 si se cambió de directorio, 1 en caso de error.
  */
-void change_directory(char **args);
+int change_directory(char **args);
 
 /**
  * @brief Imprime los argumentos proporcionados al comando "echo", eliminando
  * comillas.
  *
- * Concatena y muestra los argumentos de "echo", eliminando comillas alrededor
- * de cada uno.
+ * Escribe los argumentos de "echo" separados por espacios, sin las comillas
+ * que los rodean, directamente en el descriptor de salida estándar con una
+ * sola llamada a `writev` y sin límite de longitud.
  *
  * @param args Array de cadenas que contiene "echo" seguido de los argumentos a
  * imprimir.
  */
 void echo_command(char **args);
 
-/**
- * @brief Obtiene el ID actual del trabajo para procesos en segundo plano.
- *
- * Retorna un identificador único de trabajo para los procesos en segundo plano.
- *
- * @return int El ID actual del trabajo.
- */
-int get_current_job_id(void);
-
 /**
  * @brief Redirige la entrada y salida estándar según los descriptores.
  *
@@ -72,17 +65,103 @@ int get_current_job_id(void);
 void handle_redirection(int input_redirect, int output_redirect);
 
 /**
- * @brief Configura el proceso padre para manejar la ejecución en primer o
+ * @brief Sigue a un proceso recién lanzado como un trabajo en primer o
  * segundo plano.
  *
- * Configura el proceso padre para esperar o supervisar un proceso hijo
- * en función de si se está ejecutando en primer o segundo plano.
+ * En primer plano espera a que termine o se suspenda (ver
+ * `job_foreground`); en segundo plano muestra su número de trabajo.
  *
  * @param pid El ID del proceso hijo.
  * @param background Indica si el proceso está en segundo plano (1 para segundo
  * plano).
+ * @param command Texto del comando, para `jobs`.
+ * @return int Estado de salida del proceso (ver `command_status`), o 0 si
+ * quedó en segundo plano.
+ */
+int handle_parent_process(pid_t pid, int background, const char *command);
+
+/**
+ * @brief Convierte un estado de `waitpid` en el estado de salida de la shell.
+ *
+ * @param status Estado devuelto por `waitpid`.
+ * @return int Código de salida, o 128 + número de señal si el proceso
+ * terminó o se detuvo por una señal.
+ */
+int command_status(int status);
+
+/**
+ * @brief Une los argumentos de un comando con espacios, para mostrarlo en
+ * `jobs`.
+ *
+ * @param args Argumentos, terminados en NULL.
+ * @return char* Texto nuevo (liberar con free), o NULL si no hubo memoria.
+ */
+char *args_text(char **args);
+
+/**
+ * @brief Indica si un nombre corresponde a un comando interno.
+ *
+ * @param name Nombre del comando.
+ * @return int Distinto de 0 si es interno.
+ */
+int is_builtin(const char *name);
+
+/**
+ * @brief Ejecuta un comando interno en el proceso actual.
+ *
+ * @param args Argumentos del comando, terminados en NULL.
+ * @param running Puntero al estado de ejecución de la shell.
+ * @return int Estado de salida del comando.
+ */
+int run_builtin(char **args, int *running);
+
+/**
+ * @brief Ejecuta un comando simple con sus descriptores ya abiertos.
+ *
+ * Los comandos internos en primer plano corren en la shell con los
+ * descriptores redirigidos temporalmente; el resto se lanza como proceso.
+ *
+ * @param args Argumentos del comando, terminados en NULL. Si `args[0]` es
+ * NULL el comando no hace nada (solo tenía redirecciones).
+ * @param fds Descriptores para la entrada, salida y error estándar, o -1
+ * para heredarlos. No se cierran.
+ * @param background Ejecutar en segundo plano.
+ * @param running Puntero al estado de ejecución de la shell.
+ * @return int Estado de salida del comando (127 si no pudo lanzarse).
+ */
+int run_simple_command(char **args, const int fds[3], int background,
+                       int *running);
+
+/**
+ * @struct s_saved_fds
+ * @brief Descriptores estándar guardados mientras corre un comando interno.
+ */
+struct s_saved_fds {
+  int fds[3]; /**< Copias de los descriptores 0, 1 y 2, o -1 si no se
+                   redirigieron. */
+};
+
+/**
+ * @brief Aplica redirecciones a la propia shell guardando los descriptores
+ * estándar que reemplaza.
+ *
+ * Permite ejecutar comandos internos con redirección sin crear un proceso.
+ * Debe seguirse siempre de `restore_fds`, aun si falla.
+ *
+ * @param fds Descriptores para la entrada, salida y error estándar, o -1
+ * para dejarlos como están.
+ * @param saved Donde se guardan las copias de los descriptores originales.
+ * @return int 0 si tuvo éxito, -1 si alguna redirección falló.
+ */
+int save_and_redirect(const int fds[3], struct s_saved_fds *saved);
+
+/**
+ * @brief Restaura los descriptores estándar guardados por
+ * `save_and_redirect`.
+ *
+ * @param saved Copias de los descriptores originales.
  */
-void handle_parent_process(pid_t pid, int background);
+void restore_fds(struct s_saved_fds *saved);
 
 /**
  * @brief Restaura los manejadores de señales por defecto en el proceso hijo.
@@ -0,0 +1,101 @@
+/**
+ * @file event_loop.h
+ * @brief Bucle de eventos de la shell sobre epoll y signalfd.
+ *
+ * La shell bloquea SIGCHLD, SIGINT, SIGTSTP y SIGQUIT y las recibe por un
+ * `signalfd` que se espera con `epoll` junto con los pidfd de sus hijos (ver
+ * children.h) y la entrada estándar (o el FIFO del monitor). Así, recolectar
+ * procesos hijos, reenviar señales al trabajo en primer plano y mostrar
+ * avisos ocurre en contexto normal, nunca dentro de un manejador de señales.
+ *
+ * Mientras el bucle no está activo (antes de `event_loop_init`, en las
+ * pruebas o en los procesos hijos que ejecutan parte de una línea) las
+ * funciones de espera usan directamente `waitpid`, `poll` y `read`.
+ */
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+struct s_child;
+
+/**
+ * @brief Bloquea las señales que atiende la shell y crea el bucle.
+ *
+ * @return int 0 si tuvo éxito, -1 si no pudo crearse (el error ya se informó).
+ */
+int event_loop_init(void);
+
+/**
+ * @brief Cierra el bucle y restaura la máscara de señales anterior.
+ */
+void event_loop_shutdown(void);
+
+/**
+ * @brief Indica si el bucle está activo en este proceso.
+ *
+ * @return int Distinto de 0 si se creó en este proceso (no en un padre).
+ */
+int event_loop_active(void);
+
+/**
+ * @brief Atiende sin bloquear las señales pendientes y los hijos que
+ * terminaron.
+ */
+void event_loop_poll(void);
+
+/**
+ * @brief Registra el pidfd de un proceso hijo.
+ *
+ * Cuando el hijo termine, el bucle llama a `child_ready(child)`.
+ *
+ * @param fd pidfd del hijo.
+ * @param child Registro del hijo.
+ * @return int 0 si tuvo éxito, -1 si no pudo registrarse.
+ */
+int event_loop_watch(int fd, struct s_child *child);
+
+/**
+ * @brief Quita un descriptor registrado con `event_loop_watch`.
+ *
+ * @param fd Descriptor a quitar.
+ */
+void event_loop_unwatch(int fd);
+
+/**
+ * @brief Espera y atiende un lote de eventos: señales o hijos que terminan.
+ *
+ * @param interruptible Si es distinto de 0, SIGINT termina la espera.
+ * @return int 1 si se atendieron eventos, 0 si llegó SIGINT y
+ * `interruptible`, -1 si hubo un error o el bucle no está activo.
+ */
+int event_loop_wait(int interruptible);
+
+/**
+ * @brief Espera hasta que `fd` tenga datos para leer, atendiendo mientras
+ * tanto las señales y los procesos hijos.
+ *
+ * @param fd Descriptor a esperar.
+ * @param interruptible Si es distinto de 0, SIGINT termina la espera en lugar
+ * de tratarse como en el prompt.
+ * @return int 1 si `fd` está listo, 0 si la espera se interrumpió con SIGINT,
+ * -1 si hubo un error.
+ */
+int event_loop_wait_fd(int fd, int interruptible);
+
+/**
+ * @brief Lee una línea de la entrada estándar, sin límite de longitud.
+ *
+ * Mientras espera atiende las señales y muestra los avisos de los trabajos en
+ * segundo plano que terminan, volviendo a mostrar el prompt.
+ *
+ * @param line Buffer de la línea; se agranda con realloc según haga falta.
+ * @param capacity Tamaño de `*line`.
+ * @return ssize_t Longitud de la línea, sin el salto de línea final, o -1 al
+ * llegar al fin de la entrada o ante un error.
+ */
+ssize_t event_loop_read_line(char **line, size_t *capacity);
+
+#endif // EVENT_LOOP_H
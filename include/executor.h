@@ -0,0 +1,48 @@
+/**
+ * @file executor.h
+ * @brief Ejecución del árbol sintáctico de una línea de comandos.
+ *
+ * El ejecutor recorre el árbol directamente: `&&` y `||` evalúan el operando
+ * derecho según el estado del izquierdo, `;` ejecuta ambos en orden, `( )`
+ * corre su contenido en un proceso hijo y `{ }` en la propia shell con las
+ * redirecciones aplicadas temporalmente.
+ */
+
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include "ast.h"
+
+/**
+ * @brief Ejecuta un árbol sintáctico.
+ *
+ * Deja de ejecutar en cuanto un comando (como `quit`) pone `*running` en 0.
+ *
+ * @param node Raíz del árbol.
+ * @param running Puntero al estado de ejecución de la shell.
+ * @return int Estado de salida del último comando ejecutado.
+ */
+int execute_node(struct s_node *node, int *running);
+
+/**
+ * @brief Abre los archivos de una lista de redirecciones.
+ *
+ * Las redirecciones se aplican en orden, de modo que una posterior sobre el
+ * mismo descriptor reemplaza a la anterior. Los descriptores abiertos tienen
+ * FD_CLOEXEC.
+ *
+ * @param redirects Lista de redirecciones.
+ * @param fds Descriptores para 0, 1 y 2; los que no se redirigen quedan en -1.
+ * @return int 0 si tuvo éxito, -1 si algún archivo no pudo abrirse (ya
+ * informado; no queda ningún descriptor abierto).
+ */
+int open_redirects(const struct s_redirect *redirects, int fds[3]);
+
+/**
+ * @brief Cierra los descriptores abiertos por `open_redirects`.
+ *
+ * @param fds Descriptores para 0, 1 y 2.
+ */
+void close_redirects(int fds[3]);
+
+#endif // EXECUTOR_H
@@ -15,15 +15,11 @@
 
 // Variables globales relacionadas con los procesos y el estado de la shell
 /**
- * @brief PID del proceso que se ejecuta en primer plano.
+ * @brief Grupo de procesos del trabajo que se ejecuta en primer plano (ver
+ * jobs.h), o 0 si no hay ninguno.
  */
 extern pid_t foreground_pid;
 
-/**
- * @brief PID del proceso suspendido en primer plano.
- */
-extern pid_t foreground_suspended;
-
 /**
  * @brief Grupo de procesos de la shell.
  */
@@ -39,17 +35,14 @@ extern struct termios shell_tmodes;
  */
 extern int testing_mode;
 
-// Definiciones de constantes
 /**
- * @brief Número máximo de argumentos permitidos.
+ * @brief Indica si este proceso controla la terminal y puede entregarla a sus
+ * trabajos en primer plano. Es 0 en los procesos hijos que ejecutan una
+ * parte de la línea en segundo plano o dentro de una pipeline.
  */
-#define MAX_ARGS 100
-
-/**
- * @brief Número máximo de comandos en una pipeline.
- */
-#define MAX_PIPELINE 10
+extern int job_control;
 
+// Definiciones de constantes
 /**
  * @brief Tamaño máximo para el buffer de salida.
  */
@@ -69,9 +62,4 @@ extern int testing_mode;
 #define PATH_MAX 4096
 #endif
 
-/**
- * @brief Tamaño máximo de la entrada del usuario.
- */
-#define MY_MAX_INPUT 1024
-
 #endif // GLOBALS_H
@@ -0,0 +1,235 @@
+/**
+ * @file jobs.h
+ * @brief Tabla de trabajos de la shell y los comandos `jobs`, `fg`, `bg`,
+ * `kill` y `wait`.
+ *
+ * Un trabajo es una línea o pipeline lanzada desde la shell: todos sus
+ * procesos comparten un grupo, de modo que Ctrl+C, Ctrl+Z, `kill %n` y
+ * SIGCONT llegan a todas las etapas. Los trabajos se identifican con `%n` y
+ * se guardan en un arreglo indexado por ese número; cada proceso se registra
+ * en children.h con el número de su trabajo, así que buscar un trabajo por
+ * número o por PID cuesta O(1). Como en bash, un trabajo nuevo recibe el
+ * número siguiente al mayor en uso, y los números se reutilizan cuando la
+ * tabla se vacía.
+ *
+ * Los trabajos en primer plano también están en la tabla mientras corren, y
+ * se quedan en ella si se suspenden.
+ */
+
+#ifndef JOBS_H
+#define JOBS_H
+
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+
+/**
+ * @brief Estado de un trabajo.
+ */
+enum e_job_state {
+  JOB_RUNNING, /**< Algún proceso sigue en ejecución. */
+  JOB_STOPPED, /**< Los procesos que quedan están suspendidos. */
+  JOB_DONE,    /**< Todos los procesos terminaron. */
+  JOB_QUEUED   /**< Espera su turno para lanzarse (ver admission.h). */
+};
+
+struct s_job;
+
+/**
+ * @brief Crea un trabajo vacío con el número libre siguiente.
+ *
+ * @param command Texto que se muestra en `jobs` (se copia).
+ * @return struct s_job* El trabajo, o NULL si no hubo memoria (ya informado).
+ */
+struct s_job *job_create(const char *command);
+
+/**
+ * @brief Crea un trabajo en cola: figura en `jobs` con su número pero
+ * todavía no tiene procesos ni cuenta como en ejecución.
+ *
+ * @param command Texto que se muestra en `jobs` (se copia).
+ * @return struct s_job* El trabajo, o NULL si no hubo memoria (ya informado).
+ */
+struct s_job *job_create_queued(const char *command);
+
+/**
+ * @brief Hace que el próximo job_create devuelva un trabajo en cola, ya en
+ * ejecución, en lugar de crear uno nuevo.
+ *
+ * Así un trabajo lanzado desde la cola conserva su número.
+ *
+ * @param job Trabajo en cola.
+ */
+void job_reserve(struct s_job *job);
+
+/**
+ * @brief Termina la reserva de job_reserve. Si el trabajo no llegó a usarse
+ * (por ejemplo, porque una redirección falló), se quita de la tabla.
+ */
+void job_end_reserve(void);
+
+/**
+ * @brief Agrega un proceso ya lanzado a un trabajo.
+ *
+ * El primer proceso define el grupo del trabajo, salvo sin control de
+ * trabajos, donde los procesos quedan en el grupo de la shell.
+ *
+ * @param job Trabajo.
+ * @param pid Proceso.
+ * @return int 0 si tuvo éxito, -1 si no hubo memoria (ya informado).
+ */
+int job_add_process(struct s_job *job, pid_t pid);
+
+/**
+ * @brief Número de un trabajo (`%n`).
+ *
+ * @param job Trabajo.
+ * @return int Su número.
+ */
+int job_id(const struct s_job *job);
+
+/**
+ * @brief Grupo de procesos al que deben unirse los próximos procesos.
+ *
+ * @param job Trabajo.
+ * @return pid_t Grupo del trabajo, o 0 si todavía no tiene o si todos sus
+ * procesos terminaron (el próximo proceso crea uno nuevo).
+ */
+pid_t job_pgid(const struct s_job *job);
+
+/**
+ * @brief Deja un trabajo en segundo plano y muestra su número.
+ *
+ * Un trabajo sin procesos (no pudo lanzarse ninguno) se descarta.
+ *
+ * @param job Trabajo.
+ * @return int 0, o 127 si el trabajo no tenía procesos.
+ */
+int job_background(struct s_job *job);
+
+/**
+ * @brief Ejecuta un trabajo en primer plano hasta que termina o se suspende.
+ *
+ * Entrega la terminal al grupo del trabajo y la recupera al final. Si el
+ * trabajo termina se quita de la tabla; si se suspende, queda en ella.
+ *
+ * @param job Trabajo.
+ * @param resume Si es distinto de 0, el trabajo estaba suspendido y se le
+ * envía SIGCONT.
+ * @return int Estado de salida del último proceso (ver `command_status`).
+ */
+int job_foreground(struct s_job *job, int resume);
+
+/**
+ * @brief Espera en primer plano a que termine alguno de los procesos de un
+ * trabajo.
+ *
+ * La usan los comandos internos que lanzan un proceso nuevo cada vez que
+ * termina otro (ver parallel.h): el proceso que terminó se quita del trabajo,
+ * que así solo guarda los que están en curso. Cada proceso toma la terminal
+ * al lanzarse si crea el grupo del trabajo; al final hay que llamar a
+ * job_end_foreground.
+ *
+ * @param job Trabajo.
+ * @param status Donde se guarda el estado del proceso, como lo devuelve
+ * waitpid.
+ * @return pid_t PID del proceso que terminó, 0 si el trabajo se suspendió, o
+ * -1 si no le quedan procesos en ejecución o hubo un error.
+ */
+pid_t job_wait_any(struct s_job *job, int *status);
+
+/**
+ * @brief Termina la ejecución en primer plano de un trabajo esperado con
+ * job_wait_any.
+ *
+ * Espera a los procesos que sigan en ejecución y recupera la terminal. Si el
+ * trabajo se suspendió lo informa y queda en la tabla; si no, se quita.
+ *
+ * @param job Trabajo.
+ * @return int 1 si el trabajo quedó suspendido, 0 si terminó.
+ */
+int job_end_foreground(struct s_job *job);
+
+/**
+ * @brief Registra un cambio de estado de un proceso de un trabajo.
+ *
+ * La llama children.c cuando el proceso termina o se suspende.
+ *
+ * @param id Número del trabajo.
+ * @param pid Proceso.
+ * @param status Estado, como lo devuelve waitpid.
+ * @param usage Recursos que consumió, como los informa wait4, o NULL si no
+ * terminó o no se conocen.
+ */
+void job_child_changed(int id, pid_t pid, int status,
+                       const struct rusage *usage);
+
+/**
+ * @brief Muestra los trabajos en segundo plano que terminaron o se
+ * suspendieron desde el último aviso, y quita de la tabla los que terminaron.
+ *
+ * @param out Flujo donde se escriben (normalmente stdout).
+ * @return int Cantidad de avisos mostrados.
+ */
+int report_jobs(FILE *out);
+
+/**
+ * @brief Cantidad de trabajos en ejecución.
+ *
+ * @return int Trabajos en la tabla que no terminaron ni están suspendidos.
+ */
+int running_jobs(void);
+
+/**
+ * @brief Comando interno `jobs [-l | -p]`: lista los trabajos.
+ *
+ * @param args Argumentos del comando (args[0] es "jobs").
+ * @return int 0, o 2 si una opción no es válida.
+ */
+int jobs_command(char **args);
+
+/**
+ * @brief Comando interno `fg [%trabajo]`: continúa un trabajo en primer
+ * plano. Sin argumentos usa el trabajo actual (`%+`).
+ *
+ * @param args Argumentos del comando (args[0] es "fg").
+ * @return int Estado del trabajo, o 1 si no existe.
+ */
+int fg_command(char **args);
+
+/**
+ * @brief Comando interno `bg [%trabajo ...]`: continúa trabajos suspendidos
+ * en segundo plano.
+ *
+ * @param args Argumentos del comando (args[0] es "bg").
+ * @return int 0, o 1 si alguno no existe.
+ */
+int bg_command(char **args);
+
+/**
+ * @brief Comando interno `kill [-s señal | -señal] (%trabajo | pid) ...`.
+ *
+ * A un trabajo la señal se le envía a todo su grupo. `kill -l` lista las
+ * señales conocidas.
+ *
+ * @param args Argumentos del comando (args[0] es "kill").
+ * @return int 0, 1 si alguna señal no pudo enviarse, o 2 si los argumentos
+ * no son válidos.
+ */
+int kill_command(char **args);
+
+/**
+ * @brief Comando interno `wait [pid | %trabajo ...]`.
+ *
+ * Sin argumentos espera a todos los trabajos en ejecución; con argumentos, a
+ * cada uno de los indicados. Un trabajo esperado con `wait %n` no genera
+ * aviso. Ctrl+C interrumpe la espera.
+ *
+ * @param args Argumentos del comando (args[0] es "wait").
+ * @return int Estado del último proceso esperado, 127 si alguno no es hijo
+ * de la shell, 2 si un argumento no es válido, o 130 si la espera se
+ * interrumpió.
+ */
+int wait_command(char **args);
+
+#endif // JOBS_H
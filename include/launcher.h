@@ -0,0 +1,82 @@
+/**
+ * @file launcher.h
+ * @brief Lanzamiento de comandos externos con posix_spawn.
+ *
+ * `fork()` copia las tablas de páginas de la shell, por lo que su costo crece
+ * con el tamaño del proceso. `posix_spawn` (que glibc implementa con
+ * `clone(CLONE_VM | CLONE_VFORK)`) no copia el espacio de direcciones: las
+ * redirecciones se expresan como acciones sobre descriptores y el grupo de
+ * procesos y las señales por defecto como atributos. `fork()` se usa solo
+ * cuando el hijo tiene que tomar la terminal por su cuenta y la libc no
+ * ofrece una acción para hacerlo, o cuando hay que fijarle la afinidad o la
+ * prioridad (ver schedctl.h).
+ */
+
+#ifndef LAUNCHER_H
+#define LAUNCHER_H
+
+#include <sys/types.h>
+
+/** Lanzar con posix_spawn cuando sea posible (por defecto). */
+#define LAUNCH_SPAWN 0
+/** Lanzar siempre con fork + execv. */
+#define LAUNCH_FORK 1
+/** Pedir los procesos al zygote (ver zygote.h). */
+#define LAUNCH_ZYGOTE 2
+
+/**
+ * @brief Variable de entorno que selecciona el mecanismo de lanzamiento:
+ * "spawn", "fork" o "zygote".
+ */
+#define LAUNCH_ENV "SHELL_LAUNCH"
+
+/**
+ * @struct s_launch
+ * @brief Descripción de un proceso a lanzar.
+ */
+struct s_launch {
+  char **argv;    /**< Programa y argumentos, terminados en NULL. */
+  int in_fd;      /**< Descriptor para la entrada estándar, o -1 para heredarla. */
+  int out_fd;     /**< Descriptor para la salida estándar, o -1 para heredarla. */
+  int err_fd;     /**< Descriptor para la salida de errores, o -1 para heredarla. */
+  int close_fd;   /**< Descriptor a cerrar en el hijo (extremo libre de un pipe), o -1. */
+  pid_t pgid;     /**< Grupo al que se une el hijo; 0 crea uno nuevo. */
+  int foreground; /**< Entregar la terminal al grupo del hijo. */
+};
+
+/**
+ * @brief Lanza un proceso según la descripción dada.
+ *
+ * Los descriptores `in_fd`, `out_fd` y `err_fd` no se cierran en el padre. Si el
+ * programa no existe o no puede ejecutarse, se informa con el prefijo
+ * "Error en el comando" en stderr.
+ *
+ * @param launch Descripción del proceso.
+ * @return pid_t PID del hijo, o -1 si no se pudo lanzar.
+ */
+pid_t launch_process(const struct s_launch *launch);
+
+/**
+ * @brief Selecciona el mecanismo de lanzamiento.
+ *
+ * Con LAUNCH_ZYGOTE los procesos se piden al zygote mientras esté en marcha;
+ * si no lo está, se lanzan con posix_spawn.
+ *
+ * @param mode LAUNCH_SPAWN, LAUNCH_FORK o LAUNCH_ZYGOTE.
+ */
+void launch_set_mode(int mode);
+
+/**
+ * @brief Selecciona el mecanismo de lanzamiento por nombre.
+ *
+ * Con "zygote" además crea el zygote, por lo que conviene llamarla al inicio
+ * de la shell con el valor de LAUNCH_ENV.
+ *
+ * @param name "spawn", "fork", "zygote", o NULL para dejar el valor por
+ * defecto.
+ * @return int 0 si tuvo éxito, -1 si el nombre no es válido o el zygote no
+ * pudo crearse (en ese caso se usa posix_spawn).
+ */
+int launch_configure(const char *name);
+
+#endif // LAUNCHER_H
@@ -0,0 +1,86 @@
+/**
+ * @file lexer.h
+ * @brief Analizador léxico de las líneas de comandos.
+ *
+ * Recorre la línea una sola vez y entrega palabras y operadores. Las
+ * comillas y las barras invertidas se resuelven al leer cada palabra:
+ *
+ * - `'...'` conserva el texto tal cual.
+ * - `"..."` conserva el texto; dentro, `\` solo escapa `"`, `\`, `$` y `` ` ``.
+ * - Fuera de comillas, `\` hace literal el carácter siguiente.
+ * - Una palabra que empieza con `#` inicia un comentario hasta el final.
+ *
+ * La línea se delimita por su longitud y no necesita terminar en '\0', de
+ * modo que puede analizarse directamente dentro de un buffer más grande (por
+ * ejemplo, un script proyectado en memoria). El texto de las palabras se
+ * copia en la arena de la línea.
+ */
+
+#ifndef LEXER_H
+#define LEXER_H
+
+#include "arena.h"
+
+/**
+ * @brief Tipos de token.
+ */
+enum e_token_type {
+  TOKEN_WORD,   /**< Palabra (argumento, nombre de archivo, `{` o `}`). */
+  TOKEN_PIPE,   /**< `|` */
+  TOKEN_AND_IF, /**< `&&` */
+  TOKEN_OR_IF,  /**< `||` */
+  TOKEN_SEMI,   /**< `;` o salto de línea */
+  TOKEN_AMP,    /**< `&` */
+  TOKEN_LPAREN, /**< `(` */
+  TOKEN_RPAREN, /**< `)` */
+  TOKEN_LESS,   /**< `[n]<` */
+  TOKEN_GREAT,  /**< `[n]>` */
+  TOKEN_DGREAT, /**< `[n]>>` */
+  TOKEN_END,    /**< Fin de la línea. */
+  TOKEN_ERROR   /**< Comilla sin cerrar o falta de memoria. */
+};
+
+/**
+ * @struct s_token
+ * @brief Un token de la línea.
+ */
+struct s_token {
+  enum e_token_type type; /**< Tipo de token. */
+  char *text;   /**< Texto de la palabra, o el operador (para mensajes). */
+  int quoted;   /**< La palabra tenía comillas o escapes. */
+  int fd;       /**< Descriptor de una redirección (por defecto 0 o 1). */
+};
+
+/**
+ * @struct s_lexer
+ * @brief Estado del análisis de una línea.
+ */
+struct s_lexer {
+  const char *pos;       /**< Próximo carácter a leer. */
+  const char *end;       /**< Fin de la línea. */
+  char *out;             /**< Donde se escribe el texto de la próxima palabra. */
+  struct s_arena *arena; /**< Arena de la línea. */
+};
+
+/**
+ * @brief Prepara el análisis de una línea.
+ *
+ * @param lexer Estado a inicializar.
+ * @param line Línea de comandos (no se modifica).
+ * @param len Longitud de la línea.
+ * @param arena Arena donde se copian las palabras.
+ * @return int 0 si tuvo éxito, -1 si no hubo memoria.
+ */
+int lexer_init(struct s_lexer *lexer, const char *line, size_t len,
+               struct s_arena *arena);
+
+/**
+ * @brief Lee el próximo token.
+ *
+ * @param lexer Estado del análisis.
+ * @param token Donde se guarda el token leído.
+ * @return enum e_token_type Tipo del token (también en `token->type`).
+ */
+enum e_token_type lexer_next(struct s_lexer *lexer, struct s_token *token);
+
+#endif // LEXER_H
@@ -46,9 +46,34 @@ void stop_monitor(void);
  * Verifica si el proceso de monitoreo sigue activo o si no está en ejecución.
  * Muestra un mensaje indicando el PID del proceso si está en ejecución o un
  * mensaje de estado inactivo.
+ *
+ * Las métricas se muestran a medida que el monitor las escribe en el FIFO,
+ * esperándolas en el bucle de eventos, hasta que se presiona Ctrl+C.
  */
 void status_monitor();
 
+/**
+ * @brief Últimas métricas de carga informadas por el monitor.
+ *
+ * Lee sin bloquear los mensajes pendientes en el FIFO, que queda abierto
+ * entre llamadas hasta `monitor_load_close`. Una muestra de más de
+ * MONITOR_LOAD_STALE segundos no se usa.
+ *
+ * @param cpu_usage Donde se guarda el uso de CPU, en porcentaje.
+ * @param free_memory Donde se guarda la memoria libre, en MB.
+ * @return int 1 si llegó una muestra nueva, 0 si se repite la anterior, o -1
+ * si el monitor no está en ejecución o no informó nada reciente.
+ */
+int monitor_load(double *cpu_usage, double *free_memory);
+
+/**
+ * @brief Cierra el FIFO abierto por `monitor_load`.
+ */
+void monitor_load_close(void);
+
+/** Antigüedad máxima, en segundos, de una muestra de `monitor_load`. */
+#define MONITOR_LOAD_STALE 5
+
 /**
  * @brief Lee el intervalo de muestreo desde un archivo de configuración.
  *
@@ -76,14 +101,4 @@ int read_sampling_interval();
  */
 int get_executable_dir(char *buffer, size_t size);
 
-/**
- * @brief Manejador de señal SIGINT.
- *
- * Esta función se utiliza como manejador de la señal SIGINT (Ctrl+C) para
- * interrumpir el estado del monitor de manera segura, terminando su ejecución.
- *
- * @param sig La señal recibida (normalmente SIGINT).
- */
-void handle_sigint(int sig);
-
 #endif // MONITOR_H
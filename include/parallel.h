@@ -0,0 +1,41 @@
+/**
+ * @file parallel.h
+ * @brief Comando interno `parallel`: ejecuta un comando por cada elemento de
+ * una lista, con a lo sumo N procesos a la vez.
+ *
+ * Los elementos se toman de los argumentos que siguen a `:::` o, si no hay,
+ * de las líneas de la entrada estándar, que se leen a medida que se liberan
+ * lugares. Cada `{}` en los argumentos del comando se reemplaza por el
+ * elemento; si ninguno lo tiene, el elemento se agrega al final.
+ *
+ * Todas las tareas forman un único trabajo (ver jobs.h) en primer plano:
+ * Ctrl+C las interrumpe y ya no se lanzan más, y Ctrl+Z las suspende y deja
+ * el trabajo en la tabla, sin lanzar las que faltaban.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/**
+ * @brief Comando interno
+ * `parallel [-j N] [-k] [-t] comando [args ...] [::: elementos ...]`.
+ *
+ * - `-j N`: tareas simultáneas (por defecto, la cantidad de CPUs en línea).
+ * - `-k`: muestra la salida estándar de cada tarea completa y en el orden de
+ *   los elementos. Se guarda en un archivo en memoria (`memfd`) por tarea
+ *   hasta que le toca; a lo sumo 2N tareas esperan su turno. La salida de
+ *   errores no se guarda.
+ * - `-t`: informa en stderr el estado y la duración de cada tarea al
+ *   terminar, y al final un resumen.
+ *
+ * Si los elementos se leen de la entrada estándar, las tareas reciben
+ * /dev/null como entrada.
+ *
+ * @param args Argumentos del comando (args[0] es "parallel").
+ * @return int 0 si todas las tareas terminaron bien; si no, la cantidad de
+ * tareas con error (a lo sumo 101). 130 si se interrumpió, 148 si se
+ * suspendió y 2 si los argumentos no son válidos.
+ */
+int parallel_command(char **args);
+
+#endif // PARALLEL_H
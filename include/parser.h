@@ -10,32 +10,32 @@
 #ifndef PARSER_H
 #define PARSER_H
 
-#define MAX_ARGS 100    /**< Número máximo de argumentos permitidos. */
-#define MAX_PIPELINE 10 /**< Número máximo de comandos en una pipeline. */
-
 /**
  * @brief Divide la entrada del usuario en argumentos individuales.
  *
  * Esta función toma una cadena de entrada y la divide en un array de
  * argumentos, separando por espacios y caracteres de control como tabuladores y
- * saltos de línea.
+ * saltos de línea. El array crece según la cantidad de argumentos.
  *
- * @param input La cadena de entrada a dividir.
- * @param args Array donde se almacenarán los argumentos resultantes.
+ * @param input La cadena de entrada a dividir (se modifica).
+ * @return char** Array de argumentos terminado en NULL, que apunta dentro de
+ * `input` y debe liberarse con `free`, o NULL si no hay memoria.
  */
-void divisor_input(char *input, char **args);
+char **divisor_input(char *input);
 
 /**
  * @brief Divide un comando de entrada en una secuencia de pipelines.
  *
  * Toma una cadena de entrada y la divide en comandos individuales separados por
  * el operador de pipeline "|". Cada comando se recorta para eliminar espacios
- * iniciales y finales antes de almacenarlo.
+ * iniciales y finales antes de almacenarlo. El array crece según la cantidad
+ * de comandos.
  *
- * @param input La cadena de entrada a dividir.
- * @param commands Array donde se almacenarán los comandos de la pipeline.
- * @return int Número de comandos en la pipeline.
+ * @param input La cadena de entrada a dividir (se modifica).
+ * @param num_commands Donde se guarda el número de comandos en la pipeline.
+ * @return char** Array de comandos terminado en NULL, que apunta dentro de
+ * `input` y debe liberarse con `free`, o NULL si no hay memoria.
  */
-int parse_pipeline(char *input, char **commands);
+char **parse_pipeline(char *input, int *num_commands);
 
 #endif // PARSER_H
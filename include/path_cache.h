@@ -0,0 +1,82 @@
+/**
+ * @file path_cache.h
+ * @brief Tabla de rutas de comandos resueltas en PATH (como `hash` de bash).
+ *
+ * `execvp` prueba `execve` en cada directorio de PATH hasta encontrar el
+ * programa, por lo que un comando al final de PATH cuesta varias llamadas al
+ * sistema fallidas en cada ejecución. La tabla recuerda la ruta absoluta de
+ * cada nombre ya resuelto y también los nombres que no se encontraron, de
+ * modo que un comando repetido se lanza con una sola comprobación.
+ *
+ * La tabla completa se descarta cuando cambia PATH. Una ruta guardada se
+ * comprueba con `access()` antes de usarla y se vuelve a buscar si el
+ * programa dejó de existir. Los fallos se recuerdan durante
+ * PATH_CACHE_MISS_TTL segundos, para que un programa recién instalado se
+ * encuentre sin tener que vaciar la tabla.
+ */
+
+#ifndef PATH_CACHE_H
+#define PATH_CACHE_H
+
+#include <stdio.h>
+
+/** Segundos durante los que se recuerda que un nombre no está en PATH. */
+#define PATH_CACHE_MISS_TTL 2
+
+/** PATH que usa `execvp` cuando la variable no está definida. */
+#define PATH_CACHE_DEFAULT_PATH "/bin:/usr/bin"
+
+/**
+ * @brief Resuelve un nombre de comando a una ruta ejecutable.
+ *
+ * Los nombres que contienen '/' se devuelven sin buscarlos en PATH.
+ *
+ * @param name Nombre del comando.
+ * @return const char* Ruta del programa (válida hasta la próxima llamada que
+ * modifique la tabla), o NULL si no se encontró.
+ */
+const char *path_cache_lookup(const char *name);
+
+/**
+ * @brief Busca un nombre en PATH ignorando lo guardado y actualiza la tabla.
+ *
+ * @param name Nombre del comando (sin '/').
+ * @return const char* Ruta encontrada, o NULL si no está en PATH.
+ */
+const char *path_cache_add(const char *name);
+
+/**
+ * @brief Quita un nombre de la tabla.
+ *
+ * @param name Nombre del comando.
+ * @return int 0 si estaba en la tabla, -1 si no.
+ */
+int path_cache_remove(const char *name);
+
+/**
+ * @brief Vacía la tabla.
+ */
+void path_cache_clear(void);
+
+/**
+ * @brief Imprime los nombres resueltos con la cantidad de usos de cada uno.
+ *
+ * @param out Destino del listado.
+ * @return size_t Cantidad de entradas impresas.
+ */
+size_t path_cache_print(FILE *out);
+
+/**
+ * @brief Comando interno `hash`.
+ *
+ * - `hash`: lista la tabla.
+ * - `hash -r`: vacía la tabla.
+ * - `hash -d nombre...`: quita nombres de la tabla.
+ * - `hash nombre...`: busca los nombres en PATH y los guarda.
+ *
+ * @param args Array de argumentos terminado en NULL ("hash" en args[0]).
+ * @return int 0 si tuvo éxito, 1 si algún nombre no se encontró.
+ */
+int hash_command(char **args);
+
+#endif // PATH_CACHE_H
@@ -3,25 +3,35 @@
  * @brief Declaración de la función para manejar la ejecución de pipelines en la
  * shell.
  *
- * Este archivo define la función `execute_pipeline`, que permite la ejecución
- * de comandos en pipeline, redirigiendo la salida de cada comando a la entrada
- * del siguiente.
+ * Este archivo define la función `execute_pipeline_node`, que permite la
+ * ejecución de comandos en pipeline, redirigiendo la salida de cada comando a
+ * la entrada del siguiente.
  */
 
 #ifndef PIPES_H
 #define PIPES_H
 
+#include "ast.h"
+
 /**
- * @brief Ejecuta una secuencia de comandos en pipeline.
+ * @brief Ejecuta una pipeline.
+ *
+ * Los comandos externos se lanzan directamente. Los comandos internos y las
+ * etapas compuestas (`( )`, `{ }`) se ejecutan en un proceso hijo de la
+ * shell, de modo que también pueden formar parte de la pipeline. Las
+ * redirecciones de cada etapa tienen prioridad sobre los pipes.
  *
- * Esta función toma un array de comandos y ejecuta cada uno en una secuencia
- * de pipes, permitiendo que la salida de cada comando sea la entrada del
- * siguiente.
+ * Todas las etapas forman un trabajo (ver jobs.h) en un mismo grupo de
+ * procesos. En primer plano se espera a todas; si se suspenden, el trabajo
+ * queda en la tabla.
  *
- * @param commands Array de cadenas que contiene los comandos a ejecutar en
- * pipeline.
- * @param num_commands Número de comandos en el pipeline.
+ * @param pipeline Nodo de tipo NODE_PIPELINE.
+ * @param background Dejar la pipeline en segundo plano.
+ * @param running Puntero al estado de ejecución de la shell.
+ * @return int Estado de salida de la última etapa (127 si no pudo lanzarse),
+ * o 0 en segundo plano.
  */
-void execute_pipeline(char **commands, int num_commands);
+int execute_pipeline_node(struct s_node *pipeline, int background,
+                          int *running);
 
 #endif // PIPES_H
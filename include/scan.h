@@ -0,0 +1,71 @@
+/**
+ * @file scan.h
+ * @brief Búsqueda vectorizada de caracteres especiales para el lexer.
+ *
+ * El lexer copia las palabras carácter por carácter solo alrededor de los
+ * caracteres con significado (espacios, comillas, operadores, `$` y `\`).
+ * Las tiradas de caracteres comunes entre ellos se encuentran con estas
+ * funciones, que clasifican 16 (SSE2) o 32 (AVX2) bytes por instrucción. La
+ * implementación se elige al primer uso según la CPU; en otras arquitecturas
+ * se usa la versión escalar.
+ */
+
+#ifndef SCAN_H
+#define SCAN_H
+
+#include <stddef.h>
+
+/**
+ * @brief Implementaciones disponibles.
+ */
+enum e_scan_impl {
+  SCAN_SCALAR, /**< Un byte por vez con una tabla. */
+  SCAN_SSE2,   /**< 16 bytes por vez (x86). */
+  SCAN_AVX2    /**< 32 bytes por vez (x86 con AVX2). */
+};
+
+/**
+ * @brief Longitud del prefijo sin caracteres especiales fuera de comillas.
+ *
+ * Son especiales los espacios (`isspace`), `'`, `"`, `|`, `&`, `;`, `(`,
+ * `)`, `<`, `>`, `$` y `\`.
+ *
+ * @param p Comienzo del texto.
+ * @param len Longitud del texto.
+ * @return size_t Posición del primer carácter especial, o `len` si no hay.
+ */
+size_t scan_word(const char *p, size_t len);
+
+/**
+ * @brief Longitud del prefijo sin `"` ni `\` (texto entre comillas dobles).
+ *
+ * @param p Comienzo del texto.
+ * @param len Longitud del texto.
+ * @return size_t Posición del primer `"` o `\`, o `len` si no hay.
+ */
+size_t scan_dquote(const char *p, size_t len);
+
+/**
+ * @brief Fuerza una implementación (para pruebas y mediciones).
+ *
+ * @param impl Implementación a usar.
+ * @return int 0 si tuvo éxito, -1 si la CPU no la soporta.
+ */
+int scan_select(enum e_scan_impl impl);
+
+/**
+ * @brief Implementación en uso (elige una si todavía no se usó ninguna).
+ *
+ * @return enum e_scan_impl Implementación actual.
+ */
+enum e_scan_impl scan_current(void);
+
+/**
+ * @brief Nombre de una implementación.
+ *
+ * @param impl Implementación.
+ * @return const char* "scalar", "sse2" o "avx2".
+ */
+const char *scan_name(enum e_scan_impl impl);
+
+#endif // SCAN_H
@@ -0,0 +1,96 @@
+/**
+ * @file schedctl.h
+ * @brief Afinidad de CPU y clases de planificación de los trabajos.
+ *
+ * Los prefijos `pin`, `idle`, `batch`, `ionice` y `cgroup` se escriben al
+ * comienzo de una pipeline y se aplican a todos los procesos que se lancen mientras se
+ * ejecuta:
+ *
+ *     pin 0-3,6 make -j8 | tee log
+ *     idle ionice idle { tar c . | gzip > copia.tgz; }
+ *
+ * - `pin CPUS`: afinidad (`sched_setaffinity`) con una lista de CPUs como
+ *   "0-3,6".
+ * - `idle` y `batch`: políticas SCHED_IDLE y SCHED_BATCH.
+ * - `ionice CLASE[:NIVEL]`: prioridad de E/S (`ioprio_set`), con clase
+ *   realtime, best-effort o idle (o 1, 2 y 3, como en ionice(1)) y nivel
+ *   de 0 a 7.
+ * - `cgroup LÍMITES`: un cgroup v2 con límites y contabilidad para todos
+ *   los procesos (ver cgroup.h).
+ *
+ * Son palabras reservadas como `{`: entre comillas se ejecuta el programa
+ * del mismo nombre. Los prefijos anidados se combinan y el más interno
+ * manda en lo que repite.
+ *
+ * Los atributos se aplican en el hijo, entre fork y exec, así que los
+ * procesos con alguno se lanzan con fork en lugar de posix_spawn (ver
+ * launcher.h). Como el kernel los hereda, todo lo que lance ese hijo
+ * también los tiene. La tabla de trabajos registra los de cada trabajo
+ * (ver `jobs -l`).
+ */
+
+#ifndef SCHEDCTL_H
+#define SCHEDCTL_H
+
+struct s_cgroup;
+
+/**
+ * @brief Indica si una palabra sin comillas es un prefijo y cuántos
+ * argumentos toma.
+ *
+ * @param word Palabra.
+ * @return int 1 para `pin`, `ionice` y `cgroup`, 0 para `idle` y `batch`, o -1 si no
+ * es un prefijo.
+ */
+int schedctl_prefix_arity(const char *word);
+
+/**
+ * @brief Aplica los prefijos de `words` sobre los atributos actuales, que
+ * rigen hasta la llamada correspondiente a schedctl_end().
+ *
+ * @param words Prefijos y sus argumentos, terminados en NULL.
+ * @return int 0 si tuvo éxito, o -1 si un prefijo no es válido (ya
+ * informado); en ese caso no hay que llamar a schedctl_end().
+ */
+int schedctl_begin(char **words);
+
+/**
+ * @brief Vuelve a los atributos que regían antes del último schedctl_begin().
+ */
+void schedctl_end(void);
+
+/**
+ * @brief Indica si hay atributos para los procesos que se lancen ahora.
+ *
+ * @return int 1 si hay alguno, 0 si no.
+ */
+int schedctl_active(void);
+
+/**
+ * @brief Devuelve el cgroup de los procesos que se lancen ahora; los
+ * trabajos guardan una referencia hasta terminar.
+ *
+ * @return struct s_cgroup* Cgroup, o NULL si no hay.
+ */
+struct s_cgroup *schedctl_cgroup(void);
+
+/**
+ * @brief Aplica los atributos actuales al propio proceso. Se llama en un
+ * hijo de la shell antes de exec o de ejecutar parte de la línea; después
+ * ya no hay atributos pendientes, porque el kernel los hereda.
+ *
+ * @return int 0 si tuvo éxito, o -1 si alguno no pudo aplicarse (ya
+ * informado).
+ */
+int schedctl_apply(void);
+
+/**
+ * @brief Describe los atributos actuales como prefijos, por ejemplo
+ * `pin 0-3 idle`; así los muestra `jobs -l`.
+ *
+ * @return char* Texto reservado con malloc, o NULL si no hay atributos o
+ * no hubo memoria.
+ */
+char *schedctl_text(void);
+
+#endif // SCHEDCTL_H
@@ -0,0 +1,60 @@
+/**
+ * @file script.h
+ * @brief Lectura de archivos de comandos (scripts).
+ *
+ * Un archivo regular se proyecta completo en memoria con `mmap` y sus líneas
+ * se recorren por puntero, sin copiarlas ni hacer una llamada al sistema por
+ * línea. Los archivos que no pueden proyectarse (tuberías, dispositivos) se
+ * leen en bloques grandes hasta el final antes de ejecutar la primera línea.
+ */
+
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+#include <stddef.h>
+
+/** Tamaño de cada lectura cuando el archivo no puede proyectarse. */
+#define SCRIPT_READ_BLOCK (64 * 1024)
+
+/**
+ * @struct s_script
+ * @brief Contenido de un script y posición de la próxima línea.
+ */
+struct s_script {
+  const char *data; /**< Contenido del archivo. */
+  size_t size;      /**< Tamaño del contenido. */
+  size_t pos;       /**< Comienzo de la próxima línea. */
+  int mapped;       /**< `data` es una proyección de `mmap` (si no, malloc). */
+};
+
+/**
+ * @brief Abre un script y carga su contenido.
+ *
+ * @param script Estado a inicializar.
+ * @param path Ruta del archivo.
+ * @return int 0 si tuvo éxito, -1 si no pudo abrirse o leerse (errno indica
+ * la causa).
+ */
+int script_open(struct s_script *script, const char *path);
+
+/**
+ * @brief Entrega la próxima línea del script.
+ *
+ * La línea apunta dentro del contenido del script, no termina en '\0' y no
+ * incluye el salto de línea. Es válida hasta `script_close`.
+ *
+ * @param script Script abierto.
+ * @param line Donde se guarda el comienzo de la línea.
+ * @param len Donde se guarda la longitud de la línea.
+ * @return int 1 si hay una línea, 0 al llegar al final.
+ */
+int script_next_line(struct s_script *script, const char **line, size_t *len);
+
+/**
+ * @brief Libera el contenido del script.
+ *
+ * @param script Script abierto.
+ */
+void script_close(struct s_script *script);
+
+#endif // SCRIPT_H
@@ -0,0 +1,95 @@
+/**
+ * @file script_cache.h
+ * @brief Caché de scripts ya analizados.
+ *
+ * La primera vez que se ejecuta un script, sus líneas se analizan todas y el
+ * resultado (el texto de cada línea y su árbol sintáctico) se guarda en un
+ * archivo compacto del directorio de caché. En las ejecuciones siguientes ese
+ * archivo se proyecta en memoria con `mmap` y cada árbol se reconstruye en la
+ * arena de la línea apuntando directamente a las palabras proyectadas, sin
+ * volver a separar la línea en tokens.
+ *
+ * Cada entrada guarda la ruta absoluta del script, su tamaño, su fecha de
+ * modificación, su inodo y la versión de la shell. Si alguno no coincide la
+ * entrada se descarta y el script se analiza de nuevo, de forma transparente.
+ *
+ * El directorio es `$SHELL_CACHE_DIR` si está definida (vacía desactiva la
+ * caché), `$XDG_CACHE_HOME/shell` o `$HOME/.cache/shell`.
+ */
+
+#ifndef SCRIPT_CACHE_H
+#define SCRIPT_CACHE_H
+
+#include "arena.h"
+#include "ast.h"
+#include "script.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** Variable de entorno con el directorio de la caché. */
+#define SCRIPT_CACHE_ENV "SHELL_CACHE_DIR"
+
+/** Versión del formato de los archivos de la caché. */
+#define SCRIPT_CACHE_FORMAT 3
+
+#ifndef SHELL_VERSION
+#define SHELL_VERSION "1.0.0" /**< Versión de la shell (la define CMake). */
+#endif
+
+/**
+ * @struct s_script_cache
+ * @brief Entrada de la caché proyectada en memoria.
+ */
+struct s_script_cache {
+  const char *data;    /**< Contenido del archivo de la caché. */
+  size_t size;         /**< Tamaño del archivo. */
+  uint32_t line_count; /**< Cantidad de líneas del script. */
+  uint32_t next;       /**< Próxima línea a entregar. */
+};
+
+/**
+ * @brief Carga la entrada de la caché de un script.
+ *
+ * @param cache Estado a inicializar.
+ * @param script_path Ruta del script.
+ * @return int 0 si había una entrada vigente, -1 si no (no existe, está
+ * desactualizada o dañada, o la caché está desactivada).
+ */
+int script_cache_load(struct s_script_cache *cache, const char *script_path);
+
+/**
+ * @brief Analiza todas las líneas de un script y guarda el resultado en la
+ * caché.
+ *
+ * El archivo se escribe con otro nombre y se renombra al final, de modo que
+ * una ejecución concurrente nunca ve una entrada a medio escribir.
+ *
+ * @param script_path Ruta del script.
+ * @param script Contenido del script (no se modifica su posición).
+ * @return int 0 si se guardó, -1 si no pudo guardarse.
+ */
+int script_cache_store(const char *script_path, const struct s_script *script);
+
+/**
+ * @brief Entrega la próxima línea de una entrada de la caché.
+ *
+ * @param cache Entrada cargada.
+ * @param line Donde se guarda el texto de la línea (sin salto de línea).
+ * @param len Donde se guarda la longitud del texto.
+ * @param tree Donde se guarda el árbol de la línea, reconstruido en `arena`,
+ * o NULL si la línea está vacía, tiene errores de sintaxis o el árbol
+ * guardado no es válido (en esos casos la línea debe analizarse de nuevo).
+ * @param arena Arena de la línea.
+ * @return int 1 si hay una línea, 0 al llegar al final.
+ */
+int script_cache_next(struct s_script_cache *cache, const char **line,
+                      size_t *len, struct s_node **tree, struct s_arena *arena);
+
+/**
+ * @brief Libera la proyección de una entrada.
+ *
+ * @param cache Entrada cargada.
+ */
+void script_cache_close(struct s_script_cache *cache);
+
+#endif // SCRIPT_CACHE_H
@@ -2,10 +2,11 @@
  * @file signals.h
  * @brief Declaración de funciones para el manejo de señales en la shell.
  *
- * Este archivo contiene las declaraciones de las funciones de manejo de
- * señales, permitiendo que la shell responda adecuadamente a interrupciones
- * (SIGINT) y señales de suspensión (SIGTSTP), así como a eventos de
- * finalización de procesos hijos (SIGCHLD).
+ * Este archivo contiene las declaraciones de las funciones que atienden las
+ * interrupciones (SIGINT) y señales de suspensión (SIGTSTP). La shell bloquea
+ * esas señales y las recibe en el bucle de eventos (ver event_loop.h), que
+ * llama a estas funciones en contexto normal. La finalización de procesos
+ * hijos (SIGCHLD) se atiende en children.h.
  */
 
 #ifndef SIGNALS_H
@@ -14,7 +15,7 @@
 #include <signal.h> // Necesario para struct sigaction
 
 /**
- * @brief Manejador de señales para la shell.
+ * @brief Atiende una señal dirigida a la shell.
  *
  * Controla las señales recibidas por la shell, como SIGINT y SIGTSTP, y
  * las envía al proceso en primer plano, si lo hay.
@@ -23,14 +24,4 @@
  */
 void shell_signal_handler(int sig);
 
-/**
- * @brief Manejador de la señal SIGCHLD para procesos hijos.
- *
- * Maneja la terminación o suspensión de procesos hijos, y muestra el estado
- * del proceso en segundo plano al usuario.
- *
- * @param sig La señal recibida (usualmente SIGCHLD).
- */
-void sigchld_handler(int sig);
-
 #endif // SIGNALS_H
@@ -0,0 +1,88 @@
+/**
+ * @file timing.h
+ * @brief La palabra reservada `time`: tiempo y recursos de una pipeline.
+ *
+ * `time` al comienzo de una pipeline la ejecuta y al terminar informa en
+ * stderr el tiempo real, los tiempos de usuario y de sistema, la memoria
+ * residente máxima, los fallos de página y los cambios de contexto:
+ *
+ *     time sort -n datos | uniq -c
+ *     time -j { make; make test; } 2> medicion.json
+ *
+ * Los totales abarcan a todos los hijos que la shell recolectó mientras
+ * tanto (`getrusage(RUSAGE_CHILDREN)`). Además, cada proceso de un trabajo
+ * se recolecta con `wait4`, así que se informan también los números de
+ * cada uno: en una pipeline, los de cada etapa. Con `-j` el informe es una
+ * línea de JSON.
+ *
+ * Como los prefijos (ver schedctl.h), `time` es una palabra reservada solo
+ * sin comillas y al comienzo de la pipeline; `'time'` ejecuta el programa.
+ */
+
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <time.h>
+
+/**
+ * @brief Comienza una medición, que abarca todo hasta el timing_end()
+ * correspondiente. Las mediciones pueden anidarse.
+ *
+ * @param json Distinto de 0 para informar en JSON.
+ * @return int 0 si tuvo éxito, -1 si no hubo memoria (ya informado); en ese
+ * caso no hay que llamar a timing_end().
+ */
+int timing_begin(int json);
+
+/**
+ * @brief Termina la medición más interna e informa sus resultados en
+ * stderr.
+ *
+ * @param command Texto de lo que se midió.
+ * @param status Estado con el que terminó.
+ */
+void timing_end(const char *command, int status);
+
+/**
+ * @brief Identifica la medición más interna; los trabajos lo guardan al
+ * crearse para informar a ella sus procesos.
+ *
+ * @return int Número de la medición, o 0 si no hay ninguna.
+ */
+int timing_scope(void);
+
+/**
+ * @brief Asocia un texto a un proceso de la medición actual, como el de su
+ * etapa en una pipeline. Los procesos sin texto se informan con el de su
+ * trabajo.
+ *
+ * @param pid Proceso.
+ * @param text Texto.
+ */
+void timing_label(pid_t pid, const char *text);
+
+/**
+ * @brief Informa un proceso terminado a una medición y a las que la
+ * contienen. Si la medición ya terminó, no hace nada.
+ *
+ * @param scope Número de la medición (ver timing_scope()).
+ * @param pid Proceso.
+ * @param command Texto de su trabajo.
+ * @param status Estado de salida (ver `command_status`).
+ * @param real Segundos desde que se lanzó hasta que terminó.
+ * @param usage Recursos que consumió, como los informa wait4.
+ */
+void timing_process(int scope, pid_t pid, const char *command, int status,
+                    double real, const struct rusage *usage);
+
+/**
+ * @brief Segundos transcurridos desde un instante de CLOCK_MONOTONIC.
+ *
+ * @param since Instante.
+ * @return double Segundos.
+ */
+double timing_elapsed(const struct timespec *since);
+
+#endif // TIMING_H
@@ -0,0 +1,42 @@
+/**
+ * @file xargs.h
+ * @brief Comando interno `xargs`: ejecuta un comando con tantos elementos de
+ * la entrada como quepan en cada `execve`.
+ *
+ * Lanzar un proceso por elemento cuesta un fork y un exec por archivo; aquí
+ * cada invocación lleva todos los elementos que admite el kernel: la suma de
+ * los argumentos, el entorno y sus punteros no puede superar
+ * `sysconf(_SC_ARG_MAX)`, y cada argumento no puede superar 32 páginas.
+ *
+ * Como `parallel` (ver parallel.h), todas las invocaciones forman un único
+ * trabajo en primer plano.
+ */
+
+#ifndef XARGS_H
+#define XARGS_H
+
+/**
+ * @brief Comando interno
+ * `xargs [-0] [-a archivo] [-n max] [-P N] [-t] [comando [args ...]]`.
+ *
+ * Los elementos se leen de la entrada estándar (o de `archivo`) separados
+ * por blancos y saltos de línea, o por '\0' con `-0`; no se interpretan
+ * comillas. Sin comando se usa `echo`.
+ *
+ * - `-n max`: a lo sumo `max` elementos por invocación.
+ * - `-P N`: hasta N invocaciones simultáneas (por defecto, 1).
+ * - `-t`: informa en stderr cada invocación y, al final, cuántas se
+ *   ahorraron frente a una por elemento y los elementos por segundo.
+ *
+ * Si los elementos se leen de la entrada estándar, los comandos reciben
+ * /dev/null como entrada.
+ *
+ * @param args Argumentos del comando (args[0] es "xargs").
+ * @return int 0 si todas las invocaciones terminaron bien, 123 si alguna
+ * terminó con error, 127 si el comando no pudo ejecutarse, 1 si un elemento
+ * no cabe en una invocación o no pudo leerse el archivo, 130 si se
+ * interrumpió, 148 si se suspendió y 2 si los argumentos no son válidos.
+ */
+int xargs_command(char **args);
+
+#endif // XARGS_H
@@ -0,0 +1,63 @@
+/**
+ * @file zygote.h
+ * @brief Proceso auxiliar ("zygote") que crea los hijos de la shell.
+ *
+ * La shell crece con el tiempo y cada `fork()` copia sus tablas de páginas.
+ * El zygote se crea al arrancar, cuando la imagen de la shell todavía es
+ * pequeña, y desde entonces crea los procesos en su lugar. La shell le envía
+ * cada pedido (programa, argv, entorno y directorio actual) por un socket
+ * Unix, junto con los descriptores que el hijo usará como entrada, salida y
+ * error estándar (SCM_RIGHTS).
+ *
+ * El zygote crea los hijos con `clone(CLONE_PARENT)`, de modo que su padre es
+ * la shell: `waitpid`, SIGCHLD y el control de trabajos funcionan igual que
+ * con los procesos lanzados directamente. Solo está disponible en Linux.
+ */
+
+#ifndef ZYGOTE_H
+#define ZYGOTE_H
+
+#include "launcher.h"
+#include <sys/types.h>
+
+/**
+ * @brief Crea el zygote.
+ *
+ * Debe llamarse al inicio de la shell, antes de que su imagen crezca y antes
+ * de abrir otros descriptores, ya que el zygote hereda los abiertos.
+ *
+ * @return int 0 si tuvo éxito (o si ya estaba en marcha), -1 si no pudo
+ * crearse.
+ */
+int zygote_start(void);
+
+/**
+ * @brief Indica si el zygote está en marcha.
+ *
+ * @return int Distinto de 0 si puede atender pedidos.
+ */
+int zygote_running(void);
+
+/**
+ * @brief Pide al zygote que lance un proceso.
+ *
+ * El hijo se une al grupo `launch->pgid` (o crea uno nuevo) y, si está en
+ * primer plano y la entrada estándar es una terminal, toma la terminal antes
+ * de ejecutar el programa. `launch->close_fd` se ignora: el hijo solo recibe
+ * sus tres descriptores estándar.
+ *
+ * @param launch Descripción del proceso.
+ * @param path Ruta del programa, ya resuelta en PATH.
+ * @param pid Donde se guarda el PID del hijo, o -1 si el programa no pudo
+ * ejecutarse (el error ya se informó en stderr).
+ * @return int 0 si el zygote atendió el pedido, -1 si no está disponible (en
+ * ese caso el proceso no se lanzó y el zygote queda detenido).
+ */
+int zygote_spawn(const struct s_launch *launch, const char *path, pid_t *pid);
+
+/**
+ * @brief Detiene el zygote y espera a que termine.
+ */
+void zygote_stop(void);
+
+#endif // ZYGOTE_H
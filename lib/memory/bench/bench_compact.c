@@ -0,0 +1,93 @@
+// bench_compact.c
+//
+// Mide la fragmentación del heap antes y después de compactar, sobre una
+// carga de trabajo con rotación de asignaciones movibles de tamaños variados.
+
+#include "handle.h"
+#include "memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define NUM_HANDLES 20000
+#define NUM_ROUNDS 8
+#define MIN_SIZE 16
+#define MAX_SIZE 512
+#define COMPACT_STEP 256
+
+/** Definido en memory.c: primer bloque del heap. */
+extern void *base;
+
+static double elapsed_ms(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) * 1e3 + (end.tv_nsec - start.tv_nsec) / 1e6;
+}
+
+static void report(const char *label, char *heap_start) {
+    size_t allocated = 0;
+    size_t free_bytes = 0;
+    size_t blocks = 0;
+
+    for (t_block b = base; b; b = b->next) {
+        blocks++;
+        if (b->free) {
+            free_bytes += b->size;
+        } else {
+            allocated += b->size;
+        }
+    }
+
+    printf("%-8s heap=%8zu B  blocks=%6zu  allocated=%8zu B  free=%8zu B  fragmentation=%5.1f%%\n",
+           label, (size_t)((char *)heap_sbrk(0) - heap_start), blocks, allocated, free_bytes,
+           calculate_memory_fragmentation() * 100);
+}
+
+int main(void) {
+    static t_handle handles[NUM_HANDLES];
+    struct timespec start, end;
+
+    srand(42);
+    set_logging(0);
+    printf("Churn: %d handles, %d rounds, sizes %d-%d bytes\n", NUM_HANDLES, NUM_ROUNDS,
+           MIN_SIZE, MAX_SIZE);
+
+    char *heap_start = heap_sbrk(0);
+
+    for (int i = 0; i < NUM_HANDLES; i++) {
+        handles[i] = hmalloc(MIN_SIZE + rand() % (MAX_SIZE - MIN_SIZE + 1));
+    }
+
+    // Cada ronda libera un tercio de los handles al azar y reasigna la mitad
+    // de los huecos con tamaños nuevos, dejando huecos dispersos.
+    for (int round = 0; round < NUM_ROUNDS; round++) {
+        for (int i = 0; i < NUM_HANDLES; i++) {
+            if (handles[i] != INVALID_HANDLE && rand() % 3 == 0) {
+                hfree(handles[i]);
+                handles[i] = INVALID_HANDLE;
+            }
+        }
+        for (int i = 0; i < NUM_HANDLES; i++) {
+            if (handles[i] == INVALID_HANDLE && rand() % 2 == 0) {
+                handles[i] = hmalloc(MIN_SIZE + rand() % (MAX_SIZE - MIN_SIZE + 1));
+            }
+        }
+    }
+
+    report("before", heap_start);
+
+    size_t moves = 0;
+    size_t steps = 0;
+    size_t step_moves;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        step_moves = heap_compact(COMPACT_STEP);
+        moves += step_moves;
+        steps++;
+    } while (step_moves == COMPACT_STEP);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    report("after", heap_start);
+    printf("Compaction: %zu blocks moved in %zu steps of <= %d, %.2f ms\n", moves, steps,
+           COMPACT_STEP, elapsed_ms(start, end));
+
+    return 0;
+}
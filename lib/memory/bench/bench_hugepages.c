@@ -0,0 +1,143 @@
+// bench_hugepages.c
+//
+// Compara el heap respaldado por `sbrk` con la región de páginas enormes en
+// una carga sensible a fallos de TLB: accesos aleatorios sobre un arreglo
+// grande asignado con my_malloc. Cada modo corre en un proceso hijo, ya que
+// el respaldo solo puede elegirse antes de la primera asignación.
+//
+// Uso: bench_hugepages [MiB] [millones de accesos]
+
+#include "memory.h"
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_MIB 512
+#define DEFAULT_MILLION_ACCESSES 50
+
+/** Abre un contador de fallos de lectura en la dTLB, o -1 si no hay soporte. */
+static int open_dtlb_counter(void) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/** Lee AnonHugePages (en kB) de /proc/self/smaps_rollup. */
+static long anon_huge_kb(void) {
+    FILE *f = fopen("/proc/self/smaps_rollup", "r");
+    char line[256];
+    long kb = -1;
+
+    if (!f) {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f)) {
+        if (sscanf(line, "AnonHugePages: %ld kB", &kb) == 1) {
+            break;
+        }
+    }
+    fclose(f);
+    return kb;
+}
+
+static void run(int hugepages, size_t bytes, size_t accesses) {
+    struct timespec start, end;
+
+    set_logging(0);
+    if (malloc_hugepages(hugepages) == -1) {
+        fprintf(stderr, "No se pudo configurar el respaldo del heap\n");
+        exit(EXIT_FAILURE);
+    }
+
+    size_t count = bytes / sizeof(uint64_t);
+    uint64_t *array = my_malloc(count * sizeof(uint64_t));
+    if (!array) {
+        fprintf(stderr, "my_malloc de %zu bytes falló\n", bytes);
+        exit(EXIT_FAILURE);
+    }
+    for (size_t i = 0; i < count; i++) {
+        array[i] = i;
+    }
+
+    int counter = open_dtlb_counter();
+    if (counter != -1) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    // xorshift64: índices pseudoaleatorios sin depender de rand().
+    uint64_t x = 88172645463325252ULL;
+    uint64_t sum = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (size_t i = 0; i < accesses; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        sum += array[x % count];
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    long long misses = -1;
+    if (counter != -1) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) {
+            misses = -1;
+        }
+        close(counter);
+    }
+
+    double ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / accesses;
+    printf("%-10s %8.2f ns/access  AnonHugePages=%7ld kB  dTLB misses=", hugepages ? "hugepages" : "sbrk", ns,
+           anon_huge_kb());
+    if (misses >= 0) {
+        printf("%lld (%.3f/access)", misses, (double)misses / accesses);
+    } else {
+        printf("n/a");
+    }
+    printf("  [checksum %llu]\n", (unsigned long long)sum);
+}
+
+int main(int argc, char *argv[]) {
+    size_t mib = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_MIB;
+    size_t accesses = (argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_MILLION_ACCESSES) * 1000000UL;
+
+    FILE *thp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+    char mode[128] = "unknown\n";
+    if (thp) {
+        if (!fgets(mode, sizeof(mode), thp)) {
+            strcpy(mode, "unknown\n");
+        }
+        fclose(thp);
+    }
+    printf("Random access over %zu MiB, %zu accesses, THP: %s", mib, accesses, mode);
+    fflush(stdout);
+
+    for (int hugepages = 0; hugepages <= 1; hugepages++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            run(hugepages, mib << 20, accesses);
+            fflush(stdout);
+            _exit(EXIT_SUCCESS);
+        } else if (pid < 0) {
+            perror("fork");
+            return EXIT_FAILURE;
+        }
+        waitpid(pid, NULL, 0);
+    }
+
+    return EXIT_SUCCESS;
+}
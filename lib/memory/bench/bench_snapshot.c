@@ -0,0 +1,138 @@
+// bench_snapshot.c
+//
+// Mide el costo de las herramientas de snapshot.h. `heap_snapshot` y
+// `heap_leak_report` se miden sobre un heap real con seguimiento; como llenar
+// un heap de un millón de bloques con la lista enlazada lleva minutos,
+// `heap_diff` se mide sobre instantáneas sintéticas de ese tamaño.
+//
+// Uso: bench_snapshot [bloques del heap real] [entradas de las instantáneas]
+
+#include "snapshot.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define DEFAULT_HEAP_BLOCKS 20000
+#define DEFAULT_SNAPSHOT_ENTRIES 1000000
+#define NUM_SITES 64
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// La barrera evita que se compilen como llamadas de cola a my_malloc, que
+// dejarían como sitio de llamada el de quien las llama
+__attribute__((noinline)) static void *alloc_small(void) {
+    void *ptr = my_malloc(24);
+    __asm__ volatile("" ::: "memory");
+    return ptr;
+}
+
+__attribute__((noinline)) static void *alloc_large(void) {
+    void *ptr = my_malloc(512);
+    __asm__ volatile("" ::: "memory");
+    return ptr;
+}
+
+static void bench_real_heap(size_t blocks, FILE *sink) {
+    void **ptrs = malloc(blocks * sizeof(*ptrs));
+    if (!ptrs) {
+        perror("malloc");
+        return;
+    }
+
+    heap_track(1);
+    for (size_t i = 0; i < blocks; i++) {
+        ptrs[i] = (i % 4) ? alloc_small() : alloc_large();
+    }
+
+    double t0 = now();
+    struct s_heap_snapshot *s = heap_snapshot();
+    double t1 = now();
+    size_t leaks = heap_leak_report(sink);
+    double t2 = now();
+
+    printf("heap_snapshot    %8zu blocks %10.2f ms %8.1f ns/block\n", s ? s->count : 0,
+           (t1 - t0) * 1e3, (t1 - t0) * 1e9 / blocks);
+    printf("heap_leak_report %8zu blocks %10.2f ms %8.1f ns/block\n", leaks, (t2 - t1) * 1e3,
+           (t2 - t1) * 1e9 / blocks);
+
+    heap_snapshot_free(s);
+    for (size_t i = 0; i < blocks; i++) {
+        my_free(ptrs[i]);
+    }
+    free(ptrs);
+    heap_track(0);
+}
+
+/** Instantánea sintética: bloques contiguos de 32 bytes repartidos en NUM_SITES sitios. */
+static struct s_heap_snapshot *synthetic(size_t entries, uint64_t first_seq, size_t churn_every) {
+    struct s_heap_snapshot *s = calloc(1, sizeof(*s));
+    if (!s || !(s->entries = malloc(entries * sizeof(*s->entries)))) {
+        free(s);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < entries; i++) {
+        struct s_snapshot_entry *e = &s->entries[i];
+        // Cada `churn_every` bloques uno fue reemplazado por otra asignación
+        int replaced = churn_every && i % churn_every == 0;
+        e->ptr = (void *)(uintptr_t)(0x10000000 + i * 72);
+        e->size = 32;
+        e->seq = replaced ? first_seq + i : i + 1;
+        e->time_ns = e->seq;
+        e->caller = (void *)(uintptr_t)(0x400000 + (i % NUM_SITES) * 16);
+        s->bytes += e->size;
+    }
+    s->count = entries;
+    s->seq = first_seq + entries;
+    return s;
+}
+
+static void bench_diff(size_t entries, FILE *sink) {
+    struct s_heap_snapshot *a = synthetic(entries, 0, 0);
+    struct s_heap_snapshot *b = synthetic(entries, entries + 1, 10);
+    if (!a || !b) {
+        fprintf(stderr, "Sin memoria para las instantáneas\n");
+        heap_snapshot_free(a);
+        heap_snapshot_free(b);
+        return;
+    }
+
+    double t0 = now();
+    struct s_heap_diff d = heap_diff(a, b, NULL);
+    double t1 = now();
+    heap_diff(a, b, sink);
+    double t2 = now();
+
+    printf("heap_diff        %8zu entries %9.2f ms (totals), %.2f ms (grouped): +%zu -%zu blocks\n",
+           entries, (t1 - t0) * 1e3, (t2 - t1) * 1e3, d.new_blocks, d.freed_blocks);
+
+    heap_snapshot_free(a);
+    heap_snapshot_free(b);
+}
+
+int main(int argc, char *argv[]) {
+    size_t blocks = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_HEAP_BLOCKS;
+    size_t entries = argc > 2 ? strtoul(argv[2], NULL, 10) : DEFAULT_SNAPSHOT_ENTRIES;
+
+    set_logging(0);
+    FILE *sink = fopen("/dev/null", "w");
+    if (!sink) {
+        perror("/dev/null");
+        return EXIT_FAILURE;
+    }
+
+    if (blocks) {
+        bench_real_heap(blocks, sink);
+    }
+    if (entries) {
+        bench_diff(entries, sink);
+    }
+
+    fclose(sink);
+    return EXIT_SUCCESS;
+}
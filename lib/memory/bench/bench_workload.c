@@ -0,0 +1,93 @@
+// bench_workload.c
+//
+// Ejecuta una especificación de carga (ver workload.h) e imprime por fase el
+// rendimiento y la fragmentación. Con `all` la misma carga se repite para cada
+// política de asignación, cada una en un proceso hijo para partir de un heap
+// vacío.
+//
+// Uso: bench_workload <spec.json> [first_fit|best_fit|worst_fit|all]
+
+#include "memory.h"
+#include "workload.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const char *const policy_names[] = {"first_fit", "best_fit", "worst_fit"};
+static const int policy_values[] = {FIRST_FIT, BEST_FIT, WORST_FIT};
+
+#define NUM_POLICIES (sizeof(policy_values) / sizeof(policy_values[0]))
+
+static int run(struct s_workload *w) {
+    struct s_phase_result *results = calloc(w->num_phases, sizeof(*results));
+    if (!results) {
+        perror("calloc");
+        return -1;
+    }
+
+    int status = workload_run(w, results);
+    if (status == 0) {
+        workload_print_results(w, results);
+    } else {
+        fprintf(stderr, "workload_run failed\n");
+    }
+    free(results);
+    return status;
+}
+
+/** Ejecuta la carga con una política en un proceso hijo. */
+static int run_child(struct s_workload *w, size_t policy) {
+    w->policy = policy_values[policy];
+    printf("== %s ==\n", policy_names[policy]);
+    fflush(stdout);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int ret = run(w);
+        fflush(stdout);
+        _exit(ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    } else if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+
+    int wstatus;
+    waitpid(pid, &wstatus, 0);
+    return WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0 ? 0 : -1;
+}
+
+int main(int argc, char *argv[]) {
+    struct s_workload w;
+    int status = 0;
+
+    if (argc < 2) {
+        fprintf(stderr, "Uso: %s <spec.json> [first_fit|best_fit|worst_fit|all]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (workload_load(argv[1], &w) == -1) {
+        return EXIT_FAILURE;
+    }
+
+    if (argc < 3) {
+        status = run(&w);
+    } else {
+        int matched = 0;
+        for (size_t i = 0; i < NUM_POLICIES; i++) {
+            if (strcmp(argv[2], "all") == 0 || strcmp(argv[2], policy_names[i]) == 0) {
+                matched = 1;
+                if (run_child(&w, i) == -1) {
+                    status = -1;
+                }
+            }
+        }
+        if (!matched) {
+            fprintf(stderr, "Política desconocida: %s\n", argv[2]);
+            status = -1;
+        }
+    }
+
+    workload_free(&w);
+    return status == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file handle.h
+ * @brief Asignaciones movibles mediante handles y compactación del heap.
+ *
+ * Un handle es un identificador estable de una asignación cuya dirección
+ * puede cambiar. Mientras no está fijado con `hlock`, el compactador puede
+ * deslizar el bloque hacia direcciones más bajas para juntar el espacio
+ * libre al final del heap y devolverlo al sistema con `heap_trim`.
+ */
+
+// handle.h
+#pragma once
+
+#include "memory.h"
+
+/** Tipo de un handle. El valor 0 nunca es un handle válido. */
+typedef size_t t_handle;
+
+/** Valor devuelto por `hmalloc` cuando no se pudo asignar memoria. */
+#define INVALID_HANDLE ((t_handle)0)
+
+/**
+ * @brief Asigna un bloque movible del tamaño solicitado.
+ *
+ * @param size Tamaño en bytes requerido por el usuario.
+ * @return t_handle Handle de la asignación, o INVALID_HANDLE si falla.
+ */
+t_handle hmalloc(size_t size);
+
+/**
+ * @brief Libera un bloque asignado con `hmalloc`.
+ *
+ * El handle queda invalidado y puede reutilizarse en asignaciones futuras.
+ * Liberar un handle fijado es un error y se ignora.
+ *
+ * @param h Handle a liberar.
+ */
+void hfree(t_handle h);
+
+/**
+ * @brief Fija un bloque movible y devuelve su dirección actual.
+ *
+ * Las llamadas se anidan: el bloque no se moverá hasta que cada `hlock`
+ * tenga su `hunlock` correspondiente.
+ *
+ * @param h Handle a fijar.
+ * @return void* Puntero a los datos, o NULL si el handle no es válido.
+ */
+void *hlock(t_handle h);
+
+/**
+ * @brief Libera una fijación obtenida con `hlock`.
+ *
+ * Después de la última llamada el puntero devuelto por `hlock` deja de ser
+ * válido, ya que el compactador puede mover el bloque.
+ *
+ * @param h Handle a liberar.
+ */
+void hunlock(t_handle h);
+
+/**
+ * @brief Indica cuántas fijaciones activas tiene un handle.
+ *
+ * @param h Handle a consultar.
+ * @return unsigned int Cantidad de `hlock` pendientes (0 si no es válido).
+ */
+unsigned int hpins(t_handle h);
+
+/**
+ * @brief Ejecuta un paso incremental de compactación del heap.
+ *
+ * Recorre el heap desde donde terminó la llamada anterior y desliza bloques
+ * movibles no fijados sobre el bloque libre que los precede, realizando a lo
+ * sumo `max_moves` movimientos. Al completar una pasada entera recorta el
+ * bloque libre final con `heap_trim`.
+ *
+ * @param max_moves Cantidad máxima de bloques a mover en esta llamada.
+ * @return size_t Cantidad de bloques movidos.
+ */
+size_t heap_compact(size_t max_moves);
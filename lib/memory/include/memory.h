@@ -15,6 +15,7 @@
 #include <sys/types.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 /**
  * @brief Macro para alinear una cantidad de bytes al siguiente múltiplo de 8.
@@ -27,6 +28,10 @@
 #define BLOCK_SIZE sizeof(struct s_block) // Tamaño del bloque de control
 /** Tamaño de página en memoria. */
 #define PAGESIZE 4096
+/** Tamaño de una página enorme (huge page) de x86-64. */
+#define HUGEPAGE_SIZE (2UL * 1024 * 1024)
+/** Espacio virtual reservado para el heap cuando se usan páginas enormes. */
+#define HEAP_RESERVE (16UL * 1024 * 1024 * 1024)
 /** Política de asignación First Fit. */
 #define FIRST_FIT 0
 /** Política de asignación Best Fit. */
@@ -39,6 +44,36 @@
 #define BEST_FIT 1
 #define WORST_FIT 2
 
+/** El bloque pertenece a un handle y el compactador puede moverlo. */
+#define BLOCK_MOVABLE 0x1
+/** Bloque libre con páginas interiores devueltas con madvise (ver `released`). */
+#define BLOCK_RELEASED 0x2
+
+/** Variable de entorno con la configuración del asignador. */
+#define MALLOC_CONF_ENV "MYMALLOC_CONF"
+
+/** Tamaño mínimo por defecto de un bloque libre para liberar sus páginas. */
+#define SCAVENGE_THRESHOLD (64 * 1024)
+/** Liberar las páginas de un bloque en cuanto se libera con my_free. */
+#define SCAVENGE_ON_FREE 0x1
+/** Usar MADV_FREE (liberación diferida) en lugar de MADV_DONTNEED. */
+#define SCAVENGE_LAZY 0x2
+
+/** Bloque fuera de los límites del heap o con cabecera desalineada. */
+#define HEAP_ERR_BOUNDS 1
+/** Tamaño nulo o no alineado. */
+#define HEAP_ERR_SIZE 2
+/** `ptr` no apunta a `data`. */
+#define HEAP_ERR_PTR 3
+/** `next->prev` no apunta al bloque. */
+#define HEAP_ERR_LINK 4
+/** Lista fuera de orden de direcciones (posible ciclo). */
+#define HEAP_ERR_ORDER 5
+/** El bloque se superpone con el siguiente. */
+#define HEAP_ERR_OVERLAP 6
+/** Bloques libres adyacentes sin fusionar. */
+#define HEAP_ERR_UNFUSED 7
+
 /**
  * @struct s_block
  * @brief Estructura para representar un bloque de memoria.
@@ -51,6 +86,8 @@ struct s_block {
     struct s_block *next; /**< Puntero al siguiente bloque en la lista enlazada. */
     struct s_block *prev; /**< Puntero al bloque anterior en la lista enlazada. */
     int free;             /**< Indicador de si el bloque está libre (1) o ocupado (0). */
+    unsigned int flags;   /**< Banderas internas del bloque (ver BLOCK_*). Ocupa el relleno tras `free`. */
+    size_t released;      /**< Bytes del interior devueltos al sistema (0 sin BLOCK_RELEASED). */
     void *ptr;            /**< Puntero a la dirección de los datos almacenados. */
     char data[];          /**< Área donde comienzan los datos del bloque (array flexible). */
 };
@@ -149,6 +186,223 @@ void *my_calloc(size_t number, size_t size);
  */
 void *my_realloc(void *ptr, size_t size);
 
+/**
+ * @brief Mueve el final del heap del asignador.
+ *
+ * Equivale a `sbrk` en el modo por defecto. Con páginas enormes habilitadas
+ * opera sobre una región propia alineada a HUGEPAGE_SIZE, que se reserva
+ * con `mmap` en la primera llamada y se habilita en tramos de HUGEPAGE_SIZE
+ * marcados con `madvise(MADV_HUGEPAGE)`.
+ *
+ * @param increment Cantidad de bytes a agregar (o quitar, si es negativa).
+ * @return void* Final anterior del heap, o `(void *)-1` en caso de error.
+ */
+void *heap_sbrk(intptr_t increment);
+
+/**
+ * @brief Habilita o deshabilita el respaldo del heap con páginas enormes.
+ *
+ * Solo puede cambiarse antes de la primera asignación, ya que los bloques
+ * existentes no pueden trasladarse a la nueva región.
+ *
+ * @param enable 1 para usar la región con páginas enormes, 0 para `sbrk`.
+ * @return int 0 si se aplicó el cambio, -1 si el heap ya está en uso.
+ */
+int malloc_hugepages(int enable);
+
+/**
+ * @brief Devuelve al sistema el último bloque del heap si está libre.
+ *
+ * Solo recorta cuando el final del bloque coincide con el break actual
+ * (`sbrk(0)`), de modo que nunca se libera memoria ajena al asignador.
+ *
+ * @return size_t Cantidad de bytes devueltos al sistema (0 si no se recortó).
+ */
+size_t heap_trim(void);
+
+/**
+ * @brief Toma el mutex del heap.
+ *
+ * Todas las operaciones públicas del asignador lo toman internamente. Es
+ * recursivo, así que puede usarse para agrupar varias operaciones.
+ */
+void heap_lock(void);
+
+/**
+ * @brief Suelta el mutex del heap tomado con `heap_lock`.
+ */
+void heap_unlock(void);
+
+/**
+ * @brief Configura la liberación de páginas de bloques libres grandes.
+ *
+ * @param threshold Tamaño mínimo del bloque libre (0 deshabilita el scavenger).
+ * @param flags Combinación de SCAVENGE_ON_FREE y SCAVENGE_LAZY.
+ */
+void malloc_scavenge_control(size_t threshold, int flags);
+
+/**
+ * @brief Libera las páginas interiores de todos los bloques libres grandes.
+ *
+ * Recorre el heap y aplica `madvise` a la porción alineada a página de cada
+ * bloque libre que supere el umbral y que aún no haya sido liberado.
+ *
+ * @return size_t Bytes liberados en esta pasada.
+ */
+size_t heap_scavenge(void);
+
+/**
+ * @brief Libera las páginas de un bloque recién liberado si corresponde.
+ *
+ * Lo invoca my_free tras la fusión cuando SCAVENGE_ON_FREE está activo.
+ *
+ * @param b Bloque libre resultante de la fusión.
+ */
+void scavenge_freed_block(t_block b);
+
+/**
+ * @brief Bytes de un bloque libre cuyas páginas fueron devueltas al sistema.
+ *
+ * Al fusionar bloques libres se suman los bytes liberados de cada uno. Al
+ * partir un bloque parcialmente liberado no se sabe en qué parte quedaron
+ * las páginas residentes, así que a cada parte se le cuenta lo mínimo posible.
+ *
+ * @param b Bloque a consultar.
+ * @return size_t Tamaño de la porción liberada (0 si no está liberado).
+ */
+size_t released_bytes(t_block b);
+
+/**
+ * @brief Reparte los bytes liberados de un bloque que se va a partir.
+ *
+ * Lo invoca split_block antes de escribir la cabecera del resto. Actualiza
+ * `released` y BLOCK_RELEASED del bloque `b`.
+ *
+ * @param b Bloque que se parte.
+ * @param s Tamaño de datos que conserva `b`.
+ * @return size_t Bytes liberados que corresponden al resto.
+ */
+size_t split_released(t_block b, size_t s);
+
+/**
+ * @brief Inicia un hilo que ejecuta `heap_scavenge` periódicamente.
+ *
+ * @param interval_ms Intervalo entre pasadas en milisegundos.
+ * @return int 0 si se inició, -1 si ya estaba en ejecución o hubo un error.
+ */
+int start_scavenger(unsigned int interval_ms);
+
+/**
+ * @brief Detiene el hilo iniciado con `start_scavenger` y espera su fin.
+ */
+void stop_scavenger(void);
+
+/**
+ * @brief Función que recibe cada violación encontrada por el verificador.
+ *
+ * @param error Código HEAP_ERR_* de la violación.
+ * @param block Bloque en el que se detectó.
+ * @param arg Argumento registrado con `heap_verify_handler`.
+ */
+typedef void (*heap_verify_fn)(int error, t_block block, void *arg);
+
+/**
+ * @brief Verifica incrementalmente a lo sumo `max_blocks` bloques del heap.
+ *
+ * Continúa donde terminó la llamada anterior y vuelve al inicio al completar
+ * una pasada. Cada bloque se valida solo contra su vecino siguiente, por lo
+ * que el costo por llamada es O(max_blocks). Los ciclos se detectan porque la
+ * lista debe estar en orden creciente de direcciones. Ante un enlace inválido
+ * la pasada se reinicia en lugar de seguirlo.
+ *
+ * @param max_blocks Presupuesto de bloques a revisar.
+ * @return size_t Violaciones encontradas en esta llamada.
+ */
+size_t heap_verify_step(size_t max_blocks);
+
+/**
+ * @brief Ejecuta `heap_verify_step(max_blocks)` cada `allocations` llamadas a
+ * my_malloc.
+ *
+ * @param allocations Período en asignaciones (0 lo desactiva).
+ * @param max_blocks Presupuesto de bloques por ejecución.
+ */
+void heap_verify_every(unsigned int allocations, size_t max_blocks);
+
+/**
+ * @brief Registra la función que recibe las violaciones.
+ *
+ * Se invoca con el mutex del heap tomado, por lo que no debe asignar memoria
+ * con este asignador.
+ *
+ * @param fn Función a invocar, o NULL para solo contar.
+ * @param arg Argumento que se pasa a `fn`.
+ */
+void heap_verify_handler(heap_verify_fn fn, void *arg);
+
+/**
+ * @brief Total de violaciones encontradas desde el inicio del proceso.
+ *
+ * @return size_t Contador acumulado.
+ */
+size_t heap_verify_errors(void);
+
+/**
+ * @brief Cantidad de pasadas completas del verificador incremental.
+ *
+ * @return size_t Pasadas completadas.
+ */
+size_t heap_verify_passes(void);
+
+/**
+ * @brief Descripción breve de un código HEAP_ERR_*.
+ *
+ * @param error Código de error.
+ * @return const char* Texto estático.
+ */
+const char *heap_verify_strerror(int error);
+
+/**
+ * @brief Avisa al verificador que un bloque dejó de existir.
+ *
+ * La llaman la fusión, el recorte y el compactador para que el cursor de
+ * `heap_verify_step` nunca quede apuntando a una cabecera inexistente.
+ *
+ * @param removed Bloque eliminado.
+ * @param survivor Bloque que ocupa su lugar (o NULL).
+ */
+void verify_block_removed(t_block removed, t_block survivor);
+
+/**
+ * @brief Avanza el contador de `heap_verify_every`; lo llama my_malloc.
+ */
+void verify_on_malloc(void);
+
+/**
+ * @brief Registra una asignación en la tabla de seguimiento de snapshot.h.
+ *
+ * No hace nada si el seguimiento está desactivado.
+ *
+ * @param ptr Datos asignados (puede ser NULL).
+ * @param caller Dirección que llamó al asignador.
+ */
+void track_alloc(void *ptr, void *caller);
+
+/**
+ * @brief Quita una asignación de la tabla de seguimiento.
+ *
+ * @param ptr Datos liberados.
+ */
+void track_free(void *ptr);
+
+/**
+ * @brief Actualiza la tabla de seguimiento cuando el compactador mueve un bloque.
+ *
+ * @param from Dirección de datos anterior.
+ * @param to Dirección de datos nueva.
+ */
+void track_move(void *from, void *to);
+
 /**
  * @brief Realiza una verificación extendida de la consistencia del heap.
  *
@@ -179,6 +433,43 @@ bool is_aligned(size_t size);
  */
 void malloc_control(int mode);
 
+/**
+ * @brief Devuelve el modo de asignación actual.
+ *
+ * @return int FIRST_FIT, BEST_FIT o WORST_FIT.
+ */
+int get_method(void);
+
+/**
+ * @brief Aplica una configuración del asignador en formato `clave:valor`.
+ *
+ * Las opciones se separan con comas, por ejemplo
+ * `policy:best_fit,log:/tmp/malloc.log,log_sample:100`. Claves admitidas:
+ * - `policy`: first_fit, best_fit o worst_fit.
+ * - `log`: ruta del archivo de log, `stderr` u `off`.
+ * - `log_sample`: registrar uno de cada N eventos.
+ * - `hugepages`: 1 para respaldar el heap con páginas enormes.
+ * - `scavenge_threshold`: umbral en bytes del scavenger (0 lo deshabilita).
+ * - `scavenge`: `off`, `free` (al liberar) o `lazy` (al liberar, MADV_FREE).
+ * - `leaks`: `on` para seguir las asignaciones y reportar fugas al salir.
+ *
+ * Puede llamarse en cualquier momento; los cambios de política y de log se
+ * aplican de forma segura aunque otros hilos estén asignando memoria.
+ *
+ * @param conf Cadena de configuración.
+ * @return int 0 si todas las opciones eran válidas, o la cantidad de
+ * opciones rechazadas.
+ */
+int malloc_configure(const char *conf);
+
+/**
+ * @brief Lee la configuración de la variable de entorno MALLOC_CONF_ENV.
+ *
+ * Se ejecuta una sola vez, en la primera asignación; las llamadas
+ * posteriores no tienen efecto.
+ */
+void malloc_init_config(void);
+
 /**
  * @brief Reporta el tamaño total de bloques asignados y la cantidad de memoria libre.
  *
@@ -200,7 +491,7 @@ void debug_heap();
  *
  * Abre el archivo de log en modo append. Debe llamarse al inicio del programa.
  *
- * @param filename Nombre del archivo de log.
+ * @param filename Nombre del archivo de log, o `stderr` para la salida de error.
  * @return int Retorna 0 si se inicializó correctamente, -1 en caso de error.
  */
 int initialize_logger(const char *filename);
@@ -219,6 +510,13 @@ void finalize_logger();
  */
 void set_logging(int enable);
 
+/**
+ * @brief Registra solo uno de cada `every` eventos.
+ *
+ * @param every Período de muestreo (0 o 1 registran todos los eventos).
+ */
+void set_log_sampling(unsigned int every);
+
 /**
  * @brief Registra un evento en el archivo de log.
  *
@@ -242,7 +540,9 @@ double calculate_memory_fragmentation();
 /**
  * @brief Simula actividad de memoria para pruebas y monitoreo.
  *
- * Esta función asigna y libera bloques de memoria dinámicamente
- * y registra las estadísticas para ser usadas en monitoreo.
+ * Cada llamada avanza 100 asignaciones de una carga de fondo del generador de
+ * workload.h (tamaños log-normales, vidas exponenciales), liberando los
+ * objetos cuya vida venció, para que la fragmentación reportada al monitor
+ * refleje un patrón de uso realista.
  */
 void simulate_memory_activity();
@@ -0,0 +1,109 @@
+/**
+ * @file snapshot.h
+ * @brief Instantáneas del heap, diferencias entre ellas y reporte de fugas.
+ *
+ * Con el seguimiento activado (`heap_track`) cada asignación registra un
+ * número de secuencia, el instante en que se hizo y la dirección desde la que
+ * se llamó al asignador. Los datos viven en una tabla aparte indexada por
+ * puntero, de modo que la cabecera de los bloques no crece y el costo es nulo
+ * mientras el seguimiento está apagado.
+ */
+
+// snapshot.h
+#pragma once
+
+#include "memory.h"
+#include <stdint.h>
+#include <stdio.h>
+
+/** Cantidad máxima de sitios de llamada que se imprimen en un reporte. */
+#define SNAPSHOT_MAX_SITES 20
+
+/**
+ * @struct s_snapshot_entry
+ * @brief Un bloque ocupado en el momento de la instantánea.
+ */
+struct s_snapshot_entry {
+    void *ptr;        /**< Dirección de los datos. */
+    size_t size;      /**< Tamaño del bloque. */
+    uint64_t seq;     /**< Número de secuencia de la asignación (0 si no se siguió). */
+    uint64_t time_ns; /**< Instante de la asignación (CLOCK_MONOTONIC). */
+    void *caller;     /**< Dirección que llamó al asignador, o NULL. */
+};
+
+/**
+ * @struct s_heap_snapshot
+ * @brief Bloques ocupados en orden creciente de dirección.
+ */
+struct s_heap_snapshot {
+    size_t count;                     /**< Cantidad de bloques. */
+    size_t bytes;                     /**< Suma de sus tamaños. */
+    uint64_t seq;                     /**< Próxima secuencia al momento de la captura. */
+    struct s_snapshot_entry *entries; /**< Bloques capturados. */
+};
+
+/**
+ * @struct s_heap_diff
+ * @brief Totales de la diferencia entre dos instantáneas.
+ */
+struct s_heap_diff {
+    size_t new_blocks;   /**< Bloques presentes solo en la segunda. */
+    size_t new_bytes;    /**< Bytes de esos bloques. */
+    size_t freed_blocks; /**< Bloques presentes solo en la primera. */
+    size_t freed_bytes;  /**< Bytes de esos bloques. */
+};
+
+/**
+ * @brief Activa o desactiva el seguimiento de asignaciones.
+ *
+ * Al desactivarlo se descarta la información registrada.
+ *
+ * @param enable Distinto de 0 para activarlo.
+ * @return int 0 si tuvo éxito, -1 si no hubo memoria para la tabla.
+ */
+int heap_track(int enable);
+
+/**
+ * @brief Captura los bloques ocupados del heap.
+ *
+ * @return struct s_heap_snapshot* Instantánea (liberar con
+ * `heap_snapshot_free`), o NULL si no hubo memoria.
+ */
+struct s_heap_snapshot *heap_snapshot(void);
+
+/**
+ * @brief Libera una instantánea.
+ *
+ * @param snapshot Instantánea devuelta por `heap_snapshot`.
+ */
+void heap_snapshot_free(struct s_heap_snapshot *snapshot);
+
+/**
+ * @brief Compara dos instantáneas y agrupa las diferencias por sitio de llamada.
+ *
+ * Un bloque se considera el mismo en ambas si coinciden su dirección, su
+ * secuencia y su tamaño. El costo es lineal en el tamaño de las instantáneas.
+ *
+ * @param a Instantánea anterior (NULL equivale a un heap vacío).
+ * @param b Instantánea posterior.
+ * @param out Destino del reporte, o NULL para calcular solo los totales.
+ * @return struct s_heap_diff Totales de la diferencia.
+ */
+struct s_heap_diff heap_diff(const struct s_heap_snapshot *a, const struct s_heap_snapshot *b,
+                             FILE *out);
+
+/**
+ * @brief Imprime los bloques seguidos que siguen ocupados, agrupados por sitio
+ * de llamada.
+ *
+ * @param out Destino del reporte.
+ * @return size_t Cantidad de bloques con fuga.
+ */
+size_t heap_leak_report(FILE *out);
+
+/**
+ * @brief Activa el seguimiento y registra `heap_leak_report(stderr)` con atexit.
+ *
+ * @return int 0 si tuvo éxito, -1 en caso de error.
+ */
+int heap_leak_report_at_exit(void);
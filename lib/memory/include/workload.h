@@ -0,0 +1,142 @@
+/**
+ * @file workload.h
+ * @brief Generador sintético de cargas de asignación de memoria.
+ *
+ * Una carga se compone de fases. En cada fase se realiza una cantidad fija de
+ * asignaciones cuyos tamaños y tiempos de vida (medidos en asignaciones) se
+ * toman de distribuciones configurables. Los objetos se liberan cuando vence
+ * su tiempo de vida, lo que reproduce la mezcla de objetos efímeros y
+ * longevos de un proceso real. Todo el azar proviene de un generador con
+ * semilla, por lo que dos ejecuciones con la misma semilla son idénticas.
+ */
+
+// workload.h
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Valor constante `mu`. */
+#define DIST_FIXED 0
+/** Uniforme entre `min` y `max`. */
+#define DIST_UNIFORM 1
+/** Log-normal: exp(N(mu, sigma)). */
+#define DIST_LOGNORMAL 2
+/** Ley de potencias (Pareto) con exponente `alpha` a partir de `min`. */
+#define DIST_POWERLAW 3
+/** Mezcla de N(mu, sigma) con probabilidad `weight` y N(mu2, sigma2). */
+#define DIST_BIMODAL 4
+/** Exponencial de media `mu`. */
+#define DIST_EXPONENTIAL 5
+/** Tiempo de vida infinito: el objeto vive hasta el final de la carga. */
+#define DIST_PERMANENT 6
+
+/** Longitud máxima del nombre de una fase. */
+#define PHASE_NAME_MAX 32
+
+/**
+ * @struct s_distribution
+ * @brief Distribución de tamaños o de tiempos de vida.
+ *
+ * Los campos que no usa el tipo elegido se ignoran. Si `max` es mayor que 0
+ * las muestras se recortan al intervalo [min, max].
+ */
+struct s_distribution {
+    int type;      /**< Uno de los DIST_*. */
+    double min;    /**< Cota inferior (y escala de DIST_POWERLAW). */
+    double max;    /**< Cota superior (0 sin recorte). */
+    double mu;     /**< Media, mediana logarítmica o valor fijo. */
+    double sigma;  /**< Desvío del primer modo. */
+    double alpha;  /**< Exponente de la ley de potencias (> 1). */
+    double mu2;    /**< Media del segundo modo (DIST_BIMODAL). */
+    double sigma2; /**< Desvío del segundo modo (DIST_BIMODAL). */
+    double weight; /**< Probabilidad del primer modo (DIST_BIMODAL). */
+};
+
+/**
+ * @struct s_phase
+ * @brief Una fase de la carga de trabajo.
+ */
+struct s_phase {
+    char name[PHASE_NAME_MAX];       /**< Nombre para los reportes. */
+    size_t allocations;              /**< Asignaciones a realizar. */
+    struct s_distribution size;      /**< Tamaño de cada asignación en bytes. */
+    struct s_distribution lifetime;  /**< Vida de cada objeto, en asignaciones. */
+    int free_all;                    /**< Liberar todo lo vivo al terminar la fase. */
+};
+
+/**
+ * @struct s_workload
+ * @brief Especificación completa de una carga de trabajo.
+ */
+struct s_workload {
+    uint64_t seed;           /**< Semilla del generador pseudoaleatorio. */
+    int policy;              /**< Política de asignación, o -1 para no cambiarla. */
+    size_t num_phases;       /**< Cantidad de fases. */
+    struct s_phase *phases;  /**< Fases en orden de ejecución. */
+};
+
+/**
+ * @struct s_phase_result
+ * @brief Métricas de una fase ejecutada.
+ */
+struct s_phase_result {
+    size_t allocations;    /**< Asignaciones exitosas. */
+    size_t frees;          /**< Liberaciones realizadas. */
+    size_t failures;       /**< Asignaciones que devolvieron NULL. */
+    double seconds;        /**< Duración de la fase. */
+    double ops_per_sec;    /**< (asignaciones + liberaciones) por segundo. */
+    double fragmentation;  /**< calculate_memory_fragmentation al terminar. */
+    size_t live_objects;   /**< Objetos vivos al terminar. */
+    size_t live_bytes;     /**< Bytes solicitados vivos al terminar. */
+    size_t heap_bytes;     /**< Crecimiento del heap desde el inicio de la carga. */
+};
+
+/**
+ * @brief Ejecuta una carga de trabajo sobre my_malloc/my_free.
+ *
+ * Al terminar libera todos los objetos que sigan vivos.
+ *
+ * @param w Especificación de la carga.
+ * @param results Arreglo de `w->num_phases` resultados a completar.
+ * @return int 0 si se ejecutó, -1 si la especificación no es válida o no
+ * hubo memoria para el seguimiento de objetos.
+ */
+int workload_run(const struct s_workload *w, struct s_phase_result *results);
+
+/**
+ * @brief Imprime los resultados de una carga en formato de tabla.
+ *
+ * @param w Especificación ejecutada.
+ * @param results Resultados devueltos por `workload_run`.
+ */
+void workload_print_results(const struct s_workload *w, const struct s_phase_result *results);
+
+/**
+ * @brief Carga una especificación desde un archivo JSON.
+ *
+ * Formato:
+ * @code
+ * { "seed": 42, "policy": "best_fit",
+ *   "phases": [ { "name": "steady", "allocations": 100000,
+ *                 "size": { "distribution": "lognormal", "mu": 4.2, "sigma": 1.0,
+ *                           "min": 8, "max": 65536 },
+ *                 "lifetime": { "distribution": "exponential", "mean": 500 },
+ *                 "free_all": false } ] }
+ * @endcode
+ * Las distribuciones aceptan `fixed` (`value`), `uniform`, `lognormal`,
+ * `powerlaw` (`alpha`), `bimodal` (`mu`, `sigma`, `mu2`, `sigma2`,
+ * `weight`), `exponential` (`mean`) y `permanent`.
+ *
+ * @param path Ruta del archivo.
+ * @param w Especificación a completar; liberar con `workload_free`.
+ * @return int 0 si se cargó, -1 en caso de error.
+ */
+int workload_load(const char *path, struct s_workload *w);
+
+/**
+ * @brief Libera la memoria de una especificación cargada con `workload_load`.
+ *
+ * @param w Especificación a liberar.
+ */
+void workload_free(struct s_workload *w);
@@ -0,0 +1,168 @@
+// config.c
+//
+// Configuración del asignador a partir de una cadena `clave:valor,...`, leída
+// una sola vez de la variable de entorno MALLOC_CONF_ENV en la primera
+// asignación o aplicada explícitamente con malloc_configure.
+
+#include "memory.h"
+#include "snapshot.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Longitud máxima de una cadena de configuración. */
+#define MALLOC_CONF_MAX 1024
+
+static pthread_once_t config_once = PTHREAD_ONCE_INIT;
+
+// Las claves `scavenge` y `scavenge_threshold` se aplican juntas, de modo que
+// cada una conserva el valor configurado por la otra.
+static size_t scavenge_threshold = SCAVENGE_THRESHOLD;
+static int scavenge_flags = 0;
+
+static int parse_policy(const char *value) {
+    if (strcmp(value, "first_fit") == 0) {
+        return FIRST_FIT;
+    }
+    if (strcmp(value, "best_fit") == 0) {
+        return BEST_FIT;
+    }
+    if (strcmp(value, "worst_fit") == 0) {
+        return WORST_FIT;
+    }
+    return -1;
+}
+
+static int parse_size(const char *value, size_t *out) {
+    char *end;
+    unsigned long long n = strtoull(value, &end, 10);
+
+    if (end == value) {
+        return -1;
+    }
+    if (*end == 'k' || *end == 'K') {
+        n <<= 10;
+        end++;
+    } else if (*end == 'm' || *end == 'M') {
+        n <<= 20;
+        end++;
+    }
+    if (*end != '\0') {
+        return -1;
+    }
+    *out = (size_t)n;
+    return 0;
+}
+
+static int apply_option(const char *key, const char *value) {
+    size_t n;
+
+    if (strcmp(key, "policy") == 0) {
+        int policy = parse_policy(value);
+        if (policy < 0) {
+            return -1;
+        }
+        malloc_control(policy);
+        return 0;
+    }
+
+    if (strcmp(key, "log") == 0) {
+        if (strcmp(value, "off") == 0) {
+            set_logging(0);
+            return 0;
+        }
+        finalize_logger();
+        set_logging(1);
+        return initialize_logger(value);
+    }
+
+    if (strcmp(key, "log_sample") == 0) {
+        if (parse_size(value, &n) == -1) {
+            return -1;
+        }
+        set_log_sampling((unsigned int)n);
+        return 0;
+    }
+
+    if (strcmp(key, "hugepages") == 0) {
+        if (parse_size(value, &n) == -1) {
+            return -1;
+        }
+        return malloc_hugepages(n != 0);
+    }
+
+    if (strcmp(key, "leaks") == 0) {
+        if (strcmp(value, "on") == 0) {
+            return heap_leak_report_at_exit();
+        }
+        return strcmp(value, "off") == 0 ? heap_track(0) : -1;
+    }
+
+    if (strcmp(key, "scavenge_threshold") == 0) {
+        if (parse_size(value, &scavenge_threshold) == -1) {
+            return -1;
+        }
+        malloc_scavenge_control(scavenge_threshold, scavenge_flags);
+        return 0;
+    }
+
+    if (strcmp(key, "scavenge") == 0) {
+        if (strcmp(value, "off") == 0) {
+            scavenge_flags = 0;
+        } else if (strcmp(value, "free") == 0) {
+            scavenge_flags = SCAVENGE_ON_FREE;
+        } else if (strcmp(value, "lazy") == 0) {
+            scavenge_flags = SCAVENGE_ON_FREE | SCAVENGE_LAZY;
+        } else {
+            return -1;
+        }
+        malloc_scavenge_control(scavenge_threshold, scavenge_flags);
+        return 0;
+    }
+
+    return -1;
+}
+
+int malloc_configure(const char *conf) {
+    char buffer[MALLOC_CONF_MAX];
+    char *saveptr;
+    int errors = 0;
+
+    if (!conf) {
+        return 0;
+    }
+    if (strlen(conf) >= sizeof(buffer)) {
+        fprintf(stderr, "%s: configuration too long\n", MALLOC_CONF_ENV);
+        return 1;
+    }
+    strcpy(buffer, conf);
+
+    for (char *option = strtok_r(buffer, ",", &saveptr); option;
+         option = strtok_r(NULL, ",", &saveptr)) {
+        char *value = strpbrk(option, ":=");
+        if (value) {
+            *value++ = '\0';
+        }
+
+        if (!value || apply_option(option, value) != 0) {
+            fprintf(stderr, "%s: invalid option '%s%s%s'\n", MALLOC_CONF_ENV, option,
+                    value ? ":" : "", value ? value : "");
+            log_event("malloc_configure", 0, NULL, "Invalid configuration option");
+            errors++;
+        }
+    }
+
+    return errors;
+}
+
+static void read_env_config(void) {
+    const char *conf = getenv(MALLOC_CONF_ENV);
+    if (conf && *conf) {
+        malloc_configure(conf);
+    }
+}
+
+void malloc_init_config(void) {
+    pthread_once(&config_once, read_env_config);
+}
@@ -0,0 +1,234 @@
+// handle.c
+//
+// Tabla de handles para asignaciones movibles y compactador incremental.
+// Cada bloque movible guarda su propio handle al inicio del área de datos, de
+// modo que al deslizarlo se puede actualizar la tabla sin buscar en ella.
+
+#include "handle.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/** Definido en memory.c: primer bloque del heap. */
+extern void *base;
+
+/** Espacio reservado al inicio de los datos para guardar el handle. */
+#define HANDLE_HEADER align(sizeof(t_handle))
+
+/** Capacidad inicial de la tabla de handles. */
+#define HANDLE_TABLE_INITIAL 64
+
+struct s_handle_entry {
+    t_block block;      /**< Bloque actual de la asignación (NULL si libre). */
+    unsigned int pins;  /**< Cantidad de hlock pendientes. */
+    t_handle next_free; /**< Siguiente entrada libre cuando block es NULL. */
+};
+
+static struct s_handle_entry *handle_table = NULL;
+static size_t handle_capacity = 0;
+static size_t handle_count = 0;
+static t_handle free_handles = INVALID_HANDLE;
+
+/** Desplazamiento desde `base` donde continúa la próxima compactación. */
+static size_t compact_offset = 0;
+
+static t_block block_of(void *data) {
+    return (t_block)((char *)data - offsetof(struct s_block, data));
+}
+
+static struct s_handle_entry *lookup(t_handle h) {
+    if (h == INVALID_HANDLE || h > handle_count) {
+        return NULL;
+    }
+    struct s_handle_entry *e = &handle_table[h - 1];
+    return e->block ? e : NULL;
+}
+
+static t_handle new_handle(void) {
+    if (free_handles != INVALID_HANDLE) {
+        t_handle h = free_handles;
+        free_handles = handle_table[h - 1].next_free;
+        return h;
+    }
+
+    if (handle_count == handle_capacity) {
+        size_t capacity = handle_capacity ? handle_capacity * 2 : HANDLE_TABLE_INITIAL;
+        struct s_handle_entry *table = realloc(handle_table, capacity * sizeof(*table));
+        if (!table) {
+            return INVALID_HANDLE;
+        }
+        handle_table = table;
+        handle_capacity = capacity;
+    }
+
+    return ++handle_count;
+}
+
+static t_handle hmalloc_locked(size_t size) {
+    t_handle h = new_handle();
+    if (h == INVALID_HANDLE) {
+        log_event("hmalloc", size, NULL, "Handle table exhausted");
+        return INVALID_HANDLE;
+    }
+
+    void *data = my_malloc(HANDLE_HEADER + size);
+    if (!data) {
+        handle_table[h - 1].block = NULL;
+        handle_table[h - 1].next_free = free_handles;
+        free_handles = h;
+        return INVALID_HANDLE;
+    }
+
+    t_block b = block_of(data);
+    b->flags |= BLOCK_MOVABLE;
+    *(t_handle *)data = h;
+
+    handle_table[h - 1].block = b;
+    handle_table[h - 1].pins = 0;
+    handle_table[h - 1].next_free = INVALID_HANDLE;
+
+    log_event("hmalloc", size, data, "Movable block allocated");
+    return h;
+}
+
+t_handle hmalloc(size_t size) {
+    heap_lock();
+    t_handle h = hmalloc_locked(size);
+    heap_unlock();
+    return h;
+}
+
+void hfree(t_handle h) {
+    heap_lock();
+    struct s_handle_entry *e = lookup(h);
+    if (!e) {
+        log_event("hfree", 0, NULL, "Attempted to free invalid handle");
+    } else if (e->pins) {
+        log_event("hfree", e->block->size, e->block->data, "Attempted to free pinned handle");
+    } else {
+        my_free(e->block->data);
+
+        e->block = NULL;
+        e->next_free = free_handles;
+        free_handles = h;
+    }
+    heap_unlock();
+}
+
+void *hlock(t_handle h) {
+    void *data = NULL;
+
+    heap_lock();
+    struct s_handle_entry *e = lookup(h);
+    if (e) {
+        e->pins++;
+        data = (char *)e->block->data + HANDLE_HEADER;
+    }
+    heap_unlock();
+    return data;
+}
+
+void hunlock(t_handle h) {
+    heap_lock();
+    struct s_handle_entry *e = lookup(h);
+    if (e && e->pins) {
+        e->pins--;
+    }
+    heap_unlock();
+}
+
+unsigned int hpins(t_handle h) {
+    heap_lock();
+    struct s_handle_entry *e = lookup(h);
+    unsigned int pins = e ? e->pins : 0;
+    heap_unlock();
+    return pins;
+}
+
+static int can_slide(t_block f) {
+    t_block m = f->next;
+
+    if (!f->free || !m || m->free || !(m->flags & BLOCK_MOVABLE)) {
+        return 0;
+    }
+    // Solo se deslizan bloques contiguos: otro usuario de sbrk puede haber
+    // intercalado memoria propia entre ambos.
+    if ((char *)f->data + f->size != (char *)m) {
+        return 0;
+    }
+    return handle_table[*(t_handle *)m->data - 1].pins == 0;
+}
+
+/**
+ * Mueve el bloque que sigue a `f` a la dirección de `f` y deja el espacio
+ * libre detrás de él. Devuelve el bloque libre resultante, ya fusionado con
+ * el siguiente si también estaba libre.
+ */
+static t_block slide(t_block f) {
+    t_block m = f->next;
+    t_block prev = f->prev;
+    t_block after = m->next;
+    size_t free_size = f->size;
+    size_t moved_size = m->size;
+
+    verify_block_removed(m, f);
+    track_move(m->data, f->data);
+    memmove(f, m, BLOCK_SIZE + moved_size);
+
+    t_block moved = f;
+    moved->prev = prev;
+    moved->ptr = moved->data;
+
+    t_block hole = (t_block)((char *)moved->data + moved_size);
+    hole->size = free_size;
+    hole->free = 1;
+    hole->flags = 0;
+    hole->released = 0;
+    hole->ptr = hole->data;
+    hole->prev = moved;
+    hole->next = after;
+    moved->next = hole;
+    if (after) {
+        after->prev = hole;
+    }
+
+    handle_table[*(t_handle *)moved->data - 1].block = moved;
+
+    return fusion(hole);
+}
+
+size_t heap_compact(size_t max_moves) {
+    size_t moves = 0;
+
+    heap_lock();
+    t_block b = base;
+    while (b && (size_t)((char *)b - (char *)base) < compact_offset) {
+        b = b->next;
+    }
+
+    while (b && moves < max_moves) {
+        if (can_slide(b)) {
+            b = slide(b);
+            moves++;
+        } else {
+            b = b->next;
+        }
+    }
+
+    if (b) {
+        compact_offset = (char *)b - (char *)base;
+    } else {
+        compact_offset = 0;
+        heap_trim();
+    }
+    heap_unlock();
+
+    char additional_info[100];
+    snprintf(additional_info, sizeof(additional_info), "Moved %zu blocks%s", moves,
+             b ? "" : ", pass completed");
+    log_event("heap_compact", moves, NULL, additional_info);
+
+    return moves;
+}
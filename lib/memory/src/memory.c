@@ -4,6 +4,7 @@
 #include <memory.h>
 #include <unistd.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
@@ -18,43 +19,49 @@ int method = FIRST_FIT; // Cambiado para asignar un valor por defecto
 // Variables para el registro
 static FILE *log_file = NULL;
 static int logging_enabled = 1;
+static unsigned int log_sample_every = 1; // Registrar 1 de cada N eventos
+static unsigned int log_sample_count = 0;
 static pthread_mutex_t log_mutex = PTHREAD_MUTEX_INITIALIZER;
 
+// Mutex del heap. Es recursivo porque las operaciones compuestas (realloc,
+// handles, compactación) vuelven a entrar por my_malloc y my_free.
+static pthread_mutex_t heap_mutex;
+static pthread_once_t heap_mutex_once = PTHREAD_ONCE_INIT;
+
+static void heap_mutex_init(void) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&heap_mutex, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
 
-#define NUM_ITERATIONS 1000
-#define MIN_ALLOC_SIZE 16
-#define MAX_ALLOC_SIZE 256
-#define MAX_BLOCKS 50
-
-void simulate_memory_activity() {
-    static void* ptrs[100];
-    static int initialized = 0;
-
-    if (!initialized) {
-        for (int i = 0; i < 100; i++) {
-            ptrs[i] = NULL;
-        }
-        initialized = 1;
-    }
+void heap_lock(void) {
+    pthread_once(&heap_mutex_once, heap_mutex_init);
+    pthread_mutex_lock(&heap_mutex);
+}
 
-    for (int i = 0; i < 100; i++) {
-        if (ptrs[i] == NULL) {
-            size_t size = rand() % 1024 + 1; // Tamaños entre 1 y 1024 bytes
-            ptrs[i] = my_malloc(size);
-        } else if (rand() % 2 == 0) {
-            my_free(ptrs[i]);
-            ptrs[i] = NULL;
-        }
-    }
+void heap_unlock(void) {
+    pthread_mutex_unlock(&heap_mutex);
 }
 
+
 int initialize_logger(const char *filename) {
+    pthread_mutex_lock(&log_mutex);
     if (log_file != NULL) {
+        pthread_mutex_unlock(&log_mutex);
+        return 0;
+    }
+
+    if (strcmp(filename, "stderr") == 0) {
+        log_file = stderr;
+        pthread_mutex_unlock(&log_mutex);
         return 0;
     }
 
     log_file = fopen(filename, "a");
     if (!log_file) {
+        pthread_mutex_unlock(&log_mutex);
         perror("Failed to open log file");
         return -1;
     }
@@ -65,26 +72,42 @@ int initialize_logger(const char *filename) {
         fprintf(log_file, "=== Memory Allocator Event Log ===\n");
     }
 
+    pthread_mutex_unlock(&log_mutex);
     return 0;
 }
 
 void finalize_logger() {
+    pthread_mutex_lock(&log_mutex);
     if (log_file) {
-        fclose(log_file);
+        if (log_file != stderr) {
+            fclose(log_file);
+        }
         log_file = NULL;
     }
+    pthread_mutex_unlock(&log_mutex);
 }
 
 void set_logging(int enable) {
     logging_enabled = enable;
 }
 
+void set_log_sampling(unsigned int every) {
+    pthread_mutex_lock(&log_mutex);
+    log_sample_every = every ? every : 1;
+    log_sample_count = 0;
+    pthread_mutex_unlock(&log_mutex);
+}
+
 void log_event(const char *operation, size_t size, void *ptr, const char *additional) {
     if (!logging_enabled || !log_file) {
         return;
     }
 
     pthread_mutex_lock(&log_mutex);
+    if (!log_file || log_sample_count++ % log_sample_every != 0) {
+        pthread_mutex_unlock(&log_mutex);
+        return;
+    }
 
     time_t now = time(NULL);
     struct tm *t = localtime(&now);
@@ -179,12 +202,15 @@ void split_block(t_block b, size_t s){
         return;
     }
     
+    size_t released = split_released(b, s);
     t_block new = (t_block)((char *)b + BLOCK_SIZE + s);
     
     new->size = b->size - s - BLOCK_SIZE;
     new->next = b->next;
     new->prev = b;
     new->free = 1;
+    new->flags = released ? BLOCK_RELEASED : 0;
+    new->released = released;
     new->ptr = new->data;
     
     b->size = s;
@@ -203,6 +229,9 @@ t_block fusion(t_block b) {
     if (!b) return NULL;
 
     while (b->next && b->next->free) {
+        verify_block_removed(b->next, b);
+        b->flags |= b->next->flags & BLOCK_RELEASED;
+        b->released += b->next->released;
         b->size += BLOCK_SIZE + b->next->size;
         b->next = b->next->next;
         if (b->next) {
@@ -211,7 +240,10 @@ t_block fusion(t_block b) {
     }
 
     if (b->prev && b->prev->free) {
+        verify_block_removed(b, b->prev);
         b = b->prev;
+        b->flags |= b->next->flags & BLOCK_RELEASED;
+        b->released += b->next->released;
         b->size += BLOCK_SIZE + b->next->size;
         b->next = b->next->next;
         if (b->next) {
@@ -232,7 +264,7 @@ void copy_block(t_block src, t_block dst){
 t_block extend_heap(t_block last, size_t s) {
     t_block b;
 
-    b = sbrk(BLOCK_SIZE + s);
+    b = heap_sbrk(BLOCK_SIZE + s);
     if (b == (void*) -1) {
         perror("sbrk failed");
         log_event("extend_heap", s, NULL, "Failed to extend heap using sbrk");
@@ -243,6 +275,8 @@ t_block extend_heap(t_block last, size_t s) {
     b->next = NULL;
     b->prev = last;
     b->free = 0;
+    b->flags = 0;
+    b->released = 0;
     b->ptr = b->data;
 
     if (last) {
@@ -253,8 +287,57 @@ t_block extend_heap(t_block last, size_t s) {
 
     return b;
 }
+static size_t trim_locked(void) {
+    t_block last = base;
+
+    if (!last) {
+        return 0;
+    }
+    while (last->next) {
+        last = last->next;
+    }
+
+    if (!last->free || (char *)last->data + last->size != (char *)heap_sbrk(0)) {
+        return 0;
+    }
+
+    size_t released = BLOCK_SIZE + last->size;
+    verify_block_removed(last, last->prev);
+    if (last->prev) {
+        last->prev->next = NULL;
+    } else {
+        base = NULL;
+    }
+
+    if (heap_sbrk(-(intptr_t)released) == (void *)-1) {
+        perror("sbrk failed");
+        if (last->prev) {
+            last->prev->next = last;
+        } else {
+            base = last;
+        }
+        return 0;
+    }
+
+    log_event("heap_trim", released, NULL, "Trailing free block returned to the system");
+    return released;
+}
+
+size_t heap_trim(void) {
+    heap_lock();
+    size_t released = trim_locked();
+    heap_unlock();
+    return released;
+}
+
 void set_method(int m){
+    heap_lock();
     method = m;
+    heap_unlock();
+}
+
+int get_method(void) {
+    return method;
 }
 
 void malloc_control(int m){
@@ -319,7 +402,7 @@ void check_heap(void *data) {
         printf("Data address: NULL\n");
     }
 
-    printf("Heap address: %p\n", sbrk(0));
+    printf("Heap address: %p\n", heap_sbrk(0));
 }
 
 void check_heap_extended() {
@@ -390,7 +473,7 @@ void check_heap_extended() {
         }
     }
 
-    size_t heap_size = (char*)sbrk(0) - (char*)base;
+    size_t heap_size = (char*)heap_sbrk(0) - (char*)base;
     if (total_size > heap_size) {
         printf("Error: Total size of blocks (%zu bytes) exceeds heap size (%zu bytes).\n",
                total_size, heap_size);
@@ -417,7 +500,7 @@ void check_heap_extended() {
     }
 }
 
-void *my_malloc(size_t size) {
+static void *malloc_locked(size_t size) {
     t_block b, last = NULL;
     size_t s = align(size);
     void *result = NULL;
@@ -430,6 +513,8 @@ void *my_malloc(size_t size) {
                 split_block(b, s);
             }
             b->free = 0;
+            b->flags = 0;
+            b->released = 0;
             result = b->data;
 
             log_event(operation, size, result, "Block reused from free list");
@@ -459,7 +544,22 @@ void *my_malloc(size_t size) {
     return result;
 }
 
-void my_free(void *ptr) { 
+/** Asigna registrando `caller` como sitio de llamada (ver snapshot.h). */
+static void *malloc_from(size_t size, void *caller) {
+    malloc_init_config();
+    heap_lock();
+    void *result = malloc_locked(size);
+    track_alloc(result, caller);
+    verify_on_malloc();
+    heap_unlock();
+    return result;
+}
+
+void *my_malloc(size_t size) {
+    return malloc_from(size, __builtin_return_address(0));
+}
+
+static void free_locked(void *ptr) {
     if (!ptr) {
         log_event("free", 0, NULL, "Attempted to free NULL pointer");
         return;
@@ -473,14 +573,23 @@ void my_free(void *ptr) {
         }
         
         b->free = 1;
+        b->flags = 0;
+        b->released = 0;
+        track_free(ptr);
         
         log_event("free", b->size, ptr, "Block marked as free");
         
-        fusion(b);
+        scavenge_freed_block(fusion(b));
     } else {
         log_event("free", 0, ptr, "Attempted to free invalid pointer");
     }
 }
+
+void my_free(void *ptr) {
+    heap_lock();
+    free_locked(ptr);
+    heap_unlock();
+}
 void *my_calloc(size_t number, size_t size){
     void *new_block;
     size_t total_size;
@@ -491,7 +600,7 @@ void *my_calloc(size_t number, size_t size){
     }
 
     total_size = number * size;
-    new_block = my_malloc(total_size);
+    new_block = malloc_from(total_size, __builtin_return_address(0));
     if (new_block){
         memset(new_block, 0, total_size);
         log_event("calloc", total_size, new_block, "Block allocated and zero-initialized");
@@ -501,22 +610,24 @@ void *my_calloc(size_t number, size_t size){
     return new_block;
 }
 
-void *my_realloc(void *ptr, size_t size) { 
+static void *realloc_locked(void *ptr, size_t size, void *caller) {
     size_t s;
     t_block b;
     void *newp;
     const char *operation = "realloc";
 
     if (!ptr)
-        return my_malloc(size);
+        return malloc_from(size, caller);
 
     if (valid_addr(ptr)){
         b = get_block(ptr);
         s = align(size);
 
         if (b->size >= s){
-            if (b->size - s >= (BLOCK_SIZE + 8))
+            if (b->size - s >= (BLOCK_SIZE + 8)) {
                 split_block(b, s);
+                fusion(b->next); // El resto puede quedar junto a otro bloque libre
+            }
             log_event(operation, size, ptr, "Block resized without expanding");
             return ptr;
         } else {
@@ -527,7 +638,7 @@ void *my_realloc(void *ptr, size_t size) {
                 log_event(operation, size, ptr, "Block resized by merging with next free block");
                 return ptr;
             } else {
-                newp = my_malloc(s);
+                newp = malloc_from(s, caller);
                 if (!newp){
                     log_event(operation, size, NULL, "Failed to allocate new block during realloc");
                     return NULL;
@@ -543,6 +654,13 @@ void *my_realloc(void *ptr, size_t size) {
     return NULL;
 }
 
+void *my_realloc(void *ptr, size_t size) {
+    heap_lock();
+    void *result = realloc_locked(ptr, size, __builtin_return_address(0));
+    heap_unlock();
+    return result;
+}
+
 void memory_usage(size_t *allocated_size, size_t *free_size) {
     if (!allocated_size || !free_size) {
         printf("Error: Punteros NULL pasados a memory_usage.\n");
@@ -551,7 +669,9 @@ void memory_usage(size_t *allocated_size, size_t *free_size) {
 
     *allocated_size = 0;
     *free_size = 0;
+    size_t released_size = 0;
 
+    heap_lock();
     t_block current = base;
     int block_number = 0;
 
@@ -559,15 +679,19 @@ void memory_usage(size_t *allocated_size, size_t *free_size) {
         block_number++;
         if (current->free) {
             *free_size += current->size;
+            released_size += released_bytes(current);
         } else {
             *allocated_size += current->size;
         }
         current = current->next;
     }
+    heap_unlock();
 
     printf("\n\033[1;34mMemory Usage Report\033[0m\n");
     printf("Total Allocated Memory: %zu bytes\n", *allocated_size);
-    printf("Total Free Memory: %zu bytes\n\n", *free_size);
+    printf("Total Free Memory: %zu bytes\n", *free_size);
+    printf("  Resident: %zu bytes\n", *free_size - released_size);
+    printf("  Released: %zu bytes\n\n", released_size);
 
     char additional_info[100];
     snprintf(additional_info, sizeof(additional_info), "Allocated: %zu bytes, Free: %zu bytes", *allocated_size, *free_size);
@@ -578,6 +702,7 @@ double calculate_memory_fragmentation() {
     size_t total_free = 0;
     size_t largest_free_block = 0;
 
+    heap_lock();
     t_block current = base;
     while (current) {
         if (current->free) {
@@ -588,6 +713,7 @@ double calculate_memory_fragmentation() {
         }
         current = current->next;
     }
+    heap_unlock();
 
     if (total_free == 0) {
         return 0.0;
@@ -0,0 +1,130 @@
+// region.c
+//
+// Respaldo del heap del asignador. Por defecto se usa el break del proceso
+// (`sbrk`); opcionalmente, una región propia reservada con `mmap`, alineada a
+// HUGEPAGE_SIZE y habilitada en tramos de ese tamaño para que el kernel pueda
+// respaldarla con páginas enormes transparentes (THP).
+
+#include "memory.h"
+#include <errno.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/** Definido en memory.c: primer bloque del heap. */
+extern void *base;
+
+static int use_hugepages = 0;
+
+static char *region_start = NULL;     // Inicio alineado de la reserva
+static char *region_brk = NULL;       // Final lógico del heap
+static char *region_committed = NULL; // Final de la parte legible/escribible
+static char *region_limit = NULL;     // Final de la reserva
+
+static size_t hugepage_round(size_t n) {
+    return (n + HUGEPAGE_SIZE - 1) & ~(HUGEPAGE_SIZE - 1);
+}
+
+static int region_reserve(void) {
+    size_t len = HEAP_RESERVE + HUGEPAGE_SIZE;
+    char *p = mmap(NULL, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p == MAP_FAILED) {
+        perror("mmap failed");
+        log_event("heap_region", HEAP_RESERVE, NULL, "Failed to reserve heap region");
+        return -1;
+    }
+
+    // Se reserva un tramo extra para poder recortar el inicio hasta el
+    // siguiente múltiplo de HUGEPAGE_SIZE.
+    char *aligned = (char *)hugepage_round((uintptr_t)p);
+    if (aligned > p) {
+        munmap(p, aligned - p);
+    }
+    size_t tail = (size_t)((p + len) - (aligned + HEAP_RESERVE));
+    if (tail) {
+        munmap(aligned + HEAP_RESERVE, tail);
+    }
+
+    region_start = region_brk = region_committed = aligned;
+    region_limit = aligned + HEAP_RESERVE;
+
+    log_event("heap_region", HEAP_RESERVE, aligned, "Reserved huge page aligned heap region");
+    return 0;
+}
+
+static int region_commit(char *new_brk) {
+    size_t len = hugepage_round((size_t)(new_brk - region_committed));
+
+    if (mprotect(region_committed, len, PROT_READ | PROT_WRITE) == -1) {
+        return -1;
+    }
+    // Es solo una sugerencia: si THP está deshabilitado se usan páginas
+    // normales sin que sea un error.
+    madvise(region_committed, len, MADV_HUGEPAGE);
+
+    region_committed += len;
+    return 0;
+}
+
+static void region_decommit(char *new_brk) {
+    char *keep = region_start + hugepage_round((size_t)(new_brk - region_start));
+    if (keep >= region_committed) {
+        return;
+    }
+
+    // Reemplazar el tramo por uno nuevo sin acceso libera sus páginas.
+    if (mmap(keep, region_committed - keep, PROT_NONE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1, 0) != MAP_FAILED) {
+        region_committed = keep;
+    }
+}
+
+void *heap_sbrk(intptr_t increment) {
+    if (!use_hugepages) {
+        return sbrk(increment);
+    }
+
+    if (!region_start && region_reserve() == -1) {
+        errno = ENOMEM;
+        return (void *)-1;
+    }
+
+    char *old_brk = region_brk;
+    if (increment > 0) {
+        if ((size_t)increment > (size_t)(region_limit - region_brk)) {
+            errno = ENOMEM;
+            return (void *)-1;
+        }
+        char *new_brk = region_brk + increment;
+        if (new_brk > region_committed && region_commit(new_brk) == -1) {
+            return (void *)-1;
+        }
+        region_brk = new_brk;
+    } else if (increment < 0) {
+        if ((size_t)-increment > (size_t)(region_brk - region_start)) {
+            errno = EINVAL;
+            return (void *)-1;
+        }
+        region_brk += increment;
+        region_decommit(region_brk);
+    }
+
+    return old_brk;
+}
+
+int malloc_hugepages(int enable) {
+    // Con el mutex tomado ninguna asignación puede crear el heap entre la
+    // comprobación y el cambio de respaldo.
+    heap_lock();
+    if (base) {
+        heap_unlock();
+        log_event("malloc_hugepages", 0, NULL, "Heap already in use, backing unchanged");
+        return -1;
+    }
+    use_hugepages = enable ? 1 : 0;
+    heap_unlock();
+
+    log_event("malloc_hugepages", 0, NULL,
+              enable ? "Heap backed by huge page region" : "Heap backed by sbrk");
+    return 0;
+}
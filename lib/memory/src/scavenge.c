@@ -0,0 +1,189 @@
+// scavenge.c
+//
+// Devuelve al sistema las páginas físicas de los bloques libres grandes sin
+// mover el final del heap. Solo se libera la porción interior alineada a
+// página: la cabecera del bloque y los extremos parciales siguen residentes,
+// por lo que el bloque puede reutilizarse sin más llamadas al sistema.
+
+#include "memory.h"
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <time.h>
+
+/** Definido en memory.c: primer bloque del heap. */
+extern void *base;
+
+static size_t scavenge_threshold = SCAVENGE_THRESHOLD;
+static int scavenge_flags = 0;
+
+static pthread_t scavenger_thread;
+static int scavenger_running = 0;
+static unsigned int scavenger_interval_ms = 0;
+static pthread_mutex_t scavenger_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t scavenger_cond = PTHREAD_COND_INITIALIZER;
+
+/** Calcula la porción alineada a página de un área de datos. */
+static size_t interior_pages(char *data, size_t size, char **start) {
+    uintptr_t first = ((uintptr_t)data + PAGESIZE - 1) & ~(uintptr_t)(PAGESIZE - 1);
+    uintptr_t last = ((uintptr_t)data + size) & ~(uintptr_t)(PAGESIZE - 1);
+
+    *start = (char *)first;
+    return last > first ? last - first : 0;
+}
+
+static size_t release_block(t_block b) {
+    char *start;
+    size_t len = interior_pages(b->data, b->size, &start);
+    if (len <= b->released) {
+        return 0;
+    }
+
+    int advice = MADV_DONTNEED;
+#ifdef MADV_FREE
+    if (scavenge_flags & SCAVENGE_LAZY) {
+        advice = MADV_FREE;
+    }
+#endif
+    if (madvise(start, len, advice) == -1) {
+        // Kernels anteriores a 4.5 no conocen MADV_FREE.
+        if (errno != EINVAL || advice == MADV_DONTNEED ||
+            madvise(start, len, MADV_DONTNEED) == -1) {
+            return 0;
+        }
+    }
+
+    // Las páginas que ya estaban liberadas no cuentan como nuevas.
+    size_t newly = len - b->released;
+    b->flags |= BLOCK_RELEASED;
+    b->released = len;
+    return newly;
+}
+
+static int should_release(t_block b) {
+    char *start;
+    return scavenge_threshold && b->free && b->size >= scavenge_threshold &&
+           b->released < interior_pages(b->data, b->size, &start);
+}
+
+void malloc_scavenge_control(size_t threshold, int flags) {
+    heap_lock();
+    scavenge_threshold = threshold;
+    scavenge_flags = flags;
+    heap_unlock();
+
+    char additional_info[100];
+    snprintf(additional_info, sizeof(additional_info), "Threshold: %zu bytes, on free: %s, lazy: %s",
+             threshold, (flags & SCAVENGE_ON_FREE) ? "yes" : "no", (flags & SCAVENGE_LAZY) ? "yes" : "no");
+    log_event("malloc_scavenge_control", threshold, NULL, additional_info);
+}
+
+size_t released_bytes(t_block b) {
+    return b->free ? b->released : 0;
+}
+
+size_t split_released(t_block b, size_t s) {
+    if (!(b->flags & BLOCK_RELEASED)) {
+        return 0;
+    }
+
+    // Las páginas residentes pueden estar en cualquiera de las dos partes:
+    // cada una cuenta como liberado solo lo que no pueden cubrir.
+    char *start;
+    size_t resident = interior_pages(b->data, b->size, &start) - b->released;
+    size_t kept = interior_pages(b->data, s, &start);
+    size_t rest = interior_pages(b->data + s + BLOCK_SIZE, b->size - s - BLOCK_SIZE, &start);
+
+    b->released = kept > resident ? kept - resident : 0;
+    if (!b->released) {
+        b->flags &= ~BLOCK_RELEASED;
+    }
+    return rest > resident ? rest - resident : 0;
+}
+
+void scavenge_freed_block(t_block b) {
+    if ((scavenge_flags & SCAVENGE_ON_FREE) && should_release(b)) {
+        size_t released = release_block(b);
+        if (released) {
+            log_event("scavenge", released, b->data, "Released pages of freed block");
+        }
+    }
+}
+
+size_t heap_scavenge(void) {
+    size_t released = 0;
+
+    heap_lock();
+    for (t_block b = base; b; b = b->next) {
+        if (should_release(b)) {
+            released += release_block(b);
+        }
+    }
+    heap_unlock();
+
+    if (released) {
+        log_event("scavenge", released, NULL, "Released pages of large free blocks");
+    }
+    return released;
+}
+
+static void *scavenger_main(void *arg) {
+    (void)arg;
+
+    pthread_mutex_lock(&scavenger_mutex);
+    while (scavenger_running) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += scavenger_interval_ms / 1000;
+        deadline.tv_nsec += (long)(scavenger_interval_ms % 1000) * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+
+        if (pthread_cond_timedwait(&scavenger_cond, &scavenger_mutex, &deadline) == ETIMEDOUT &&
+            scavenger_running) {
+            pthread_mutex_unlock(&scavenger_mutex);
+            heap_scavenge();
+            pthread_mutex_lock(&scavenger_mutex);
+        }
+    }
+    pthread_mutex_unlock(&scavenger_mutex);
+    return NULL;
+}
+
+int start_scavenger(unsigned int interval_ms) {
+    pthread_mutex_lock(&scavenger_mutex);
+    if (scavenger_running) {
+        pthread_mutex_unlock(&scavenger_mutex);
+        return -1;
+    }
+    scavenger_running = 1;
+    scavenger_interval_ms = interval_ms ? interval_ms : 1;
+    pthread_mutex_unlock(&scavenger_mutex);
+
+    if (pthread_create(&scavenger_thread, NULL, scavenger_main, NULL) != 0) {
+        perror("pthread_create");
+        scavenger_running = 0;
+        return -1;
+    }
+
+    log_event("start_scavenger", interval_ms, NULL, "Background scavenger started");
+    return 0;
+}
+
+void stop_scavenger(void) {
+    pthread_mutex_lock(&scavenger_mutex);
+    if (!scavenger_running) {
+        pthread_mutex_unlock(&scavenger_mutex);
+        return;
+    }
+    scavenger_running = 0;
+    pthread_cond_signal(&scavenger_cond);
+    pthread_mutex_unlock(&scavenger_mutex);
+
+    pthread_join(scavenger_thread, NULL);
+    log_event("stop_scavenger", 0, NULL, "Background scavenger stopped");
+}
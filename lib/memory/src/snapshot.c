@@ -0,0 +1,414 @@
+// snapshot.c
+//
+// Seguimiento de asignaciones, instantáneas del heap y reporte de fugas. La
+// información de cada asignación se guarda en una tabla hash de direccionamiento
+// abierto indexada por puntero, en memoria de la libc para no alterar el heap
+// observado. Los ganchos track_* se invocan con el mutex del heap tomado.
+
+#include "snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** Definido en memory.c: primer bloque del heap. */
+extern void *base;
+
+/** Capacidad inicial de la tabla de seguimiento (potencia de 2). */
+#define TRACK_INITIAL (1 << 12)
+
+struct s_track {
+    void *ptr; /**< NULL si la entrada está vacía. */
+    void *caller;
+    uint64_t seq;
+    uint64_t time_ns;
+};
+
+static struct s_track *table = NULL;
+static size_t table_capacity = 0;
+static size_t table_used = 0;
+static uint64_t next_seq = 1;
+static int tracking = 0;
+
+static size_t slot_of(const void *p, size_t capacity) {
+    uint64_t h = (uint64_t)(uintptr_t)p;
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    return (size_t)h & (capacity - 1);
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static struct s_track *find(const void *p) {
+    if (!table) {
+        return NULL;
+    }
+    for (size_t i = slot_of(p, table_capacity);; i = (i + 1) & (table_capacity - 1)) {
+        if (table[i].ptr == p) {
+            return &table[i];
+        }
+        if (!table[i].ptr) {
+            return NULL;
+        }
+    }
+}
+
+static void insert(const struct s_track *t) {
+    size_t i = slot_of(t->ptr, table_capacity);
+    while (table[i].ptr && table[i].ptr != t->ptr) {
+        i = (i + 1) & (table_capacity - 1);
+    }
+    if (!table[i].ptr) {
+        table_used++;
+    }
+    table[i] = *t;
+}
+
+static int grow(void) {
+    size_t capacity = table_capacity ? table_capacity * 2 : TRACK_INITIAL;
+    struct s_track *old = table;
+    size_t old_capacity = table_capacity;
+
+    table = calloc(capacity, sizeof(*table));
+    if (!table) {
+        table = old;
+        return -1;
+    }
+    table_capacity = capacity;
+    table_used = 0;
+
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old[i].ptr) {
+            insert(&old[i]);
+        }
+    }
+    free(old);
+    return 0;
+}
+
+/** Borra por desplazamiento hacia atrás para no necesitar lápidas. */
+static void erase(struct s_track *t) {
+    size_t mask = table_capacity - 1;
+    size_t i = (size_t)(t - table);
+
+    for (size_t j = (i + 1) & mask; table[j].ptr; j = (j + 1) & mask) {
+        size_t k = slot_of(table[j].ptr, table_capacity);
+        // La entrada j puede ocupar el hueco i si su posición ideal k no
+        // está en el tramo circular (i, j].
+        if ((j > i && (k <= i || k > j)) || (j < i && k <= i && k > j)) {
+            table[i] = table[j];
+            i = j;
+        }
+    }
+    table[i].ptr = NULL;
+    table_used--;
+}
+
+void track_alloc(void *ptr, void *caller) {
+    if (!tracking || !ptr) {
+        return;
+    }
+    if ((table_used + 1) * 2 > table_capacity && grow() == -1) {
+        return;
+    }
+
+    struct s_track t = {ptr, caller, next_seq++, now_ns()};
+    insert(&t);
+}
+
+void track_free(void *ptr) {
+    struct s_track *t = find(ptr);
+    if (t) {
+        erase(t);
+    }
+}
+
+void track_move(void *from, void *to) {
+    struct s_track *t = find(from);
+    if (t) {
+        struct s_track moved = *t;
+        erase(t);
+        moved.ptr = to;
+        insert(&moved);
+    }
+}
+
+int heap_track(int enable) {
+    int status = 0;
+
+    heap_lock();
+    if (enable && !tracking) {
+        status = table ? 0 : grow();
+        tracking = status == 0;
+    } else if (!enable && tracking) {
+        tracking = 0;
+        free(table);
+        table = NULL;
+        table_capacity = table_used = 0;
+    }
+    heap_unlock();
+
+    log_event("heap_track", 0, NULL, enable ? "Allocation tracking enabled" : "Allocation tracking disabled");
+    return status;
+}
+
+struct s_heap_snapshot *heap_snapshot(void) {
+    struct s_heap_snapshot *s = calloc(1, sizeof(*s));
+    if (!s) {
+        return NULL;
+    }
+
+    heap_lock();
+    for (t_block b = base; b; b = b->next) {
+        s->count += !b->free;
+    }
+
+    s->entries = malloc((s->count ? s->count : 1) * sizeof(*s->entries));
+    if (!s->entries) {
+        heap_unlock();
+        free(s);
+        return NULL;
+    }
+
+    size_t n = 0;
+    for (t_block b = base; b; b = b->next) {
+        if (b->free) {
+            continue;
+        }
+        struct s_snapshot_entry *e = &s->entries[n++];
+        struct s_track *t = find(b->data);
+        e->ptr = b->data;
+        e->size = b->size;
+        e->seq = t ? t->seq : 0;
+        e->time_ns = t ? t->time_ns : 0;
+        e->caller = t ? t->caller : NULL;
+        s->bytes += b->size;
+    }
+    s->seq = next_seq;
+    heap_unlock();
+
+    return s;
+}
+
+void heap_snapshot_free(struct s_heap_snapshot *snapshot) {
+    if (snapshot) {
+        free(snapshot->entries);
+        free(snapshot);
+    }
+}
+
+/* Agregación por sitio de llamada. */
+
+struct s_site {
+    void *caller;
+    size_t new_blocks, new_bytes;
+    size_t freed_blocks, freed_bytes;
+    uint64_t oldest_ns; /**< Asignación más antigua entre los bloques nuevos. */
+    int used;
+};
+
+struct s_sites {
+    struct s_site *slots;
+    size_t capacity;
+    size_t count;
+};
+
+static struct s_site *site_of(struct s_sites *sites, void *caller) {
+    if ((sites->count + 1) * 2 > sites->capacity) {
+        struct s_sites bigger = {calloc(sites->capacity * 2, sizeof(struct s_site)),
+                                 sites->capacity * 2, 0};
+        if (!bigger.slots) {
+            return NULL;
+        }
+        for (size_t i = 0; i < sites->capacity; i++) {
+            if (sites->slots[i].used) {
+                *site_of(&bigger, sites->slots[i].caller) = sites->slots[i];
+            }
+        }
+        free(sites->slots);
+        *sites = bigger;
+    }
+
+    size_t i = slot_of(caller, sites->capacity);
+    while (sites->slots[i].used && sites->slots[i].caller != caller) {
+        i = (i + 1) & (sites->capacity - 1);
+    }
+    if (!sites->slots[i].used) {
+        sites->slots[i].used = 1;
+        sites->slots[i].caller = caller;
+        sites->count++;
+    }
+    return &sites->slots[i];
+}
+
+/** Suma un bloque nuevo a los totales y, si `sites` no es NULL, a su sitio. */
+static void add_new(struct s_sites *sites, const struct s_snapshot_entry *e, struct s_heap_diff *d) {
+    struct s_site *site = sites ? site_of(sites, e->caller) : NULL;
+    d->new_blocks++;
+    d->new_bytes += e->size;
+    if (site) {
+        site->new_blocks++;
+        site->new_bytes += e->size;
+        if (!site->oldest_ns || (e->time_ns && e->time_ns < site->oldest_ns)) {
+            site->oldest_ns = e->time_ns;
+        }
+    }
+}
+
+static void add_freed(struct s_sites *sites, const struct s_snapshot_entry *e, struct s_heap_diff *d) {
+    struct s_site *site = sites ? site_of(sites, e->caller) : NULL;
+    d->freed_blocks++;
+    d->freed_bytes += e->size;
+    if (site) {
+        site->freed_blocks++;
+        site->freed_bytes += e->size;
+    }
+}
+
+static size_t net_bytes(const struct s_site *s) {
+    return s->new_bytes > s->freed_bytes ? s->new_bytes - s->freed_bytes : s->freed_bytes - s->new_bytes;
+}
+
+static int compare_sites(const void *a, const void *b) {
+    size_t na = net_bytes(*(const struct s_site *const *)a);
+    size_t nb = net_bytes(*(const struct s_site *const *)b);
+    return na < nb ? 1 : na > nb ? -1 : 0;
+}
+
+/** Imprime los sitios con mayor variación neta de bytes. */
+static void print_sites(struct s_sites *sites, FILE *out, int leaks) {
+    struct s_site **order = malloc((sites->count ? sites->count : 1) * sizeof(*order));
+    if (!order) {
+        return;
+    }
+
+    size_t n = 0;
+    for (size_t i = 0; i < sites->capacity; i++) {
+        if (sites->slots[i].used) {
+            order[n++] = &sites->slots[i];
+        }
+    }
+    qsort(order, n, sizeof(*order), compare_sites);
+
+    uint64_t now = now_ns();
+    for (size_t i = 0; i < n && i < SNAPSHOT_MAX_SITES; i++) {
+        struct s_site *s = order[i];
+        if (leaks) {
+            fprintf(out, "  %zu bytes in %zu blocks from %p, oldest %.3fs ago\n", s->new_bytes,
+                    s->new_blocks, s->caller, s->oldest_ns ? (now - s->oldest_ns) / 1e9 : 0.0);
+        } else {
+            fprintf(out, "  +%zu bytes (+%zu blocks) -%zu bytes (-%zu blocks) from %p\n", s->new_bytes,
+                    s->new_blocks, s->freed_bytes, s->freed_blocks, s->caller);
+        }
+    }
+    if (n > SNAPSHOT_MAX_SITES) {
+        fprintf(out, "  ... and %zu more call sites\n", n - SNAPSHOT_MAX_SITES);
+    }
+    free(order);
+}
+
+static int same_block(const struct s_snapshot_entry *x, const struct s_snapshot_entry *y) {
+    return x->ptr == y->ptr && x->seq == y->seq && x->size == y->size;
+}
+
+struct s_heap_diff heap_diff(const struct s_heap_snapshot *a, const struct s_heap_snapshot *b,
+                             FILE *out) {
+    struct s_heap_diff d = {0, 0, 0, 0};
+    struct s_sites sites = {NULL, 0, 0};
+    size_t na = a ? a->count : 0;
+    size_t nb = b ? b->count : 0;
+    size_t i = 0, j = 0;
+
+    if (out) {
+        sites.capacity = 64;
+        sites.slots = calloc(sites.capacity, sizeof(*sites.slots));
+        if (!sites.slots) {
+            out = NULL;
+        }
+    }
+    struct s_sites *group = out ? &sites : NULL;
+
+    // Ambas instantáneas están ordenadas por dirección: se recorren a la par.
+    while (i < na || j < nb) {
+        const struct s_snapshot_entry *x = i < na ? &a->entries[i] : NULL;
+        const struct s_snapshot_entry *y = j < nb ? &b->entries[j] : NULL;
+
+        if (x && y && same_block(x, y)) {
+            i++;
+            j++;
+            continue;
+        }
+        if (x && (!y || (uintptr_t)x->ptr <= (uintptr_t)y->ptr)) {
+            add_freed(group, x, &d);
+            i++;
+        } else {
+            add_new(group, y, &d);
+            j++;
+        }
+    }
+
+    if (out) {
+        fprintf(out, "heap diff: +%zu blocks (+%zu bytes), -%zu blocks (-%zu bytes)\n", d.new_blocks,
+                d.new_bytes, d.freed_blocks, d.freed_bytes);
+        print_sites(&sites, out, 0);
+        free(sites.slots);
+    }
+    return d;
+}
+
+size_t heap_leak_report(FILE *out) {
+    struct s_heap_snapshot *s = heap_snapshot();
+    if (!s) {
+        return 0;
+    }
+
+    // Solo cuentan los bloques seguidos: los anteriores a heap_track no
+    // tienen sitio de llamada y pueden pertenecer al arranque del programa.
+    size_t n = 0;
+    for (size_t i = 0; i < s->count; i++) {
+        if (s->entries[i].seq) {
+            s->entries[n++] = s->entries[i];
+        }
+    }
+    s->count = n;
+
+    struct s_sites sites = {calloc(64, sizeof(struct s_site)), 64, 0};
+    struct s_heap_diff d = {0, 0, 0, 0};
+    if (sites.slots) {
+        for (size_t i = 0; i < s->count; i++) {
+            add_new(&sites, &s->entries[i], &d);
+        }
+        if (d.new_blocks) {
+            fprintf(out, "Leak report: %zu bytes in %zu blocks still allocated\n", d.new_bytes,
+                    d.new_blocks);
+            print_sites(&sites, out, 1);
+        }
+        free(sites.slots);
+    }
+
+    heap_snapshot_free(s);
+    return d.new_blocks;
+}
+
+static void leak_report_stderr(void) {
+    heap_leak_report(stderr);
+}
+
+int heap_leak_report_at_exit(void) {
+    static int registered = 0;
+
+    if (heap_track(1) == -1) {
+        return -1;
+    }
+    if (!registered) {
+        if (atexit(leak_report_stderr) != 0) {
+            return -1;
+        }
+        registered = 1;
+    }
+    return 0;
+}
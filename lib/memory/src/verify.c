@@ -0,0 +1,173 @@
+// verify.c
+//
+// Verificador incremental del heap. A diferencia de check_heap_extended, que
+// recorre toda la lista e imprime cada hallazgo, revisa un número acotado de
+// bloques por llamada, guarda un cursor para continuar y reporta las
+// violaciones mediante un contador y una función registrada.
+
+#include "memory.h"
+#include <stdint.h>
+
+/** Definido en memory.c: primer bloque del heap. */
+extern void *base;
+
+static t_block cursor = NULL; // Próximo bloque a revisar (NULL: desde base)
+static size_t total_errors = 0;
+static size_t total_passes = 0;
+
+static heap_verify_fn handler = NULL;
+static void *handler_arg = NULL;
+
+static unsigned int verify_period = 0;
+static unsigned int verify_countdown = 0;
+static size_t verify_budget = 0;
+
+static const char *const error_names[] = {
+    "ok",
+    "block outside heap bounds",
+    "invalid block size",
+    "ptr does not point to data",
+    "next->prev does not point back",
+    "list out of address order",
+    "block overlaps the next one",
+    "adjacent free blocks not fused",
+};
+
+static void report(int error, t_block b, size_t *errors) {
+    (*errors)++;
+    total_errors++;
+    if (handler) {
+        handler(error, b, handler_arg);
+    }
+}
+
+static int in_bounds(t_block b, char *heap_end) {
+    return (char *)b >= (char *)base && (char *)b->data <= heap_end &&
+           ((uintptr_t)b & (sizeof(void *) - 1)) == 0;
+}
+
+/**
+ * Revisa un bloque contra su siguiente. Devuelve el siguiente bloque a
+ * revisar, o NULL si terminó la lista o si el enlace no es confiable.
+ */
+static t_block check_block(t_block b, char *heap_end, size_t *errors) {
+    if (b->size == 0 || b->size != align(b->size) ||
+        (char *)b->data + b->size > heap_end) {
+        report(HEAP_ERR_SIZE, b, errors);
+    }
+    if (b->ptr != (void *)b->data) {
+        report(HEAP_ERR_PTR, b, errors);
+    }
+
+    t_block next = b->next;
+    if (!next) {
+        return NULL;
+    }
+    if (next <= b) {
+        report(HEAP_ERR_ORDER, b, errors);
+        return NULL;
+    }
+    if (!in_bounds(next, heap_end)) {
+        report(HEAP_ERR_BOUNDS, b, errors);
+        return NULL;
+    }
+    if (next->prev != b) {
+        report(HEAP_ERR_LINK, b, errors);
+    }
+    if ((char *)b->data + b->size > (char *)next) {
+        report(HEAP_ERR_OVERLAP, b, errors);
+    }
+    if (b->free && next->free) {
+        report(HEAP_ERR_UNFUSED, b, errors);
+    }
+    return next;
+}
+
+static size_t verify_locked(size_t max_blocks) {
+    size_t errors = 0;
+
+    if (!base) {
+        cursor = NULL;
+        return 0;
+    }
+
+    char *heap_end = heap_sbrk(0);
+    t_block b = cursor ? cursor : base;
+    if (!cursor && !in_bounds(b, heap_end)) {
+        report(HEAP_ERR_BOUNDS, b, &errors);
+        return errors;
+    }
+
+    for (size_t n = 0; n < max_blocks && b; n++) {
+        b = check_block(b, heap_end, &errors);
+    }
+
+    cursor = b;
+    if (!b) {
+        total_passes++;
+    }
+    return errors;
+}
+
+size_t heap_verify_step(size_t max_blocks) {
+    heap_lock();
+    size_t errors = verify_locked(max_blocks);
+    heap_unlock();
+
+    if (errors) {
+        log_event("heap_verify", errors, NULL, "Heap verification found violations");
+    }
+    return errors;
+}
+
+void heap_verify_every(unsigned int allocations, size_t max_blocks) {
+    heap_lock();
+    verify_period = allocations;
+    verify_countdown = allocations;
+    verify_budget = max_blocks;
+    heap_unlock();
+}
+
+void verify_on_malloc(void) {
+    if (verify_period && --verify_countdown == 0) {
+        verify_countdown = verify_period;
+        size_t errors = verify_locked(verify_budget);
+        if (errors) {
+            log_event("heap_verify", errors, NULL, "Periodic heap verification found violations");
+        }
+    }
+}
+
+void heap_verify_handler(heap_verify_fn fn, void *arg) {
+    heap_lock();
+    handler = fn;
+    handler_arg = arg;
+    heap_unlock();
+}
+
+size_t heap_verify_errors(void) {
+    heap_lock();
+    size_t errors = total_errors;
+    heap_unlock();
+    return errors;
+}
+
+size_t heap_verify_passes(void) {
+    heap_lock();
+    size_t passes = total_passes;
+    heap_unlock();
+    return passes;
+}
+
+const char *heap_verify_strerror(int error) {
+    if (error < 0 || (size_t)error >= sizeof(error_names) / sizeof(error_names[0])) {
+        return "unknown error";
+    }
+    return error_names[error];
+}
+
+void verify_block_removed(t_block removed, t_block survivor) {
+    if (cursor == removed) {
+        cursor = survivor;
+    }
+}
@@ -0,0 +1,290 @@
+// workload.c
+//
+// Generador de cargas sintéticas. Los objetos vivos se guardan en un montículo
+// binario ordenado por el instante de muerte (medido en asignaciones), así que
+// en cada paso se liberan en O(log n) los que vencieron antes de asignar el
+// siguiente. El seguimiento usa la libc para no alterar el heap medido.
+
+#include "workload.h"
+#include "memory.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/** Instante de muerte de los objetos permanentes. */
+#define NEVER UINT64_MAX
+
+#define TWO_PI 6.283185307179586
+
+/** Asignaciones por llamada a simulate_memory_activity. */
+#define SIMULATION_STEPS 100
+
+struct s_rng {
+    uint64_t state;
+};
+
+struct s_live {
+    uint64_t death; /**< Tick en el que se libera. */
+    void *ptr;
+    size_t size;
+};
+
+struct s_workload_state {
+    struct s_rng rng;
+    uint64_t tick;
+    struct s_live *live; /**< Montículo mínimo por `death`. */
+    size_t live_count;
+    size_t live_capacity;
+    size_t live_bytes;
+};
+
+// splitmix64: rápido, sin estados prohibidos y suficiente para simulación.
+static uint64_t rng_next(struct s_rng *rng) {
+    uint64_t z = (rng->state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/** Uniforme en (0, 1]. */
+static double rng_uniform(struct s_rng *rng) {
+    return ((rng_next(rng) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+/** Normal estándar por Box-Muller. */
+static double rng_normal(struct s_rng *rng) {
+    double u1 = rng_uniform(rng);
+    double u2 = rng_uniform(rng);
+    return sqrt(-2.0 * log(u1)) * cos(TWO_PI * u2);
+}
+
+static double sample(const struct s_distribution *d, struct s_rng *rng) {
+    double x;
+
+    switch (d->type) {
+    case DIST_FIXED:
+        x = d->mu;
+        break;
+    case DIST_UNIFORM:
+        x = d->min + rng_uniform(rng) * (d->max - d->min);
+        break;
+    case DIST_LOGNORMAL:
+        x = exp(d->mu + d->sigma * rng_normal(rng));
+        break;
+    case DIST_POWERLAW: {
+        double alpha = d->alpha > 1.0 ? d->alpha : 2.0;
+        double scale = d->min > 0 ? d->min : 1.0;
+        x = scale * pow(rng_uniform(rng), -1.0 / (alpha - 1.0));
+        break;
+    }
+    case DIST_BIMODAL:
+        if (rng_uniform(rng) <= d->weight) {
+            x = d->mu + d->sigma * rng_normal(rng);
+        } else {
+            x = d->mu2 + d->sigma2 * rng_normal(rng);
+        }
+        break;
+    case DIST_EXPONENTIAL:
+        x = -d->mu * log(rng_uniform(rng));
+        break;
+    case DIST_PERMANENT:
+    default:
+        return INFINITY;
+    }
+
+    if (x < d->min) {
+        x = d->min;
+    }
+    if (d->max > 0 && x > d->max) {
+        x = d->max;
+    }
+    return x;
+}
+
+static void live_swap(struct s_live *a, struct s_live *b) {
+    struct s_live t = *a;
+    *a = *b;
+    *b = t;
+}
+
+static int live_push(struct s_workload_state *s, struct s_live obj) {
+    if (s->live_count == s->live_capacity) {
+        size_t capacity = s->live_capacity ? s->live_capacity * 2 : 1024;
+        struct s_live *live = realloc(s->live, capacity * sizeof(*live));
+        if (!live) {
+            return -1;
+        }
+        s->live = live;
+        s->live_capacity = capacity;
+    }
+
+    size_t i = s->live_count++;
+    s->live[i] = obj;
+    while (i > 0 && s->live[(i - 1) / 2].death > s->live[i].death) {
+        live_swap(&s->live[(i - 1) / 2], &s->live[i]);
+        i = (i - 1) / 2;
+    }
+    s->live_bytes += obj.size;
+    return 0;
+}
+
+static struct s_live live_pop(struct s_workload_state *s) {
+    struct s_live top = s->live[0];
+    s->live[0] = s->live[--s->live_count];
+
+    size_t i = 0;
+    for (;;) {
+        size_t l = 2 * i + 1, r = l + 1, m = i;
+        if (l < s->live_count && s->live[l].death < s->live[m].death) {
+            m = l;
+        }
+        if (r < s->live_count && s->live[r].death < s->live[m].death) {
+            m = r;
+        }
+        if (m == i) {
+            break;
+        }
+        live_swap(&s->live[i], &s->live[m]);
+        i = m;
+    }
+    s->live_bytes -= top.size;
+    return top;
+}
+
+/** Libera los objetos vencidos y devuelve cuántos fueron. */
+static size_t free_expired(struct s_workload_state *s) {
+    size_t frees = 0;
+    while (s->live_count && s->live[0].death <= s->tick) {
+        my_free(live_pop(s).ptr);
+        frees++;
+    }
+    return frees;
+}
+
+static size_t free_all(struct s_workload_state *s) {
+    size_t frees = s->live_count;
+    while (s->live_count) {
+        my_free(live_pop(s).ptr);
+    }
+    return frees;
+}
+
+/**
+ * Avanza un tick: libera lo vencido y realiza una asignación de la fase.
+ * Devuelve 1 si asignó, 0 si my_malloc falló y -1 si no hubo memoria para
+ * seguir el objeto.
+ */
+static int step(struct s_workload_state *s, const struct s_phase *phase, size_t *frees) {
+    s->tick++;
+    *frees += free_expired(s);
+
+    double size = sample(&phase->size, &s->rng);
+    double lifetime = sample(&phase->lifetime, &s->rng);
+    struct s_live obj;
+
+    obj.size = size < 1.0 ? 1 : (size_t)size;
+    obj.death = lifetime >= (double)(NEVER - s->tick) ? NEVER : s->tick + (uint64_t)lifetime + 1;
+    obj.ptr = my_malloc(obj.size);
+    if (!obj.ptr) {
+        return 0;
+    }
+    if (live_push(s, obj) == -1) {
+        my_free(obj.ptr);
+        return -1;
+    }
+    return 1;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int workload_run(const struct s_workload *w, struct s_phase_result *results) {
+    struct s_workload_state s = {0};
+    int status = 0;
+
+    if (!w || !results || (w->num_phases && !w->phases)) {
+        return -1;
+    }
+    if (w->policy >= 0) {
+        malloc_control(w->policy);
+    }
+
+    s.rng.state = w->seed;
+    char *heap_start = heap_sbrk(0);
+
+    for (size_t i = 0; i < w->num_phases && status == 0; i++) {
+        const struct s_phase *phase = &w->phases[i];
+        struct s_phase_result *r = &results[i];
+        memset(r, 0, sizeof(*r));
+
+        double start = now();
+        for (size_t n = 0; n < phase->allocations; n++) {
+            int ret = step(&s, phase, &r->frees);
+            if (ret == -1) {
+                status = -1;
+                break;
+            }
+            if (ret == 1) {
+                r->allocations++;
+            } else {
+                r->failures++;
+            }
+        }
+        if (phase->free_all) {
+            r->frees += free_all(&s);
+        }
+        r->seconds = now() - start;
+
+        r->ops_per_sec = r->seconds > 0 ? (r->allocations + r->frees) / r->seconds : 0;
+        r->fragmentation = calculate_memory_fragmentation();
+        r->live_objects = s.live_count;
+        r->live_bytes = s.live_bytes;
+        r->heap_bytes = (size_t)((char *)heap_sbrk(0) - heap_start);
+
+        char additional_info[100];
+        snprintf(additional_info, sizeof(additional_info), "Phase '%s': %.0f ops/s, fragmentation %.3f",
+                 phase->name, r->ops_per_sec, r->fragmentation);
+        log_event("workload_run", r->allocations, NULL, additional_info);
+    }
+
+    free_all(&s);
+    free(s.live);
+    return status;
+}
+
+void workload_print_results(const struct s_workload *w, const struct s_phase_result *results) {
+    printf("%-16s %10s %10s %8s %12s %8s %10s %12s %12s\n", "phase", "allocs", "frees", "failed",
+           "ops/s", "frag", "live", "live_bytes", "heap_bytes");
+    for (size_t i = 0; i < w->num_phases; i++) {
+        const struct s_phase_result *r = &results[i];
+        printf("%-16s %10zu %10zu %8zu %12.0f %8.3f %10zu %12zu %12zu\n", w->phases[i].name,
+               r->allocations, r->frees, r->failures, r->ops_per_sec, r->fragmentation,
+               r->live_objects, r->live_bytes, r->heap_bytes);
+    }
+}
+
+void simulate_memory_activity() {
+    // Carga de fondo para el monitor: tamaños log-normales con mediana de 64
+    // bytes y vidas exponenciales de media 200 asignaciones, de modo que
+    // conviven objetos efímeros con algunos de larga duración.
+    static const struct s_phase background = {
+        .name = "background",
+        .size = {.type = DIST_LOGNORMAL, .min = 8, .max = 16384, .mu = 4.16, .sigma = 1.1},
+        .lifetime = {.type = DIST_EXPONENTIAL, .mu = 200},
+    };
+    static struct s_workload_state state = {.rng = {.state = 1}};
+    size_t frees = 0;
+
+    heap_lock();
+    for (int i = 0; i < SIMULATION_STEPS; i++) {
+        if (step(&state, &background, &frees) == -1) {
+            break;
+        }
+    }
+    heap_unlock();
+}
@@ -0,0 +1,195 @@
+// workload_spec.c
+//
+// Lectura de especificaciones de carga en JSON (ver workload_load en
+// workload.h). Está separado de workload.c para que el asignador no dependa
+// de cJSON: solo lo enlazan los ejecutables que cargan especificaciones.
+
+#include "workload.h"
+#include "memory.h"
+#include <cjson/cJSON.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct s_name {
+    const char *name;
+    int value;
+};
+
+static const struct s_name distributions[] = {
+    {"fixed", DIST_FIXED},       {"uniform", DIST_UNIFORM},         {"lognormal", DIST_LOGNORMAL},
+    {"powerlaw", DIST_POWERLAW}, {"bimodal", DIST_BIMODAL},         {"exponential", DIST_EXPONENTIAL},
+    {"permanent", DIST_PERMANENT},
+};
+
+static const struct s_name policies[] = {
+    {"first_fit", FIRST_FIT},
+    {"best_fit", BEST_FIT},
+    {"worst_fit", WORST_FIT},
+};
+
+static int lookup_name(const struct s_name *names, size_t count, const char *name) {
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(names[i].name, name) == 0) {
+            return names[i].value;
+        }
+    }
+    return -1;
+}
+
+static double get_number(const cJSON *object, const char *key, double fallback) {
+    const cJSON *item = cJSON_GetObjectItemCaseSensitive(object, key);
+    return cJSON_IsNumber(item) ? item->valuedouble : fallback;
+}
+
+static char *read_file(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size < 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    char *content = malloc((size_t)size + 1);
+    if (content) {
+        size_t n = fread(content, 1, (size_t)size, file);
+        content[n] = '\0';
+    }
+    fclose(file);
+    return content;
+}
+
+static int parse_distribution(const cJSON *json, struct s_distribution *d, const char *what,
+                              const char *phase) {
+    const cJSON *type = cJSON_GetObjectItemCaseSensitive(json, "distribution");
+
+    if (!cJSON_IsObject(json) || !cJSON_IsString(type)) {
+        fprintf(stderr, "workload: phase '%s': missing %s distribution\n", phase, what);
+        return -1;
+    }
+
+    d->type = lookup_name(distributions, sizeof(distributions) / sizeof(distributions[0]),
+                          type->valuestring);
+    if (d->type < 0) {
+        fprintf(stderr, "workload: phase '%s': unknown distribution '%s'\n", phase,
+                type->valuestring);
+        return -1;
+    }
+
+    d->min = get_number(json, "min", 0);
+    d->max = get_number(json, "max", 0);
+    d->mu = get_number(json, "mu", 0);
+    d->sigma = get_number(json, "sigma", 0);
+    d->alpha = get_number(json, "alpha", 2.0);
+    d->mu2 = get_number(json, "mu2", 0);
+    d->sigma2 = get_number(json, "sigma2", 0);
+    d->weight = get_number(json, "weight", 0.5);
+
+    // `value` y `mean` son alias más legibles de `mu`.
+    if (d->type == DIST_FIXED) {
+        d->mu = get_number(json, "value", d->mu);
+    } else if (d->type == DIST_EXPONENTIAL) {
+        d->mu = get_number(json, "mean", d->mu);
+    }
+    return 0;
+}
+
+static int parse_phase(const cJSON *json, struct s_phase *phase, size_t index) {
+    const cJSON *name = cJSON_GetObjectItemCaseSensitive(json, "name");
+    const cJSON *free_all = cJSON_GetObjectItemCaseSensitive(json, "free_all");
+
+    if (!cJSON_IsObject(json)) {
+        fprintf(stderr, "workload: phase %zu is not an object\n", index);
+        return -1;
+    }
+
+    if (cJSON_IsString(name)) {
+        snprintf(phase->name, sizeof(phase->name), "%s", name->valuestring);
+    } else {
+        snprintf(phase->name, sizeof(phase->name), "phase%zu", index);
+    }
+
+    double allocations = get_number(json, "allocations", -1);
+    if (allocations < 0) {
+        fprintf(stderr, "workload: phase '%s': missing allocations\n", phase->name);
+        return -1;
+    }
+    phase->allocations = (size_t)allocations;
+    phase->free_all = cJSON_IsTrue(free_all);
+
+    if (parse_distribution(cJSON_GetObjectItemCaseSensitive(json, "size"), &phase->size, "size",
+                           phase->name) == -1) {
+        return -1;
+    }
+    return parse_distribution(cJSON_GetObjectItemCaseSensitive(json, "lifetime"), &phase->lifetime,
+                              "lifetime", phase->name);
+}
+
+static int parse_workload(const cJSON *json, struct s_workload *w) {
+    const cJSON *policy = cJSON_GetObjectItemCaseSensitive(json, "policy");
+    const cJSON *phases = cJSON_GetObjectItemCaseSensitive(json, "phases");
+
+    w->seed = (uint64_t)get_number(json, "seed", 1);
+    w->policy = -1;
+    if (cJSON_IsString(policy)) {
+        w->policy = lookup_name(policies, sizeof(policies) / sizeof(policies[0]), policy->valuestring);
+        if (w->policy < 0) {
+            fprintf(stderr, "workload: unknown policy '%s'\n", policy->valuestring);
+            return -1;
+        }
+    }
+
+    if (!cJSON_IsArray(phases) || cJSON_GetArraySize(phases) == 0) {
+        fprintf(stderr, "workload: 'phases' must be a non-empty array\n");
+        return -1;
+    }
+
+    w->num_phases = (size_t)cJSON_GetArraySize(phases);
+    w->phases = calloc(w->num_phases, sizeof(*w->phases));
+    if (!w->phases) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < w->num_phases; i++) {
+        if (parse_phase(cJSON_GetArrayItem(phases, (int)i), &w->phases[i], i) == -1) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int workload_load(const char *path, struct s_workload *w) {
+    memset(w, 0, sizeof(*w));
+
+    char *content = read_file(path);
+    if (!content) {
+        return -1;
+    }
+
+    cJSON *json = cJSON_Parse(content);
+    free(content);
+    if (!json) {
+        fprintf(stderr, "workload: invalid JSON in %s\n", path);
+        return -1;
+    }
+
+    int status = parse_workload(json, w);
+    cJSON_Delete(json);
+    if (status == -1) {
+        workload_free(w);
+    }
+    return status;
+}
+
+void workload_free(struct s_workload *w) {
+    free(w->phases);
+    w->phases = NULL;
+    w->num_phases = 0;
+}
@@ -0,0 +1,401 @@
+// admission.c
+//
+// Este archivo contiene la cola de admisión de los trabajos en segundo plano
+// y el comando interno `admission`.
+
+#include "admission.h"
+#include "arena.h"
+#include "event_loop.h"
+#include "executor.h"
+#include "jobs.h"
+#include "monitorHandle.h"
+#include "schedctl.h"
+
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ADMISSION_POLL_MS 250   // Revisión de la cola sin eventos
+#define ADMISSION_SAMPLE_MS 250 // Intervalo mínimo entre lecturas de /proc
+
+/**
+ * @brief Límites de admisión; un valor negativo no limita.
+ */
+static struct {
+  int max_jobs;       /**< Trabajos en ejecución. */
+  double max_cpu;     /**< Uso de CPU, en porcentaje. */
+  double min_free_mb; /**< Memoria libre, en MB. */
+} limits = {-1, -1, -1};
+
+/**
+ * @brief Última muestra de carga.
+ */
+static struct {
+  double cpu_usage;       /**< Uso de CPU en porcentaje, o -1 si no se sabe. */
+  double free_mb;         /**< Memoria libre en MB, o -1 si no se sabe. */
+  unsigned long seq;      /**< Cantidad de muestras tomadas. */
+  unsigned long admitted; /**< Muestra con la que se admitió el último. */
+  const char *source;     /**< "monitor" o "/proc". */
+  struct timespec taken;  /**< Momento de la última lectura de /proc. */
+  unsigned long long cpu_total, cpu_idle; /**< Contadores de /proc/stat. */
+} load = {-1, -1, 0, (unsigned long)-1, "/proc", {0, 0}, 0, 0};
+
+/**
+ * @brief Un trabajo en cola y el texto con el que se lanzará (ver
+ * node_source()).
+ */
+struct s_entry {
+  struct s_job *job; /**< Trabajo, o NULL si salió antes de su turno. */
+  char *source;      /**< Contenido de `lista &`, reservado con malloc. */
+};
+
+// Trabajos en cola, en orden de llegada
+static struct s_entry *queue;
+static size_t queue_head, queue_tail, queue_capacity;
+static int queued_count;
+
+static int launching; // Evita volver a encolar lo que lanza la cola
+
+static int admission_enabled(void) {
+  return limits.max_jobs >= 0 || limits.max_cpu >= 0 ||
+         limits.min_free_mb >= 0;
+}
+
+/** Lee el uso de CPU desde la lectura anterior de /proc/stat. */
+static void read_proc_cpu(void) {
+  unsigned long long v[8] = {0};
+  FILE *fp = fopen("/proc/stat", "r");
+  if (fp == NULL) {
+    return;
+  }
+  int n = fscanf(fp, "cpu %llu %llu %llu %llu %llu %llu %llu %llu", &v[0],
+                 &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]);
+  fclose(fp);
+  if (n < 4) {
+    return;
+  }
+
+  unsigned long long total = 0;
+  for (int i = 0; i < 8; i++) {
+    total += v[i];
+  }
+  unsigned long long idle = v[3] + v[4]; // idle + iowait
+  if (load.cpu_total != 0 && total > load.cpu_total) {
+    load.cpu_usage = 100.0 * (1.0 - (double)(idle - load.cpu_idle) /
+                                        (double)(total - load.cpu_total));
+  }
+  load.cpu_total = total;
+  load.cpu_idle = idle;
+}
+
+/** Lee la memoria disponible de /proc/meminfo. */
+static void read_proc_memory(void) {
+  char line[128];
+  FILE *fp = fopen("/proc/meminfo", "r");
+  if (fp == NULL) {
+    return;
+  }
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    unsigned long long kb;
+    if (sscanf(line, "MemAvailable: %llu kB", &kb) == 1) {
+      load.free_mb = (double)kb / 1024.0;
+      break;
+    }
+  }
+  fclose(fp);
+}
+
+/** Actualiza la muestra de carga: del monitor si informa, si no de /proc. */
+static void sample_load(void) {
+  double cpu_usage, free_mb;
+  int result = monitor_load(&cpu_usage, &free_mb);
+  if (result != -1) {
+    load.source = "monitor";
+    load.cpu_usage = cpu_usage;
+    load.free_mb = free_mb;
+    load.seq += result;
+    return;
+  }
+
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  long elapsed_ms = (now.tv_sec - load.taken.tv_sec) * 1000 +
+                    (now.tv_nsec - load.taken.tv_nsec) / 1000000;
+  if (load.seq > 0 && strcmp(load.source, "/proc") == 0 &&
+      elapsed_ms < ADMISSION_SAMPLE_MS) {
+    return;
+  }
+  load.source = "/proc";
+  load.taken = now;
+  read_proc_cpu();
+  read_proc_memory();
+  load.seq++;
+}
+
+/** Indica si un trabajo más entra en los límites. */
+static int can_admit(void) {
+  if (limits.max_jobs >= 0 && running_jobs() >= limits.max_jobs) {
+    return 0;
+  }
+  if (limits.max_cpu < 0 && limits.min_free_mb < 0) {
+    return 1;
+  }
+
+  sample_load();
+  // La muestra con la que se admitió el último trabajo todavía no lo refleja
+  if (load.seq == load.admitted) {
+    return 0;
+  }
+  // Una métrica que no se conoce no limita
+  if (limits.max_cpu >= 0 && load.cpu_usage >= 0 &&
+      load.cpu_usage > limits.max_cpu) {
+    return 0;
+  }
+  if (limits.min_free_mb >= 0 && load.free_mb >= 0 &&
+      load.free_mb < limits.min_free_mb) {
+    return 0;
+  }
+  return 1;
+}
+
+/** Registra que se admitió un trabajo con la muestra actual. */
+static void note_admitted(void) {
+  if (limits.max_cpu >= 0 || limits.min_free_mb >= 0) {
+    load.admitted = load.seq;
+  }
+}
+
+static int queue_push(struct s_job *job, char *source) {
+  if (queue_tail == queue_capacity) {
+    // Primero se recupera el espacio de los que ya salieron
+    if (queue_head > 0) {
+      memmove(queue, queue + queue_head,
+              (queue_tail - queue_head) * sizeof(*queue));
+      queue_tail -= queue_head;
+      queue_head = 0;
+    }
+    if (queue_tail == queue_capacity) {
+      size_t capacity = queue_capacity ? 2 * queue_capacity : 16;
+      struct s_entry *grown = realloc(queue, capacity * sizeof(*grown));
+      if (grown == NULL) {
+        return -1;
+      }
+      queue = grown;
+      queue_capacity = capacity;
+    }
+  }
+  queue[queue_tail++] = (struct s_entry){job, source};
+  queued_count++;
+  return 0;
+}
+
+/** Primer trabajo de la cola, sin sacarlo. */
+static struct s_job *queue_first(void) {
+  while (queue_head < queue_tail && queue[queue_head].job == NULL) {
+    queue_head++;
+  }
+  return queue_head < queue_tail ? queue[queue_head].job : NULL;
+}
+
+/** Saca un trabajo de la cola y devuelve su texto, o NULL si no estaba. */
+static char *queue_take(struct s_job *job) {
+  char *source = NULL;
+  for (size_t i = queue_head; i < queue_tail; i++) {
+    if (queue[i].job == job) {
+      source = queue[i].source;
+      queue[i].job = NULL;
+      queued_count--;
+      break;
+    }
+  }
+  if (queued_count == 0) {
+    queue_head = queue_tail = 0;
+    monitor_load_close(); // Nadie más necesita las muestras
+  }
+  return source;
+}
+
+void admission_forget(struct s_job *job) { free(queue_take(job)); }
+
+/** Quita de la tabla un trabajo en cola que no va a lanzarse. */
+static void discard_job(struct s_job *job) {
+  job_reserve(job);
+  job_end_reserve(); // Una reserva que no se usó quita el trabajo
+}
+
+int admission_queued(void) { return queued_count; }
+
+int admission_timeout(void) {
+  return queued_count > 0 ? ADMISSION_POLL_MS : -1;
+}
+
+/**
+ * Texto con el que se lanzará un trabajo: los prefijos que lo abarcan (ver
+ * schedctl.h) ya no van a regir cuando le toque.
+ */
+static char *queued_source(struct s_node *body) {
+  char *source = node_source(body);
+  char *prefixes = schedctl_text();
+  if (source == NULL || prefixes == NULL) {
+    free(prefixes);
+    return source;
+  }
+
+  char *text = malloc(strlen(prefixes) + strlen(source) + 2);
+  if (text != NULL) {
+    sprintf(text, "%s %s", prefixes, source);
+  }
+  free(prefixes);
+  free(source);
+  return text;
+}
+
+int admission_defer(struct s_node *body) {
+  // En un hijo de la shell no hay bucle que atienda la cola
+  if (!admission_enabled() || launching || !event_loop_active()) {
+    return 0;
+  }
+  if (queued_count == 0 && can_admit()) {
+    note_admitted();
+    return 0;
+  }
+
+  char *text = node_text(body);
+  char *source = queued_source(body);
+  struct s_job *job = text && source ? job_create_queued(text) : NULL;
+  free(text);
+  if (job == NULL || queue_push(job, source) == -1) {
+    // Sin memoria para encolarlo, se lanza sin esperar
+    if (job != NULL) {
+      discard_job(job);
+    }
+    free(source);
+    return 0;
+  }
+  printf("[%d] en cola\n", job_id(job));
+  return 1;
+}
+
+int admission_start(struct s_job *job) {
+  struct s_arena arena;
+  int running = 1;
+  int status = 1;
+
+  char *source = queue_take(job);
+  arena_init(&arena);
+  struct s_node *body = source ? parse_line(source, &arena) : NULL;
+  if (body != NULL) {
+    // Se ejecuta en segundo plano con el número que ya tenía
+    struct s_node background = {.type = NODE_BACKGROUND, .body = body};
+    launching = 1;
+    job_reserve(job);
+    status = execute_node(&background, &running);
+    job_end_reserve();
+    launching = 0;
+  } else {
+    fprintf(stderr, "admission: [%d] %s: no se pudo lanzar\n", job_id(job),
+            source ? source : "sin texto");
+    discard_job(job);
+  }
+  arena_destroy(&arena);
+  free(source);
+  return status;
+}
+
+int admit_jobs(void) {
+  int admitted = 0;
+
+  if (launching || queued_count == 0 || !event_loop_active()) {
+    return 0;
+  }
+  while (queued_count > 0 && can_admit()) {
+    struct s_job *job = queue_first();
+    note_admitted();
+    admission_start(job);
+    admitted++;
+  }
+  return admitted;
+}
+
+/** Lee un límite numérico entre `min` y `max`. */
+static int parse_limit(const char *option, const char *value, double min,
+                       double max, double *limit) {
+  char *end;
+  double number = value ? strtod(value, &end) : -1;
+  if (value == NULL || *end != '\0' || end == value || number < min ||
+      number > max) {
+    fprintf(stderr, "admission: %s: valor inválido\n", option);
+    return -1;
+  }
+  *limit = number;
+  return 0;
+}
+
+int admission_command(char **args) {
+  if (args[1] == NULL) {
+    if (!admission_enabled()) {
+      printf("Admisión desactivada\n");
+    } else {
+      printf("Admisión:");
+      if (limits.max_jobs >= 0) {
+        printf(" trabajos <= %d", limits.max_jobs);
+      }
+      if (limits.max_cpu >= 0) {
+        printf(" CPU <= %.1f%%", limits.max_cpu);
+      }
+      if (limits.min_free_mb >= 0) {
+        printf(" memoria libre >= %.0f MB", limits.min_free_mb);
+      }
+      printf("\n");
+    }
+    sample_load();
+    printf("Carga (%s): CPU ", load.source);
+    if (load.cpu_usage >= 0) {
+      printf("%.1f%%", load.cpu_usage);
+    } else {
+      printf("desconocida");
+    }
+    printf(", memoria libre %.0f MB, trabajos en ejecución %d, en cola %d\n",
+           load.free_mb, running_jobs(), queued_count);
+    return 0;
+  }
+
+  if (strcmp(args[1], "off") == 0 && args[2] == NULL) {
+    limits.max_jobs = -1;
+    limits.max_cpu = -1;
+    limits.min_free_mb = -1;
+    admit_jobs(); // Sin límites, sale toda la cola
+    return 0;
+  }
+
+  // Se validan todos antes de aplicar alguno
+  double max_jobs = limits.max_jobs, max_cpu = limits.max_cpu,
+         min_free_mb = limits.min_free_mb;
+  for (int i = 1; args[i] != NULL; i++) {
+    double *limit = strcmp(args[i], "-j") == 0   ? &max_jobs
+                    : strcmp(args[i], "-c") == 0 ? &max_cpu
+                    : strcmp(args[i], "-m") == 0 ? &min_free_mb
+                                                 : NULL;
+    if (limit == NULL) {
+      fprintf(stderr, "admission: uso: admission [-j N] [-c %%CPU] [-m MB] "
+                      "| admission off\n");
+      return 2;
+    }
+    double min = limit == &max_jobs ? 1 : 0;
+    double max = limit == &max_cpu ? 100 : limit == &max_jobs ? INT_MAX : 1e12;
+    if (parse_limit(args[i], args[i + 1], min, max, limit) == -1) {
+      return 2;
+    }
+    i++;
+  }
+  limits.max_jobs = (int)max_jobs;
+  limits.max_cpu = max_cpu;
+  limits.min_free_mb = min_free_mb;
+  if (limits.max_cpu >= 0) {
+    sample_load(); // Con una lectura previa, la primera muestra ya sirve
+  }
+  admit_jobs(); // Los límites nuevos pueden dejar pasar a algunos
+  return 0;
+}
@@ -0,0 +1,79 @@
+// alloc_config.c
+//
+// Este archivo contiene la lectura de la clave `allocation_method` de
+// config.json y su exportación como configuración del asignador de memoria.
+
+#include "alloc_config.h"
+#include <cjson/cJSON.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Métodos de asignación aceptados en config.json.
+ */
+static const char *const allocation_methods[] = {"first_fit", "best_fit",
+                                                 "worst_fit"};
+
+static char *read_file(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (file == NULL) {
+    return NULL;
+  }
+
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  if (size < 0) {
+    fclose(file);
+    return NULL;
+  }
+
+  char *content = malloc((size_t)size + 1);
+  if (content != NULL) {
+    size_t read = fread(content, 1, (size_t)size, file);
+    content[read] = '\0';
+  }
+  fclose(file);
+  return content;
+}
+
+int export_allocator_config(const char *config_path) {
+  if (getenv(ALLOC_CONF_ENV) != NULL) {
+    return 0; // La variable de entorno tiene prioridad
+  }
+
+  char *content = read_file(config_path);
+  if (content == NULL) {
+    return -1;
+  }
+
+  cJSON *json = cJSON_Parse(content);
+  free(content);
+  if (json == NULL) {
+    fprintf(stderr, "Error al parsear %s\n", config_path);
+    return -1;
+  }
+
+  int result = 0;
+  cJSON *method = cJSON_GetObjectItem(json, "allocation_method");
+  if (cJSON_IsString(method)) {
+    result = -1;
+    for (size_t i = 0;
+         i < sizeof(allocation_methods) / sizeof(allocation_methods[0]); i++) {
+      if (strcmp(method->valuestring, allocation_methods[i]) == 0) {
+        char conf[64];
+        snprintf(conf, sizeof(conf), "policy:%s", allocation_methods[i]);
+        result = setenv(ALLOC_CONF_ENV, conf, 0) == 0 ? 1 : -1;
+        break;
+      }
+    }
+    if (result == -1) {
+      fprintf(stderr, "allocation_method inválido en %s: %s\n", config_path,
+              method->valuestring);
+    }
+  }
+
+  cJSON_Delete(json);
+  return result;
+}
@@ -0,0 +1,89 @@
+// arena.c
+//
+// Este archivo contiene la arena de memoria en la que viven los tokens y el
+// árbol sintáctico de cada línea de comandos.
+
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** Alineación de las asignaciones. */
+#define ARENA_ALIGN (sizeof(void *) > sizeof(double) ? sizeof(void *) : sizeof(double))
+
+/**
+ * @struct s_arena_chunk
+ * @brief Bloque de memoria de la arena.
+ */
+struct s_arena_chunk {
+  struct s_arena_chunk *next; /**< Bloque anterior. */
+  size_t size;                /**< Bytes utilizables en `data`. */
+  size_t used;                /**< Bytes ya repartidos. */
+  char data[];                /**< Memoria que se reparte. */
+};
+
+static struct s_arena_chunk *new_chunk(size_t size) {
+  struct s_arena_chunk *chunk = malloc(sizeof(*chunk) + size);
+  if (chunk) {
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+  }
+  return chunk;
+}
+
+void arena_init(struct s_arena *arena) { arena->head = NULL; }
+
+void *arena_alloc(struct s_arena *arena, size_t size) {
+  size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+  struct s_arena_chunk *chunk = arena->head;
+  if (!chunk || chunk->size - chunk->used < size) {
+    chunk = new_chunk(size > ARENA_CHUNK_SIZE ? size : ARENA_CHUNK_SIZE);
+    if (!chunk) {
+      return NULL;
+    }
+    chunk->next = arena->head;
+    arena->head = chunk;
+  }
+
+  void *p = chunk->data + chunk->used;
+  chunk->used += size;
+  return p;
+}
+
+char *arena_strndup(struct s_arena *arena, const char *s, size_t len) {
+  char *copy = arena_alloc(arena, len + 1);
+  if (copy) {
+    memcpy(copy, s, len);
+    copy[len] = '\0';
+  }
+  return copy;
+}
+
+void arena_reset(struct s_arena *arena) {
+  struct s_arena_chunk *chunk = arena->head;
+  if (!chunk) {
+    return;
+  }
+  // Se conserva el bloque más antiguo si es de tamaño normal
+  while (chunk->next) {
+    struct s_arena_chunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  if (chunk->size > ARENA_CHUNK_SIZE) {
+    free(chunk);
+    chunk = NULL;
+  } else {
+    chunk->used = 0;
+  }
+  arena->head = chunk;
+}
+
+void arena_destroy(struct s_arena *arena) {
+  while (arena->head) {
+    struct s_arena_chunk *next = arena->head->next;
+    free(arena->head);
+    arena->head = next;
+  }
+}
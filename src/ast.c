@@ -0,0 +1,525 @@
+// ast.c
+//
+// Este archivo contiene el analizador descendente recursivo que construye el
+// árbol sintáctico de una línea de comandos.
+
+#include "ast.h"
+#include "lexer.h"
+#include "schedctl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Cierre que termina una lista.
+ */
+enum e_list_end { END_LINE, END_PAREN, END_BRACE };
+
+/**
+ * @struct s_parser
+ * @brief Estado del análisis: el lexer y un token de anticipación.
+ */
+struct s_parser {
+  struct s_lexer lexer;  /**< Analizador léxico de la línea. */
+  struct s_token token;  /**< Token actual. */
+  struct s_arena *arena; /**< Arena de la línea. */
+  int failed;            /**< Ya se informó un error (o no hay que informarlo). */
+};
+
+static struct s_node *parse_list(struct s_parser *p, enum e_list_end end);
+static struct s_node *parse_pipeline(struct s_parser *p);
+
+static void advance(struct s_parser *p) { lexer_next(&p->lexer, &p->token); }
+
+static struct s_node *syntax_error(struct s_parser *p) {
+  if (!p->failed) {
+    if (p->token.type == TOKEN_ERROR) {
+      fprintf(stderr, "Error de sintaxis: %s\n", p->token.text);
+    } else {
+      fprintf(stderr, "Error de sintaxis cerca de '%s'\n", p->token.text);
+    }
+    p->failed = 1;
+  }
+  return NULL;
+}
+
+static struct s_node *new_node(struct s_parser *p, enum e_node_type type) {
+  struct s_node *node = arena_alloc(p->arena, sizeof(*node));
+  if (node) {
+    memset(node, 0, sizeof(*node));
+    node->type = type;
+  } else if (!p->failed) {
+    perror("Error de memoria");
+    p->failed = 1;
+  }
+  return node;
+}
+
+static struct s_node *new_binary(struct s_parser *p, enum e_node_type type,
+                                 struct s_node *left, struct s_node *right) {
+  struct s_node *node = new_node(p, type);
+  if (node) {
+    node->left = left;
+    node->right = right;
+  }
+  return node;
+}
+
+/** Agrega un puntero a un vector de la arena, duplicando su capacidad. */
+static void **push(struct s_parser *p, void **vec, int count, int *cap,
+                   void *item) {
+  if (count + 1 >= *cap) {
+    int new_cap = *cap ? *cap * 2 : 8;
+    void **grown = arena_alloc(p->arena, new_cap * sizeof(void *));
+    if (!grown) {
+      return NULL;
+    }
+    if (count) {
+      memcpy(grown, vec, count * sizeof(void *));
+    }
+    vec = grown;
+    *cap = new_cap;
+  }
+  vec[count] = item;
+  vec[count + 1] = NULL;
+  return vec;
+}
+
+static int is_reserved(const struct s_parser *p, const char *word) {
+  return p->token.type == TOKEN_WORD && !p->token.quoted &&
+         strcmp(p->token.text, word) == 0;
+}
+
+static int is_redirect(const struct s_parser *p) {
+  return p->token.type == TOKEN_LESS || p->token.type == TOKEN_GREAT ||
+         p->token.type == TOKEN_DGREAT;
+}
+
+/** Lee una redirección y la agrega al final de `*tail`. */
+static int parse_redirect(struct s_parser *p, struct s_redirect ***tail) {
+  struct s_redirect *r = arena_alloc(p->arena, sizeof(*r));
+  if (!r) {
+    return -1;
+  }
+  r->type = p->token.type == TOKEN_LESS    ? REDIRECT_IN
+            : p->token.type == TOKEN_GREAT ? REDIRECT_OUT
+                                           : REDIRECT_APPEND;
+  r->fd = p->token.fd;
+  r->next = NULL;
+
+  advance(p);
+  if (p->token.type != TOKEN_WORD) {
+    syntax_error(p);
+    return -1;
+  }
+  r->target = p->token.text;
+  advance(p);
+
+  **tail = r;
+  *tail = &r->next;
+  return 0;
+}
+
+static struct s_node *parse_simple(struct s_parser *p) {
+  struct s_node *node = new_node(p, NODE_COMMAND);
+  struct s_redirect **tail;
+  int cap = 0;
+
+  if (!node) {
+    return NULL;
+  }
+  tail = &node->redirects;
+
+  while (p->token.type == TOKEN_WORD || is_redirect(p)) {
+    if (is_redirect(p)) {
+      if (parse_redirect(p, &tail) == -1) {
+        return NULL;
+      }
+      continue;
+    }
+    node->argv = (char **)push(p, (void **)node->argv, node->argc, &cap,
+                               p->token.text);
+    if (!node->argv) {
+      return NULL;
+    }
+    node->argc++;
+    advance(p);
+  }
+
+  if (node->argc == 0 && node->redirects == NULL) {
+    return syntax_error(p);
+  }
+  if (node->argc == 0) {
+    // Solo redirecciones (`> archivo`): se ejecutan como un comando vacío
+    node->argv = arena_alloc(p->arena, sizeof(char *));
+    if (!node->argv) {
+      return NULL;
+    }
+    node->argv[0] = NULL;
+  }
+  return node;
+}
+
+/** `( lista )` o `{ lista }` seguidos de redirecciones. */
+static struct s_node *parse_compound(struct s_parser *p, enum e_node_type type) {
+  struct s_node *node = new_node(p, type);
+  if (!node) {
+    return NULL;
+  }
+
+  advance(p);
+  node->body = parse_list(p, type == NODE_SUBSHELL ? END_PAREN : END_BRACE);
+  if (!node->body) {
+    return NULL;
+  }
+  if (type == NODE_SUBSHELL ? p->token.type != TOKEN_RPAREN
+                            : !is_reserved(p, "}")) {
+    return syntax_error(p);
+  }
+  advance(p);
+
+  struct s_redirect **tail = &node->redirects;
+  while (is_redirect(p)) {
+    if (parse_redirect(p, &tail) == -1) {
+      return NULL;
+    }
+  }
+  return node;
+}
+
+static struct s_node *parse_command(struct s_parser *p) {
+  if (p->token.type == TOKEN_LPAREN) {
+    return parse_compound(p, NODE_SUBSHELL);
+  }
+  if (is_reserved(p, "{")) {
+    return parse_compound(p, NODE_GROUP);
+  }
+  if (is_reserved(p, "}")) {
+    return syntax_error(p);
+  }
+  return parse_simple(p);
+}
+
+static struct s_node *parse_stages(struct s_parser *p) {
+  struct s_node *first = parse_command(p);
+  if (!first || p->token.type != TOKEN_PIPE) {
+    return first;
+  }
+
+  struct s_node *node = new_node(p, NODE_PIPELINE);
+  int cap = 0;
+  if (!node) {
+    return NULL;
+  }
+  node->stages = (struct s_node **)push(p, NULL, 0, &cap, first);
+  node->num_stages = 1;
+
+  while (node->stages && p->token.type == TOKEN_PIPE) {
+    advance(p);
+    struct s_node *stage = parse_command(p);
+    if (!stage) {
+      return NULL;
+    }
+    node->stages = (struct s_node **)push(p, (void **)node->stages,
+                                          node->num_stages, &cap, stage);
+    node->num_stages++;
+  }
+  return node->stages ? node : NULL;
+}
+
+/** Indica si el token actual empieza un prefijo (ver schedctl.h). */
+static int is_prefix(const struct s_parser *p) {
+  return p->token.type == TOKEN_WORD && !p->token.quoted &&
+         schedctl_prefix_arity(p->token.text) >= 0;
+}
+
+/** `time [-j] pipeline` (ver timing.h). */
+static struct s_node *parse_time(struct s_parser *p) {
+  struct s_node *node = new_node(p, NODE_TIME);
+  int cap = 0;
+  if (!node) {
+    return NULL;
+  }
+  do {
+    node->argv = (char **)push(p, (void **)node->argv, node->argc, &cap,
+                               p->token.text);
+    if (!node->argv) {
+      return NULL;
+    }
+    node->argc++;
+    advance(p);
+  } while (node->argc == 1 && is_reserved(p, "-j"));
+  node->body = parse_pipeline(p);
+  return node->body ? node : NULL;
+}
+
+/** Pipeline precedida de prefijos como `pin 0-3 idle`, que la abarcan. */
+static struct s_node *parse_pipeline(struct s_parser *p) {
+  if (is_reserved(p, "time")) {
+    return parse_time(p);
+  }
+  if (!is_prefix(p)) {
+    return parse_stages(p);
+  }
+
+  struct s_node *node = new_node(p, NODE_SCHED);
+  int cap = 0;
+  if (!node) {
+    return NULL;
+  }
+  while (is_prefix(p)) {
+    int words = 1 + schedctl_prefix_arity(p->token.text);
+    for (int i = 0; i < words; i++) {
+      if (p->token.type != TOKEN_WORD) {
+        return syntax_error(p);
+      }
+      node->argv = (char **)push(p, (void **)node->argv, node->argc, &cap,
+                                 p->token.text);
+      if (!node->argv) {
+        return NULL;
+      }
+      node->argc++;
+      advance(p);
+    }
+  }
+  node->body = parse_stages(p);
+  return node->body ? node : NULL;
+}
+
+static struct s_node *parse_and_or(struct s_parser *p) {
+  struct s_node *node = parse_pipeline(p);
+
+  while (node && (p->token.type == TOKEN_AND_IF ||
+                  p->token.type == TOKEN_OR_IF)) {
+    enum e_node_type type = p->token.type == TOKEN_AND_IF ? NODE_AND : NODE_OR;
+    advance(p);
+    struct s_node *right = parse_pipeline(p);
+    node = right ? new_binary(p, type, node, right) : NULL;
+  }
+  return node;
+}
+
+/** Indica si el token actual cierra la lista. */
+static int at_list_end(const struct s_parser *p, enum e_list_end end) {
+  switch (end) {
+  case END_PAREN:
+    return p->token.type == TOKEN_RPAREN;
+  case END_BRACE:
+    return is_reserved(p, "}");
+  default:
+    return p->token.type == TOKEN_END;
+  }
+}
+
+static struct s_node *parse_list(struct s_parser *p, enum e_list_end end) {
+  struct s_node *list = NULL;
+
+  do {
+    struct s_node *item = parse_and_or(p);
+    if (!item) {
+      return NULL;
+    }
+
+    if (p->token.type == TOKEN_AMP) {
+      struct s_node *background = new_node(p, NODE_BACKGROUND);
+      if (!background) {
+        return NULL;
+      }
+      background->body = item;
+      item = background;
+      advance(p);
+    } else if (p->token.type == TOKEN_SEMI) {
+      advance(p);
+    } else if (!at_list_end(p, end)) {
+      return syntax_error(p);
+    }
+
+    list = list ? new_binary(p, NODE_SEQUENCE, list, item) : item;
+  } while (list && !at_list_end(p, end) && p->token.type != TOKEN_END);
+
+  return list;
+}
+
+struct s_node *parse_line(const char *line, struct s_arena *arena) {
+  return parse_buffer(line, strlen(line), arena);
+}
+
+static struct s_node *parse(const char *line, size_t len,
+                            struct s_arena *arena, int report) {
+  struct s_parser p;
+  p.arena = arena;
+  p.failed = !report; // Sin informar, como si ya se hubiera informado
+
+  if (lexer_init(&p.lexer, line, len, arena) == -1) {
+    if (report) {
+      perror("Error de memoria");
+    }
+    return NULL;
+  }
+  advance(&p);
+  if (p.token.type == TOKEN_END) {
+    return NULL; // Línea vacía o solo un comentario
+  }
+
+  struct s_node *tree = parse_list(&p, END_LINE);
+  if (tree && p.token.type != TOKEN_END) {
+    return syntax_error(&p);
+  }
+  return tree;
+}
+
+struct s_node *parse_buffer(const char *line, size_t len,
+                            struct s_arena *arena) {
+  return parse(line, len, arena, 1);
+}
+
+struct s_node *parse_buffer_silent(const char *line, size_t len,
+                                   struct s_arena *arena) {
+  return parse(line, len, arena, 0);
+}
+
+/** Indica si el lexer no leería la palabra tal cual. */
+static int needs_quotes(const char *word) {
+  return *word == '\0' || word[strcspn(word, " \t\r\n|&;()<>'\"\\#")] ||
+         strcmp(word, "{") == 0 || strcmp(word, "}") == 0;
+}
+
+/**
+ * Indica si una palabra en posición de comando se leería como palabra
+ * reservada: `time`, su opción `-j` y los prefijos (ver schedctl.h).
+ */
+static int is_keyword(const char *word) {
+  return strcmp(word, "time") == 0 || strcmp(word, "-j") == 0 ||
+         schedctl_prefix_arity(word) >= 0;
+}
+
+/** Escribe una palabra entre comillas simples. */
+static void write_quoted(FILE *out, const char *word) {
+  fputc('\'', out);
+  for (; *word; word++) {
+    if (*word == '\'') {
+      fputs("'\\''", out); // Cierra, agrega la comilla escapada y reabre
+    } else {
+      fputc(*word, out);
+    }
+  }
+  fputc('\'', out);
+}
+
+/** Escribe una palabra; con `quote`, entre comillas simples si hace falta. */
+static void write_word(FILE *out, const char *word, int quote) {
+  if (quote && needs_quotes(word)) {
+    write_quoted(out, word);
+  } else {
+    fputs(word, out);
+  }
+}
+
+/** Escribe las redirecciones de un nodo, cada una precedida de un espacio. */
+static void write_redirects(FILE *out, const struct s_redirect *r,
+                            int quote) {
+  static const char *const ops[] = {"<", ">", ">>"};
+  for (; r; r = r->next) {
+    int default_fd = r->type == REDIRECT_IN ? 0 : 1;
+    if (r->fd != default_fd) {
+      fprintf(out, " %d%s", r->fd, ops[r->type]);
+    } else {
+      fprintf(out, " %s", ops[r->type]);
+    }
+    write_word(out, r->target, quote);
+  }
+}
+
+/** Indica si una lista termina en `&`, que ya separa lo que sigue. */
+static int ends_in_background(const struct s_node *node) {
+  while (node->type == NODE_SEQUENCE) {
+    node = node->right;
+  }
+  return node->type == NODE_BACKGROUND;
+}
+
+static void write_node(FILE *out, const struct s_node *node, int quote) {
+  static const char *const binary[] = {
+      [NODE_AND] = " && ", [NODE_OR] = " || ", [NODE_SEQUENCE] = "; "};
+
+  switch (node->type) {
+  case NODE_COMMAND:
+    for (int i = 0; i < node->argc; i++) {
+      if (i) {
+        fputc(' ', out);
+      }
+      // Un comando llamado como una palabra reservada se escribió con
+      // comillas; sin ellas se volvería a leer como prefijo o `time`
+      if (quote && i == 0 && is_keyword(node->argv[0])) {
+        write_quoted(out, node->argv[0]);
+      } else {
+        write_word(out, node->argv[i], quote);
+      }
+    }
+    write_redirects(out, node->redirects, quote);
+    break;
+  case NODE_PIPELINE:
+    for (int i = 0; i < node->num_stages; i++) {
+      if (i) {
+        fputs(" | ", out);
+      }
+      write_node(out, node->stages[i], quote);
+    }
+    break;
+  case NODE_AND:
+  case NODE_OR:
+  case NODE_SEQUENCE:
+    write_node(out, node->left, quote);
+    // `a &; b` no es válido: después de `&` basta un espacio
+    if (node->type == NODE_SEQUENCE && ends_in_background(node->left)) {
+      fputc(' ', out);
+    } else {
+      fputs(binary[node->type], out);
+    }
+    write_node(out, node->right, quote);
+    break;
+  case NODE_BACKGROUND:
+    write_node(out, node->body, quote);
+    fputs(" &", out);
+    break;
+  case NODE_SCHED:
+  case NODE_TIME:
+    for (int i = 0; i < node->argc; i++) {
+      write_word(out, node->argv[i], quote);
+      fputc(' ', out);
+    }
+    write_node(out, node->body, quote);
+    break;
+  case NODE_SUBSHELL:
+    fputs("( ", out);
+    write_node(out, node->body, quote);
+    fputs(" )", out);
+    write_redirects(out, node->redirects, quote);
+    break;
+  case NODE_GROUP:
+    fputs("{ ", out);
+    write_node(out, node->body, quote);
+    fputs(ends_in_background(node->body) ? " }" : "; }", out);
+    write_redirects(out, node->redirects, quote);
+    break;
+  }
+}
+
+static char *write_text(const struct s_node *node, int quote) {
+  char *text = NULL;
+  size_t size;
+  FILE *out = open_memstream(&text, &size);
+  if (out == NULL) {
+    return NULL;
+  }
+  write_node(out, node, quote);
+  if (fclose(out) != 0) {
+    free(text);
+    return NULL;
+  }
+  return text;
+}
+
+char *node_text(const struct s_node *node) { return write_text(node, 0); }
+
+char *node_source(const struct s_node *node) { return write_text(node, 1); }
@@ -0,0 +1,405 @@
+// cgroup.c
+//
+// Este archivo contiene los cgroups por trabajo: la búsqueda de la jerarquía
+// cgroup2, la creación de cada cgroup con sus límites y el informe de su
+// consumo al terminar.
+
+#include "cgroup.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CPU_PERIOD_US 100000 // Período de cpu.max
+
+/**
+ * @brief Un cgroup de trabajo.
+ */
+struct s_cgroup {
+  char *path; /**< Directorio del cgroup. */
+  int refs;   /**< Referencias: el prefijo y sus trabajos. */
+};
+
+/**
+ * @brief Controladores con límites; cada uno tiene su archivo `*.max`.
+ */
+static const char *const controllers[] = {"memory", "cpu", "pids"};
+#define NUM_LIMITS 3
+
+/** Estado de la jerarquía: 0 sin buscar, 1 disponible, -1 no disponible. */
+static int available;
+static char base[PATH_MAX];     // Cgroup de la shell, padre de los demás
+static int enabled[NUM_LIMITS]; // Controladores habilitados en `base`
+static unsigned long created;   // Para nombrar los cgroups
+
+/** Arma la ruta de un archivo de control; -1 (ENAMETOOLONG) si no entra. */
+static int control_path(char *path, const char *dir, const char *name) {
+  if ((size_t)snprintf(path, PATH_MAX, "%s/%s", dir, name) >= PATH_MAX) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+  return 0;
+}
+
+/** Escribe un texto en un archivo de control. */
+static int write_file(const char *dir, const char *name, const char *value) {
+  char path[PATH_MAX];
+  if (control_path(path, dir, name) == -1) {
+    return -1;
+  }
+  int fd = open(path, O_WRONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return -1;
+  }
+  ssize_t n = write(fd, value, strlen(value));
+  int saved = errno;
+  close(fd);
+  errno = saved;
+  return n == (ssize_t)strlen(value) ? 0 : -1;
+}
+
+/** Lee un archivo de control; NULL si no existe. */
+static FILE *open_file(const char *dir, const char *name) {
+  char path[PATH_MAX];
+  return control_path(path, dir, name) == 0 ? fopen(path, "re") : NULL;
+}
+
+/** Busca dónde está montada la jerarquía cgroup2. */
+static int find_mount(char *mount, size_t size) {
+  char line[1024];
+  int found = 0;
+  FILE *fp = fopen("/proc/self/mountinfo", "re");
+  if (fp == NULL) {
+    return -1;
+  }
+  while (!found && fgets(line, sizeof(line), fp) != NULL) {
+    char root[PATH_MAX], point[PATH_MAX];
+    const char *fstype = strstr(line, " - ");
+    found = fstype != NULL && strncmp(fstype, " - cgroup2 ", 11) == 0 &&
+            sscanf(line, "%*d %*d %*s %4095s %4095s", root, point) == 2 &&
+            strcmp(root, "/") == 0 &&
+            (size_t)snprintf(mount, size, "%s", point) < size;
+  }
+  fclose(fp);
+  return found ? 0 : -1;
+}
+
+/** Arma `base` con el cgroup v2 de la shell. */
+static int find_base(void) {
+  char mount[PATH_MAX], line[PATH_MAX];
+  int found = 0;
+
+  if (find_mount(mount, sizeof(mount)) == -1) {
+    return -1;
+  }
+  FILE *fp = fopen("/proc/self/cgroup", "re");
+  if (fp == NULL) {
+    return -1;
+  }
+  while (!found && fgets(line, sizeof(line), fp) != NULL) {
+    if (strncmp(line, "0::", 3) == 0) {
+      line[strcspn(line, "\n")] = '\0';
+      const char *own = strcmp(line + 3, "/") == 0 ? "" : line + 3;
+      found = (size_t)snprintf(base, sizeof(base), "%s%s", mount, own) <
+              sizeof(base);
+    }
+  }
+  fclose(fp);
+  return found && access(base, W_OK) == 0 ? 0 : -1;
+}
+
+/** Indica si `word` figura en una lista separada por blancos. */
+static int in_list(const char *list, const char *word) {
+  size_t length = strlen(word);
+  const char *p = list + strspn(list, " \n");
+  while (*p != '\0') {
+    size_t n = strcspn(p, " \n");
+    if (n == length && strncmp(p, word, length) == 0) {
+      return 1;
+    }
+    p += n;
+    p += strspn(p, " \n");
+  }
+  return 0;
+}
+
+/** Habilita en `base` los controladores disponibles, y anota cuáles quedan. */
+static void enable_controllers(void) {
+  char line[1024] = "";
+  FILE *fp = open_file(base, "cgroup.controllers");
+  if (fp != NULL) {
+    if (fgets(line, sizeof(line), fp) == NULL) {
+      line[0] = '\0';
+    }
+    fclose(fp);
+  }
+
+  int moved = 0;
+  for (int i = 0; i < NUM_LIMITS; i++) {
+    if (!in_list(line, controllers[i])) {
+      continue;
+    }
+
+    char request[20];
+    snprintf(request, sizeof(request), "+%s", controllers[i]);
+    enabled[i] = write_file(base, "cgroup.subtree_control", request) == 0;
+    if (!enabled[i] && errno == EBUSY && !moved) {
+      // Un cgroup con procesos no puede repartir controladores entre sus
+      // hijos: la shell pasa a una hoja propia y se vuelve a intentar
+      char leaf[PATH_MAX];
+      moved = 1;
+      if ((size_t)snprintf(leaf, sizeof(leaf), "%s/shell-%d", base,
+                           (int)getpid()) < sizeof(leaf) &&
+          (mkdir(leaf, 0755) == 0 || errno == EEXIST) &&
+          write_file(leaf, "cgroup.procs", "0") == 0) {
+        enabled[i] =
+            write_file(base, "cgroup.subtree_control", request) == 0;
+      }
+    }
+  }
+}
+
+/** Busca la jerarquía la primera vez que se la necesita. */
+static int cgroups_available(void) {
+  if (available == 0) {
+    available = find_base() == 0 ? 1 : -1;
+    if (available == 1) {
+      enable_controllers();
+    } else {
+      fprintf(stderr, "cgroup: no hay cgroup v2 con permiso de escritura; "
+                      "los trabajos corren sin cgroup\n");
+    }
+  }
+  return available == 1;
+}
+
+/** Lee un límite `nombre=valor` en el formato de su archivo `*.max`. */
+static int parse_limit(const char *item, size_t length, int *index,
+                       char *value, size_t size) {
+  const char *equal = memchr(item, '=', length);
+  if (equal == NULL || equal + 1 == item + length) {
+    return -1;
+  }
+  *index = -1;
+  for (int i = 0; i < NUM_LIMITS; i++) {
+    if ((size_t)(equal - item) == strlen(controllers[i]) &&
+        strncmp(item, controllers[i], equal - item) == 0) {
+      *index = i;
+    }
+  }
+  if (*index == -1) {
+    return -1;
+  }
+
+  char number[32];
+  size_t digits = item + length - equal - 1;
+  if (digits >= sizeof(number)) {
+    return -1;
+  }
+  memcpy(number, equal + 1, digits);
+  number[digits] = '\0';
+  char *end;
+  errno = 0;
+  unsigned long long n = strtoull(number, &end, 10);
+  if (end == number || number[0] == '-' || errno == ERANGE || n == 0) {
+    return -1;
+  }
+
+  const char *units = "KMG";
+  const char *unit = *end ? strchr(units, *end) : NULL;
+  if (*index == 0 && unit != NULL && end[1] == '\0') {
+    for (const char *u = units; u <= unit; u++) {
+      if (n > ULLONG_MAX / 1024) {
+        return -1;
+      }
+      n *= 1024;
+    }
+  } else if (*end != '\0') {
+    return -1;
+  }
+
+  if (*index == 1) {
+    // Porcentaje de una CPU: la cuota dentro de cada período
+    if (n > ULLONG_MAX / (CPU_PERIOD_US / 100)) {
+      return -1;
+    }
+    snprintf(value, size, "%llu %d", n * (CPU_PERIOD_US / 100),
+             CPU_PERIOD_US);
+  } else {
+    snprintf(value, size, "%llu", n);
+  }
+  return 0;
+}
+
+int cgroup_create(const char *spec, struct s_cgroup **cgroup) {
+  char values[NUM_LIMITS][48] = {{0}};
+
+  *cgroup = NULL;
+  // Todos los límites se validan antes de crear nada
+  const char *item = spec;
+  while (strcmp(spec, "acct") != 0) {
+    size_t length = strcspn(item, ",");
+    int index;
+    char value[48];
+    if (parse_limit(item, length, &index, value, sizeof(value)) == -1) {
+      fprintf(stderr, "cgroup: límite inválido: %.*s\n", (int)length, item);
+      return -1;
+    }
+    memcpy(values[index], value, sizeof(value));
+    if (item[length] == '\0') {
+      break;
+    }
+    item += length + 1;
+  }
+
+  if (!cgroups_available()) {
+    return 0;
+  }
+  char path[PATH_MAX];
+  if ((size_t)snprintf(path, sizeof(path), "%s/job-%d-%lu", base,
+                       (int)getpid(), ++created) >= sizeof(path) ||
+      mkdir(path, 0755) == -1) {
+    fprintf(stderr, "cgroup: no se pudo crear %s: %s\n", path,
+            strerror(errno));
+    return 0;
+  }
+
+  for (int i = 0; i < NUM_LIMITS; i++) {
+    if (values[i][0] == '\0') {
+      continue;
+    }
+    char name[16];
+    snprintf(name, sizeof(name), "%s.max", controllers[i]);
+    if (!enabled[i]) {
+      fprintf(stderr, "cgroup: sin el controlador %s; no se aplica %s\n",
+              controllers[i], name);
+    } else if (write_file(path, name, values[i]) == -1) {
+      fprintf(stderr, "cgroup: %s: %s\n", name, strerror(errno));
+    }
+  }
+
+  struct s_cgroup *cg = malloc(sizeof(*cg));
+  if (cg == NULL || (cg->path = strdup(path)) == NULL) {
+    free(cg);
+    rmdir(path);
+    perror("Error de memoria");
+    return 0;
+  }
+  cg->refs = 1;
+  *cgroup = cg;
+  return 0;
+}
+
+void cgroup_hold(struct s_cgroup *cgroup) { cgroup->refs++; }
+
+int cgroup_enter(const struct s_cgroup *cgroup) {
+  // En cgroup v2, "0" es el propio proceso
+  return write_file(cgroup->path, "cgroup.procs", "0");
+}
+
+/** Busca `clave valor` en un archivo como cpu.stat; -1 si no está. */
+static long long read_key(const char *dir, const char *name, const char *key) {
+  char line[256];
+  long long value = -1;
+  FILE *fp = open_file(dir, name);
+  if (fp == NULL) {
+    return -1;
+  }
+  size_t length = strlen(key);
+  while (value == -1 && fgets(line, sizeof(line), fp) != NULL) {
+    if (strncmp(line, key, length) == 0 && line[length] == ' ') {
+      value = strtoll(line + length + 1, NULL, 10);
+    }
+  }
+  fclose(fp);
+  return value;
+}
+
+/** Suma los bytes leídos y escritos de todos los dispositivos de io.stat. */
+static int read_io(const char *dir, long long *rbytes, long long *wbytes) {
+  char line[512];
+  FILE *fp = open_file(dir, "io.stat");
+  if (fp == NULL) {
+    return -1;
+  }
+  *rbytes = *wbytes = 0;
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    const char *r = strstr(line, " rbytes=");
+    const char *w = strstr(line, " wbytes=");
+    *rbytes += r ? strtoll(r + 8, NULL, 10) : 0;
+    *wbytes += w ? strtoll(w + 8, NULL, 10) : 0;
+  }
+  fclose(fp);
+  return 0;
+}
+
+/** Escribe una cantidad de bytes con la unidad que corresponda. */
+static void print_bytes(FILE *out, long long bytes) {
+  static const char *const units[] = {"B", "KB", "MB", "GB"};
+  double value = bytes;
+  int unit = 0;
+  while (value >= 1024 && unit < 3) {
+    value /= 1024;
+    unit++;
+  }
+  fprintf(out, unit ? "%.1f %s" : "%.0f %s", value, units[unit]);
+}
+
+/** Informa el consumo del cgroup en stderr. */
+static void report(const struct s_cgroup *cgroup) {
+  const char *name = strrchr(cgroup->path, '/') + 1;
+  long long usage = read_key(cgroup->path, "cpu.stat", "usage_usec");
+  long long user = read_key(cgroup->path, "cpu.stat", "user_usec");
+  long long system = read_key(cgroup->path, "cpu.stat", "system_usec");
+  long long peak = -1;
+  FILE *fp = open_file(cgroup->path, "memory.peak");
+  if (fp != NULL) {
+    if (fscanf(fp, "%lld", &peak) != 1) {
+      peak = -1;
+    }
+    fclose(fp);
+  }
+  long long rbytes, wbytes;
+  int io = read_io(cgroup->path, &rbytes, &wbytes);
+
+  fflush(stdout);
+  fprintf(stderr, "cgroup %s:", name);
+  if (usage >= 0) {
+    fprintf(stderr, " CPU %.3fs (usuario %.3fs, sistema %.3fs)", usage / 1e6,
+            user / 1e6, system / 1e6);
+  }
+  if (peak >= 0) {
+    fprintf(stderr, ", memoria máx ");
+    print_bytes(stderr, peak);
+  }
+  if (io == 0) {
+    fprintf(stderr, ", E/S leídos ");
+    print_bytes(stderr, rbytes);
+    fprintf(stderr, ", escritos ");
+    print_bytes(stderr, wbytes);
+  }
+  fprintf(stderr, "\n");
+}
+
+void cgroup_release(struct s_cgroup *cgroup) {
+  if (--cgroup->refs > 0) {
+    return;
+  }
+  // Si ningún proceso llegó a correr en él (un trabajo que se quitó de la
+  // cola, por ejemplo), no hay nada que informar
+  if (read_key(cgroup->path, "cpu.stat", "usage_usec") != 0) {
+    report(cgroup);
+  }
+  // Si quedó algún proceso (un demonio, por ejemplo), el cgroup queda
+  if (rmdir(cgroup->path) == -1 && errno != EBUSY) {
+    fprintf(stderr, "cgroup: no se pudo borrar %s: %s\n", cgroup->path,
+            strerror(errno));
+  }
+  free(cgroup->path);
+  free(cgroup);
+}
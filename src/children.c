@@ -0,0 +1,318 @@
+// children.c
+//
+// Este archivo contiene el seguimiento de los procesos hijos de la shell con
+// pidfd y la espera de un hijo en particular.
+
+#define _GNU_SOURCE // W_STOPCODE
+
+#include "children.h"
+#include "event_loop.h"
+#include "jobs.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define CHILD_TABLE_MIN 64 // Tamaño inicial de la tabla hash
+
+/**
+ * @struct s_child
+ * @brief Registro de un proceso hijo.
+ */
+struct s_child {
+  pid_t pid;   /**< Proceso. */
+  int pidfd;   /**< pidfd en el bucle de eventos, o -1 si no tiene. */
+  int job;     /**< Trabajo al que pertenece (0 si no tiene). */
+  int flags;   /**< Combinación de e_child_flags. */
+  int waited;  /**< Alguien espera su estado: no se libera al terminar. */
+  int done;    /**< Terminó; `status` tiene su estado. */
+  int stopped; /**< Se suspendió y nadie lo informó todavía. */
+  int status;  /**< Último estado, como lo devuelve waitpid. */
+};
+
+// Tabla hash de direccionamiento abierto, de PID a registro. Su tamaño es una
+// potencia de 2 y se mantiene a lo sumo a la mitad de su capacidad.
+static struct s_child **table;
+static size_t table_size;
+static size_t table_count;
+
+static size_t without_pidfd; // Hijos que se recolectan al recibir SIGCHLD
+
+static size_t slot_of(pid_t pid) {
+  return ((size_t)pid * 2654435761u) & (table_size - 1);
+}
+
+static struct s_child *child_find(pid_t pid) {
+  if (table_size == 0) {
+    return NULL;
+  }
+  for (size_t i = slot_of(pid); table[i]; i = (i + 1) & (table_size - 1)) {
+    if (table[i]->pid == pid) {
+      return table[i];
+    }
+  }
+  return NULL;
+}
+
+static void table_place(struct s_child *child) {
+  size_t i = slot_of(child->pid);
+  while (table[i]) {
+    i = (i + 1) & (table_size - 1);
+  }
+  table[i] = child;
+}
+
+static int table_insert(struct s_child *child) {
+  if (2 * (table_count + 1) > table_size) {
+    size_t old_size = table_size;
+    struct s_child **old = table;
+    size_t size = old_size ? 2 * old_size : CHILD_TABLE_MIN;
+
+    table = calloc(size, sizeof(*table));
+    if (table == NULL) {
+      table = old;
+      return -1;
+    }
+    table_size = size;
+    for (size_t i = 0; i < old_size; i++) {
+      if (old[i]) {
+        table_place(old[i]);
+      }
+    }
+    free(old);
+  }
+  table_place(child);
+  table_count++;
+  return 0;
+}
+
+static void table_remove(struct s_child *child) {
+  size_t mask = table_size - 1;
+  size_t i = slot_of(child->pid);
+  while (table[i] != child) {
+    i = (i + 1) & mask;
+  }
+  table[i] = NULL;
+  table_count--;
+
+  // Los registros que siguen en la misma secuencia se vuelven a ubicar, para
+  // que la búsqueda no se corte en el hueco
+  for (size_t j = (i + 1) & mask; table[j]; j = (j + 1) & mask) {
+    struct s_child *moved = table[j];
+    table[j] = NULL;
+    table_place(moved);
+  }
+}
+
+/** Registra un hijo y abre su pidfd; si ya estaba registrado, lo devuelve. */
+static struct s_child *child_add(pid_t pid, int job, int flags) {
+  struct s_child *child = child_find(pid);
+  if (child) {
+    return child;
+  }
+
+  child = malloc(sizeof(*child));
+  if (child == NULL) {
+    perror("Error de memoria");
+    return NULL;
+  }
+  child->pid = pid;
+  child->job = job;
+  child->flags = flags;
+  // Sin trabajo ni CHILD_QUIET, lo espera quien lo lanzó
+  child->waited = job == 0 && !(flags & CHILD_QUIET);
+  child->done = 0;
+  child->stopped = 0;
+  child->status = 0;
+  if (table_insert(child) == -1) {
+    free(child);
+    perror("Error de memoria");
+    return NULL;
+  }
+
+  // Sin pidfd (kernel anterior a 5.3 o sin descriptores libres) el hijo se
+  // recolecta al recibir SIGCHLD
+  child->pidfd = (int)syscall(SYS_pidfd_open, pid, 0);
+  if (child->pidfd != -1 && event_loop_watch(child->pidfd, child) == -1) {
+    close(child->pidfd);
+    child->pidfd = -1;
+  }
+  if (child->pidfd == -1) {
+    without_pidfd++;
+  }
+  return child;
+}
+
+/** Cierra el pidfd de un hijo, si todavía lo tiene. */
+static void child_unwatch(struct s_child *child) {
+  if (child->pidfd != -1) {
+    // Un hijo de la shell creado con fork comparte el pidfd: hay que quitarlo
+    // del bucle explícitamente antes de cerrarlo
+    event_loop_unwatch(child->pidfd);
+    close(child->pidfd);
+    child->pidfd = -1;
+  } else if (!child->done) {
+    without_pidfd--;
+  }
+}
+
+static void child_forget(struct s_child *child) {
+  table_remove(child);
+  free(child);
+}
+
+/** Registra el fin de un hijo ya recolectado, con lo que consumió. */
+static void child_finished(struct s_child *child, int status,
+                           const struct rusage *usage) {
+  child_unwatch(child);
+  child->done = 1;
+  child->status = status;
+
+  if (child->job) {
+    // El registro lo libera el trabajo, con release_child, cuando sale de la
+    // tabla de trabajos
+    job_child_changed(child->job, child->pid, status, usage);
+  } else if (!child->waited) {
+    child_forget(child);
+  }
+}
+
+int track_child(pid_t pid, int job, int flags) {
+  if (!event_loop_active()) {
+    return 0; // Sin bucle, cada hijo lo espera directamente quien lo lanzó
+  }
+  return child_add(pid, job, flags) ? 0 : -1;
+}
+
+int child_job(pid_t pid) {
+  struct s_child *child = child_find(pid);
+  return child ? child->job : 0;
+}
+
+void release_child(pid_t pid) {
+  struct s_child *child = child_find(pid);
+  if (child) {
+    child_unwatch(child);
+    child_forget(child);
+  }
+}
+
+void child_ready(struct s_child *child) {
+  int status = 0;
+  struct rusage usage;
+  pid_t pid;
+
+  // wait4 informa además los recursos del hijo, para `time` (ver timing.h)
+  while ((pid = wait4(child->pid, &status, WNOHANG, &usage)) == -1 &&
+         errno == EINTR) {
+  }
+  if (pid == 0) {
+    return; // Todavía no terminó
+  }
+  child_finished(child, status, pid == -1 ? NULL : &usage);
+}
+
+/** Registra las suspensiones que informa waitid para `type` e `id`. */
+static void collect_stopped(idtype_t type, id_t id) {
+  siginfo_t info;
+
+  for (;;) {
+    info.si_pid = 0;
+    if (waitid(type, id, &info, WSTOPPED | WNOHANG) == -1 || info.si_pid == 0) {
+      break;
+    }
+    struct s_child *child = child_find(info.si_pid);
+    if (child == NULL) {
+      continue;
+    }
+    child->status = W_STOPCODE(info.si_status);
+    if (child->job) {
+      job_child_changed(child->job, child->pid, child->status, NULL);
+    } else {
+      child->stopped = 1;
+    }
+    if (type == P_PID) {
+      break;
+    }
+  }
+}
+
+void reap_children(int stopped) {
+  int saved_errno = errno;
+  int status;
+  struct rusage usage;
+  pid_t pid;
+
+  // Los hijos suspendidos no hacen que su pidfd quede listo
+  if (stopped) {
+    collect_stopped(P_ALL, 0);
+  }
+
+  // Los hijos sin pidfd se recolectan aquí. Un proceso que no está registrado
+  // no lo espera nadie
+  if (without_pidfd > 0) {
+    while ((pid = wait4(-1, &status, WNOHANG, &usage)) > 0) {
+      struct s_child *child = child_find(pid);
+      if (child) {
+        child_finished(child, status, &usage);
+      }
+    }
+  }
+
+  errno = saved_errno;
+}
+
+void reap_stopped(pid_t pgid) {
+  if (event_loop_active()) {
+    collect_stopped(P_PGID, (id_t)pgid);
+  }
+}
+
+pid_t wait_child(pid_t pid, int *status, int options) {
+  if (!event_loop_active()) {
+    pid_t result;
+    while ((result = waitpid(pid, status, options)) == -1 && errno == EINTR) {
+    }
+    return result;
+  }
+
+  struct s_child *child = child_find(pid);
+  if (child == NULL) {
+    // Sin esta comprobación, esperar a un proceso que no es hijo de la shell
+    // no terminaría nunca
+    siginfo_t info;
+    if (waitid(P_PID, (id_t)pid, &info,
+               WEXITED | WSTOPPED | WNOHANG | WNOWAIT) == -1 ||
+        (child = child_add(pid, 0, 0)) == NULL) {
+      return -1;
+    }
+  }
+  child->waited = 1;
+
+  for (;;) {
+    if (child->done) {
+      *status = child->status;
+      child_forget(child);
+      return pid;
+    }
+    if (options & WUNTRACED) {
+      // Varias SIGCHLD pueden llegar como una sola y perderse la que
+      // informaba la suspensión: el hijo esperado se consulta directamente
+      collect_stopped(P_PID, (id_t)pid);
+    }
+    if (child->stopped) {
+      child->stopped = 0;
+      if (options & WUNTRACED) {
+        *status = child->status;
+        return pid;
+      }
+    }
+    if (event_loop_wait(0) == -1) {
+      return -1;
+    }
+  }
+}
@@ -1,71 +1,99 @@
 // comandos.c
 #include "commands.h"
+#include "admission.h"
+#include "children.h"
 #include "globals.h"
 #include "monitorHandle.h" // Para start_monitor(), stop_monitor(), status_monitor()
 #include "file_finder.h"
+#include "jobs.h"
+#include "launcher.h"
+#include "parallel.h"
+#include "path_cache.h"
+#include "schedctl.h"
 #include "utils.h"         // Para free_args()
+#include "xargs.h"
+#include <errno.h>
 #include <fcntl.h>
 #include <limits.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/uio.h>
 #include <sys/wait.h>
 #include <termios.h>
 #include <unistd.h>
 
-static int job_id = 1; // Inicializamos el ID de trabajo globalmente
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
 
-int get_current_job_id(void) { return job_id; }
-
-void echo_command(char **args) {
-  int i = 1; // Comienza desde args[1] ya que args[0] es "echo"
-  char buffer[MAX_BUFFER_SIZE] = ""; // Buffer para el resultado final
-
-  while (args[i] != NULL) {
-    char *arg = args[i];
-    size_t arg_len = strlen(arg);
-    char processed_arg[256]; // Buffer temporal para el argumento procesado
-    size_t start = 0;
-    size_t end = arg_len;
-
-    // Remueve comillas al inicio
-    if (arg[0] == '"' || arg[0] == '\'') {
-      start = 1;
+/**
+ * @brief Escribe todos los bloques de `iov` en `fd`, reintentando las
+ * escrituras parciales y respetando IOV_MAX.
+ */
+static int write_all(int fd, struct iovec *iov, int count) {
+  while (count > 0) {
+    ssize_t written = writev(fd, iov, count < IOV_MAX ? count : IOV_MAX);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
     }
-
-    // Remueve comillas al final
-    if (arg_len > start &&
-        (arg[arg_len - 1] == '"' || arg[arg_len - 1] == '\'')) {
-      end = arg_len - 1;
+    // Descartar los bloques completos y ajustar el primero pendiente
+    while (count > 0 && (size_t)written >= iov->iov_len) {
+      written -= iov->iov_len;
+      iov++;
+      count--;
     }
+    if (count > 0) {
+      iov->iov_base = (char *)iov->iov_base + written;
+      iov->iov_len -= written;
+    }
+  }
+  return 0;
+}
 
-    // Copia el argumento sin comillas al buffer temporal
-    strncpy(processed_arg, arg + start, end - start);
-    processed_arg[end - start] = '\0'; // Asegura el terminador null
+void echo_command(char **args) {
+  int argc = 0;
+  while (args[argc + 1] != NULL) {
+    argc++;
+  }
 
-    // Verifica que no exceda el tamaño del buffer principal
-    if (strlen(buffer) + strlen(processed_arg) + 2 >
-        MAX_BUFFER_SIZE) { // +1 para espacio y +1 para '\0'
-      fprintf(stderr, "Error: El buffer es demasiado pequeño para concatenar "
-                      "todos los argumentos.\n");
+  // Cada argumento aporta su texto y un separador (espacio o salto de línea)
+  struct iovec local[32];
+  struct iovec *iov = local;
+  int count = argc ? 2 * argc : 1;
+  if (count > (int)(sizeof(local) / sizeof(local[0]))) {
+    iov = malloc(count * sizeof(*iov));
+    if (iov == NULL) {
+      perror("echo");
       return;
     }
+  }
 
-    // Concatena el argumento procesado al buffer principal
-    strcat(buffer, processed_arg);
-
-    // Agrega un espacio si hay más argumentos
-    if (args[i + 1] != NULL) {
-      strcat(buffer, " ");
-    }
+  // Las comillas ya las resolvió el lexer
+  for (int i = 0; i < argc; i++) {
+    iov[2 * i].iov_base = args[i + 1];
+    iov[2 * i].iov_len = strlen(args[i + 1]);
+    iov[2 * i + 1].iov_base = i + 1 < argc ? " " : "\n";
+    iov[2 * i + 1].iov_len = 1;
+  }
+  if (argc == 0) {
+    iov[0].iov_base = "\n";
+    iov[0].iov_len = 1;
+  }
 
-    i++;
+  // Lo que printf tenga pendiente debe salir antes que el texto de echo
+  fflush(stdout);
+  if (write_all(STDOUT_FILENO, iov, count) == -1) {
+    perror("echo");
   }
 
-  // Agrega el salto de línea al final y muestra el resultado
-  strcat(buffer, "\n");
-  printf("%s", buffer);
+  if (iov != local) {
+    free(iov);
+  }
 }
 
 void close_descriptors(int input_redirect, int output_redirect) {
@@ -73,154 +101,265 @@ void close_descriptors(int input_redirect, int output_redirect) {
     if (output_redirect != -1) close(output_redirect);
 }
 
-void execute_command(char **args, int *running) {
-    int background = 0;
-    int input_redirect = -1;
-    int output_redirect = -1;
-
-    // Manejo de redirección y procesos en segundo plano
-    for (int i = 0; args[i] != NULL; i++) {
-        if (strcmp(args[i], "<") == 0) {
-            args[i] = NULL;
-            input_redirect = open(args[i + 1], O_RDONLY);
-            if (input_redirect < 0) {
-                perror("Error al abrir el archivo de entrada");
-                return;
-            }
-            i++;
-        } else if (strcmp(args[i], ">") == 0) {
-            args[i] = NULL;
-            output_redirect = open(args[i + 1], O_WRONLY | O_CREAT | O_TRUNC, 0644);
-            if (output_redirect < 0) {
-                perror("Error al abrir el archivo de salida");
-                return;
-            }
-            i++;
-        } else if (strcmp(args[i], "&") == 0) {
-            background = 1; // Marcar el proceso como en segundo plano
-            args[i] = NULL;
+/**
+ * @brief Nombres de los comandos internos que ejecuta run_builtin().
+ */
+static const char *const builtins[] = {
+    "fg",   "find_config_files", "start_monitor", "stop_monitor",
+    "status_monitor", "quit", "cd", "hash", "echo", "wait", "jobs", "bg",
+    "kill", "parallel", "xargs", "admission"};
+
+int is_builtin(const char *name) {
+    for (size_t i = 0; i < sizeof(builtins) / sizeof(builtins[0]); i++) {
+        if (strcmp(name, builtins[i]) == 0) {
+            return 1;
         }
     }
+    return 0;
+}
 
-    // Manejo del comando "fg" para reanudar procesos suspendidos
-    if (strcmp(args[0], "fg") == 0) {
-        if (foreground_suspended > 0) {
-            foreground_pid = foreground_suspended;
-            foreground_suspended = 0;
-            printf("Reanudando proceso %d en primer plano\n", foreground_pid);
-
-            if (tcsetpgrp(STDIN_FILENO, foreground_pid) == -1)
-                perror("tcsetpgrp");
-            if (kill(-foreground_pid, SIGCONT) < 0)
-                perror("kill(SIGCONT)");
-
-            int status;
-            if (waitpid(foreground_pid, &status, WUNTRACED) == -1)
-                perror("waitpid");
-
-            if (WIFSTOPPED(status)) {
-                foreground_suspended = foreground_pid;
-                printf("\n[1]+  Detenido\t\t%d\n", foreground_pid);
-            }
-
-            if (tcsetpgrp(STDIN_FILENO, shell_pgid) == -1)
-                perror("tcsetpgrp");
-            foreground_pid = 0;
-        } else {
-            printf("No hay procesos en estado detenido\n");
-        }
-        close_descriptors(input_redirect, output_redirect);
-        return;
-    }
+int run_builtin(char **args, int *running) {
+    int status = 0;
 
-    // Comando "find_config_files"
-    if (strcmp(args[0], "find_config_files") == 0) {
+    if (strcmp(args[0], "fg") == 0) {
+        status = fg_command(args);
+    } else if (strcmp(args[0], "find_config_files") == 0) {
         if (args[1] != NULL) {
             find_config_files(args[1]);
         } else {
             printf("Por favor, especifica el directorio para buscar archivos de configuración.\n");
+            status = 1;
         }
-        close_descriptors(input_redirect, output_redirect);
-        return;
-    }
-
-    // Manejo de comandos internos específicos
-    if (strcmp(args[0], "start_monitor") == 0) {
+    } else if (strcmp(args[0], "start_monitor") == 0) {
         start_monitor();
-        close_descriptors(input_redirect, output_redirect);
-        return;
-    }
-    if (strcmp(args[0], "stop_monitor") == 0) {
+    } else if (strcmp(args[0], "stop_monitor") == 0) {
         stop_monitor();
-        close_descriptors(input_redirect, output_redirect);
-        return;
-    }
-    if (strcmp(args[0], "status_monitor") == 0) {
+    } else if (strcmp(args[0], "status_monitor") == 0) {
         status_monitor();
-        close_descriptors(input_redirect, output_redirect);
-        return;
-    }
-    if (strcmp(args[0], "quit") == 0) {
+    } else if (strcmp(args[0], "quit") == 0) {
         printf("Cerrando la shell de Mateo...\n");
         *running = 0;
-        close_descriptors(input_redirect, output_redirect);
-        return;
+    } else if (strcmp(args[0], "cd") == 0) {
+        status = change_directory(args);
+    } else if (strcmp(args[0], "hash") == 0) {
+        status = hash_command(args);
+    } else if (strcmp(args[0], "echo") == 0) {
+        echo_command(args);
+    } else if (strcmp(args[0], "wait") == 0) {
+        status = wait_command(args);
+    } else if (strcmp(args[0], "jobs") == 0) {
+        status = jobs_command(args);
+    } else if (strcmp(args[0], "bg") == 0) {
+        status = bg_command(args);
+    } else if (strcmp(args[0], "kill") == 0) {
+        status = kill_command(args);
+    } else if (strcmp(args[0], "parallel") == 0) {
+        status = parallel_command(args);
+    } else if (strcmp(args[0], "xargs") == 0) {
+        status = xargs_command(args);
+    } else if (strcmp(args[0], "admission") == 0) {
+        status = admission_command(args);
+    }
+    return status;
+}
+
+/**
+ * @brief Copia un descriptor estándar fuera del rango 0-2, con FD_CLOEXEC
+ * para que no lo hereden los procesos que lance el comando interno.
+ */
+static int save_fd(int fd) {
+    return fcntl(fd, F_DUPFD_CLOEXEC, STDERR_FILENO + 1);
+}
+
+int save_and_redirect(const int fds[3], struct s_saved_fds *saved) {
+    static const char *const errors[3] = {"Error al redirigir la entrada",
+                                          "Error al redirigir la salida",
+                                          "Error al redirigir la salida de errores"};
+
+    for (int i = 0; i < 3; i++) {
+        saved->fds[i] = -1;
+    }
+    // Lo que stdio tenga pendiente pertenece a la salida anterior
+    fflush(stdout);
+    fflush(stderr);
+
+    for (int i = 0; i < 3; i++) {
+        if (fds[i] == -1) {
+            continue;
+        }
+        if ((saved->fds[i] = save_fd(i)) == -1 || dup2(fds[i], i) == -1) {
+            perror(errors[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void restore_fds(struct s_saved_fds *saved) {
+    fflush(stdout);
+    fflush(stderr);
+    for (int i = 0; i < 3; i++) {
+        if (saved->fds[i] != -1) {
+            dup2(saved->fds[i], i);
+            close(saved->fds[i]);
+            saved->fds[i] = -1;
+        }
     }
-    if (strcmp(args[0], "cd") == 0) {
-        change_directory(args);
-        close_descriptors(input_redirect, output_redirect);
-        return;
+}
+
+/** Redirige los descriptores estándar en un proceso hijo. */
+static void redirect_child_fds(const int fds[3]) {
+    for (int i = 0; i < 3; i++) {
+        if (fds[i] != -1 && fds[i] != i && dup2(fds[i], i) == -1) {
+            perror("Error al redirigir");
+            _exit(EXIT_FAILURE);
+        }
     }
+}
 
-    // Comando "echo" con soporte de redirección
-    if (strcmp(args[0], "echo") == 0) {
-        pid_t pid = fork();
-        if (pid == 0) { // Proceso hijo para manejar "echo"
-            if (output_redirect != -1) {
-                if (dup2(output_redirect, STDOUT_FILENO) == -1) {
-                    perror("Error al redirigir la salida");
-                    exit(EXIT_FAILURE);
+int command_status(int status) {
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    }
+    if (WIFSIGNALED(status)) {
+        return 128 + WTERMSIG(status);
+    }
+    if (WIFSTOPPED(status)) {
+        return 128 + WSTOPSIG(status);
+    }
+    return 1;
+}
+
+char *args_text(char **args) {
+    size_t length = 0;
+    for (int i = 0; args[i] != NULL; i++) {
+        length += strlen(args[i]) + 1;
+    }
+    char *text = malloc(length + 1);
+    if (text == NULL) {
+        return NULL;
+    }
+    char *p = text;
+    for (int i = 0; args[i] != NULL; i++) {
+        size_t n = strlen(args[i]);
+        memcpy(p, args[i], n);
+        p += n;
+        *p++ = ' ';
+    }
+    if (p > text) {
+        p--; // Sin el último espacio
+    }
+    *p = '\0';
+    return text;
+}
+
+/** Sigue como trabajo a un proceso recién lanzado, con el texto de `args`. */
+static int run_job(pid_t pid, int background, char **args) {
+    char *text = args_text(args);
+    int status = handle_parent_process(pid, background, text ? text : args[0]);
+    free(text);
+    return status;
+}
+
+int run_simple_command(char **args, const int fds[3], int background,
+                       int *running) {
+    int status = 0;
+
+    // Solo redirecciones: los archivos ya se abrieron (y crearon)
+    if (args[0] == NULL) {
+        return 0;
+    }
+
+    // Los comandos internos corren en la propia shell: las redirecciones se
+    // aplican sobre sus descriptores estándar y se deshacen al terminar. En
+    // segundo plano se ejecutan en un hijo, como en bash.
+    if (is_builtin(args[0])) {
+        if (background) {
+            // Lo pendiente en los buffers de la shell no debe escribirlo
+            // también el hijo
+            fflush(stdout);
+            fflush(stderr);
+            pid_t pid = fork();
+            if (pid == 0) {
+                // Su propio grupo, como cualquier trabajo, para que
+                // `kill %n` le llegue
+                if (job_control) {
+                    setpgid(0, 0);
+                }
+                job_control = 0;
+                reset_signal_handlers();
+                if (schedctl_apply() == -1) {
+                    _exit(EXIT_FAILURE);
                 }
-                close(output_redirect);
+                sigset_t empty;
+                sigemptyset(&empty);
+                sigprocmask(SIG_SETMASK, &empty, NULL);
+                redirect_child_fds(fds);
+                status = run_builtin(args, running);
+                fflush(stdout);
+                _exit(status);
+            } else if (pid < 0) {
+                perror("Error al crear el proceso");
+                return 1;
             }
-            echo_command(args);
-            exit(EXIT_SUCCESS);
-        } else if (pid < 0) {
-            perror("Error al crear el proceso para echo");
+            if (job_control) {
+                setpgid(pid, pid);
+            }
+            return run_job(pid, background, args);
+        }
+
+        struct s_saved_fds saved;
+        if (save_and_redirect(fds, &saved) == 0) {
+            status = run_builtin(args, running);
         } else {
-            handle_parent_process(pid, background);
+            status = 1;
         }
-        close_descriptors(input_redirect, output_redirect);
-        return;
+        restore_fds(&saved);
+        return status;
     }
 
-    // Ejecución de comandos externos con redirección y segundo plano
-    pid_t pid = fork();
-    if (pid == 0) {  // Proceso hijo
-        setpgid(0, 0); // Crea un nuevo grupo de procesos
+    // Ejecución de comandos externos en un nuevo grupo de procesos que toma
+    // la terminal si está en primer plano. Sin control de trabajos (en un
+    // hijo de la shell) queda en el grupo del hijo, que es el del trabajo
+    struct s_launch launch = {args, fds[0], fds[1], fds[2], -1,
+                              job_control ? 0 : getpgrp(),
+                              !background && job_control};
+    pid_t pid = launch_process(&launch);
+    return pid > 0 ? run_job(pid, background, args) : 127;
+}
+
+void execute_command(char **args, int *running) {
+    int background = 0;
+    int fds[3] = {-1, -1, -1};
 
-        // Control de terminal solo en primer plano
-        if (!background && tcsetpgrp(STDIN_FILENO, getpid()) == -1) {
-            perror("tcsetpgrp");
-            exit(EXIT_FAILURE);
-        }
-        // Manejo de redirección de entrada y salida
-        handle_redirection(input_redirect, output_redirect);
-
-        // Restaurar manejadores de señales por defecto y ejecutar comando
-        reset_signal_handlers();
-        if (execvp(args[0], args) == -1) {
-            perror("Error en el comando");
-            close_descriptors(input_redirect, output_redirect);
-            exit(EXIT_FAILURE);
+    // Manejo de redirección y procesos en segundo plano
+    for (int i = 0; args[i] != NULL; i++) {
+        if (strcmp(args[i], "<") == 0) {
+            args[i] = NULL;
+            fds[0] = open(args[i + 1], O_RDONLY);
+            if (fds[0] < 0) {
+                perror("Error al abrir el archivo de entrada");
+                close_descriptors(fds[0], fds[1]);
+                return;
+            }
+            i++;
+        } else if (strcmp(args[i], ">") == 0) {
+            args[i] = NULL;
+            fds[1] = open(args[i + 1], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fds[1] < 0) {
+                perror("Error al abrir el archivo de salida");
+                close_descriptors(fds[0], fds[1]);
+                return;
+            }
+            i++;
+        } else if (strcmp(args[i], "&") == 0) {
+            background = 1; // Marcar el proceso como en segundo plano
+            args[i] = NULL;
         }
-    } else if (pid < 0) {
-        perror("Error al crear el proceso");
-    } else {
-        handle_parent_process(pid, background);
     }
 
-    close_descriptors(input_redirect, output_redirect);
+    run_simple_command(args, fds, background, running);
+    close_descriptors(fds[0], fds[1]);
 }
 
 
@@ -241,25 +380,18 @@ void handle_redirection(int input_redirect, int output_redirect) {
   }
 }
 
-void handle_parent_process(pid_t pid, int background) {
-  if (background) {
-    printf("[%d] %d\n", job_id++, pid);
-  } else {
-    int status;
-    foreground_pid = pid;
-
-    if (waitpid(foreground_pid, &status, WUNTRACED) == -1)
+int handle_parent_process(pid_t pid, int background, const char *command) {
+  struct s_job *job = job_create(command);
+  if (job == NULL) {
+    // Sin memoria para seguirlo como trabajo, al menos no queda sin esperar
+    int status = 0;
+    if (!background && wait_child(pid, &status, 0) == -1) {
       perror("waitpid");
-
-    if (WIFSTOPPED(status)) {
-      foreground_suspended = foreground_pid;
-      printf("\n[1]+  Detenido\t\t%d\n", foreground_pid);
     }
-
-    if (tcsetpgrp(STDIN_FILENO, shell_pgid) == -1)
-      perror("tcsetpgrp");
-    foreground_pid = 0;
+    return background ? 0 : command_status(status);
   }
+  job_add_process(job, pid); // Los errores ya se informaron
+  return background ? job_background(job) : job_foreground(job, 0);
 }
 
 /**
@@ -271,7 +403,7 @@ void reset_signal_handlers() {
   signal(SIGQUIT, SIG_DFL);
 }
 
-void change_directory(char **args) {
+int change_directory(char **args) {
   char cwd[PATH_MAX];
   char *home = getenv("HOME"); // Obtener el directorio HOME del usuario
   char *oldpwd =
@@ -280,7 +412,7 @@ void change_directory(char **args) {
   // Guardar el directorio actual en `cwd`
   if (getcwd(cwd, sizeof(cwd)) == NULL) {
     perror("Error al obtener el directorio actual");
-    return;
+    return 1;
   }
 
   // Manejar "cd -" para cambiar al último directorio (OLDPWD)
@@ -292,15 +424,15 @@ void change_directory(char **args) {
         setenv("OLDPWD", cwd,
                1); // Actualizar OLDPWD al directorio actual anterior
         setenv("PWD", oldpwd, 1); // Actualizar PWD al nuevo directorio
-      } else {
-        perror("Error en el comando"); // Error al intentar cambiar a OLDPWD
+        return 0;
       }
+      perror("Error en el comando"); // Error al intentar cambiar a OLDPWD
     } else {
       fprintf(
           stderr,
           "OLDPWD no está definido\n"); // Mensaje si OLDPWD no está definido
     }
-    return;
+    return 1;
   }
 
   // Si no hay argumento, cambiar al directorio HOME
@@ -313,7 +445,8 @@ void change_directory(char **args) {
     setenv("OLDPWD", cwd,
            1); // Guardar el directorio actual en OLDPWD antes del cambio
     setenv("PWD", args[1], 1); // Actualizar PWD al nuevo directorio
-  } else {
-    perror("Error en el comando"); // Mensaje de error si chdir falla
+    return 0;
   }
+  perror("Error en el comando"); // Mensaje de error si chdir falla
+  return 1;
 }
@@ -0,0 +1,307 @@
+// event_loop.c
+//
+// Este archivo contiene el bucle de eventos de la shell: la espera con epoll
+// sobre un signalfd, los pidfd de los procesos hijos y la entrada estándar o
+// el FIFO del monitor, y la lectura de líneas.
+
+#define _GNU_SOURCE // signalfd, epoll
+
+#include "event_loop.h"
+#include "admission.h"
+#include "children.h"
+#include "jobs.h"
+#include "prompt.h"
+#include "signals.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+#define INPUT_BLOCK 4096 // Tamaño mínimo de cada lectura de stdin
+
+static int epoll_fd = -1;
+static int signal_fd = -1;
+static pid_t owner;            // Proceso que creó el bucle
+static sigset_t previous_mask; // Máscara anterior a event_loop_init
+
+// Los eventos del signalfd y del descriptor que se espera se distinguen por
+// estas direcciones; los demás llevan el registro de un proceso hijo
+static char signal_tag, ready_tag;
+
+// Lo leído de stdin que todavía no se entregó como línea
+static char *input;
+static size_t input_start, input_end, input_size;
+static int input_eof;
+
+int event_loop_init(void) {
+  sigset_t handled;
+  sigemptyset(&handled);
+  sigaddset(&handled, SIGCHLD);
+  sigaddset(&handled, SIGINT);
+  sigaddset(&handled, SIGTSTP);
+  sigaddset(&handled, SIGQUIT);
+
+  // Bloqueadas, las señales quedan pendientes hasta que se leen del signalfd
+  if (sigprocmask(SIG_BLOCK, &handled, &previous_mask) == -1) {
+    perror("sigprocmask");
+    return -1;
+  }
+  signal_fd = signalfd(-1, &handled, SFD_NONBLOCK | SFD_CLOEXEC);
+  epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  struct epoll_event event = {.events = EPOLLIN, .data.ptr = &signal_tag};
+  if (signal_fd == -1 || epoll_fd == -1 ||
+      epoll_ctl(epoll_fd, EPOLL_CTL_ADD, signal_fd, &event) == -1) {
+    perror("Error al crear el bucle de eventos");
+    event_loop_shutdown();
+    return -1;
+  }
+  owner = getpid();
+  return 0;
+}
+
+void event_loop_shutdown(void) {
+  if (epoll_fd != -1) {
+    close(epoll_fd);
+    epoll_fd = -1;
+  }
+  if (signal_fd != -1) {
+    close(signal_fd);
+    signal_fd = -1;
+    sigprocmask(SIG_SETMASK, &previous_mask, NULL);
+  }
+}
+
+int event_loop_active(void) {
+  // Un hijo creado con fork hereda los descriptores, pero el signalfd solo
+  // informa las señales del proceso que lo lee y la instancia de epoll es
+  // compartida: en el hijo el bucle no se usa
+  return epoll_fd != -1 && owner == getpid();
+}
+
+/**
+ * @brief Lee y atiende las señales pendientes.
+ *
+ * @param interruptible Si es distinto de 0, SIGINT no se atiende y solo se
+ * informa.
+ * @return int 1 si llegó SIGINT y `interruptible`, 0 si no.
+ */
+static int dispatch_signals(int interruptible) {
+  struct signalfd_siginfo info[16];
+  ssize_t n;
+  int interrupted = 0;
+  int children = 0, stopped = 0;
+
+  while ((n = read(signal_fd, info, sizeof(info))) > 0) {
+    for (size_t i = 0; i < (size_t)n / sizeof(info[0]); i++) {
+      int sig = (int)info[i].ssi_signo;
+      if (sig == SIGCHLD) {
+        // Varias terminaciones pueden llegar como un único SIGCHLD:
+        // reap_children las recolecta a todas
+        children = 1;
+        stopped |= info[i].ssi_code == CLD_STOPPED;
+      } else if (sig == SIGINT && interruptible) {
+        interrupted = 1;
+      } else {
+        shell_signal_handler(sig);
+      }
+    }
+  }
+  if (children) {
+    reap_children(stopped);
+  }
+  return interrupted;
+}
+
+/**
+ * @brief Atiende un lote de eventos de epoll.
+ *
+ * @param ready Se pone en 1 si el descriptor que se espera está listo.
+ * @return int 1 si llegó SIGINT y `interruptible`, 0 si no.
+ */
+static int dispatch_events(const struct epoll_event *events, int n,
+                           int interruptible, int *ready) {
+  // Primero los hijos: al atender SIGCHLD pueden recolectarse (y liberarse)
+  // registros cuyos eventos todavía están en este lote
+  int signals = 0;
+  for (int i = 0; i < n; i++) {
+    if (events[i].data.ptr == &ready_tag) {
+      *ready = 1; // Datos, fin de archivo o error: lo resuelve read
+    } else if (events[i].data.ptr == &signal_tag) {
+      signals = 1;
+    } else {
+      child_ready(events[i].data.ptr);
+    }
+  }
+  return signals && dispatch_signals(interruptible);
+}
+
+void event_loop_poll(void) {
+  if (!event_loop_active()) {
+    return;
+  }
+  // Recolectar aquí a los hijos que terminaron evita que, en un script que
+  // lanza muchos trabajos, se acumulen pidfd abiertos y procesos zombi
+  struct epoll_event events[64];
+  int n, ready = 0;
+  do {
+    n = epoll_wait(epoll_fd, events, 64, 0);
+    if (n > 0) {
+      dispatch_events(events, n, 0, &ready);
+    }
+  } while (n == 64 || (n == -1 && errno == EINTR));
+  admit_jobs();
+}
+
+int event_loop_watch(int fd, struct s_child *child) {
+  struct epoll_event event = {.events = EPOLLIN, .data.ptr = child};
+  return epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+}
+
+void event_loop_unwatch(int fd) { epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL); }
+
+/**
+ * @brief Espera eventos hasta que `fd` esté listo o, si `fd` es -1, hasta
+ * atender un lote de eventos.
+ */
+static int wait_events(int fd, int interruptible) {
+  struct epoll_event event = {.events = EPOLLIN, .data.ptr = &ready_tag};
+  int result = -1;
+
+  if (fd != -1 && epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+    // Un archivo regular no se puede esperar: siempre está listo
+    if (errno == EPERM) {
+      return 1;
+    }
+    perror("epoll_ctl");
+    return -1;
+  }
+
+  for (;;) {
+    struct epoll_event events[64];
+    // Con trabajos en cola, la carga se revisa aunque no lleguen eventos
+    int n = epoll_wait(epoll_fd, events, 64, admission_timeout());
+    if (n == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("epoll_wait");
+      break;
+    }
+
+    int ready = 0;
+    if (dispatch_events(events, n, interruptible, &ready)) {
+      result = 0;
+      goto done;
+    }
+    // En el prompt, los avisos se muestran apenas llegan
+    int admitted = admit_jobs();
+    if (fd == STDIN_FILENO && (report_jobs(stdout) > 0 || admitted > 0)) {
+      print_prompt();
+      fflush(stdout);
+    }
+    if (ready || fd == -1) {
+      result = 1;
+      break;
+    }
+  }
+
+done:
+  if (fd != -1) {
+    // Solo el signalfd queda registrado entre esperas, para que un
+    // descriptor listo que nadie lee no despierte las demás
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+  }
+  return result;
+}
+
+int event_loop_wait(int interruptible) {
+  return event_loop_active() ? wait_events(-1, interruptible) : -1;
+}
+
+int event_loop_wait_fd(int fd, int interruptible) {
+  if (event_loop_active()) {
+    return wait_events(fd, interruptible);
+  }
+
+  struct pollfd pfd = {.fd = fd, .events = POLLIN};
+  while (poll(&pfd, 1, -1) == -1) {
+    if (errno != EINTR) {
+      perror("poll");
+      return -1;
+    }
+  }
+  return 1;
+}
+
+/** Deja lugar para al menos INPUT_BLOCK bytes más al final de `input`. */
+static int input_reserve(void) {
+  if (input_start > 0) {
+    memmove(input, input + input_start, input_end - input_start);
+    input_end -= input_start;
+    input_start = 0;
+  }
+  if (input_size - input_end >= INPUT_BLOCK) {
+    return 0;
+  }
+  size_t size = input_size ? 2 * input_size : INPUT_BLOCK;
+  char *grown = realloc(input, size);
+  if (grown == NULL) {
+    perror("Error de memoria");
+    return -1;
+  }
+  input = grown;
+  input_size = size;
+  return 0;
+}
+
+ssize_t event_loop_read_line(char **line, size_t *capacity) {
+  for (;;) {
+    char *start = input + input_start;
+    size_t available = input_end - input_start;
+    char *newline = available ? memchr(start, '\n', available) : NULL;
+
+    // Una línea completa, o lo que quede antes del fin de la entrada
+    if (newline != NULL || (input_eof && available > 0)) {
+      size_t length = newline ? (size_t)(newline - start) : available;
+      if (*capacity < length + 1) {
+        char *grown = realloc(*line, length + 1);
+        if (grown == NULL) {
+          perror("Error de memoria");
+          return -1;
+        }
+        *line = grown;
+        *capacity = length + 1;
+      }
+      memcpy(*line, start, length);
+      (*line)[length] = '\0';
+      input_start += length + (newline != NULL);
+      return (ssize_t)length;
+    }
+    if (input_eof) {
+      input_eof = 0; // Ctrl-D en una terminal no cierra la entrada
+      return -1;
+    }
+
+    if (input_reserve() == -1) {
+      return -1;
+    }
+    if (event_loop_active() && wait_events(STDIN_FILENO, 0) == -1) {
+      return -1;
+    }
+    ssize_t n = read(STDIN_FILENO, input + input_end, input_size - input_end);
+    if (n > 0) {
+      input_end += (size_t)n;
+    } else if (n == 0) {
+      input_eof = 1;
+    } else if (errno != EINTR && errno != EAGAIN) {
+      perror("read");
+      return -1;
+    }
+  }
+}
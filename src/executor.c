@@ -0,0 +1,265 @@
+// executor.c
+//
+// Este archivo contiene el ejecutor que recorre el árbol sintáctico de una
+// línea de comandos.
+
+#include "executor.h"
+#include "admission.h"
+#include "children.h"
+#include "commands.h"
+#include "globals.h"
+#include "pipes.h"
+#include "schedctl.h"
+#include "timing.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+int open_redirects(const struct s_redirect *redirects, int fds[3]) {
+  for (int i = 0; i < 3; i++) {
+    fds[i] = -1;
+  }
+
+  for (const struct s_redirect *r = redirects; r; r = r->next) {
+    if (r->fd < 0 || r->fd > 2) {
+      fprintf(stderr, "Error: redirección del descriptor %d no soportada\n",
+              r->fd);
+      close_redirects(fds);
+      return -1;
+    }
+
+    int fd;
+    if (r->type == REDIRECT_IN) {
+      fd = open(r->target, O_RDONLY | O_CLOEXEC);
+    } else {
+      int mode = r->type == REDIRECT_APPEND ? O_APPEND : O_TRUNC;
+      fd = open(r->target, O_WRONLY | O_CREAT | O_CLOEXEC | mode, 0644);
+    }
+    if (fd < 0) {
+      perror(r->type == REDIRECT_IN ? "Error al abrir el archivo de entrada"
+                                    : "Error al abrir el archivo de salida");
+      close_redirects(fds);
+      return -1;
+    }
+
+    if (fds[r->fd] != -1) {
+      close(fds[r->fd]);
+    }
+    fds[r->fd] = fd;
+  }
+  return 0;
+}
+
+void close_redirects(int fds[3]) {
+  for (int i = 0; i < 3; i++) {
+    if (fds[i] != -1) {
+      close(fds[i]);
+      fds[i] = -1;
+    }
+  }
+}
+
+static int launch_background(struct s_node *body, int *running);
+
+static int execute_simple(struct s_node *node, int background, int *running) {
+  int fds[3];
+  if (open_redirects(node->redirects, fds) == -1) {
+    return 1;
+  }
+  int status = run_simple_command(node->argv, fds, background, running);
+  close_redirects(fds);
+  return status;
+}
+
+/** `( lista )`: el contenido corre en un proceso hijo de la shell. */
+static int execute_subshell(struct s_node *node, int *running) {
+  int fds[3];
+  if (open_redirects(node->redirects, fds) == -1) {
+    return 1;
+  }
+
+  // Lo pendiente en los buffers de la shell no debe escribirlo también el hijo
+  fflush(stdout);
+  fflush(stderr);
+  pid_t pid = fork();
+  if (pid == 0) {
+    // El hijo sigue en el grupo de la shell, por lo que puede entregar la
+    // terminal a sus propios comandos y recuperarla
+    if (schedctl_apply() == -1) {
+      _exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < 3; i++) {
+      if (fds[i] != -1 && dup2(fds[i], i) == -1) {
+        perror("Error al redirigir");
+        _exit(EXIT_FAILURE);
+      }
+    }
+    close_redirects(fds);
+    int status = execute_node(node->body, running);
+    fflush(stdout);
+    _exit(status);
+  }
+  close_redirects(fds);
+  if (pid < 0) {
+    perror("Error al crear el proceso");
+    return 1;
+  }
+
+  int status = 0;
+  if (wait_child(pid, &status, 0) == -1) {
+    perror("waitpid");
+    return 1;
+  }
+  return command_status(status);
+}
+
+/** `{ lista; }`: el contenido corre en la shell con las redirecciones aplicadas. */
+static int execute_group(struct s_node *node, int *running) {
+  struct s_saved_fds saved;
+  int fds[3];
+  int status = 1;
+
+  if (open_redirects(node->redirects, fds) == -1) {
+    return 1;
+  }
+  if (save_and_redirect(fds, &saved) == 0) {
+    status = execute_node(node->body, running);
+  }
+  restore_fds(&saved);
+  close_redirects(fds);
+  return status;
+}
+
+/**
+ * Prefijos como `idle`: sus atributos rigen para los procesos que se lancen
+ * mientras se ejecuta el contenido, en primer o segundo plano.
+ */
+static int execute_sched(struct s_node *node, int background, int *running) {
+  if (schedctl_begin(node->argv) == -1) {
+    return 2;
+  }
+  int status = background ? launch_background(node->body, running)
+                          : execute_node(node->body, running);
+  schedctl_end();
+  return status;
+}
+
+/**
+ * `time`: mide el contenido en la propia shell. En segundo plano lo ejecuta
+ * un hijo (ver launch_background), que es quien informa.
+ */
+static int execute_time(struct s_node *node, int *running) {
+  if (timing_begin(node->argc > 1) == -1) {
+    return 1;
+  }
+  int status = execute_node(node->body, running);
+  char *text = node_text(node->body);
+  timing_end(text ? text : "", status);
+  free(text);
+  return status;
+}
+
+/**
+ * `lista &`: un comando simple o una pipeline se lanzan directamente, como un
+ * trabajo con todos sus procesos; el resto en un hijo.
+ */
+static int launch_background(struct s_node *body, int *running) {
+  if (body->type == NODE_COMMAND) {
+    return execute_simple(body, 1, running);
+  }
+  if (body->type == NODE_PIPELINE) {
+    return execute_pipeline_node(body, 1, running);
+  }
+  if (body->type == NODE_SCHED) {
+    return execute_sched(body, 1, running);
+  }
+
+  fflush(stdout);
+  fflush(stderr);
+  pid_t pid = fork();
+  if (pid == 0) {
+    // Un trabajo en segundo plano no toma la terminal ni lee de ella. Sus
+    // comandos quedan en su grupo, para que `kill %n` les llegue
+    if (job_control) {
+      setpgid(0, 0);
+    }
+    job_control = 0;
+    reset_signal_handlers();
+    if (schedctl_apply() == -1) {
+      _exit(EXIT_FAILURE);
+    }
+    sigset_t empty;
+    sigemptyset(&empty);
+    sigprocmask(SIG_SETMASK, &empty, NULL);
+    if (isatty(STDIN_FILENO)) {
+      int null_fd = open("/dev/null", O_RDONLY);
+      if (null_fd != -1) {
+        dup2(null_fd, STDIN_FILENO);
+        close(null_fd);
+      }
+    }
+    int status = execute_node(body, running);
+    fflush(stdout);
+    _exit(status);
+  }
+  if (pid < 0) {
+    perror("Error al crear el proceso");
+    return 1;
+  }
+  if (job_control) {
+    setpgid(pid, pid);
+  }
+  char *text = node_text(body);
+  int status = handle_parent_process(pid, 1, text ? text : "");
+  free(text);
+  return status;
+}
+
+static int execute_background(struct s_node *body, int *running) {
+  if (admission_defer(body)) {
+    return 0; // Se lanza cuando le toque (ver admission.h)
+  }
+  return launch_background(body, running);
+}
+
+int execute_node(struct s_node *node, int *running) {
+  int status = 0;
+
+  switch (node->type) {
+  case NODE_COMMAND:
+    return execute_simple(node, 0, running);
+  case NODE_PIPELINE:
+    return execute_pipeline_node(node, 0, running);
+  case NODE_AND:
+    status = execute_node(node->left, running);
+    if (status == 0 && *running) {
+      status = execute_node(node->right, running);
+    }
+    return status;
+  case NODE_OR:
+    status = execute_node(node->left, running);
+    if (status != 0 && *running) {
+      status = execute_node(node->right, running);
+    }
+    return status;
+  case NODE_SEQUENCE:
+    status = execute_node(node->left, running);
+    if (*running) {
+      status = execute_node(node->right, running);
+    }
+    return status;
+  case NODE_BACKGROUND:
+    return execute_background(node->body, running);
+  case NODE_SUBSHELL:
+    return execute_subshell(node, running);
+  case NODE_GROUP:
+    return execute_group(node, running);
+  case NODE_SCHED:
+    return execute_sched(node, 0, running);
+  case NODE_TIME:
+    return execute_time(node, running);
+  }
+  return status;
+}
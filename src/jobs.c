@@ -0,0 +1,991 @@
+// jobs.c
+//
+// Este archivo contiene la tabla de trabajos de la shell, su ejecución en
+// primer y segundo plano y los comandos internos `jobs`, `fg`, `bg`, `kill` y
+// `wait`.
+
+#include "jobs.h"
+#include "admission.h"
+#include "cgroup.h"
+#include "children.h"
+#include "commands.h"
+#include "event_loop.h"
+#include "globals.h"
+#include "schedctl.h"
+#include "timing.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define JOB_TABLE_MIN 16 // Capacidad inicial de la tabla de trabajos
+
+/**
+ * @struct s_process
+ * @brief Un proceso de un trabajo.
+ */
+struct s_process {
+  pid_t pid;               /**< Proceso. */
+  int status;              /**< Último estado, como lo devuelve waitpid. */
+  enum e_job_state state;  /**< En ejecución, suspendido o terminado. */
+  struct timespec started; /**< Cuándo se lanzó (CLOCK_MONOTONIC). */
+  double real;             /**< Segundos hasta que terminó. */
+  struct rusage usage;     /**< Recursos que consumió, al terminar. */
+};
+
+/**
+ * @struct s_job
+ * @brief Un trabajo de la tabla.
+ */
+struct s_job {
+  int id;                  /**< Número del trabajo (`%n`). */
+  pid_t pgid;              /**< Grupo de sus procesos, o 0 si no tiene. */
+  char *command;           /**< Texto que se muestra en `jobs`. */
+  char *sched;             /**< Prefijos que rigen (schedctl.h), o NULL. */
+  struct s_cgroup *cgroup; /**< Cgroup de sus procesos, o NULL. */
+  int timing;              /**< Medición de `time` que lo abarca, o 0. */
+  struct s_process *procs; /**< Procesos, en el orden de la pipeline. */
+  int count;               /**< Cantidad de procesos. */
+  int capacity;            /**< Capacidad de `procs`. */
+  int alive;               /**< Procesos que no terminaron. */
+  int stopped;             /**< Procesos suspendidos. */
+  int stop_status;         /**< Estado de la última suspensión. */
+  enum e_job_state state;  /**< Estado del trabajo. */
+  int foreground;          /**< Lo espera job_foreground: no genera avisos. */
+  int pending;             /**< Tiene un aviso pendiente. */
+  int has_tmodes;          /**< `tmodes` guarda los modos del trabajo. */
+  struct termios tmodes;   /**< Modos de la terminal al suspenderse. */
+  struct s_job *newer;     /**< Trabajo usado más recientemente. */
+  struct s_job *older;     /**< Trabajo usado menos recientemente. */
+};
+
+// Trabajos indexados por número; `last_id` es el mayor en uso
+static struct s_job **table;
+static int table_capacity;
+static int last_id;
+
+// Lista por uso reciente: el primero es el trabajo actual (`%+`) y el
+// segundo el anterior (`%-`)
+static struct s_job *recent;
+
+static int running_count; // Trabajos en JOB_RUNNING
+
+static struct s_job *reserved; // Lo devuelve el próximo job_create
+
+// Números de los trabajos con avisos pendientes, en orden de llegada
+static int *pending;
+static size_t pending_count, pending_capacity;
+
+static struct s_job *job_find(int id) {
+  return id > 0 && id <= last_id ? table[id] : NULL;
+}
+
+/** Quita un trabajo de la lista por uso reciente. */
+static void unlink_recent(struct s_job *job) {
+  if (job->newer) {
+    job->newer->older = job->older;
+  } else if (recent == job) {
+    recent = job->older;
+  }
+  if (job->older) {
+    job->older->newer = job->newer;
+  }
+  job->newer = job->older = NULL;
+}
+
+/** Convierte un trabajo en el actual. */
+static void touch(struct s_job *job) {
+  if (recent == job) {
+    return;
+  }
+  unlink_recent(job);
+  job->older = recent;
+  if (recent) {
+    recent->newer = job;
+  }
+  recent = job;
+}
+
+/** Quita un trabajo de la tabla y libera sus procesos y su memoria. */
+static void job_remove(struct s_job *job) {
+  for (int i = 0; i < job->count; i++) {
+    release_child(job->procs[i].pid);
+  }
+  unlink_recent(job);
+  if (job->state == JOB_RUNNING) {
+    running_count--;
+  } else if (job->state == JOB_QUEUED) {
+    admission_forget(job);
+  }
+  table[job->id] = NULL;
+  // Cada posición vacía se recorre una sola vez antes de volver a usarse
+  while (last_id > 0 && table[last_id] == NULL) {
+    last_id--;
+  }
+  // Los procesos de un trabajo terminado se informan a su medición, si
+  // todavía está en curso
+  for (int i = 0; job->timing && job->state == JOB_DONE && i < job->count;
+       i++) {
+    const struct s_process *proc = &job->procs[i];
+    timing_process(job->timing, proc->pid, job->command,
+                   command_status(proc->status), proc->real, &proc->usage);
+  }
+  free(job->procs);
+  free(job->command);
+  free(job->sched);
+  // Con la última referencia se informa lo que consumió
+  if (job->cgroup != NULL) {
+    cgroup_release(job->cgroup);
+  }
+  free(job);
+}
+
+static void add_pending(struct s_job *job) {
+  if (pending_count == pending_capacity) {
+    size_t capacity = pending_capacity ? 2 * pending_capacity : 16;
+    int *grown = realloc(pending, capacity * sizeof(*grown));
+    if (grown == NULL) {
+      perror("Error de memoria");
+      return;
+    }
+    pending = grown;
+    pending_capacity = capacity;
+  }
+  pending[pending_count++] = job->id;
+  job->pending = 1;
+}
+
+/** Recalcula el estado de un trabajo después de un cambio en sus procesos. */
+static void update_state(struct s_job *job) {
+  enum e_job_state state = job->alive == 0              ? JOB_DONE
+                           : job->stopped == job->alive ? JOB_STOPPED
+                                                        : JOB_RUNNING;
+  if (state == job->state) {
+    return;
+  }
+  if (job->state == JOB_RUNNING) {
+    running_count--;
+  } else if (state == JOB_RUNNING) {
+    running_count++;
+  }
+  job->state = state;
+
+  if (state == JOB_STOPPED) {
+    touch(job);
+  }
+  // Los trabajos en primer plano los informa job_foreground
+  if (state != JOB_RUNNING && !job->foreground && !job->pending) {
+    add_pending(job);
+  }
+}
+
+/** Registra un nuevo estado de un proceso de un trabajo y lo que consumió. */
+static void process_changed(struct s_job *job, struct s_process *proc,
+                            int status, const struct rusage *usage) {
+  if (WIFSTOPPED(status)) {
+    if (proc->state == JOB_RUNNING) {
+      proc->state = JOB_STOPPED;
+      job->stopped++;
+    }
+    job->stop_status = status;
+  } else {
+    if (proc->state == JOB_STOPPED) {
+      job->stopped--;
+    }
+    if (proc->state != JOB_DONE) {
+      proc->state = JOB_DONE;
+      proc->real = timing_elapsed(&proc->started);
+      job->alive--;
+    }
+    if (usage != NULL) {
+      proc->usage = *usage;
+    }
+    proc->status = status;
+  }
+  update_state(job);
+}
+
+/** Busca un proceso en un trabajo; las pipelines suelen ser cortas. */
+static struct s_process *find_process(struct s_job *job, pid_t pid) {
+  for (int i = 0; i < job->count; i++) {
+    if (job->procs[i].pid == pid) {
+      return &job->procs[i];
+    }
+  }
+  return NULL;
+}
+
+void job_child_changed(int id, pid_t pid, int status,
+                       const struct rusage *usage) {
+  struct s_job *job = job_find(id);
+  struct s_process *proc = job ? find_process(job, pid) : NULL;
+  if (proc) {
+    process_changed(job, proc, status, usage);
+  }
+}
+
+/**
+ * @brief Sin bucle de eventos, espera directamente con wait4 hasta que el
+ * trabajo termine o se suspenda.
+ */
+static void wait_direct(struct s_job *job) {
+  for (int i = 0; i < job->count && job->state == JOB_RUNNING; i++) {
+    struct s_process *proc = &job->procs[i];
+    int status = 0;
+    struct rusage usage;
+    pid_t pid;
+
+    if (proc->state != JOB_RUNNING) {
+      continue;
+    }
+    while ((pid = wait4(proc->pid, &status, WUNTRACED, &usage)) == -1 &&
+           errno == EINTR) {
+    }
+    if (pid == -1) {
+      status = 0; // Ya lo recolectó otro: se da por terminado
+    }
+    process_changed(job, proc, status, pid == -1 ? NULL : &usage);
+  }
+}
+
+/**
+ * @brief Sin bucle de eventos, actualiza sin bloquear el estado de los
+ * trabajos. Un proceso que no es hijo de este proceso (por ejemplo, en un
+ * hijo que heredó la tabla) se deja como está.
+ */
+static void poll_direct(void) {
+  for (int id = 1; id <= last_id; id++) {
+    struct s_job *job = table[id];
+    for (int i = 0; job && i < job->count; i++) {
+      int status;
+      struct rusage usage;
+      if (job->procs[i].state != JOB_DONE &&
+          wait4(job->procs[i].pid, &status, WNOHANG | WUNTRACED, &usage) > 0) {
+        process_changed(job, &job->procs[i], status, &usage);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Espera hasta que un trabajo deje de estar en ejecución.
+ *
+ * @return int 1 si terminó o se suspendió, 0 si llegó SIGINT e
+ * `interruptible`, -1 si hubo un error.
+ */
+static int wait_job(struct s_job *job, int interruptible) {
+  if (!event_loop_active()) {
+    wait_direct(job);
+    return 1;
+  }
+  while (job->state == JOB_RUNNING) {
+    // Varias SIGCHLD pueden llegar como una sola y perderse la que informaba
+    // la suspensión: el grupo del trabajo se consulta directamente
+    reap_stopped(job->pgid);
+    if (job->state != JOB_RUNNING) {
+      break;
+    }
+    int result = event_loop_wait(interruptible);
+    if (result != 1) {
+      return result;
+    }
+  }
+  return 1;
+}
+
+/** Guarda una referencia al cgroup que rige, si hay. */
+static void hold_cgroup(struct s_job *job) {
+  job->cgroup = schedctl_cgroup();
+  if (job->cgroup != NULL) {
+    cgroup_hold(job->cgroup);
+  }
+}
+
+struct s_job *job_create(const char *command) {
+  if (reserved != NULL) {
+    struct s_job *job = reserved;
+    reserved = NULL;
+    job->state = JOB_RUNNING;
+    running_count++;
+    job->pgid = job_control ? 0 : getpgrp();
+    free(job->sched);
+    job->sched = schedctl_text();
+    hold_cgroup(job);
+    job->timing = timing_scope();
+    return job;
+  }
+
+  int id = last_id + 1;
+
+  if (id >= table_capacity) {
+    int capacity = table_capacity ? 2 * table_capacity : JOB_TABLE_MIN;
+    struct s_job **grown = realloc(table, capacity * sizeof(*grown));
+    if (grown == NULL) {
+      perror("Error de memoria");
+      return NULL;
+    }
+    memset(grown + table_capacity, 0,
+           (capacity - table_capacity) * sizeof(*grown));
+    table = grown;
+    table_capacity = capacity;
+  }
+
+  struct s_job *job = calloc(1, sizeof(*job));
+  if (job == NULL || (job->command = strdup(command)) == NULL) {
+    free(job);
+    perror("Error de memoria");
+    return NULL;
+  }
+  job->id = id;
+  job->sched = schedctl_text();
+  hold_cgroup(job);
+  job->timing = timing_scope();
+  // Sin control de trabajos los procesos quedan en el grupo de la shell
+  job->pgid = job_control ? 0 : getpgrp();
+  job->state = JOB_RUNNING;
+  running_count++;
+  table[id] = job;
+  last_id = id;
+  touch(job);
+  return job;
+}
+
+struct s_job *job_create_queued(const char *command) {
+  struct s_job *job = job_create(command);
+  if (job != NULL) {
+    job->state = JOB_QUEUED;
+    running_count--;
+    // Al admitirse se ejecuta de nuevo con sus prefijos, en otro cgroup
+    if (job->cgroup != NULL) {
+      cgroup_release(job->cgroup);
+      job->cgroup = NULL;
+    }
+  }
+  return job;
+}
+
+void job_reserve(struct s_job *job) { reserved = job; }
+
+void job_end_reserve(void) {
+  if (reserved != NULL) {
+    struct s_job *job = reserved;
+    reserved = NULL;
+    job_remove(job);
+  }
+}
+
+int job_add_process(struct s_job *job, pid_t pid) {
+  if (job->count == job->capacity) {
+    int capacity = job->capacity ? 2 * job->capacity : 4;
+    struct s_process *grown =
+        realloc(job->procs, capacity * sizeof(*grown));
+    if (grown == NULL) {
+      perror("Error de memoria");
+      return -1;
+    }
+    job->procs = grown;
+    job->capacity = capacity;
+  }
+  job->procs[job->count].pid = pid;
+  job->procs[job->count].status = 0;
+  job->procs[job->count].state = JOB_RUNNING;
+  clock_gettime(CLOCK_MONOTONIC, &job->procs[job->count].started);
+  memset(&job->procs[job->count].usage, 0, sizeof(job->procs->usage));
+  // Si todos sus procesos terminaron, su grupo ya no existe y el proceso
+  // nuevo creó otro (ver job_pgid)
+  if (job->pgid == 0 || (job_control && job->alive == 0)) {
+    job->pgid = pid;
+  }
+  job->count++;
+  job->alive++;
+  update_state(job); // Un trabajo de job_wait_any pudo quedar sin procesos
+  return track_child(pid, job->id, 0);
+}
+
+int job_id(const struct s_job *job) { return job->id; }
+
+pid_t job_pgid(const struct s_job *job) {
+  return job_control && job->alive == 0 ? 0 : job->pgid;
+}
+
+/** Marca al trabajo como actual (`+`) o anterior (`-`). */
+static char job_mark(const struct s_job *job) {
+  if (job == recent) {
+    return '+';
+  }
+  return recent && job == recent->older ? '-' : ' ';
+}
+
+/** Describe el estado de un trabajo, como "Hecho" o "Salida 2". */
+static const char *state_text(const struct s_job *job, char *buf,
+                              size_t size) {
+  if (job->state == JOB_RUNNING) {
+    return "Ejecutando";
+  }
+  if (job->state == JOB_STOPPED) {
+    return "Detenido";
+  }
+  if (job->state == JOB_QUEUED) {
+    return "En cola";
+  }
+  int status = job->procs[job->count - 1].status;
+  if (WIFSIGNALED(status)) {
+    snprintf(buf, size, "Terminado (señal %d)", WTERMSIG(status));
+  } else if (WEXITSTATUS(status) != 0) {
+    snprintf(buf, size, "Salida %d", WEXITSTATUS(status));
+  } else {
+    return "Hecho";
+  }
+  return buf;
+}
+
+static void print_job(FILE *out, const struct s_job *job, int with_pgid) {
+  char buf[32];
+  if (with_pgid) {
+    fprintf(out, "[%d]%c %d  %s\t\t%s", job->id, job_mark(job), job->pgid,
+            state_text(job, buf, sizeof(buf)), job->command);
+    // Los prefijos que abarcan al trabajo pueden no estar en su texto
+    if (job->sched != NULL) {
+      fprintf(out, "\t(%s)", job->sched);
+    }
+    fputc('\n', out);
+  } else {
+    fprintf(out, "[%d]%c  %s\t\t%s\n", job->id, job_mark(job),
+            state_text(job, buf, sizeof(buf)), job->command);
+  }
+}
+
+int job_background(struct s_job *job) {
+  if (job->count == 0) {
+    job_remove(job);
+    return 127;
+  }
+  printf("[%d] %d\n", job->id, job->procs[job->count - 1].pid);
+  return 0;
+}
+
+/** Envía SIGCONT a un trabajo y lo marca en ejecución. */
+static void continue_job(struct s_job *job) {
+  if (kill(-job->pgid, SIGCONT) < 0) {
+    perror("kill(SIGCONT)");
+  }
+  for (int i = 0; i < job->count; i++) {
+    if (job->procs[i].state == JOB_STOPPED) {
+      job->procs[i].state = JOB_RUNNING;
+    }
+  }
+  job->stopped = 0;
+  job->pending = 0; // Un aviso de suspensión ya no corresponde
+  update_state(job);
+}
+
+/** Indica si la shell puede entregar la terminal a sus trabajos. */
+static int owns_terminal(void) {
+  return job_control && isatty(STDIN_FILENO);
+}
+
+/** Pone un trabajo en primer plano, sin entregarle todavía la terminal. */
+static void enter_foreground(struct s_job *job) {
+  job->foreground = 1;
+  job->pending = 0;
+  touch(job);
+  foreground_pid = job->pgid;
+}
+
+/**
+ * @brief Espera a que un trabajo en primer plano termine o se suspenda y
+ * recupera la terminal. Si se suspendió, lo informa.
+ */
+static void leave_foreground(struct s_job *job, int terminal) {
+  if (wait_job(job, 0) == -1) {
+    perror("waitpid");
+  }
+
+  if (terminal) {
+    // Recuperar la terminal y sus modos; los del trabajo se guardan para
+    // restaurarlos si vuelve al primer plano
+    if (tcsetpgrp(STDIN_FILENO, shell_pgid) == -1) {
+      perror("tcsetpgrp");
+    }
+    if (job->state == JOB_STOPPED) {
+      job->has_tmodes = tcgetattr(STDIN_FILENO, &job->tmodes) == 0;
+    }
+    if (tcsetattr(STDIN_FILENO, TCSADRAIN, &shell_tmodes) == -1) {
+      perror("tcsetattr");
+    }
+  }
+  foreground_pid = 0;
+  job->foreground = 0;
+
+  if (job->state == JOB_STOPPED) {
+    printf("\n");
+    print_job(stdout, job, 0);
+  }
+}
+
+int job_foreground(struct s_job *job, int resume) {
+  if (job->count == 0) {
+    job_remove(job);
+    return 127;
+  }
+
+  int terminal = owns_terminal();
+  enter_foreground(job);
+  if (terminal && tcsetpgrp(STDIN_FILENO, job->pgid) == -1) {
+    perror("tcsetpgrp");
+  }
+  if (resume) {
+    if (terminal && job->has_tmodes &&
+        tcsetattr(STDIN_FILENO, TCSADRAIN, &job->tmodes) == -1) {
+      perror("tcsetattr");
+    }
+    continue_job(job);
+  }
+
+  leave_foreground(job, terminal);
+  if (job->state == JOB_STOPPED) {
+    return command_status(job->stop_status);
+  }
+  int status = command_status(job->procs[job->count - 1].status);
+  if (job->state == JOB_DONE) {
+    job_remove(job);
+  }
+  return status;
+}
+
+pid_t job_wait_any(struct s_job *job, int *status) {
+  if (!job->foreground) {
+    enter_foreground(job);
+  }
+  // Cada proceso nuevo pudo crear otro grupo (ver job_pgid)
+  foreground_pid = job->pgid;
+
+  for (;;) {
+    for (int i = 0; i < job->count; i++) {
+      if (job->procs[i].state == JOB_DONE) {
+        pid_t pid = job->procs[i].pid;
+        *status = job->procs[i].status;
+        release_child(pid);
+        // Así el trabajo solo guarda los procesos en curso
+        memmove(&job->procs[i], &job->procs[i + 1],
+                (job->count - i - 1) * sizeof(*job->procs));
+        job->count--;
+        return pid;
+      }
+    }
+    if (job->state != JOB_RUNNING || job->alive == 0) {
+      return job->state == JOB_STOPPED ? 0 : -1;
+    }
+
+    if (!event_loop_active()) {
+      // Sin bucle, se espera al más antiguo
+      for (int i = 0; i < job->count; i++) {
+        if (job->procs[i].state == JOB_RUNNING) {
+          int result = 0;
+          struct rusage usage;
+          pid_t pid;
+          while ((pid = wait4(job->procs[i].pid, &result, WUNTRACED,
+                              &usage)) == -1 &&
+                 errno == EINTR) {
+          }
+          process_changed(job, &job->procs[i], pid == -1 ? 0 : result,
+                          pid == -1 ? NULL : &usage);
+          break;
+        }
+      }
+      continue;
+    }
+    reap_stopped(job->pgid);
+    if (job->state == JOB_RUNNING && event_loop_wait(0) == -1) {
+      return -1;
+    }
+  }
+}
+
+int job_end_foreground(struct s_job *job) {
+  if (!job->foreground) {
+    enter_foreground(job);
+  }
+  update_state(job); // Pudo quedar sin procesos
+  leave_foreground(job, owns_terminal());
+  if (job->state == JOB_STOPPED) {
+    return 1;
+  }
+  job_remove(job);
+  return 0;
+}
+
+int report_jobs(FILE *out) {
+  int reported = 0;
+
+  if (!event_loop_active()) {
+    poll_direct();
+  }
+  for (size_t i = 0; i < pending_count; i++) {
+    // El trabajo pudo salir de la tabla (por ejemplo, con `wait %n`) y su
+    // número pasar a otro trabajo sin aviso pendiente
+    struct s_job *job = job_find(pending[i]);
+    if (job == NULL || !job->pending) {
+      continue;
+    }
+    job->pending = 0;
+    fprintf(out, "\n");
+    print_job(out, job, 0);
+    reported++;
+    if (job->state == JOB_DONE) {
+      job_remove(job);
+    }
+  }
+  pending_count = 0;
+  return reported;
+}
+
+int running_jobs(void) { return running_count; }
+
+/**
+ * @brief Busca un trabajo a partir de `%n`, `%+`, `%%`, `%-` o `n`; sin
+ * especificación, el trabajo actual. Informa el error si no existe.
+ */
+static struct s_job *job_from_spec(const char *builtin, const char *spec) {
+  struct s_job *job;
+
+  if (spec == NULL || strcmp(spec, "%") == 0 || strcmp(spec, "%%") == 0 ||
+      strcmp(spec, "%+") == 0) {
+    job = recent;
+  } else if (strcmp(spec, "%-") == 0) {
+    job = recent ? recent->older : NULL;
+  } else {
+    char *end;
+    const char *number = spec[0] == '%' ? spec + 1 : spec;
+    long id = strtol(number, &end, 10);
+    if (*end != '\0' || end == number || id <= 0 || id > INT_MAX) {
+      fprintf(stderr, "%s: %s: especificación de trabajo inválida\n", builtin,
+              spec);
+      return NULL;
+    }
+    job = job_find((int)id);
+  }
+
+  if (job == NULL) {
+    if (spec == NULL) {
+      fprintf(stderr, "%s: no hay trabajo actual\n", builtin);
+    } else {
+      fprintf(stderr, "%s: %s: no existe ese trabajo\n", builtin, spec);
+    }
+  }
+  return job;
+}
+
+int jobs_command(char **args) {
+  int with_pgid = 0, only_pgid = 0;
+
+  for (int i = 1; args[i] != NULL; i++) {
+    if (strcmp(args[i], "-l") == 0) {
+      with_pgid = 1;
+    } else if (strcmp(args[i], "-p") == 0) {
+      only_pgid = 1;
+    } else {
+      fprintf(stderr, "jobs: opción inválida: %s\n", args[i]);
+      return 2;
+    }
+  }
+
+  if (!event_loop_active()) {
+    poll_direct();
+  }
+  // Lo pendiente en stdout debe salir antes que la lista
+  fflush(stdout);
+  for (int id = 1; id <= last_id; id++) {
+    struct s_job *job = table[id];
+    if (job == NULL || (job->count == 0 && job->state != JOB_QUEUED)) {
+      continue;
+    }
+    if (only_pgid) {
+      if (job->state == JOB_QUEUED) {
+        continue; // Todavía no tiene grupo
+      }
+      printf("%d\n", job->pgid);
+      continue;
+    }
+    print_job(stdout, job, with_pgid);
+    // Un trabajo terminado ya se informó aquí
+    job->pending = 0;
+    if (job->state == JOB_DONE) {
+      job_remove(job);
+    }
+  }
+  return 0;
+}
+
+int fg_command(char **args) {
+  struct s_job *job = job_from_spec("fg", args[1]);
+  if (job == NULL) {
+    return 1;
+  }
+  if (job->state == JOB_DONE) {
+    fprintf(stderr, "fg: el trabajo %d ya terminó\n", job->id);
+    return 1;
+  }
+  printf("%s\n", job->command);
+  if (job->state == JOB_QUEUED) {
+    // Se lanza sin esperar su turno; si no pudo lanzarse, ya no está
+    int id = job->id;
+    int status = admission_start(job);
+    return job_find(id) ? job_foreground(job, 0) : status;
+  }
+  return job_foreground(job, 1);
+}
+
+int bg_command(char **args) {
+  int count = 0;
+  int status = 0;
+
+  while (args[count + 1] != NULL) {
+    count++;
+  }
+  // Sin argumentos, el trabajo actual: args[1] es NULL
+  for (int i = 1; i <= (count ? count : 1); i++) {
+    struct s_job *job = job_from_spec("bg", args[i]);
+    if (job == NULL) {
+      status = 1;
+    } else if (job->state == JOB_DONE) {
+      fprintf(stderr, "bg: el trabajo %d ya terminó\n", job->id);
+      status = 1;
+    } else if (job->state == JOB_RUNNING) {
+      fprintf(stderr, "bg: el trabajo %d ya está en segundo plano\n",
+              job->id);
+    } else if (job->state == JOB_QUEUED) {
+      admission_start(job); // Sin esperar su turno
+    } else {
+      continue_job(job);
+      printf("[%d]%c %s &\n", job->id, job_mark(job), job->command);
+    }
+  }
+  return status;
+}
+
+/** Señales que `kill` reconoce por nombre. */
+static const struct {
+  const char *name;
+  int number;
+} signal_names[] = {
+    {"HUP", SIGHUP},   {"INT", SIGINT},   {"QUIT", SIGQUIT},
+    {"ILL", SIGILL},   {"TRAP", SIGTRAP}, {"ABRT", SIGABRT},
+    {"BUS", SIGBUS},   {"FPE", SIGFPE},   {"KILL", SIGKILL},
+    {"USR1", SIGUSR1}, {"SEGV", SIGSEGV}, {"USR2", SIGUSR2},
+    {"PIPE", SIGPIPE}, {"ALRM", SIGALRM}, {"TERM", SIGTERM},
+    {"CHLD", SIGCHLD}, {"CONT", SIGCONT}, {"STOP", SIGSTOP},
+    {"TSTP", SIGTSTP}, {"TTIN", SIGTTIN}, {"TTOU", SIGTTOU},
+    {"URG", SIGURG},   {"XCPU", SIGXCPU}, {"XFSZ", SIGXFSZ},
+    {"WINCH", SIGWINCH}};
+
+/** Convierte "TERM", "SIGTERM" o "15" en un número de señal, o -1. */
+static int parse_signal(const char *name) {
+  char *end;
+  long number = strtol(name, &end, 10);
+  if (*end == '\0' && end != name) {
+    return number >= 0 && number < NSIG ? (int)number : -1;
+  }
+  if (strncmp(name, "SIG", 3) == 0) {
+    name += 3;
+  }
+  for (size_t i = 0; i < sizeof(signal_names) / sizeof(signal_names[0]);
+       i++) {
+    if (strcmp(name, signal_names[i].name) == 0) {
+      return signal_names[i].number;
+    }
+  }
+  return -1;
+}
+
+int kill_command(char **args) {
+  int sig = SIGTERM;
+  int i = 1;
+
+  if (args[1] != NULL && strcmp(args[1], "-l") == 0) {
+    for (size_t j = 0; j < sizeof(signal_names) / sizeof(signal_names[0]);
+         j++) {
+      printf("%2d) SIG%s\n", signal_names[j].number, signal_names[j].name);
+    }
+    return 0;
+  }
+  if (args[1] != NULL && strcmp(args[1], "-s") == 0) {
+    sig = args[2] ? parse_signal(args[2]) : -1;
+    i = 3;
+  } else if (args[1] != NULL && args[1][0] == '-' && args[1][1] != '\0') {
+    sig = parse_signal(args[1] + 1);
+    i = 2;
+  }
+  if (sig == -1) {
+    fprintf(stderr, "kill: señal inválida\n");
+    return 2;
+  }
+  if (args[i] == NULL) {
+    fprintf(stderr, "kill: uso: kill [-s señal | -señal] %%trabajo | pid "
+                    "...\n");
+    return 2;
+  }
+
+  int status = 0;
+  for (; args[i] != NULL; i++) {
+    if (args[i][0] == '%') {
+      struct s_job *job = job_from_spec("kill", args[i]);
+      if (job == NULL || job->state == JOB_DONE) {
+        status = 1;
+        continue;
+      }
+      if (job->state == JOB_QUEUED) {
+        job_remove(job); // Todavía no tiene procesos: sale de la cola
+        continue;
+      }
+      if (kill(-job->pgid, sig) < 0) {
+        perror("kill");
+        status = 1;
+      } else if (job->state == JOB_STOPPED &&
+                 (sig == SIGTERM || sig == SIGHUP)) {
+        // Un trabajo suspendido no atiende la señal hasta continuar
+        kill(-job->pgid, SIGCONT);
+      }
+      continue;
+    }
+
+    char *end;
+    long pid = strtol(args[i], &end, 10);
+    if (*end != '\0' || end == args[i]) {
+      fprintf(stderr, "kill: %s: no es un PID ni un trabajo válido\n",
+              args[i]);
+      status = 1;
+    } else if (kill((pid_t)pid, sig) < 0) {
+      perror("kill");
+      status = 1;
+    }
+  }
+  return status;
+}
+
+/** Busca el trabajo y el proceso de un PID: O(1) con el bucle activo. */
+static struct s_job *job_of_pid(pid_t pid, struct s_process **proc) {
+  struct s_job *job = NULL;
+
+  if (event_loop_active()) {
+    job = job_find(child_job(pid));
+  } else {
+    for (int id = 1; id <= last_id && job == NULL; id++) {
+      if (table[id] && find_process(table[id], pid)) {
+        job = table[id];
+      }
+    }
+  }
+  *proc = job ? find_process(job, pid) : NULL;
+  return *proc ? job : NULL;
+}
+
+/** `wait pid`: espera a un proceso de un trabajo. */
+static int wait_pid(const char *arg) {
+  char *end;
+  long pid = strtol(arg, &end, 10);
+  struct s_process *proc;
+
+  if (*end != '\0' || end == arg || pid <= 0) {
+    fprintf(stderr, "wait: `%s': no es un PID ni un trabajo válido\n", arg);
+    return 2;
+  }
+  struct s_job *job = job_of_pid((pid_t)pid, &proc);
+  if (job == NULL) {
+    fprintf(stderr, "wait: el proceso %ld no es hijo de esta shell\n", pid);
+    return 127;
+  }
+
+  while (proc->state != JOB_DONE) {
+    if (!event_loop_active()) {
+      int status = 0;
+      struct rusage usage;
+      pid_t pid;
+      while ((pid = wait4(proc->pid, &status, 0, &usage)) == -1 &&
+             errno == EINTR) {
+      }
+      process_changed(job, proc, status, pid == -1 ? NULL : &usage);
+      break;
+    }
+    int result = event_loop_wait(1);
+    if (result != 1) {
+      return result == 0 ? 130 : 1;
+    }
+  }
+
+  int status = command_status(proc->status);
+  if (job->state == JOB_DONE) {
+    job_remove(job); // Su estado lo informa wait, no un aviso
+  }
+  return status;
+}
+
+int wait_command(char **args) {
+  // Cada proceso que termina despierta una sola vez al bucle, por su pidfd:
+  // la espera de N trabajos cuesta O(N) en total
+  if (args[1] == NULL) {
+    if (!event_loop_active()) {
+      for (int id = 1; id <= last_id; id++) {
+        if (table[id] && table[id]->state == JOB_RUNNING) {
+          wait_direct(table[id]);
+        }
+      }
+      return 0;
+    }
+    while (running_count > 0 || admission_queued() > 0) {
+      int result = event_loop_wait(1);
+      if (result != 1) {
+        return result == 0 ? 130 : 1;
+      }
+    }
+    return 0;
+  }
+
+  int status = 0;
+  for (int i = 1; args[i] != NULL; i++) {
+    if (args[i][0] != '%') {
+      status = wait_pid(args[i]);
+      if (status == 130) {
+        return status;
+      }
+      continue;
+    }
+
+    struct s_job *job = job_from_spec("wait", args[i]);
+    if (job == NULL) {
+      status = 127;
+      continue;
+    }
+    // Un trabajo en cola se espera hasta que se lanza; si no pudo lanzarse,
+    // ya no está en la tabla
+    int id = job->id;
+    while (job != NULL && job->state == JOB_QUEUED) {
+      int result = event_loop_wait(1);
+      if (result != 1) {
+        return result == 0 ? 130 : 1;
+      }
+      job = job_find(id);
+    }
+    if (job == NULL) {
+      status = 127;
+      continue;
+    }
+    int result = wait_job(job, 1);
+    if (result != 1) {
+      return result == 0 ? 130 : 1;
+    }
+    if (job->state == JOB_STOPPED) {
+      status = command_status(job->stop_status);
+    } else {
+      status = command_status(job->procs[job->count - 1].status);
+      job_remove(job); // Su estado lo informa wait, no un aviso
+    }
+  }
+  return status;
+}
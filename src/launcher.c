@@ -0,0 +1,214 @@
+// launcher.c
+//
+// Este archivo contiene el lanzamiento de comandos externos con posix_spawn y
+// el camino alternativo con fork + execv.
+
+#define _GNU_SOURCE // posix_spawn_file_actions_addtcsetpgrp_np
+
+#include "launcher.h"
+#include "path_cache.h"
+#include "schedctl.h"
+#include "zygote.h"
+#include <errno.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// glibc 2.35 agregó una acción para que el hijo tome la terminal antes de
+// ejecutar el programa, igual que lo hace el hijo de fork.
+#if defined(__GLIBC__) &&                                                      \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35))
+#define HAVE_SPAWN_TCSETPGRP 1
+#else
+#define HAVE_SPAWN_TCSETPGRP 0
+#endif
+
+extern char **environ;
+
+static int launch_mode = LAUNCH_SPAWN;
+
+void launch_set_mode(int mode) { launch_mode = mode; }
+
+int launch_configure(const char *name) {
+  if (name == NULL || strcmp(name, "spawn") == 0) {
+    launch_mode = LAUNCH_SPAWN;
+  } else if (strcmp(name, "fork") == 0) {
+    launch_mode = LAUNCH_FORK;
+  } else if (strcmp(name, "zygote") == 0) {
+    if (zygote_start() == -1) {
+      launch_mode = LAUNCH_SPAWN;
+      return -1;
+    }
+    launch_mode = LAUNCH_ZYGOTE;
+  } else {
+    fprintf(stderr, "%s: modo de lanzamiento desconocido '%s'\n", LAUNCH_ENV,
+            name);
+    return -1;
+  }
+  return 0;
+}
+
+/** Indica si el hijo debe tomar la terminal. */
+static int wants_terminal(const struct s_launch *launch) {
+  return launch->foreground && isatty(STDIN_FILENO);
+}
+
+/** Redirige `fd` sobre `target` en el hijo de fork. */
+static void redirect_fd(int fd, int target) {
+  if (fd == -1 || fd == target) {
+    return;
+  }
+  if (dup2(fd, target) == -1) {
+    perror("Error al redirigir");
+    _exit(EXIT_FAILURE);
+  }
+  close(fd);
+}
+
+static pid_t launch_fork(const struct s_launch *launch, const char *path) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    setpgid(0, launch->pgid);
+
+    if (wants_terminal(launch) &&
+        tcsetpgrp(STDIN_FILENO, launch->pgid ? launch->pgid : getpid()) == -1) {
+      perror("tcsetpgrp");
+      exit(EXIT_FAILURE);
+    }
+
+    if (launch->close_fd != -1) {
+      close(launch->close_fd);
+    }
+    redirect_fd(launch->in_fd, STDIN_FILENO);
+    redirect_fd(launch->out_fd, STDOUT_FILENO);
+    redirect_fd(launch->err_fd, STDERR_FILENO);
+
+    sigset_t empty;
+    sigemptyset(&empty);
+    sigprocmask(SIG_SETMASK, &empty, NULL);
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTSTP, SIG_DFL);
+    signal(SIGQUIT, SIG_DFL);
+
+    if (schedctl_apply() == -1) {
+      exit(EXIT_FAILURE);
+    }
+    execv(path, launch->argv);
+    perror("Error en el comando");
+    exit(EXIT_FAILURE);
+  } else if (pid < 0) {
+    perror("Error al crear el proceso");
+  }
+  return pid;
+}
+
+static int add_redirection(posix_spawn_file_actions_t *actions, int fd,
+                           int target) {
+  if (fd == -1 || fd == target) {
+    return 0;
+  }
+  int err = posix_spawn_file_actions_adddup2(actions, fd, target);
+  if (err == 0) {
+    err = posix_spawn_file_actions_addclose(actions, fd);
+  }
+  return err;
+}
+
+static pid_t launch_spawn(const struct s_launch *launch, const char *path) {
+  posix_spawn_file_actions_t actions;
+  posix_spawnattr_t attr;
+  sigset_t defaults, empty;
+  pid_t pid = -1;
+  int err;
+
+  if ((err = posix_spawn_file_actions_init(&actions)) != 0) {
+    fprintf(stderr, "posix_spawn: %s\n", strerror(err));
+    return -1;
+  }
+  if ((err = posix_spawnattr_init(&attr)) != 0) {
+    posix_spawn_file_actions_destroy(&actions);
+    fprintf(stderr, "posix_spawn: %s\n", strerror(err));
+    return -1;
+  }
+
+  // Mismas señales que restaura reset_signal_handlers() en los hijos de fork
+  sigemptyset(&defaults);
+  sigaddset(&defaults, SIGINT);
+  sigaddset(&defaults, SIGTSTP);
+  sigaddset(&defaults, SIGQUIT);
+  sigemptyset(&empty);
+
+  posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP |
+                                      POSIX_SPAWN_SETSIGDEF |
+                                      POSIX_SPAWN_SETSIGMASK);
+  posix_spawnattr_setpgroup(&attr, launch->pgid);
+  posix_spawnattr_setsigdefault(&attr, &defaults);
+  posix_spawnattr_setsigmask(&attr, &empty);
+
+#if HAVE_SPAWN_TCSETPGRP
+  if (wants_terminal(launch)) {
+    err = posix_spawn_file_actions_addtcsetpgrp_np(&actions, STDIN_FILENO);
+  }
+#endif
+  if (err == 0 && launch->close_fd != -1) {
+    err = posix_spawn_file_actions_addclose(&actions, launch->close_fd);
+  }
+  if (err == 0) {
+    err = add_redirection(&actions, launch->in_fd, STDIN_FILENO);
+  }
+  if (err == 0) {
+    err = add_redirection(&actions, launch->out_fd, STDOUT_FILENO);
+  }
+  if (err == 0) {
+    err = add_redirection(&actions, launch->err_fd, STDERR_FILENO);
+  }
+  if (err == 0) {
+    err = posix_spawn(&pid, path, &actions, &attr, launch->argv, environ);
+  }
+
+  posix_spawnattr_destroy(&attr);
+  posix_spawn_file_actions_destroy(&actions);
+
+  if (err != 0) {
+    fprintf(stderr, "Error en el comando: %s\n", strerror(err));
+    return -1;
+  }
+  return pid;
+}
+
+pid_t launch_process(const struct s_launch *launch) {
+  pid_t pid;
+
+  // La ruta se resuelve una vez en el padre y se recuerda para las próximas
+  // ejecuciones, en lugar de que execvp recorra PATH en cada hijo
+  const char *path = path_cache_lookup(launch->argv[0]);
+  if (path == NULL) {
+    fprintf(stderr, "Error en el comando: %s\n", strerror(ENOENT));
+    return -1;
+  }
+
+  // posix_spawn y el zygote no pueden fijar la afinidad ni la prioridad de
+  // E/S del hijo (ver schedctl.h)
+  if (schedctl_active()) {
+    pid = launch_fork(launch, path);
+  } else if (launch_mode == LAUNCH_ZYGOTE &&
+             zygote_spawn(launch, path, &pid) == 0) {
+    // El zygote atendió el pedido
+  } else if (launch_mode == LAUNCH_FORK ||
+             (!HAVE_SPAWN_TCSETPGRP && wants_terminal(launch))) {
+    pid = launch_fork(launch, path);
+  } else {
+    pid = launch_spawn(launch, path);
+  }
+
+  // También desde el padre, para que el grupo exista antes de usarlo sin
+  // importar cuál de los dos procesos corra primero. Falla sin consecuencias
+  // si el hijo ya ejecutó el programa.
+  if (pid > 0) {
+    setpgid(pid, launch->pgid ? launch->pgid : pid);
+  }
+  return pid;
+}
@@ -0,0 +1,168 @@
+// lexer.c
+//
+// Este archivo contiene el analizador léxico que divide una línea de
+// comandos en palabras y operadores, resolviendo comillas y escapes.
+
+#include "lexer.h"
+#include "scan.h"
+#include <ctype.h>
+#include <string.h>
+
+int lexer_init(struct s_lexer *lexer, const char *line, size_t len,
+               struct s_arena *arena) {
+  // Cada palabra ocupa a lo sumo lo que ocupaba en la línea más su '\0', y
+  // hay a lo sumo una palabra por cada dos caracteres
+  lexer->pos = line;
+  lexer->end = line + len;
+  lexer->arena = arena;
+  lexer->out = arena_alloc(arena, 2 * len + 2);
+  return lexer->out ? 0 : -1;
+}
+
+static int is_operator_char(char c) {
+  return c == '|' || c == '&' || c == ';' || c == '(' || c == ')' ||
+         c == '<' || c == '>' || c == '\n';
+}
+
+/**
+ * @brief Reconoce un operador al comienzo de `p`.
+ *
+ * @return size_t Cantidad de caracteres del operador (0 si no hay).
+ */
+static size_t read_operator(const char *p, const char *end,
+                            struct s_token *token) {
+  static const struct {
+    const char *text;
+    enum e_token_type type;
+  } operators[] = {{"&&", TOKEN_AND_IF}, {"||", TOKEN_OR_IF},
+                   {">>", TOKEN_DGREAT}, {"|", TOKEN_PIPE},
+                   {"&", TOKEN_AMP},     {";", TOKEN_SEMI},
+                   {"\n", TOKEN_SEMI},   {"(", TOKEN_LPAREN},
+                   {")", TOKEN_RPAREN},  {"<", TOKEN_LESS},
+                   {">", TOKEN_GREAT}};
+
+  for (size_t i = 0; i < sizeof(operators) / sizeof(operators[0]); i++) {
+    size_t n = strlen(operators[i].text);
+    if ((size_t)(end - p) >= n && memcmp(p, operators[i].text, n) == 0) {
+      token->type = operators[i].type;
+      token->text = (char *)operators[i].text;
+      token->fd = operators[i].type == TOKEN_LESS ? 0 : 1;
+      return n;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Lee una palabra, quitando comillas y escapes.
+ */
+static enum e_token_type read_word(struct s_lexer *lexer,
+                                   struct s_token *token) {
+  const char *p = lexer->pos;
+  const char *end = lexer->end;
+  char *out = lexer->out;
+  int quoted = 0;
+
+  token->text = out;
+  while (p < end) {
+    // Los caracteres comunes se copian por tiradas, no de a uno
+    size_t n = scan_word(p, end - p);
+    memcpy(out, p, n);
+    out += n;
+    p += n;
+    if (p == end || isspace((unsigned char)*p) || is_operator_char(*p)) {
+      break;
+    }
+
+    if (*p == '\'') {
+      const char *close = memchr(p + 1, '\'', end - p - 1);
+      if (!close) {
+        token->text = "comilla sin cerrar";
+        return token->type = TOKEN_ERROR;
+      }
+      memcpy(out, p + 1, close - p - 1);
+      out += close - p - 1;
+      p = close + 1;
+      quoted = 1;
+    } else if (*p == '"') {
+      p++;
+      for (;;) {
+        n = scan_dquote(p, end - p);
+        memcpy(out, p, n);
+        out += n;
+        p += n;
+        if (p == end || *p == '"') {
+          break;
+        }
+        // Una barra solo escapa ", \, $ y `; si no, se conserva
+        if (p + 1 < end && memchr("\"\\$`", p[1], 4)) {
+          p++;
+        }
+        *out++ = *p++;
+      }
+      if (p == end) {
+        token->text = "comilla sin cerrar";
+        return token->type = TOKEN_ERROR;
+      }
+      p++;
+      quoted = 1;
+    } else if (*p == '\\') {
+      if (p + 1 < end) {
+        *out++ = p[1];
+        p += 2;
+      } else {
+        p++; // Una barra al final de la línea no agrega nada
+      }
+      quoted = 1;
+    } else {
+      *out++ = *p++; // `$` todavía no tiene significado especial
+    }
+  }
+  *out++ = '\0';
+
+  lexer->pos = p;
+  lexer->out = out;
+  token->quoted = quoted;
+  token->fd = -1;
+  return token->type = TOKEN_WORD;
+}
+
+enum e_token_type lexer_next(struct s_lexer *lexer, struct s_token *token) {
+  const char *p = lexer->pos;
+  const char *end = lexer->end;
+
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+    p++;
+  }
+  lexer->pos = p;
+  token->quoted = 0;
+
+  if (p == end || *p == '#') {
+    token->text = "fin de línea";
+    return token->type = TOKEN_END;
+  }
+
+  // `2>archivo`: los dígitos pegados a < o > indican el descriptor
+  const char *digits = p;
+  while (digits < end && isdigit((unsigned char)*digits)) {
+    digits++;
+  }
+  if (digits > p && digits < end && digits - p < 4 &&
+      (*digits == '<' || *digits == '>')) {
+    int fd = 0;
+    for (const char *d = p; d < digits; d++) {
+      fd = fd * 10 + (*d - '0');
+    }
+    lexer->pos = digits + read_operator(digits, end, token);
+    token->fd = fd;
+    return token->type;
+  }
+
+  // La mayoría de los tokens son palabras: no se buscan operadores en ellas
+  size_t n = is_operator_char(*p) ? read_operator(p, end, token) : 0;
+  if (n > 0) {
+    lexer->pos = p + n;
+    return token->type;
+  }
+  return read_word(lexer, token);
+}
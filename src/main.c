@@ -2,12 +2,19 @@
 
 #define _POSIX_C_SOURCE 200809L // Define el estándar POSIX
 
+#include "alloc_config.h"
+#include "arena.h"
+#include "ast.h"
 #include "commands.h"
+#include "event_loop.h"
+#include "executor.h"
 #include "globals.h"
+#include "jobs.h"
+#include "launcher.h"
 #include "monitorHandle.h"
-#include "parser.h"
-#include "pipes.h"
 #include "prompt.h"
+#include "script.h"
+#include "script_cache.h"
 #include "signals.h" // signals.h ya incluye <signal.h>
 #include "utils.h"
 #include "file_finder.h"
@@ -64,38 +71,40 @@ void show_banner() {
 }
 
 int main(int argc, char *argv[]) {
+  // El zygote (SHELL_LAUNCH=zygote) se crea antes que nada, mientras la
+  // imagen de la shell es pequeña y no hay otros descriptores abiertos
+  launch_configure(getenv(LAUNCH_ENV));
+
+  // Opciones: -q no muestra los comandos de un script antes de ejecutarlos
+  int echo_commands = 1;
+  int opt;
+  while ((opt = getopt(argc, argv, "q")) != -1) {
+    if (opt == 'q') {
+      echo_commands = 0;
+    } else {
+      fprintf(stderr, "Uso: %s [-q] [archivo]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+  const char *script_path = optind < argc ? argv[optind] : NULL;
+
   show_banner();
 
   // Definición de variables globales
   foreground_pid = 0;
-  foreground_suspended = 0;
 
-  char input[MY_MAX_INPUT];
-  char *args[MAX_ARGS];
-  char *commands[MAX_PIPELINE];
-  int num_commands;
+  char *input = NULL; // Línea leída; se agranda según haga falta
+  size_t input_capacity = 0;
+  ssize_t input_length;
   int running = 1;
-  FILE *input_file = NULL;
-
-  // Configurar el manejador de SIGCHLD
-  struct sigaction sa_chld;
-  sa_chld.sa_handler = sigchld_handler;
-  sigemptyset(&sa_chld.sa_mask);
-  sa_chld.sa_flags = SA_RESTART | SA_NOCLDSTOP;
-  if (sigaction(SIGCHLD, &sa_chld, NULL) == -1) {
-    perror("sigaction SIGCHLD");
-    exit(EXIT_FAILURE);
-  }
-
-  // Configurar el manejador de señales para SIGINT, SIGTSTP y SIGQUIT
-  struct sigaction sa;
-  sa.sa_handler = shell_signal_handler;
-  sigemptyset(&sa.sa_mask);
-  sa.sa_flags = SA_RESTART;
-  if (sigaction(SIGINT, &sa, NULL) == -1 ||
-      sigaction(SIGTSTP, &sa, NULL) == -1 ||
-      sigaction(SIGQUIT, &sa, NULL) == -1) {
-    perror("sigaction");
+  struct s_script script; // Archivo de comandos, si se indicó uno
+  struct s_script_cache cache; // Su versión ya analizada, si está en la caché
+  int cached = 0;
+  struct s_arena arena; // Memoria del árbol de la línea actual
+
+  // SIGCHLD, SIGINT, SIGTSTP y SIGQUIT se atienden en el bucle de eventos,
+  // fuera del contexto de un manejador de señales
+  if (event_loop_init() == -1) {
     exit(EXIT_FAILURE);
   }
 
@@ -122,16 +131,34 @@ int main(int argc, char *argv[]) {
     exit(EXIT_FAILURE);
   }
 
-  // Si se proporciona un archivo de comandos como argumento, abrirlo
-  if (argc > 1) {
-    input_file = fopen(argv[1], "r");
-    if (input_file == NULL) {
-      perror("Error al abrir el archivo de comandos");
-      return EXIT_FAILURE;
+  // Si se proporciona un archivo de comandos como argumento, cargarlo: de la
+  // caché si ya se analizó sin cambios desde entonces, o del archivo (y en
+  // ese caso se analiza completo y se guarda para la próxima vez)
+  if (script_path != NULL) {
+    cached = script_cache_load(&cache, script_path) == 0;
+    if (!cached) {
+      if (script_open(&script, script_path) == -1) {
+        perror("Error al abrir el archivo de comandos");
+        return EXIT_FAILURE;
+      }
+      if (script_cache_store(script_path, &script) == 0 &&
+          script_cache_load(&cache, script_path) == 0) {
+        script_close(&script);
+        cached = 1;
+      }
     }
+  }
 
-    setvbuf(input_file, NULL, _IONBF, 0); // Desactiva el buffering
-
+  // Exportar la política del asignador definida en config.json para que la
+  // hereden los procesos lanzados desde la shell. Si la ruta no entra en
+  // PATH_MAX no se lee: truncada sería la de otro archivo
+  char exe_dir[PATH_MAX];
+  if (get_executable_dir(exe_dir, sizeof(exe_dir)) == 0) {
+    char config_path[PATH_MAX];
+    if ((size_t)snprintf(config_path, sizeof(config_path), "%s/config.json",
+                         exe_dir) < sizeof(config_path)) {
+      export_allocator_config(config_path);
+    }
   }
 
   // Cambiar al directorio de inicio del usuario
@@ -144,61 +171,72 @@ int main(int argc, char *argv[]) {
     fprintf(stderr, "No se pudo obtener el directorio HOME\n");
   }
 
+  arena_init(&arena);
+
   // Bucle principal de la shell
   while (running) {
-    // Mostrar el prompt solo si estamos en modo interactivo
-    if (input_file == NULL) {
-      print_prompt();
-    }
-
-    // Leer el input del usuario o del archivo de comandos
-    if (input_file != NULL) {
-      // Leer desde el archivo de comandos
-      if (fgets(input, sizeof(input), input_file) == NULL) {
-        break; // Salir si se alcanza el EOF
+    struct s_node *tree;
+
+    // Avisar de los trabajos en segundo plano que terminaron desde la línea
+    // anterior
+    event_loop_poll();
+    report_jobs(stdout);
+
+    if (script_path != NULL) {
+      const char *line;
+      size_t line_length;
+      int more;
+
+      if (cached) {
+        more = script_cache_next(&cache, &line, &line_length, &tree, &arena);
+      } else {
+        more = script_next_line(&script, &line, &line_length);
+        tree = NULL;
       }
-      printf("%s", input); // Imprimir el comando en pantalla para referencia
-    } else {
-      // Leer desde stdin
-      if (fgets(input, sizeof(input), stdin) == NULL) {
-        if (feof(stdin)) { // Fin de archivo (Ctrl-D)
-          printf("\n");
-          break;
-        } else {
-          perror("fgets");
-          continue;
-        }
+      if (!more) {
+        break; // Salir si se alcanza el final del archivo
+      }
+      if (echo_commands) {
+        // Imprimir el comando en pantalla para referencia
+        fwrite(line, 1, line_length, stdout);
+        putchar('\n');
       }
-    }
-
-    // Eliminar el salto de línea al final
-    input[strcspn(input, "\n")] = '\0';
 
-    // Verificar si el input contiene '|'
-    if (strchr(input, '|') != NULL) {
-      // Parsear la pipeline
-      num_commands = parse_pipeline(input, commands);
-      if (num_commands > 0) {
-        // Ejecutar la pipeline
-        execute_pipeline(commands, num_commands);
+      // Sin árbol (no hay caché, o la línea está vacía o tiene errores) la
+      // línea se analiza aquí, directamente desde el contenido del script,
+      // para que los errores se informen en su momento
+      if (tree == NULL) {
+        tree = parse_buffer(line, line_length, &arena);
       }
     } else {
-      // Dividir el input en argumentos
-      divisor_input(input, args);
-
-      // Si no hay ningún comando, continuar con el siguiente ciclo
-      if (args[0] == NULL) {
-        continue;
+      // Mostrar el prompt y leer de stdin, sin límite de longitud; mientras
+      // se espera, el bucle atiende las señales y los procesos hijos
+      print_prompt();
+      fflush(stdout);
+      input_length = event_loop_read_line(&input, &input_capacity);
+      if (input_length == -1) { // Fin de archivo (Ctrl-D)
+        printf("\n");
+        break;
       }
+      tree = parse_buffer(input, (size_t)input_length, &arena);
+    }
 
-      // Ejecutar el comando
-      execute_command(args, &running);
+    // Ejecutar el árbol de la línea completa
+    if (tree != NULL) {
+      execute_node(tree, &running);
     }
+    arena_reset(&arena);
   }
 
-  // Cerrar el archivo de comandos si está abierto
-  if (input_file != NULL) {
-    fclose(input_file);
+  arena_destroy(&arena);
+  free(input);
+  event_loop_shutdown();
+
+  // Liberar el archivo de comandos si se cargó uno
+  if (cached) {
+    script_cache_close(&cache);
+  } else if (script_path != NULL) {
+    script_close(&script);
   }
 
   return 0;
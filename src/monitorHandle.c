@@ -3,6 +3,9 @@
  * @brief Implementaciones de funciones para controlar el programa de monitoreo.
  */
 
+#include "monitorHandle.h"
+#include "children.h"
+#include "event_loop.h"
 #include <cjson/cJSON.h>
 #include <errno.h>
 #include <fcntl.h> // Para open
@@ -10,11 +13,11 @@
 #include <libgen.h> // Para dirname
 #include <limits.h>
 #include <signal.h>
-#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 int testing_mode = 0; // Define la variable para las pruebas
@@ -27,10 +30,10 @@ pid_t monitor_pid = 0;
  */
 #define FIFO_PATH "/tmp/metrics_fifo"
 
-/**
- * @brief Variable de control para mantener la ejecución.
- */
-volatile bool keep_running = true;
+// Lectura de las métricas para la cola de admisión (ver monitor_load)
+static int load_fd = -1, load_writer_fd = -1;
+static double load_cpu_usage, load_free_memory;
+static time_t load_time; // Momento de la última muestra, o 0 si no hay
 
 int read_sampling_interval() {
   FILE *file = fopen("/tmp/sampling_interval.txt", "r");
@@ -110,6 +113,12 @@ void start_monitor() {
     // Crear proceso hijo para ejecutar metricShell
     pid_t metric_pid = fork();
     if (metric_pid == 0) {
+      // Las señales que la shell atiende en su bucle de eventos están
+      // bloqueadas, y la máscara se hereda a través de exec
+      sigset_t empty;
+      sigemptyset(&empty);
+      sigprocmask(SIG_SETMASK, &empty, NULL);
+
       // Proceso hijo: ejecuta metricShell con config.json como argumento
       printf("Ejecutando metricShell en el proceso hijo\n");
       execl(metric_path, "metricShell", config_path, NULL);
@@ -121,6 +130,7 @@ void start_monitor() {
       perror("Error al crear el proceso de metricShell");
     } else {
       monitor_pid = metric_pid;
+      track_child(metric_pid, 0, CHILD_QUIET); // Se recolecta sin avisos
       printf("MetricShell iniciado con PID %d\n", monitor_pid);
     }
   }
@@ -145,88 +155,146 @@ void stop_monitor() {
   }
 }
 
-void handle_sigint(int sig) {
-  (void)sig; // Evita advertencias por no usar el parámetro
-  printf("\nTerminando el monitor de estado...\n");
-  keep_running = false;
+/** Muestra las métricas de un mensaje del monitor. */
+static void print_metrics(int fifo_fd) {
+  char buffer[4096];
+  ssize_t bytes_read = read(fifo_fd, buffer, sizeof(buffer) - 1);
+  if (bytes_read > 0) {
+    buffer[bytes_read] = '\0';
+
+    cJSON *json = cJSON_Parse(buffer);
+    if (!json) {
+      fprintf(stderr, "Error al parsear JSON: %s\n", cJSON_GetErrorPtr());
+      return;
+    }
+
+    // Mostrar las métricas si existen
+    cJSON *cpu_usage = cJSON_GetObjectItem(json, "cpu_usage");
+    if (cJSON_IsNumber(cpu_usage)) {
+      printf("CPU Usage: %.2f%%\n", cpu_usage->valuedouble);
+    }
+
+    cJSON *total_memory = cJSON_GetObjectItem(json, "total_memory");
+    cJSON *used_memory = cJSON_GetObjectItem(json, "used_memory");
+    cJSON *free_memory = cJSON_GetObjectItem(json, "free_memory");
+    if (cJSON_IsNumber(total_memory) && cJSON_IsNumber(used_memory) &&
+        cJSON_IsNumber(free_memory)) {
+      printf("Memory Usage: Total: %.2f MB, Used: %.2f MB, Free: %.2f MB\n",
+             total_memory->valuedouble, used_memory->valuedouble,
+             free_memory->valuedouble);
+    }
+
+    cJSON *disk_reads = cJSON_GetObjectItem(json, "disk_reads");
+    cJSON *disk_writes = cJSON_GetObjectItem(json, "disk_writes");
+    if (cJSON_IsNumber(disk_reads) && cJSON_IsNumber(disk_writes)) {
+      printf("Disk Usage: Reads: %.0f, Writes: %.0f\n",
+             disk_reads->valuedouble, disk_writes->valuedouble);
+    }
+
+    cJSON *rx_bytes = cJSON_GetObjectItem(json, "rx_bytes");
+    cJSON *tx_bytes = cJSON_GetObjectItem(json, "tx_bytes");
+    if (cJSON_IsNumber(rx_bytes) && cJSON_IsNumber(tx_bytes)) {
+      printf("Network Usage: RX: %.0f bytes, TX: %.0f bytes\n",
+             rx_bytes->valuedouble, tx_bytes->valuedouble);
+    }
+
+    cJSON *context_switches = cJSON_GetObjectItem(json, "context_switches");
+    if (cJSON_IsNumber(context_switches)) {
+      printf("Context Switches: %.0f\n", context_switches->valuedouble);
+    }
+
+    cJSON *running_processes = cJSON_GetObjectItem(json, "running_processes");
+    if (cJSON_IsNumber(running_processes)) {
+      printf("Running Processes: %.0f\n", running_processes->valuedouble);
+    }
+
+    // Procesar la fragmentación de memoria antes de eliminar el objeto JSON
+    cJSON *memory_fragmentation = cJSON_GetObjectItem(json, "memory_fragmentation");
+    if (cJSON_IsNumber(memory_fragmentation)) {
+      printf("Memory Fragmentation: %.2f%%\n", memory_fragmentation->valuedouble * 100);
+    }
+
+    // Eliminar el objeto JSON después de usarlo
+    cJSON_Delete(json);
+  }
 }
 
 void status_monitor() {
-  // Registrar el manejador de señal para SIGINT
-  signal(SIGINT, handle_sigint);
   printf("\n Control + C para terminar el status.\n");
-  while (keep_running) {
-    int fifo_fd = open(FIFO_PATH, O_RDONLY | O_NONBLOCK);
-    if (fifo_fd < 0) {
-      perror("Error al abrir el FIFO para lectura");
-      sleep(1);
+  int fifo_fd = open(FIFO_PATH, O_RDONLY | O_NONBLOCK);
+  if (fifo_fd < 0) {
+    perror("Error al abrir el FIFO para lectura");
+    return;
+  }
+  // Con un extremo de escritura propio, el FIFO no queda en fin de archivo
+  // (y siempre listo para leer) mientras el monitor no lo tiene abierto
+  int writer_fd = open(FIFO_PATH, O_WRONLY | O_NONBLOCK);
+
+  // Cada mensaje del monitor se muestra apenas llega, sin consultar el FIFO
+  // periódicamente; Ctrl+C termina la espera
+  while (event_loop_wait_fd(fifo_fd, 1) == 1) {
+    print_metrics(fifo_fd);
+  }
+  printf("\nTerminando el monitor de estado...\n");
+
+  if (writer_fd != -1) {
+    close(writer_fd);
+  }
+  close(fifo_fd);
+  printf("Status monitor detenido.\n");
+}
+
+void monitor_load_close(void) {
+  if (load_writer_fd != -1) {
+    close(load_writer_fd);
+    load_writer_fd = -1;
+  }
+  if (load_fd != -1) {
+    close(load_fd);
+    load_fd = -1;
+  }
+  load_time = 0;
+}
+
+int monitor_load(double *cpu_usage, double *free_memory) {
+  if (monitor_pid <= 0 || testing_mode) {
+    monitor_load_close();
+    return -1;
+  }
+  if (load_fd == -1) {
+    load_fd = open(FIFO_PATH, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (load_fd == -1) {
+      return -1;
+    }
+    // Como en status_monitor, para que el FIFO no quede en fin de archivo
+    load_writer_fd = open(FIFO_PATH, O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+  }
+
+  // Se vacía el FIFO: cuenta el último mensaje
+  int fresh = 0;
+  char buffer[4096];
+  ssize_t n;
+  while ((n = read(load_fd, buffer, sizeof(buffer) - 1)) > 0) {
+    buffer[n] = '\0';
+    cJSON *json = cJSON_Parse(buffer);
+    if (json == NULL) {
       continue;
     }
+    cJSON *cpu = cJSON_GetObjectItem(json, "cpu_usage");
+    cJSON *memory = cJSON_GetObjectItem(json, "free_memory");
+    if (cJSON_IsNumber(cpu) && cJSON_IsNumber(memory)) {
+      load_cpu_usage = cpu->valuedouble;
+      load_free_memory = memory->valuedouble;
+      load_time = time(NULL);
+      fresh = 1;
+    }
+    cJSON_Delete(json);
+  }
 
-    char buffer[4096];
-    ssize_t bytes_read = read(fifo_fd, buffer, sizeof(buffer) - 1);
-    if (bytes_read > 0) {
-      buffer[bytes_read] = '\0';
-
-      cJSON *json = cJSON_Parse(buffer);
-      if (!json) {
-        fprintf(stderr, "Error al parsear JSON: %s\n", cJSON_GetErrorPtr());
-        close(fifo_fd);
-        continue;
-      }
-
-      // Mostrar las métricas si existen
-      cJSON *cpu_usage = cJSON_GetObjectItem(json, "cpu_usage");
-      if (cJSON_IsNumber(cpu_usage)) {
-        printf("CPU Usage: %.2f%%\n", cpu_usage->valuedouble);
-      }
-
-      cJSON *total_memory = cJSON_GetObjectItem(json, "total_memory");
-      cJSON *used_memory = cJSON_GetObjectItem(json, "used_memory");
-      cJSON *free_memory = cJSON_GetObjectItem(json, "free_memory");
-      if (cJSON_IsNumber(total_memory) && cJSON_IsNumber(used_memory) &&
-          cJSON_IsNumber(free_memory)) {
-        printf("Memory Usage: Total: %.2f MB, Used: %.2f MB, Free: %.2f MB\n",
-               total_memory->valuedouble, used_memory->valuedouble,
-               free_memory->valuedouble);
-      }
-
-      cJSON *disk_reads = cJSON_GetObjectItem(json, "disk_reads");
-      cJSON *disk_writes = cJSON_GetObjectItem(json, "disk_writes");
-      if (cJSON_IsNumber(disk_reads) && cJSON_IsNumber(disk_writes)) {
-        printf("Disk Usage: Reads: %.0f, Writes: %.0f\n",
-               disk_reads->valuedouble, disk_writes->valuedouble);
-      }
-
-      cJSON *rx_bytes = cJSON_GetObjectItem(json, "rx_bytes");
-      cJSON *tx_bytes = cJSON_GetObjectItem(json, "tx_bytes");
-      if (cJSON_IsNumber(rx_bytes) && cJSON_IsNumber(tx_bytes)) {
-        printf("Network Usage: RX: %.0f bytes, TX: %.0f bytes\n",
-               rx_bytes->valuedouble, tx_bytes->valuedouble);
-      }
-
-      cJSON *context_switches = cJSON_GetObjectItem(json, "context_switches");
-      if (cJSON_IsNumber(context_switches)) {
-        printf("Context Switches: %.0f\n", context_switches->valuedouble);
-      }
-
-      cJSON *running_processes = cJSON_GetObjectItem(json, "running_processes");
-      if (cJSON_IsNumber(running_processes)) {
-        printf("Running Processes: %.0f\n", running_processes->valuedouble);
-      }
-
-      // Procesar la fragmentación de memoria antes de eliminar el objeto JSON
-      cJSON *memory_fragmentation = cJSON_GetObjectItem(json, "memory_fragmentation");
-      if (cJSON_IsNumber(memory_fragmentation)) {
-        printf("Memory Fragmentation: %.2f%%\n", memory_fragmentation->valuedouble * 100);
-      }
-
-      // Eliminar el objeto JSON después de usarlo
-      cJSON_Delete(json);
-    }
-
-    close(fifo_fd);
-    sleep(read_sampling_interval()); // Pausa antes de la siguiente lectura
+  if (load_time == 0 || time(NULL) - load_time > MONITOR_LOAD_STALE) {
+    return -1;
   }
-  printf("Status monitor detenido.\n");
+  *cpu_usage = load_cpu_usage;
+  *free_memory = load_free_memory;
+  return fresh;
 }
@@ -0,0 +1,407 @@
+// parallel.c
+//
+// Este archivo contiene el comando interno `parallel`, que reparte una lista
+// de elementos entre a lo sumo N procesos simultáneos.
+
+#define _GNU_SOURCE // memfd_create
+
+#include "parallel.h"
+#include "commands.h"
+#include "globals.h"
+#include "jobs.h"
+#include "launcher.h"
+#include "utils.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define PARALLEL_MAX_FAILED 101 // Estado máximo por tareas con error
+#define PARALLEL_BUFFER 16384   // Bloque de copia de las salidas guardadas
+
+/**
+ * @struct s_task
+ * @brief Un lugar para una tarea en curso.
+ */
+struct s_task {
+  pid_t pid;             /**< Proceso, o 0 si el lugar está libre. */
+  size_t seq;            /**< Número de la tarea, desde 0. */
+  int out_fd;            /**< Salida guardada con -k, o -1. */
+  char *item;            /**< Elemento, para -t (o NULL). */
+  struct timespec start; /**< Momento en que se lanzó. */
+};
+
+/**
+ * @struct s_parallel
+ * @brief Estado de una ejecución de `parallel`.
+ */
+struct s_parallel {
+  char **command;       /**< Comando y argumentos, sin `:::`. */
+  int command_count;    /**< Cantidad de argumentos en `command`. */
+  char **items;         /**< Elementos tras `:::`, o NULL para leer stdin. */
+  int exhausted;        /**< No quedan elementos. */
+  char *line;           /**< Última línea leída de stdin. */
+  size_t line_capacity; /**< Capacidad de `line`. */
+  int in_fd;            /**< Entrada de las tareas, o -1 para heredarla. */
+  int slots;            /**< Tareas simultáneas (-j). */
+  int keep_order;       /**< -k: salidas en el orden de los elementos. */
+  int timing;           /**< -t: informar cada tarea y un resumen. */
+  struct s_task *tasks; /**< `slots` lugares. */
+  int running;          /**< Tareas en curso. */
+  int *held;            /**< Con -k, salidas terminadas por `seq % window`. */
+  size_t window;        /**< Tareas que pueden esperar su turno con -k. */
+  size_t next_seq;      /**< Número de la próxima tarea. */
+  size_t next_output;   /**< Con -k, próxima tarea cuya salida se muestra. */
+  size_t failed;        /**< Tareas que terminaron con error. */
+};
+
+static double seconds_since(const struct timespec *start) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - start->tv_sec) +
+         (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+/** Devuelve el próximo elemento, o NULL si no quedan. */
+static const char *next_item(struct s_parallel *p) {
+  if (p->exhausted) {
+    return NULL;
+  }
+  if (p->items) {
+    if (*p->items == NULL) {
+      p->exhausted = 1;
+      return NULL;
+    }
+    return *p->items++;
+  }
+
+  // Línea por línea, para lanzar las primeras tareas sin esperar el final de
+  // la entrada
+  ssize_t n = getline(&p->line, &p->line_capacity, stdin);
+  if (n == -1) {
+    clearerr(stdin); // Ctrl-D en una terminal no cierra la entrada
+    p->exhausted = 1;
+    return NULL;
+  }
+  if (n > 0 && p->line[n - 1] == '\n') {
+    p->line[n - 1] = '\0';
+  }
+  return p->line;
+}
+
+static void free_argv(char **argv) {
+  if (argv) {
+    free_args(argv);
+    free(argv);
+  }
+}
+
+/**
+ * @brief Arma los argumentos de una tarea: cada `{}` se reemplaza por el
+ * elemento y, si no hay ninguno, el elemento se agrega al final.
+ */
+static char **task_argv(const struct s_parallel *p, const char *item) {
+  size_t item_length = strlen(item);
+  int replaced = 0;
+  char **argv = calloc((size_t)p->command_count + 2, sizeof(*argv));
+  if (argv == NULL) {
+    return NULL;
+  }
+
+  for (int i = 0; i < p->command_count; i++) {
+    const char *arg = p->command[i];
+    size_t count = 0;
+    for (const char *s = strstr(arg, "{}"); s; s = strstr(s + 2, "{}")) {
+      count++;
+    }
+    argv[i] = malloc(strlen(arg) + count * item_length + 1);
+    if (argv[i] == NULL) {
+      free_argv(argv);
+      return NULL;
+    }
+    char *out = argv[i];
+    for (const char *s; (s = strstr(arg, "{}")) != NULL; arg = s + 2) {
+      memcpy(out, arg, (size_t)(s - arg));
+      out += s - arg;
+      memcpy(out, item, item_length);
+      out += item_length;
+    }
+    strcpy(out, arg);
+    replaced |= count > 0;
+  }
+  if (!replaced && (argv[p->command_count] = strdup(item)) == NULL) {
+    free_argv(argv);
+    return NULL;
+  }
+  return argv;
+}
+
+/** Escribe en stdout la salida guardada de una tarea y la cierra. */
+static void copy_output(int fd) {
+  char buffer[PARALLEL_BUFFER];
+  ssize_t n;
+
+  if (lseek(fd, 0, SEEK_SET) == -1) {
+    perror("lseek");
+  }
+  while ((n = read(fd, buffer, sizeof(buffer))) != 0) {
+    if (n == -1) {
+      if (errno == EINTR) {
+        continue;
+      }
+      perror("read");
+      break;
+    }
+    for (ssize_t written = 0; written < n;) {
+      ssize_t w = write(STDOUT_FILENO, buffer + written, (size_t)(n - written));
+      if (w == -1 && errno != EINTR) {
+        perror("write");
+        close(fd);
+        return;
+      }
+      written += w > 0 ? w : 0;
+    }
+  }
+  close(fd);
+}
+
+/** Con -k, muestra en orden las salidas de las tareas que ya terminaron. */
+static void flush_outputs(struct s_parallel *p) {
+  while (p->next_output < p->next_seq) {
+    int *held = &p->held[p->next_output % p->window];
+    if (*held == -1) {
+      break; // Todavía no terminó
+    }
+    copy_output(*held);
+    *held = -1;
+    p->next_output++;
+  }
+}
+
+/** Registra el fin de una tarea y libera su lugar. */
+static void finish_task(struct s_parallel *p, struct s_task *task,
+                        int status) {
+  if (status != 0) {
+    p->failed++;
+  }
+  if (p->timing) {
+    fprintf(stderr, "parallel: [%zu] %s: estado %d, %.3f s\n", task->seq + 1,
+            task->item, status, seconds_since(&task->start));
+  }
+  if (p->keep_order) {
+    p->held[task->seq % p->window] = task->out_fd;
+    flush_outputs(p);
+  }
+  free(task->item);
+  task->item = NULL;
+  task->out_fd = -1;
+  task->pid = 0;
+}
+
+/** Lanza la tarea de un elemento en un lugar libre. */
+static void launch_task(struct s_parallel *p, struct s_job *job,
+                        struct s_task *task, const char *item) {
+  task->seq = p->next_seq++;
+  task->out_fd = -1;
+  task->item = p->timing ? strdup(item) : NULL;
+  clock_gettime(CLOCK_MONOTONIC, &task->start);
+
+  char **argv = task_argv(p, item);
+  if (argv == NULL ||
+      (p->keep_order &&
+       (task->out_fd = memfd_create("parallel", MFD_CLOEXEC)) == -1)) {
+    perror(argv ? "memfd_create" : "Error de memoria");
+    free_argv(argv);
+    // Con -k la tarea igual ocupa su turno, sin salida
+    task->out_fd = p->keep_order ? open("/dev/null", O_RDONLY) : -1;
+    finish_task(p, task, 1);
+    return;
+  }
+
+  // El primer proceso crea el grupo del trabajo y toma la terminal, salvo si
+  // la shell la necesita para leer los elementos
+  pid_t pgid = job_pgid(job);
+  struct s_launch launch = {argv, p->in_fd, task->out_fd, -1, -1, pgid,
+                            pgid == 0 && job_control && p->items != NULL};
+  pid_t pid = launch_process(&launch);
+  free_argv(argv);
+  if (pid <= 0) {
+    finish_task(p, task, 127);
+    return;
+  }
+  job_add_process(job, pid); // Los errores ya se informaron
+  task->pid = pid;
+  p->running++;
+}
+
+static struct s_task *find_task(struct s_parallel *p, pid_t pid) {
+  for (int i = 0; i < p->slots; i++) {
+    if (p->tasks[i].pid == pid) {
+      return &p->tasks[i];
+    }
+  }
+  return NULL;
+}
+
+/** Lee las opciones; devuelve el índice del comando o -1 si no son válidas. */
+static int parse_options(struct s_parallel *p, char **args) {
+  int i = 1;
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  p->slots = cpus > 0 && cpus < INT_MAX ? (int)cpus : 1;
+
+  for (; args[i] != NULL && args[i][0] == '-'; i++) {
+    if (strcmp(args[i], "--") == 0) {
+      i++;
+      break;
+    } else if (strcmp(args[i], "-k") == 0) {
+      p->keep_order = 1;
+    } else if (strcmp(args[i], "-t") == 0) {
+      p->timing = 1;
+    } else if (strncmp(args[i], "-j", 2) == 0) {
+      const char *value = args[i][2] != '\0' ? args[i] + 2 : args[++i];
+      char *end;
+      long slots = value ? strtol(value, &end, 10) : 0;
+      if (value == NULL || *end != '\0' || end == value || slots <= 0 ||
+          slots > INT_MAX / 2) {
+        fprintf(stderr, "parallel: -j: cantidad de tareas inválida\n");
+        return -1;
+      }
+      p->slots = (int)slots;
+    } else {
+      fprintf(stderr, "parallel: opción inválida: %s\n", args[i]);
+      return -1;
+    }
+  }
+  return i;
+}
+
+int parallel_command(char **args) {
+  struct s_parallel p = {0};
+  int first = parse_options(&p, args);
+  if (first == -1) {
+    return 2;
+  }
+  p.command = &args[first];
+  while (p.command[p.command_count] != NULL &&
+         strcmp(p.command[p.command_count], ":::") != 0) {
+    p.command_count++;
+  }
+  if (p.command_count == 0) {
+    fprintf(stderr, "parallel: uso: parallel [-j N] [-k] [-t] comando "
+                    "[args ...] [::: elementos ...]\n");
+    return 2;
+  }
+  if (p.command[p.command_count] != NULL) {
+    p.items = &p.command[p.command_count + 1];
+  }
+
+  // Las tareas no deben competir con la shell por la entrada que lee
+  p.in_fd = p.items ? -1 : open("/dev/null", O_RDONLY | O_CLOEXEC);
+  p.tasks = calloc((size_t)p.slots, sizeof(*p.tasks));
+  p.window = p.keep_order ? 2 * (size_t)p.slots : 0;
+  p.held = p.keep_order ? malloc(p.window * sizeof(*p.held)) : NULL;
+  char *text = args_text(args);
+  struct s_job *job = p.tasks && (p.held || !p.keep_order)
+                          ? job_create(text ? text : "parallel")
+                          : NULL;
+  free(text);
+  if (job == NULL) {
+    if (p.tasks == NULL || (p.keep_order && p.held == NULL)) {
+      perror("Error de memoria");
+    }
+    free(p.tasks);
+    free(p.held);
+    if (p.in_fd != -1) {
+      close(p.in_fd);
+    }
+    return 1;
+  }
+  for (int i = 0; i < p.slots; i++) {
+    p.tasks[i].out_fd = -1;
+  }
+  for (size_t i = 0; i < p.window; i++) {
+    p.held[i] = -1;
+  }
+
+  struct timespec start;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  // Lo pendiente en los buffers de la shell debe salir antes que las tareas
+  fflush(stdout);
+
+  int interrupted = 0, stopped = 0;
+  for (;;) {
+    // Lanzar mientras haya lugares libres; con -k, además, mientras las
+    // salidas que esperan su turno quepan en la ventana
+    while (!interrupted && p.running < p.slots &&
+           (!p.keep_order || p.next_seq - p.next_output < p.window)) {
+      const char *item = next_item(&p);
+      if (item == NULL) {
+        break;
+      }
+      launch_task(&p, job, find_task(&p, 0), item);
+    }
+    if (p.running == 0) {
+      break;
+    }
+
+    int status;
+    pid_t pid = job_wait_any(job, &status);
+    if (pid <= 0) {
+      stopped = pid == 0;
+      break;
+    }
+    struct s_task *task = find_task(&p, pid);
+    if (task == NULL) {
+      continue;
+    }
+    p.running--;
+    // Ctrl+C: las tareas en curso terminan y no se lanzan más
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGINT) {
+      interrupted = 1;
+    }
+    finish_task(&p, task, command_status(status));
+  }
+  stopped |= job_end_foreground(job);
+
+  if (p.timing) {
+    fprintf(stderr, "parallel: %zu tareas, %zu con error, %.3f s\n",
+            p.next_seq, p.failed, seconds_since(&start));
+  }
+
+  // Si el trabajo se suspendió, las salidas de las tareas que terminaron se
+  // muestran igual, y las de las suspendidas se descartan
+  for (; p.keep_order && p.next_output < p.next_seq; p.next_output++) {
+    int fd = p.held[p.next_output % p.window];
+    if (fd != -1) {
+      copy_output(fd);
+    }
+  }
+  for (int i = 0; i < p.slots; i++) {
+    if (p.tasks[i].out_fd != -1) {
+      close(p.tasks[i].out_fd);
+    }
+    free(p.tasks[i].item);
+  }
+  free(p.tasks);
+  free(p.held);
+  free(p.line);
+  if (p.in_fd != -1) {
+    close(p.in_fd);
+  }
+
+  if (interrupted) {
+    return 128 + SIGINT;
+  }
+  if (stopped) {
+    return 128 + SIGTSTP;
+  }
+  return p.failed < PARALLEL_MAX_FAILED ? (int)p.failed : PARALLEL_MAX_FAILED;
+}
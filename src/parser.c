@@ -5,27 +5,54 @@
 // pipelines.
 
 #include "parser.h"
-#include "globals.h"
 #include <ctype.h>
+#include <stdlib.h>
 #include <string.h>
 
-void divisor_input(char *input, char **args) {
-  int i = 0;
+/**
+ * @brief Agrega un elemento a un array terminado en NULL, duplicando su
+ * capacidad cuando se llena.
+ *
+ * @return char** El array (posiblemente movido), o NULL si no hay memoria (el
+ * array original se libera).
+ */
+static char **append(char **array, int count, int *capacity, char *item) {
+  if (count + 1 >= *capacity) {
+    int new_capacity = *capacity ? *capacity * 2 : 8;
+    char **grown = realloc(array, new_capacity * sizeof(char *));
+    if (grown == NULL) {
+      free(array);
+      return NULL;
+    }
+    array = grown;
+    *capacity = new_capacity;
+  }
+  array[count] = item;
+  array[count + 1] = NULL;
+  return array;
+}
+
+char **divisor_input(char *input) {
+  int count = 0;
+  int capacity = 0;
+  char **args = append(NULL, 0, &capacity, NULL);
   char *token = strtok(input, " \t\r\n");
 
-  while (token != NULL && i < MAX_ARGS - 1) {
-    args[i++] = token;
+  while (token != NULL && args != NULL) {
+    args = append(args, count++, &capacity, token);
     token = strtok(NULL, " \t\r\n");
   }
 
-  args[i] = NULL; // Termina el array de argumentos
+  return args;
 }
 
-int parse_pipeline(char *input, char **commands) {
-  int i = 0;
+char **parse_pipeline(char *input, int *num_commands) {
+  int count = 0;
+  int capacity = 0;
+  char **commands = append(NULL, 0, &capacity, NULL);
   char *token = strtok(input, "|");
 
-  while (token != NULL && i < MAX_PIPELINE - 1) {
+  while (token != NULL && commands != NULL) {
     // Eliminar espacios iniciales
     while (isspace(*token))
       token++;
@@ -36,10 +63,10 @@ int parse_pipeline(char *input, char **commands) {
       *end-- = '\0';
     }
 
-    commands[i++] = token;
+    commands = append(commands, count++, &capacity, token);
     token = strtok(NULL, "|");
   }
 
-  commands[i] = NULL; // Termina el array de comandos
-  return i;
+  *num_commands = commands ? count : 0;
+  return commands;
 }
@@ -0,0 +1,252 @@
+// path_cache.c
+//
+// Este archivo contiene la tabla de rutas de comandos resueltas en PATH y el
+// comando interno `hash`.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "path_cache.h"
+#include "globals.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+/** Cantidad de listas de la tabla (potencia de dos). */
+#define PATH_CACHE_BUCKETS 64
+
+/**
+ * @struct s_path_entry
+ * @brief Un nombre de comando y su resolución.
+ */
+struct s_path_entry {
+  char *name;                 /**< Nombre del comando. */
+  char *path;                 /**< Ruta absoluta, o NULL si no se encontró. */
+  unsigned long hits;         /**< Veces que se usó la entrada. */
+  time_t expires;             /**< Vencimiento de un fallo (CLOCK_MONOTONIC). */
+  struct s_path_entry *next;  /**< Siguiente entrada de la lista. */
+};
+
+static struct s_path_entry *buckets[PATH_CACHE_BUCKETS];
+static char *cached_path_var; // PATH con el que se llenó la tabla
+
+static time_t monotonic_seconds(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec;
+}
+
+/** FNV-1a de 32 bits. */
+static unsigned hash_name(const char *name) {
+  uint32_t h = 2166136261u;
+  for (const unsigned char *c = (const unsigned char *)name; *c; c++) {
+    h = (h ^ *c) * 16777619u;
+  }
+  return h & (PATH_CACHE_BUCKETS - 1);
+}
+
+static const char *current_path_var(void) {
+  const char *path = getenv("PATH");
+  return path ? path : PATH_CACHE_DEFAULT_PATH;
+}
+
+static void free_entry(struct s_path_entry *entry) {
+  free(entry->name);
+  free(entry->path);
+  free(entry);
+}
+
+void path_cache_clear(void) {
+  for (int i = 0; i < PATH_CACHE_BUCKETS; i++) {
+    while (buckets[i]) {
+      struct s_path_entry *next = buckets[i]->next;
+      free_entry(buckets[i]);
+      buckets[i] = next;
+    }
+  }
+  free(cached_path_var);
+  cached_path_var = NULL;
+}
+
+/** Vacía la tabla si PATH cambió desde que se llenó. */
+static void check_path_var(void) {
+  const char *path = current_path_var();
+  if (cached_path_var && strcmp(cached_path_var, path) == 0) {
+    return;
+  }
+  path_cache_clear();
+  cached_path_var = strdup(path);
+}
+
+static int is_executable(const char *path) {
+  struct stat st;
+  return stat(path, &st) == 0 && S_ISREG(st.st_mode) &&
+         access(path, X_OK) == 0;
+}
+
+/**
+ * @brief Busca `name` en los directorios de PATH, en orden, igual que
+ * execvp (un directorio vacío es el directorio actual).
+ */
+static char *search_path(const char *name) {
+  const char *dir = current_path_var();
+  size_t name_len = strlen(name);
+  char candidate[PATH_MAX];
+
+  for (;;) {
+    const char *end = strchr(dir, ':');
+    size_t dir_len = end ? (size_t)(end - dir) : strlen(dir);
+
+    if (dir_len == 0) {
+      if (name_len + 1 <= sizeof(candidate)) {
+        memcpy(candidate, name, name_len + 1);
+        if (is_executable(candidate)) {
+          return strdup(candidate);
+        }
+      }
+    } else if (dir_len + name_len + 2 <= sizeof(candidate)) {
+      memcpy(candidate, dir, dir_len);
+      candidate[dir_len] = '/';
+      memcpy(candidate + dir_len + 1, name, name_len + 1);
+      if (is_executable(candidate)) {
+        return strdup(candidate);
+      }
+    }
+
+    if (!end) {
+      return NULL;
+    }
+    dir = end + 1;
+  }
+}
+
+static struct s_path_entry **find_slot(const char *name) {
+  struct s_path_entry **slot = &buckets[hash_name(name)];
+  while (*slot && strcmp((*slot)->name, name) != 0) {
+    slot = &(*slot)->next;
+  }
+  return slot;
+}
+
+/** Resuelve `name` y guarda el resultado (también si no se encontró). */
+static struct s_path_entry *resolve(const char *name) {
+  struct s_path_entry **slot = find_slot(name);
+  struct s_path_entry *entry = *slot;
+
+  if (!entry) {
+    entry = calloc(1, sizeof(*entry));
+    if (!entry || !(entry->name = strdup(name))) {
+      free(entry);
+      return NULL;
+    }
+    *slot = entry;
+  }
+
+  free(entry->path);
+  entry->path = search_path(name);
+  entry->hits = 0;
+  entry->expires = entry->path ? 0 : monotonic_seconds() + PATH_CACHE_MISS_TTL;
+  return entry;
+}
+
+const char *path_cache_lookup(const char *name) {
+  if (strchr(name, '/')) {
+    return name;
+  }
+  check_path_var();
+
+  struct s_path_entry *entry = *find_slot(name);
+  if (entry && entry->path) {
+    // El programa pudo haberse borrado o movido desde que se guardó
+    if (access(entry->path, X_OK) != 0) {
+      entry = resolve(name);
+    }
+  } else if (!entry || monotonic_seconds() >= entry->expires) {
+    entry = resolve(name);
+  }
+
+  if (!entry) {
+    // Sin memoria para la tabla: buscar sin guardar
+    static char *uncached;
+    free(uncached);
+    uncached = search_path(name);
+    return uncached;
+  }
+  if (entry->path) {
+    entry->hits++;
+  }
+  return entry->path;
+}
+
+const char *path_cache_add(const char *name) {
+  check_path_var();
+  struct s_path_entry *entry = resolve(name);
+  return entry ? entry->path : NULL;
+}
+
+int path_cache_remove(const char *name) {
+  struct s_path_entry **slot = find_slot(name);
+  if (!*slot) {
+    return -1;
+  }
+  struct s_path_entry *entry = *slot;
+  *slot = entry->next;
+  free_entry(entry);
+  return 0;
+}
+
+size_t path_cache_print(FILE *out) {
+  size_t printed = 0;
+  check_path_var();
+
+  for (int i = 0; i < PATH_CACHE_BUCKETS; i++) {
+    for (struct s_path_entry *e = buckets[i]; e; e = e->next) {
+      if (!e->path) {
+        continue; // Los fallos no se listan, como en bash
+      }
+      if (printed++ == 0) {
+        fprintf(out, "usos\tcomando\n");
+      }
+      fprintf(out, "%4lu\t%s\n", e->hits, e->path);
+    }
+  }
+  if (printed == 0) {
+    fprintf(out, "hash: la tabla está vacía\n");
+  }
+  return printed;
+}
+
+int hash_command(char **args) {
+  int status = 0;
+
+  if (args[1] == NULL) {
+    path_cache_print(stdout);
+    return 0;
+  }
+  if (strcmp(args[1], "-r") == 0) {
+    path_cache_clear();
+    return 0;
+  }
+  if (strcmp(args[1], "-d") == 0) {
+    for (int i = 2; args[i] != NULL; i++) {
+      if (path_cache_remove(args[i]) != 0) {
+        fprintf(stderr, "hash: %s: no está en la tabla\n", args[i]);
+        status = 1;
+      }
+    }
+    return status;
+  }
+
+  for (int i = 1; args[i] != NULL; i++) {
+    if (strchr(args[i], '/')) {
+      continue; // Las rutas no se buscan en PATH
+    }
+    if (!path_cache_add(args[i])) {
+      fprintf(stderr, "hash: %s: no se encontró\n", args[i]);
+      status = 1;
+    }
+  }
+  return status;
+}
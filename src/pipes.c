@@ -1,144 +1,174 @@
 // pipes.c
 //
-// Este archivo contiene la implementación de la función `execute_pipeline`
-// que permite la ejecución de múltiples comandos en pipeline dentro de la
-// shell.
+// Este archivo contiene la implementación de la función
+// `execute_pipeline_node` que permite la ejecución de múltiples comandos en
+// pipeline dentro de la shell.
 
 #include "pipes.h"
 #include "commands.h"
-#include "parser.h"
-#include "utils.h"
+#include "executor.h"
+#include "globals.h"
+#include "jobs.h"
+#include "launcher.h"
+#include "schedctl.h"
+#include "timing.h"
 
-#include <fcntl.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
-#include <sys/wait.h>
-#include <termios.h>
 #include <unistd.h>
 
-void execute_pipeline(char **commands, int num_commands) {
-  int in_fd = STDIN_FILENO; // Descriptor de entrada inicial (estándar)
-  pid_t last_pid = 0;       // PID del último proceso en la pipeline
-  int fd[2]; // Descriptores de pipe para comunicación entre procesos
-
-  for (int i = 0; i < num_commands; i++) {
-    char *args[MAX_ARGS];
-    divisor_input(commands[i], args);
-
-    // Manejo de comandos vacíos en la pipeline
-    if (args[0] == NULL) {
-      continue;
-    }
-
-    // Verificar si el comando es interno y no puede ejecutarse en pipeline
-    if (strcmp(args[0], "cd") == 0 || strcmp(args[0], "echo") == 0 ||
-        strcmp(args[0], "quit") == 0) {
-      fprintf(stderr,
-              "Error: El comando interno '%s' no puede ser parte de una "
-              "pipeline.\n",
-              args[0]);
-      return;
+/**
+ * @brief Ejecuta una etapa que no es un comando externo en un hijo de la shell.
+ *
+ * El hijo se une al grupo de la pipeline, como los comandos externos, y
+ * ejecuta la etapa con el control de trabajos desactivado.
+ */
+static pid_t fork_stage(struct s_node *stage, const int fds[3], int close_fd,
+                        pid_t pgid, int foreground, int *running) {
+  // Lo pendiente en los buffers de la shell no debe escribirlo también el hijo
+  fflush(stdout);
+  fflush(stderr);
+  pid_t pid = fork();
+  if (pid == 0) {
+    setpgid(0, pgid);
+    // La terminal se toma antes de redirigir la entrada estándar
+    if (foreground && isatty(STDIN_FILENO)) {
+      tcsetpgrp(STDIN_FILENO, pgid ? pgid : getpid());
     }
-
-    // Crear un pipe para la comunicación, excepto para el último comando
-    if (i < num_commands - 1) {
-      if (pipe(fd) == -1) {
-        perror("pipe");
-        return;
-      }
+    job_control = 0;
+    reset_signal_handlers();
+    if (schedctl_apply() == -1) {
+      _exit(EXIT_FAILURE);
     }
 
-    // Crear un nuevo proceso para ejecutar el comando actual
-    pid_t pid = fork();
-    if (pid == 0) { // Proceso hijo
-      // Establecer un nuevo grupo de procesos para el hijo
-      setpgid(0, 0);
-
-      // Redirigir la entrada si no es el primer comando
-      if (in_fd != STDIN_FILENO) {
-        dup2(in_fd, STDIN_FILENO);
-        close(in_fd);
-      }
+    sigset_t empty;
+    sigemptyset(&empty);
+    sigprocmask(SIG_SETMASK, &empty, NULL);
 
-      // Redirigir la salida si no es el último comando
-      if (i < num_commands - 1) {
-        close(fd[0]);               // Cerrar el extremo de lectura del pipe
-        dup2(fd[1], STDOUT_FILENO); // Redirigir la salida al pipe
-        close(fd[1]);
+    if (close_fd != -1) {
+      close(close_fd);
+    }
+    for (int i = 0; i < 3; i++) {
+      if (fds[i] != -1 && fds[i] != i) {
+        if (dup2(fds[i], i) == -1) {
+          perror("Error al redirigir");
+          _exit(EXIT_FAILURE);
+        }
+        close(fds[i]);
       }
+    }
 
-      // Restaurar los manejadores de señales por defecto
-      signal(SIGINT, SIG_DFL);
-      signal(SIGTSTP, SIG_DFL);
-      signal(SIGQUIT, SIG_DFL);
+    int status;
+    if (stage->type == NODE_COMMAND) {
+      status = run_simple_command(stage->argv, (const int[3]){-1, -1, -1}, 0,
+                                  running);
+    } else {
+      status = execute_node(stage, running);
+    }
+    fflush(stdout);
+    _exit(status);
+  } else if (pid < 0) {
+    perror("Error al crear el proceso");
+  } else {
+    setpgid(pid, pgid ? pgid : pid);
+  }
+  return pid;
+}
 
-      // Ejecutar el comando actual
-      if (execvp(args[0], args) == -1) {
-        perror("Error en el comando");
-        exit(EXIT_FAILURE);
-      }
-    } else if (pid < 0) { // Error al crear el proceso
-      perror("fork");
-      return;
-    } else { // Proceso padre
-      // Establecer el grupo de procesos del hijo en el proceso padre
-      setpgid(pid, pid);
-
-      // Cerrar el extremo de escritura del pipe en el proceso padre
-      if (i < num_commands - 1) {
-        close(fd[1]);
-      }
+/**
+ * @brief Lanza una etapa con los descriptores de la pipeline y sus
+ * redirecciones, en el grupo `pgid` (0 crea uno nuevo).
+ */
+static pid_t launch_stage(struct s_node *stage, int in_fd, int out_fd,
+                          int close_fd, pid_t pgid, int foreground,
+                          int *running) {
+  int fds[3] = {-1, -1, -1};
+
+  // Las redirecciones propias de un comando reemplazan a los pipes; las de
+  // `( )` y `{ }` las aplica la etapa misma dentro del hijo
+  if (stage->type == NODE_COMMAND &&
+      open_redirects(stage->redirects, fds) == -1) {
+    return -1;
+  }
+  int stage_fds[3] = {fds[0] != -1 ? fds[0] : in_fd,
+                      fds[1] != -1 ? fds[1] : out_fd, fds[2]};
+
+  pid_t pid;
+  if (stage->type == NODE_COMMAND && stage->argv[0] != NULL &&
+      !is_builtin(stage->argv[0])) {
+    struct s_launch launch = {stage->argv, stage_fds[0], stage_fds[1],
+                              stage_fds[2], close_fd,    pgid,
+                              foreground};
+    pid = launch_process(&launch);
+  } else {
+    pid = fork_stage(stage, stage_fds, close_fd, pgid, foreground, running);
+  }
 
-      // Actualizar in_fd para el siguiente comando
-      if (in_fd != STDIN_FILENO) {
-        close(in_fd);
-      }
-      if (i < num_commands - 1) {
-        in_fd = fd[0];
-      }
+  close_redirects(fds);
+  return pid;
+}
 
-      // Guardar el PID del último proceso para controlar el terminal
-      last_pid = pid;
-    }
+int execute_pipeline_node(struct s_node *pipeline, int background,
+                          int *running) {
+  int num_stages = pipeline->num_stages;
+  int in_fd = -1; // Extremo de lectura del pipe anterior
+  int fd[2];      // Descriptores de pipe para comunicación entre procesos
+  pid_t last_pid = -1;
+
+  // Todas las etapas forman un trabajo y comparten su grupo de procesos, de
+  // modo que Ctrl+C, Ctrl+Z y `kill %n` les llegan a todas
+  char *text = node_text(pipeline);
+  struct s_job *job = job_create(text ? text : "");
+  free(text);
+  if (job == NULL) {
+    return 1;
   }
+  int foreground = !background && job_control;
 
-  // Control del terminal para el último proceso de la pipeline
-  if (last_pid > 0) {
-    foreground_pid = last_pid;
-    if (tcsetpgrp(STDIN_FILENO, foreground_pid) == -1) {
-      perror("tcsetpgrp");
-    }
+  for (int i = 0; i < num_stages; i++) {
+    int last = i == num_stages - 1;
 
-    // Esperar al último proceso de la pipeline
-    int status;
-    if (waitpid(foreground_pid, &status, WUNTRACED) == -1) {
-      perror("waitpid");
-    }
-
-    // Verificar si el proceso fue suspendido
-    if (WIFSTOPPED(status)) {
-      foreground_suspended = foreground_pid;
-      printf("\n[1]+  Detenido\t\t%d\n", foreground_pid);
+    // Crear un pipe para la comunicación, excepto para la última etapa
+    if (!last && pipe(fd) == -1) {
+      perror("pipe");
+      last_pid = -1;
+      break;
     }
 
-    // Restaurar el control del terminal a la shell
-    if (tcsetpgrp(STDIN_FILENO, shell_pgid) == -1) {
-      perror("tcsetpgrp");
+    // Si el lanzamiento falla el error ya se informó; la pipeline continúa
+    // como si la etapa hubiera terminado sin producir salida
+    last_pid = launch_stage(pipeline->stages[i], in_fd, last ? -1 : fd[1],
+                            last ? -1 : fd[0], job_pgid(job), foreground,
+                            running);
+    if (last_pid > 0) {
+      job_add_process(job, last_pid);
+      // `time` informa cada etapa con su propio texto
+      char *stage_text = timing_scope() ? node_text(pipeline->stages[i]) : NULL;
+      if (stage_text != NULL) {
+        timing_label(last_pid, stage_text);
+        free(stage_text);
+      }
     }
 
-    // Restaurar los modos de terminal de la shell
-    if (tcgetattr(STDIN_FILENO, &shell_tmodes) == -1) {
-      perror("tcgetattr");
+    // Cerrar en el padre el extremo de escritura y el pipe anterior
+    if (!last) {
+      close(fd[1]);
     }
-    if (tcsetattr(STDIN_FILENO, TCSADRAIN, &shell_tmodes) == -1) {
-      perror("tcsetattr");
+    if (in_fd != -1) {
+      close(in_fd);
     }
+    in_fd = last ? -1 : fd[0];
+  }
+  if (in_fd != -1) {
+    close(in_fd);
+  }
 
-    // Resetear foreground_pid si el proceso no fue suspendido
-    if (foreground_suspended == 0) {
-      foreground_pid = 0;
-    }
+  if (background) {
+    return job_background(job);
   }
+  // Se espera a todas las etapas; el estado es el de la última, o 127 si no
+  // pudo lanzarse
+  int status = job_foreground(job, 0);
+  return last_pid > 0 ? status : 127;
 }
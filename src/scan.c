@@ -0,0 +1,234 @@
+// scan.c
+//
+// Este archivo contiene la búsqueda de caracteres especiales del lexer, en
+// versión escalar, SSE2 y AVX2, y la elección de la implementación según la
+// CPU.
+
+#include "scan.h"
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SCAN_X86 1
+#include <immintrin.h>
+#else
+#define SCAN_X86 0
+#endif
+
+/** Caracteres que cortan una tirada fuera de comillas. */
+static const unsigned char word_special[256] = {
+    [' '] = 1, ['\t'] = 1, ['\n'] = 1, ['\v'] = 1, ['\f'] = 1, ['\r'] = 1,
+    ['\''] = 1, ['"'] = 1, ['|'] = 1, ['&'] = 1, [';'] = 1, ['('] = 1,
+    [')'] = 1, ['<'] = 1, ['>'] = 1, ['$'] = 1, ['\\'] = 1};
+
+static size_t scan_word_scalar(const char *p, size_t len) {
+  size_t i = 0;
+  while (i < len && !word_special[(unsigned char)p[i]]) {
+    i++;
+  }
+  return i;
+}
+
+static size_t scan_dquote_scalar(const char *p, size_t len) {
+  size_t i = 0;
+  while (i < len && p[i] != '"' && p[i] != '\\') {
+    i++;
+  }
+  return i;
+}
+
+#if SCAN_X86
+
+/** Posición del primer bit en 1 de una máscara distinta de 0. */
+static inline unsigned first_bit(unsigned mask) {
+  return (unsigned)__builtin_ctz(mask);
+}
+
+/**
+ * Bytes de `v` en el rango [lo, lo + n]: con la resta sin signo saturada,
+ * `v - lo - n` da 0 solo dentro del rango.
+ */
+static inline __m128i in_range_sse2(__m128i v, char lo, char n) {
+  __m128i shifted = _mm_sub_epi8(v, _mm_set1_epi8(lo));
+  return _mm_cmpeq_epi8(_mm_subs_epu8(shifted, _mm_set1_epi8(n)),
+                        _mm_setzero_si128());
+}
+
+static size_t scan_word_sse2(const char *p, size_t len) {
+  size_t i = 0;
+
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+    // \t \n \v \f \r son 0x09-0x0d; & ' ( ) son 0x26-0x29
+    __m128i m = _mm_or_si128(in_range_sse2(v, '\t', 4),
+                             in_range_sse2(v, '&', 3));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(' ')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('"')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('$')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(';')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('<')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('>')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('|')));
+    unsigned mask = (unsigned)_mm_movemask_epi8(m);
+    if (mask) {
+      return i + first_bit(mask);
+    }
+  }
+  // El resto se recorre de a un byte para no leer fuera del texto
+  return i + scan_word_scalar(p + i, len - i);
+}
+
+static size_t scan_dquote_sse2(const char *p, size_t len) {
+  size_t i = 0;
+
+  for (; i + 16 <= len; i += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i *)(p + i));
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                             _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+    unsigned mask = (unsigned)_mm_movemask_epi8(m);
+    if (mask) {
+      return i + first_bit(mask);
+    }
+  }
+  return i + scan_dquote_scalar(p + i, len - i);
+}
+
+/*
+ * AVX2 clasifica cada byte con dos búsquedas en tablas de 16 entradas
+ * (vpshufb), una por cada mitad del byte. Cada bit identifica una mitad alta
+ * (0x0_, 0x2_, 0x3_, 0x5_, 0x7_); la tabla de la mitad baja tiene, para cada
+ * valor, los bits de las mitades altas con las que forma un carácter
+ * especial. El byte es especial si ambas búsquedas comparten algún bit.
+ */
+__attribute__((target("avx2"))) static size_t scan_word_avx2(const char *p,
+                                                             size_t len) {
+  const __m256i lo_table = _mm256_setr_epi8(
+      0x02, 0, 0x02, 0, 0x02, 0, 0x02, 0x02, 0x02, 0x03, 0x01, 0x05, 0x1d,
+      0x01, 0x04, 0, 0x02, 0, 0x02, 0, 0x02, 0, 0x02, 0x02, 0x02, 0x03, 0x01,
+      0x05, 0x1d, 0x01, 0x04, 0);
+  const __m256i hi_table = _mm256_setr_epi8(
+      0x01, 0, 0x02, 0x04, 0, 0x08, 0, 0x10, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0,
+      0x02, 0x04, 0, 0x08, 0, 0x10, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m256i nibble = _mm256_set1_epi8(0x0f);
+  size_t i = 0;
+
+  for (; i + 32 <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+    __m256i lo = _mm256_shuffle_epi8(lo_table, _mm256_and_si256(v, nibble));
+    __m256i hi = _mm256_shuffle_epi8(
+        hi_table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble));
+    __m256i common = _mm256_and_si256(lo, hi);
+    unsigned plain = (unsigned)_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(common, _mm256_setzero_si256()));
+    if (plain != 0xffffffffu) {
+      return i + first_bit(~plain);
+    }
+  }
+  return i + scan_word_sse2(p + i, len - i);
+}
+
+__attribute__((target("avx2"))) static size_t scan_dquote_avx2(const char *p,
+                                                               size_t len) {
+  size_t i = 0;
+
+  for (; i + 32 <= len; i += 32) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)(p + i));
+    __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+    unsigned mask = (unsigned)_mm256_movemask_epi8(m);
+    if (mask) {
+      return i + first_bit(mask);
+    }
+  }
+  return i + scan_dquote_sse2(p + i, len - i);
+}
+
+#endif // SCAN_X86
+
+static size_t scan_word_resolve(const char *p, size_t len);
+static size_t scan_dquote_resolve(const char *p, size_t len);
+
+static size_t (*scan_word_impl)(const char *, size_t) = scan_word_resolve;
+static size_t (*scan_dquote_impl)(const char *, size_t) = scan_dquote_resolve;
+static enum e_scan_impl current_impl = SCAN_SCALAR;
+static int resolved;
+
+/** Elige la mejor implementación que soporta la CPU. */
+static void resolve(void) {
+#if SCAN_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && scan_select(SCAN_AVX2) == 0) {
+    return;
+  }
+  if (__builtin_cpu_supports("sse2") && scan_select(SCAN_SSE2) == 0) {
+    return;
+  }
+#endif
+  scan_select(SCAN_SCALAR);
+}
+
+static size_t scan_word_resolve(const char *p, size_t len) {
+  resolve();
+  return scan_word_impl(p, len);
+}
+
+static size_t scan_dquote_resolve(const char *p, size_t len) {
+  resolve();
+  return scan_dquote_impl(p, len);
+}
+
+size_t scan_word(const char *p, size_t len) { return scan_word_impl(p, len); }
+
+size_t scan_dquote(const char *p, size_t len) {
+  return scan_dquote_impl(p, len);
+}
+
+int scan_select(enum e_scan_impl impl) {
+  switch (impl) {
+  case SCAN_SCALAR:
+    scan_word_impl = scan_word_scalar;
+    scan_dquote_impl = scan_dquote_scalar;
+    break;
+#if SCAN_X86
+  case SCAN_SSE2:
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("sse2")) {
+      return -1;
+    }
+    scan_word_impl = scan_word_sse2;
+    scan_dquote_impl = scan_dquote_sse2;
+    break;
+  case SCAN_AVX2:
+    __builtin_cpu_init();
+    if (!__builtin_cpu_supports("avx2")) {
+      return -1;
+    }
+    scan_word_impl = scan_word_avx2;
+    scan_dquote_impl = scan_dquote_avx2;
+    break;
+#endif
+  default:
+    return -1;
+  }
+  current_impl = impl;
+  resolved = 1;
+  return 0;
+}
+
+enum e_scan_impl scan_current(void) {
+  if (!resolved) {
+    resolve();
+  }
+  return current_impl;
+}
+
+const char *scan_name(enum e_scan_impl impl) {
+  switch (impl) {
+  case SCAN_SSE2:
+    return "sse2";
+  case SCAN_AVX2:
+    return "avx2";
+  default:
+    return "scalar";
+  }
+}
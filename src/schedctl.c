@@ -0,0 +1,311 @@
+// schedctl.c
+//
+// Este archivo contiene los prefijos `pin`, `idle`, `batch`, `ionice` y
+// `cgroup`: la lectura de sus argumentos, los atributos que rigen mientras
+// se ejecuta una pipeline y su aplicación en los procesos hijos.
+
+#define _GNU_SOURCE // cpu_set_t, sched_setaffinity, SCHED_IDLE
+
+#include "schedctl.h"
+#include "cgroup.h"
+
+#include <limits.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// ioprio_set(2) no tiene envoltorio en glibc
+#define IOPRIO_WHO_PROCESS 1
+#define IOPRIO_CLASS_SHIFT 13
+#define IOPRIO_LEVELS 8
+
+#define SCHEDCTL_CPUS 0x1   // La afinidad está fijada
+#define SCHEDCTL_POLICY 0x2 // La política está fijada
+#define SCHEDCTL_IO 0x4     // La prioridad de E/S está fijada
+#define SCHEDCTL_CGROUP 0x8 // Los procesos van a un cgroup
+
+/**
+ * @brief Atributos que rigen en un prefijo y los de los prefijos que lo
+ * contienen.
+ */
+struct s_sched {
+  int flags;               /**< Atributos fijados (SCHEDCTL_*). */
+  cpu_set_t cpus;          /**< CPUs permitidas. */
+  int policy;              /**< SCHED_IDLE o SCHED_BATCH. */
+  int ioclass;             /**< Clase de E/S: 1, 2 o 3. */
+  int iolevel;             /**< Nivel dentro de la clase. */
+  const char *limits;      /**< Límites del cgroup, como en el prefijo. */
+  struct s_cgroup *cgroup; /**< Cgroup de los procesos. */
+  int owns_cgroup;         /**< Este prefijo creó `cgroup`. */
+  struct s_sched *outer;   /**< Atributos anteriores. */
+};
+
+static struct s_sched *current;
+
+static const char *const io_classes[] = {NULL, "realtime", "best-effort",
+                                         "idle"};
+
+int schedctl_prefix_arity(const char *word) {
+  if (strcmp(word, "pin") == 0 || strcmp(word, "ionice") == 0 ||
+      strcmp(word, "cgroup") == 0) {
+    return 1;
+  }
+  if (strcmp(word, "idle") == 0 || strcmp(word, "batch") == 0) {
+    return 0;
+  }
+  return -1;
+}
+
+/** Lee un número de CPU o de nivel; -1 si no es válido. */
+static long parse_number(const char *text, char **end, long max) {
+  if (*text < '0' || *text > '9') {
+    return -1;
+  }
+  long value = strtol(text, end, 10);
+  return value <= max ? value : -1;
+}
+
+/** Lee una lista de CPUs como "0-3,6". */
+static int parse_cpus(const char *list, cpu_set_t *cpus) {
+  const char *p = list;
+  char *end;
+
+  CPU_ZERO(cpus);
+  for (;;) {
+    long first = parse_number(p, &end, CPU_SETSIZE - 1);
+    long last = first;
+    if (first != -1 && *end == '-') {
+      last = parse_number(end + 1, &end, CPU_SETSIZE - 1);
+    }
+    if (first == -1 || last < first) {
+      fprintf(stderr, "pin: lista de CPUs inválida: %s\n", list);
+      return -1;
+    }
+    for (long cpu = first; cpu <= last; cpu++) {
+      CPU_SET(cpu, cpus);
+    }
+    if (*end == '\0') {
+      break;
+    }
+    if (*end != ',') {
+      fprintf(stderr, "pin: lista de CPUs inválida: %s\n", list);
+      return -1;
+    }
+    p = end + 1;
+  }
+
+  // Se comprueba aquí y no en el hijo, donde el error llegaría tarde
+  cpu_set_t allowed, usable;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    CPU_AND(&usable, cpus, &allowed);
+    if (CPU_COUNT(&usable) == 0) {
+      fprintf(stderr, "pin: ninguna de esas CPUs está disponible: %s\n",
+              list);
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/** Lee una prioridad de E/S como "best-effort:7" o "3". */
+static int parse_io(const char *text, struct s_sched *sched) {
+  size_t length = strcspn(text, ":");
+  int ioclass = 0;
+
+  for (int i = 1; i <= 3; i++) {
+    if ((strlen(io_classes[i]) == length &&
+         strncmp(text, io_classes[i], length) == 0) ||
+        (length == 1 && text[0] == '0' + i)) {
+      ioclass = i;
+    }
+  }
+  if (ioclass == 0) {
+    fprintf(stderr, "ionice: clase inválida: %s\n", text);
+    return -1;
+  }
+
+  // Como ionice(1): nivel 4 si no se indica; la clase idle no tiene niveles
+  int level = ioclass == 3 ? 0 : 4;
+  if (text[length] == ':') {
+    char *end;
+    level = parse_number(text + length + 1, &end, IOPRIO_LEVELS - 1);
+    if (level == -1 || *end != '\0' || ioclass == 3) {
+      fprintf(stderr, "ionice: nivel inválido: %s\n", text);
+      return -1;
+    }
+  }
+  sched->ioclass = ioclass;
+  sched->iolevel = level;
+  sched->flags |= SCHEDCTL_IO;
+  return 0;
+}
+
+int schedctl_begin(char **words) {
+  struct s_sched *sched = malloc(sizeof(*sched));
+  if (sched == NULL) {
+    perror("Error de memoria");
+    return -1;
+  }
+  if (current != NULL) {
+    *sched = *current;
+  } else {
+    memset(sched, 0, sizeof(*sched));
+  }
+  sched->owns_cgroup = 0;
+
+  const char *limits = NULL;
+  for (int i = 0; words[i] != NULL; i++) {
+    int error = 0;
+    if (strcmp(words[i], "idle") == 0 || strcmp(words[i], "batch") == 0) {
+      sched->policy = words[i][0] == 'i' ? SCHED_IDLE : SCHED_BATCH;
+      sched->flags |= SCHEDCTL_POLICY;
+    } else if (words[i + 1] == NULL) {
+      fprintf(stderr, "%s: falta el argumento\n", words[i]);
+      error = 1;
+    } else if (strcmp(words[i], "pin") == 0) {
+      error = parse_cpus(words[++i], &sched->cpus) == -1;
+      sched->flags |= SCHEDCTL_CPUS;
+    } else if (strcmp(words[i], "cgroup") == 0) {
+      limits = words[++i]; // Se crea cuando todo lo demás es válido
+    } else {
+      error = parse_io(words[++i], sched) == -1;
+    }
+    if (error) {
+      free(sched);
+      return -1;
+    }
+  }
+
+  if (limits != NULL) {
+    struct s_cgroup *cgroup;
+    if (cgroup_create(limits, &cgroup) == -1) {
+      free(sched);
+      return -1;
+    }
+    // Sin cgroups disponibles el trabajo corre igual (ya se avisó)
+    if (cgroup != NULL) {
+      sched->limits = limits;
+      sched->cgroup = cgroup;
+      sched->owns_cgroup = 1;
+      sched->flags |= SCHEDCTL_CGROUP;
+    }
+  }
+
+  sched->outer = current;
+  current = sched;
+  return 0;
+}
+
+void schedctl_end(void) {
+  struct s_sched *sched = current;
+  if (sched != NULL) {
+    current = sched->outer;
+    if (sched->owns_cgroup) {
+      cgroup_release(sched->cgroup); // Sus trabajos tienen sus referencias
+    }
+    free(sched);
+  }
+}
+
+int schedctl_active(void) { return current != NULL && current->flags != 0; }
+
+struct s_cgroup *schedctl_cgroup(void) {
+  return current != NULL && (current->flags & SCHEDCTL_CGROUP) ? current->cgroup
+                                                               : NULL;
+}
+
+int schedctl_apply(void) {
+  if (!schedctl_active()) {
+    return 0;
+  }
+  const struct s_sched *sched = current;
+  // Lo que lance este proceso los hereda del kernel
+  current = NULL;
+
+  // Sin cgroup el proceso corre igual, como cuando no están disponibles
+  if ((sched->flags & SCHEDCTL_CGROUP) && cgroup_enter(sched->cgroup) == -1) {
+    perror("cgroup");
+  }
+  if ((sched->flags & SCHEDCTL_CPUS) &&
+      sched_setaffinity(0, sizeof(sched->cpus), &sched->cpus) == -1) {
+    perror("pin");
+    return -1;
+  }
+  if (sched->flags & SCHEDCTL_POLICY) {
+    struct sched_param param = {.sched_priority = 0};
+    if (sched_setscheduler(0, sched->policy, &param) == -1) {
+      perror(sched->policy == SCHED_IDLE ? "idle" : "batch");
+      return -1;
+    }
+  }
+  if ((sched->flags & SCHEDCTL_IO) &&
+      syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0,
+              sched->ioclass << IOPRIO_CLASS_SHIFT | sched->iolevel) == -1) {
+    perror("ionice");
+    return -1;
+  }
+  return 0;
+}
+
+/** Escribe una lista de CPUs en rangos, como "0-3,6". */
+static void write_cpus(FILE *out, const cpu_set_t *cpus) {
+  const char *separator = "";
+  for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+    if (!CPU_ISSET(cpu, cpus)) {
+      continue;
+    }
+    int last = cpu;
+    while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, cpus)) {
+      last++;
+    }
+    if (last > cpu) {
+      fprintf(out, "%s%d-%d", separator, cpu, last);
+    } else {
+      fprintf(out, "%s%d", separator, cpu);
+    }
+    separator = ",";
+    cpu = last;
+  }
+}
+
+char *schedctl_text(void) {
+  if (!schedctl_active()) {
+    return NULL;
+  }
+
+  char *text = NULL;
+  size_t size;
+  FILE *out = open_memstream(&text, &size);
+  if (out == NULL) {
+    return NULL;
+  }
+  const char *separator = "";
+  if (current->flags & SCHEDCTL_CPUS) {
+    fputs("pin ", out);
+    write_cpus(out, &current->cpus);
+    separator = " ";
+  }
+  if (current->flags & SCHEDCTL_POLICY) {
+    fprintf(out, "%s%s", separator,
+            current->policy == SCHED_IDLE ? "idle" : "batch");
+    separator = " ";
+  }
+  if (current->flags & SCHEDCTL_IO) {
+    fprintf(out, "%sionice %s", separator, io_classes[current->ioclass]);
+    if (current->ioclass != 3) {
+      fprintf(out, ":%d", current->iolevel);
+    }
+    separator = " ";
+  }
+  if (current->flags & SCHEDCTL_CGROUP) {
+    fprintf(out, "%scgroup %s", separator, current->limits);
+  }
+  if (fclose(out) != 0) {
+    free(text);
+    return NULL;
+  }
+  return text;
+}
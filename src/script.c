@@ -0,0 +1,115 @@
+// script.c
+//
+// Este archivo contiene la lectura de archivos de comandos: proyección en
+// memoria de archivos regulares y lectura por bloques del resto.
+
+#define _DEFAULT_SOURCE // madvise
+
+#include "script.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/** Lee `fd` hasta el final en un buffer que crece al doble cuando se llena. */
+static int read_all(int fd, struct s_script *script) {
+  char *data = NULL;
+  size_t size = 0;
+  size_t capacity = 0;
+
+  for (;;) {
+    if (capacity - size < SCRIPT_READ_BLOCK) {
+      size_t new_capacity = capacity ? capacity * 2 : SCRIPT_READ_BLOCK;
+      char *grown = realloc(data, new_capacity);
+      if (grown == NULL) {
+        free(data);
+        errno = ENOMEM;
+        return -1;
+      }
+      data = grown;
+      capacity = new_capacity;
+    }
+
+    ssize_t n = read(fd, data + size, capacity - size);
+    if (n == 0) {
+      break;
+    }
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      int saved_errno = errno;
+      free(data);
+      errno = saved_errno;
+      return -1;
+    }
+    size += n;
+  }
+
+  script->data = data;
+  script->size = size;
+  script->mapped = 0;
+  return 0;
+}
+
+int script_open(struct s_script *script, const char *path) {
+  struct stat st;
+  int result = 0;
+
+  memset(script, 0, sizeof(*script));
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return -1;
+  }
+
+  if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+    void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data != MAP_FAILED) {
+      madvise(data, st.st_size, MADV_SEQUENTIAL);
+      script->data = data;
+      script->size = st.st_size;
+      script->mapped = 1;
+      close(fd);
+      return 0;
+    }
+  }
+
+  // Tuberías, dispositivos o sistemas de archivos sin mmap
+  result = read_all(fd, script);
+  int saved_errno = errno;
+  close(fd);
+  errno = saved_errno;
+  return result;
+}
+
+int script_next_line(struct s_script *script, const char **line, size_t *len) {
+  if (script->pos >= script->size) {
+    return 0;
+  }
+
+  const char *start = script->data + script->pos;
+  size_t remaining = script->size - script->pos;
+  const char *newline = memchr(start, '\n', remaining);
+
+  *line = start;
+  if (newline) {
+    *len = newline - start;
+    script->pos += *len + 1;
+  } else {
+    *len = remaining; // Última línea sin salto de línea
+    script->pos = script->size;
+  }
+  return 1;
+}
+
+void script_close(struct s_script *script) {
+  if (script->mapped) {
+    munmap((void *)script->data, script->size);
+  } else {
+    free((void *)script->data);
+  }
+  memset(script, 0, sizeof(*script));
+}
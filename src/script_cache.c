@@ -0,0 +1,551 @@
+// script_cache.c
+//
+// Este archivo contiene la caché de scripts analizados: la serialización de
+// los árboles sintácticos, su escritura en el directorio de caché y su
+// reconstrucción a partir del archivo proyectado en memoria.
+
+#define _GNU_SOURCE // realpath, mkstemp, st_mtim
+
+#include "script_cache.h"
+#include "globals.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Formato del archivo: una cabecera, la tabla de líneas y luego los nodos,
+ * redirecciones y cadenas. Todas las referencias son desplazamientos de 32
+ * bits desde el comienzo del archivo (0 es NULL). Los registros son
+ * secuencias de enteros de 32 bits alineadas a 4 bytes; su tamaño depende
+ * del tipo de nodo:
+ *
+ *   NODE_COMMAND                    tipo, argc, redirecciones, argv[argc]
+ *   NODE_PIPELINE                   tipo, n, etapas[n]
+ *   NODE_AND, NODE_OR, NODE_SEQUENCE  tipo, izquierdo, derecho
+ *   NODE_BACKGROUND                 tipo, contenido
+ *   NODE_SUBSHELL, NODE_GROUP       tipo, contenido, redirecciones
+ *   NODE_SCHED, NODE_TIME           tipo, argc, contenido, argv[argc]
+ *
+ * Las cadenas terminan en '\0', van sin alinear y el último byte del archivo
+ * es '\0', de modo que cualquier desplazamiento dentro del archivo es una
+ * cadena válida.
+ */
+
+#define CACHE_MAGIC "SHCACHE"
+
+/** Cabecera del archivo. */
+struct s_cache_header {
+  char magic[8];        /**< CACHE_MAGIC. */
+  uint32_t format;      /**< SCRIPT_CACHE_FORMAT. */
+  uint32_t line_count;  /**< Cantidad de líneas. */
+  uint64_t size;        /**< Tamaño del script. */
+  int64_t mtime_sec;    /**< Fecha de modificación del script. */
+  int64_t mtime_nsec;   /**< Nanosegundos de la fecha de modificación. */
+  uint64_t ino;         /**< Inodo del script. */
+  uint64_t dev;         /**< Dispositivo del script. */
+  uint32_t version_off; /**< Versión de la shell. */
+  uint32_t path_off;    /**< Ruta absoluta del script. */
+  uint32_t lines_off;   /**< Tabla de líneas. */
+  uint32_t total_size;  /**< Tamaño del archivo completo. */
+};
+
+/** Una línea del script. */
+struct s_cache_line {
+  uint32_t text_off; /**< Texto de la línea. */
+  uint32_t text_len; /**< Longitud del texto. */
+  uint32_t tree_off; /**< Árbol (0 si la línea está vacía o tiene errores). */
+};
+
+/** Una redirección (ver struct s_redirect). */
+struct s_cache_redirect {
+  uint32_t type;
+  int32_t fd;
+  uint32_t target_off;
+  uint32_t next_off;
+};
+
+/** Buffer donde se arma el archivo antes de escribirlo. */
+struct s_writer {
+  char *data;
+  size_t size;
+  size_t capacity;
+  int failed; /**< Faltó memoria o el archivo superaría los 4 GiB. */
+};
+
+/**
+ * @brief Reserva `len` bytes en cero y devuelve su desplazamiento.
+ *
+ * @param align Alineación del comienzo (1 para cadenas, 4 para registros).
+ */
+static uint32_t reserve(struct s_writer *w, size_t len, size_t align) {
+  size_t offset = (w->size + align - 1) & ~(align - 1);
+  size_t end = offset + len;
+
+  if (w->failed || end > UINT32_MAX) {
+    w->failed = 1;
+    return 0;
+  }
+  if (end > w->capacity) {
+    size_t capacity = w->capacity ? w->capacity : 4096;
+    while (capacity < end) {
+      capacity *= 2;
+    }
+    char *grown = realloc(w->data, capacity);
+    if (grown == NULL) {
+      w->failed = 1;
+      return 0;
+    }
+    w->data = grown;
+    w->capacity = capacity;
+  }
+  memset(w->data + w->size, 0, end - w->size);
+  w->size = end;
+  return (uint32_t)offset;
+}
+
+static uint32_t put_bytes(struct s_writer *w, const char *s, size_t len) {
+  uint32_t offset = reserve(w, len + 1, 1);
+  if (!w->failed) {
+    memcpy(w->data + offset, s, len); // El '\0' ya lo puso reserve
+  }
+  return offset;
+}
+
+/** Escribe un valor de 32 bits en un desplazamiento ya reservado. */
+static void set_u32(struct s_writer *w, uint32_t offset, uint32_t value) {
+  if (!w->failed) {
+    memcpy(w->data + offset, &value, sizeof(value));
+  }
+}
+
+static uint32_t put_redirects(struct s_writer *w, const struct s_redirect *r) {
+  if (r == NULL) {
+    return 0;
+  }
+  uint32_t offset = reserve(w, sizeof(struct s_cache_redirect), 4);
+  struct s_cache_redirect rec = {r->type, r->fd, 0, 0};
+  rec.target_off = put_bytes(w, r->target, strlen(r->target));
+  rec.next_off = put_redirects(w, r->next);
+  if (!w->failed) {
+    memcpy(w->data + offset, &rec, sizeof(rec));
+  }
+  return offset;
+}
+
+static uint32_t put_node(struct s_writer *w, const struct s_node *node) {
+  if (node == NULL) {
+    return 0;
+  }
+
+  // El registro se reserva primero: el buffer puede moverse al crecer, así
+  // que sus campos se completan a través de su desplazamiento
+  uint32_t offset;
+  switch (node->type) {
+  case NODE_COMMAND:
+    offset = reserve(w, (3 + node->argc) * sizeof(uint32_t), 4);
+    set_u32(w, offset + 4, node->argc);
+    set_u32(w, offset + 8, put_redirects(w, node->redirects));
+    for (int i = 0; i < node->argc; i++) {
+      uint32_t arg = put_bytes(w, node->argv[i], strlen(node->argv[i]));
+      set_u32(w, offset + (3 + i) * sizeof(uint32_t), arg);
+    }
+    break;
+  case NODE_PIPELINE:
+    offset = reserve(w, (2 + node->num_stages) * sizeof(uint32_t), 4);
+    set_u32(w, offset + 4, node->num_stages);
+    for (int i = 0; i < node->num_stages; i++) {
+      uint32_t stage = put_node(w, node->stages[i]);
+      set_u32(w, offset + (2 + i) * sizeof(uint32_t), stage);
+    }
+    break;
+  case NODE_AND:
+  case NODE_OR:
+  case NODE_SEQUENCE:
+    offset = reserve(w, 3 * sizeof(uint32_t), 4);
+    set_u32(w, offset + 4, put_node(w, node->left));
+    set_u32(w, offset + 8, put_node(w, node->right));
+    break;
+  case NODE_BACKGROUND:
+    offset = reserve(w, 2 * sizeof(uint32_t), 4);
+    set_u32(w, offset + 4, put_node(w, node->body));
+    break;
+  case NODE_SCHED:
+  case NODE_TIME:
+    offset = reserve(w, (3 + node->argc) * sizeof(uint32_t), 4);
+    set_u32(w, offset + 4, node->argc);
+    set_u32(w, offset + 8, put_node(w, node->body));
+    for (int i = 0; i < node->argc; i++) {
+      uint32_t arg = put_bytes(w, node->argv[i], strlen(node->argv[i]));
+      set_u32(w, offset + (3 + i) * sizeof(uint32_t), arg);
+    }
+    break;
+  default: // NODE_SUBSHELL, NODE_GROUP
+    offset = reserve(w, 3 * sizeof(uint32_t), 4);
+    set_u32(w, offset + 4, put_node(w, node->body));
+    set_u32(w, offset + 8, put_redirects(w, node->redirects));
+    break;
+  }
+  set_u32(w, offset, node->type);
+  return offset;
+}
+
+/** FNV-1a de 64 bits. */
+static uint64_t hash_path(const char *path) {
+  uint64_t h = 14695981039346656037ULL;
+  for (const unsigned char *c = (const unsigned char *)path; *c; c++) {
+    h = (h ^ *c) * 1099511628211ULL;
+  }
+  return h;
+}
+
+/** Arma el directorio de la caché; crea los que falten si `create`. */
+static int cache_dir(char *dir, size_t size, int create) {
+  const char *env = getenv(SCRIPT_CACHE_ENV);
+  const char *base;
+
+  if (env != NULL) {
+    if (*env == '\0') {
+      return -1; // Caché desactivada
+    }
+    snprintf(dir, size, "%s", env);
+  } else if ((base = getenv("XDG_CACHE_HOME")) != NULL && *base == '/') {
+    snprintf(dir, size, "%s/shell", base);
+  } else if ((base = getenv("HOME")) != NULL) {
+    snprintf(dir, size, "%s/.cache", base);
+    if (create) {
+      mkdir(dir, 0700);
+    }
+    snprintf(dir, size, "%s/.cache/shell", base);
+  } else {
+    return -1;
+  }
+
+  if (create && mkdir(dir, 0700) == -1 && errno != EEXIST) {
+    return -1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Resuelve la ruta absoluta del script y el archivo de su entrada.
+ */
+static int cache_paths(const char *script_path, char *real, char *entry,
+                       int create) {
+  char dir[PATH_MAX];
+
+  if (realpath(script_path, real) == NULL ||
+      cache_dir(dir, sizeof(dir), create) == -1) {
+    return -1;
+  }
+  int n = snprintf(entry, PATH_MAX, "%s/%016llx.ast", dir,
+                   (unsigned long long)hash_path(real));
+  return n < PATH_MAX ? 0 : -1;
+}
+
+/** Indica si la cabecera describe al script tal como está ahora. */
+static int header_matches(const struct s_cache_header *h, const char *data,
+                          const struct stat *st, const char *real) {
+  return (uint64_t)st->st_size == h->size &&
+         st->st_mtim.tv_sec == h->mtime_sec &&
+         st->st_mtim.tv_nsec == h->mtime_nsec &&
+         (uint64_t)st->st_ino == h->ino && (uint64_t)st->st_dev == h->dev &&
+         strcmp(data + h->version_off, SHELL_VERSION) == 0 &&
+         strcmp(data + h->path_off, real) == 0;
+}
+
+int script_cache_load(struct s_script_cache *cache, const char *script_path) {
+  char real[PATH_MAX], entry[PATH_MAX];
+  struct stat st, entry_st;
+
+  memset(cache, 0, sizeof(*cache));
+  if (cache_paths(script_path, real, entry, 0) == -1 ||
+      stat(real, &st) == -1) {
+    return -1;
+  }
+
+  int fd = open(entry, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return -1;
+  }
+  if (fstat(fd, &entry_st) == -1 ||
+      (size_t)entry_st.st_size < sizeof(struct s_cache_header)) {
+    close(fd);
+    return -1;
+  }
+  size_t size = entry_st.st_size;
+  void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return -1;
+  }
+
+  const struct s_cache_header *h = data;
+  const char *bytes = data;
+  if (memcmp(h->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+      h->format != SCRIPT_CACHE_FORMAT || h->total_size != size ||
+      bytes[size - 1] != '\0' || h->version_off >= size ||
+      h->path_off >= size || h->lines_off % 4 != 0 ||
+      h->lines_off > size ||
+      (size - h->lines_off) / sizeof(struct s_cache_line) < h->line_count ||
+      !header_matches(h, bytes, &st, real)) {
+    munmap(data, size);
+    return -1;
+  }
+
+  cache->data = data;
+  cache->size = size;
+  cache->line_count = h->line_count;
+  cache->next = 0;
+  return 0;
+}
+
+/** Indica si un registro de `len` bytes en `offset` está dentro del archivo. */
+static int valid_record(const struct s_script_cache *cache, uint32_t offset,
+                        size_t len) {
+  return offset != 0 && offset % 4 == 0 && offset <= cache->size &&
+         cache->size - offset >= len;
+}
+
+static int load_redirects(const struct s_script_cache *cache, uint32_t offset,
+                          struct s_redirect **out, struct s_arena *arena) {
+  struct s_redirect **tail = out;
+
+  while (offset != 0) {
+    if (!valid_record(cache, offset, sizeof(struct s_cache_redirect))) {
+      return -1;
+    }
+    struct s_cache_redirect rec;
+    memcpy(&rec, cache->data + offset, sizeof(rec));
+    struct s_redirect *r = arena_alloc(arena, sizeof(*r));
+    if (r == NULL || rec.target_off >= cache->size) {
+      return -1;
+    }
+    r->type = rec.type;
+    r->fd = rec.fd;
+    r->target = (char *)cache->data + rec.target_off;
+    r->next = NULL;
+    *tail = r;
+    tail = &r->next;
+    offset = rec.next_off;
+  }
+  *tail = NULL;
+  return 0;
+}
+
+/** Lee el entero `index` de un registro ya validado. */
+static uint32_t field(const struct s_script_cache *cache, uint32_t offset,
+                      uint32_t index) {
+  uint32_t value;
+  memcpy(&value, cache->data + offset + index * sizeof(uint32_t),
+         sizeof(value));
+  return value;
+}
+
+/** Reconstruye un nodo en la arena; las palabras apuntan a la proyección. */
+static struct s_node *load_node(const struct s_script_cache *cache,
+                                uint32_t offset, struct s_arena *arena) {
+  if (!valid_record(cache, offset, 2 * sizeof(uint32_t))) {
+    return NULL;
+  }
+  uint32_t type = field(cache, offset, 0);
+  uint32_t count = field(cache, offset, 1);
+
+  struct s_node *node = arena_alloc(arena, sizeof(*node));
+  if (node == NULL) {
+    return NULL;
+  }
+  memset(node, 0, sizeof(*node));
+  node->type = type;
+
+  switch (type) {
+  case NODE_COMMAND:
+  case NODE_SCHED:
+  case NODE_TIME:
+    if (count > INT_MAX ||
+        !valid_record(cache, offset, (3 + (size_t)count) * sizeof(uint32_t)) ||
+        !(node->argv = arena_alloc(arena, (count + 1) * sizeof(char *)))) {
+      return NULL;
+    }
+    // El tercer campo son las redirecciones del comando o el contenido de
+    // los prefijos y de `time`
+    if (type != NODE_COMMAND
+            ? !(node->body = load_node(cache, field(cache, offset, 2), arena))
+            : load_redirects(cache, field(cache, offset, 2), &node->redirects,
+                             arena) == -1) {
+      return NULL;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      uint32_t arg = field(cache, offset, 3 + i);
+      if (arg >= cache->size) {
+        return NULL;
+      }
+      node->argv[i] = (char *)cache->data + arg;
+    }
+    node->argv[count] = NULL;
+    node->argc = count;
+    return node;
+  case NODE_PIPELINE:
+    if (count > INT_MAX ||
+        !valid_record(cache, offset, (2 + (size_t)count) * sizeof(uint32_t)) ||
+        !(node->stages = arena_alloc(arena, count * sizeof(struct s_node *)))) {
+      return NULL;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      node->stages[i] = load_node(cache, field(cache, offset, 2 + i), arena);
+      if (node->stages[i] == NULL) {
+        return NULL;
+      }
+    }
+    node->num_stages = count;
+    return node;
+  case NODE_AND:
+  case NODE_OR:
+  case NODE_SEQUENCE:
+    if (!valid_record(cache, offset, 3 * sizeof(uint32_t)) ||
+        !(node->left = load_node(cache, count, arena)) ||
+        !(node->right = load_node(cache, field(cache, offset, 2), arena))) {
+      return NULL;
+    }
+    return node;
+  case NODE_BACKGROUND:
+    return (node->body = load_node(cache, count, arena)) ? node : NULL;
+  case NODE_SUBSHELL:
+  case NODE_GROUP:
+    if (!valid_record(cache, offset, 3 * sizeof(uint32_t)) ||
+        !(node->body = load_node(cache, count, arena)) ||
+        load_redirects(cache, field(cache, offset, 2), &node->redirects,
+                       arena) == -1) {
+      return NULL;
+    }
+    return node;
+  }
+  return NULL; // Tipo desconocido
+}
+
+int script_cache_next(struct s_script_cache *cache, const char **line,
+                      size_t *len, struct s_node **tree, struct s_arena *arena) {
+  if (cache->next >= cache->line_count) {
+    return 0;
+  }
+
+  const struct s_cache_header *h = (const void *)cache->data;
+  struct s_cache_line rec;
+  memcpy(&rec,
+         cache->data + h->lines_off + cache->next * sizeof(struct s_cache_line),
+         sizeof(rec));
+  cache->next++;
+
+  if (rec.text_off >= cache->size || cache->size - rec.text_off <= rec.text_len) {
+    // Texto fuera del archivo: no hay nada confiable que ejecutar
+    *line = "";
+    *len = 0;
+    *tree = NULL;
+    return 1;
+  }
+  *line = cache->data + rec.text_off;
+  *len = rec.text_len;
+  *tree = rec.tree_off ? load_node(cache, rec.tree_off, arena) : NULL;
+  return 1;
+}
+
+void script_cache_close(struct s_script_cache *cache) {
+  if (cache->data != NULL) {
+    munmap((void *)cache->data, cache->size);
+  }
+  memset(cache, 0, sizeof(*cache));
+}
+
+/** Escribe todo el buffer en `fd`. */
+static int write_all(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t n = write(fd, data, size);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    data += n;
+    size -= n;
+  }
+  return 0;
+}
+
+int script_cache_store(const char *script_path, const struct s_script *script) {
+  char real[PATH_MAX], entry[PATH_MAX], tmp[PATH_MAX + 8];
+  struct stat st;
+  struct s_writer w = {0};
+  struct s_arena arena;
+  struct s_script lines = *script;
+  const char *line;
+  size_t len;
+
+  if (cache_paths(script_path, real, entry, 1) == -1 ||
+      stat(real, &st) == -1 || (uint64_t)st.st_size != script->size) {
+    return -1;
+  }
+
+  // Cabecera y tabla de líneas; la cantidad de líneas se conoce al final
+  uint32_t header_off = reserve(&w, sizeof(struct s_cache_header), 8);
+  uint32_t line_count = 0;
+  lines.pos = 0;
+  while (script_next_line(&lines, &line, &len)) {
+    line_count++;
+  }
+  uint32_t lines_off =
+      reserve(&w, line_count * sizeof(struct s_cache_line), 4);
+
+  arena_init(&arena);
+  lines.pos = 0;
+  for (uint32_t i = 0; i < line_count && !w.failed; i++) {
+    struct s_cache_line rec;
+    script_next_line(&lines, &line, &len);
+    rec.text_off = put_bytes(&w, line, len);
+    rec.text_len = len;
+    rec.tree_off = put_node(&w, parse_buffer_silent(line, len, &arena));
+    if (!w.failed) {
+      memcpy(w.data + lines_off + i * sizeof(rec), &rec, sizeof(rec));
+    }
+    arena_reset(&arena);
+  }
+  arena_destroy(&arena);
+
+  struct s_cache_header h = {0};
+  memcpy(h.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  h.format = SCRIPT_CACHE_FORMAT;
+  h.line_count = line_count;
+  h.size = st.st_size;
+  h.mtime_sec = st.st_mtim.tv_sec;
+  h.mtime_nsec = st.st_mtim.tv_nsec;
+  h.ino = st.st_ino;
+  h.dev = st.st_dev;
+  h.version_off = put_bytes(&w, SHELL_VERSION, strlen(SHELL_VERSION));
+  h.path_off = put_bytes(&w, real, strlen(real));
+  h.lines_off = lines_off;
+  h.total_size = w.size; // put_bytes dejó un '\0' al final
+  if (w.failed) {
+    free(w.data);
+    return -1;
+  }
+  memcpy(w.data + header_off, &h, sizeof(h));
+
+  snprintf(tmp, sizeof(tmp), "%s.XXXXXX", entry);
+  int fd = mkstemp(tmp);
+  if (fd < 0) {
+    free(w.data);
+    return -1;
+  }
+  int result = write_all(fd, w.data, w.size);
+  if (close(fd) == -1 || result == -1 || rename(tmp, entry) == -1) {
+    unlink(tmp);
+    result = -1;
+  }
+  free(w.data);
+  return result;
+}
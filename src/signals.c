@@ -1,28 +1,25 @@
 // signals.c
 //
-// Este archivo contiene las implementaciones de los manejadores de señales para
-// la shell, incluyendo el control de interrupciones y la gestión de procesos
-// hijos que terminan o son suspendidos.
+// Este archivo contiene la atención de las señales de la shell, incluyendo el
+// control de interrupciones. Se ejecuta desde el bucle de eventos, en
+// contexto normal, y no dentro de un manejador de señales; los procesos hijos
+// se recolectan en children.c.
 
 #include "signals.h"
 #include "globals.h"
 #include "prompt.h"
 
-#include <errno.h>
 #include <signal.h>
 #include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-#include <sys/wait.h>
 #include <termios.h>
 #include <unistd.h>
 
 // Variables globales para almacenar el PID del proceso en primer plano y el
 // grupo de procesos de la shell
-pid_t foreground_pid = 0;       // PID del proceso en primer plano
-pid_t foreground_suspended = 0; // PID del proceso suspendido en primer plano
-pid_t shell_pgid;               // ID del grupo de procesos de la shell
-struct termios shell_tmodes;    // Modo terminal de la shell
+pid_t foreground_pid = 0;    // Grupo del trabajo en primer plano
+pid_t shell_pgid;            // ID del grupo de procesos de la shell
+struct termios shell_tmodes; // Modo terminal de la shell
+int job_control = 1;         // La shell entrega la terminal a sus trabajos
 
 void shell_signal_handler(int sig) {
   if (foreground_pid > 0) {
@@ -44,34 +41,3 @@ void shell_signal_handler(int sig) {
     fflush(stdout);
   }
 }
-
-void sigchld_handler(int sig) {
-  (void)sig; // Indica que 'sig' no se usa en el cuerpo de la función
-
-  int saved_errno = errno; // Guardar errno para restaurarlo después
-  int status;
-  pid_t pid;
-
-  // Recolectar todos los procesos hijos que hayan terminado o suspendido
-  while ((pid = waitpid(-1, &status, WUNTRACED | WNOHANG)) > 0) {
-    if (pid == foreground_pid) {
-      // El proceso en primer plano es manejado directamente en execute_command
-      continue;
-    }
-
-    if (WIFSTOPPED(status)) {
-      // Proceso en segundo plano suspendido
-      printf("\n[Proceso en segundo plano %d] Detenido\n", pid);
-    } else {
-      // Proceso en segundo plano terminado
-      printf("\n[Proceso en segundo plano %d] Hecho\n", pid);
-    }
-
-    // Mostrar el prompt de nuevo después de notificar sobre el proceso
-    print_prompt();
-    fflush(stdout);
-  }
-
-  // Restaurar errno para no afectar otras operaciones
-  errno = saved_errno;
-}
@@ -0,0 +1,284 @@
+// timing.c
+//
+// Este archivo contiene la palabra reservada `time`: las mediciones en
+// curso, los procesos que se les informan y el informe final, en texto o en
+// JSON.
+
+#define _DEFAULT_SOURCE // timersub
+
+#include "timing.h"
+
+#include <cjson/cJSON.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+/**
+ * @struct s_sample
+ * @brief Un proceso terminado, o los totales de una medición.
+ */
+struct s_sample {
+  pid_t pid;           /**< Proceso (0 en los totales). */
+  char *command;       /**< Texto de la etapa o del trabajo. */
+  int status;          /**< Estado de salida. */
+  double real;         /**< Segundos de tiempo real. */
+  struct rusage usage; /**< Recursos que consumió. */
+};
+
+/**
+ * @struct s_label
+ * @brief Texto de un proceso (ver timing_label()).
+ */
+struct s_label {
+  pid_t pid;  /**< Proceso. */
+  char *text; /**< Texto. */
+};
+
+/**
+ * @struct s_timing
+ * @brief Una medición en curso.
+ */
+struct s_timing {
+  int id;                   /**< Número de la medición. */
+  int json;                 /**< Informar en JSON. */
+  struct timespec started;  /**< Comienzo (CLOCK_MONOTONIC). */
+  struct rusage before;     /**< RUSAGE_CHILDREN al comenzar. */
+  struct s_sample *samples; /**< Procesos terminados, en orden. */
+  int count;                /**< Cantidad de procesos. */
+  int capacity;             /**< Capacidad de `samples`. */
+  struct s_label *labels;   /**< Textos de los procesos. */
+  int label_count;          /**< Cantidad de textos. */
+  int label_capacity;       /**< Capacidad de `labels`. */
+  struct s_timing *outer;   /**< Medición que contiene a esta. */
+};
+
+static struct s_timing *current;
+static int last_id;
+
+/** Agranda un arreglo de a `size` bytes por elemento; -1 si no hay memoria. */
+static int grow(void **items, int count, int *capacity, size_t size) {
+  if (count < *capacity) {
+    return 0;
+  }
+  int grown_capacity = *capacity ? 2 * *capacity : 8;
+  void *grown = realloc(*items, grown_capacity * size);
+  if (grown == NULL) {
+    perror("Error de memoria");
+    return -1;
+  }
+  *items = grown;
+  *capacity = grown_capacity;
+  return 0;
+}
+
+double timing_elapsed(const struct timespec *since) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)(now.tv_sec - since->tv_sec) +
+         (double)(now.tv_nsec - since->tv_nsec) / 1e9;
+}
+
+static double seconds(const struct timeval *tv) {
+  return (double)tv->tv_sec + (double)tv->tv_usec / 1e6;
+}
+
+int timing_begin(int json) {
+  struct s_timing *timing = calloc(1, sizeof(*timing));
+  if (timing == NULL) {
+    perror("Error de memoria");
+    return -1;
+  }
+  timing->id = ++last_id;
+  timing->json = json;
+  getrusage(RUSAGE_CHILDREN, &timing->before);
+  clock_gettime(CLOCK_MONOTONIC, &timing->started);
+  timing->outer = current;
+  current = timing;
+  return 0;
+}
+
+int timing_scope(void) { return current ? current->id : 0; }
+
+void timing_label(pid_t pid, const char *text) {
+  if (current == NULL ||
+      grow((void **)&current->labels, current->label_count,
+           &current->label_capacity, sizeof(*current->labels)) == -1) {
+    return;
+  }
+  char *copy = strdup(text);
+  if (copy == NULL) {
+    perror("Error de memoria");
+    return;
+  }
+  current->labels[current->label_count].pid = pid;
+  current->labels[current->label_count].text = copy;
+  current->label_count++;
+}
+
+static const char *find_label(const struct s_timing *timing, pid_t pid) {
+  for (int i = 0; i < timing->label_count; i++) {
+    if (timing->labels[i].pid == pid) {
+      return timing->labels[i].text;
+    }
+  }
+  return NULL;
+}
+
+void timing_process(int scope, pid_t pid, const char *command, int status,
+                    double real, const struct rusage *usage) {
+  struct s_timing *timing = current;
+  while (timing != NULL && timing->id != scope) {
+    timing = timing->outer;
+  }
+  if (timing != NULL) {
+    const char *label = find_label(timing, pid);
+    command = label ? label : command;
+  }
+
+  // Las mediciones que la contienen también lo incluyen
+  for (; timing != NULL; timing = timing->outer) {
+    if (grow((void **)&timing->samples, timing->count, &timing->capacity,
+             sizeof(*timing->samples)) == -1) {
+      return;
+    }
+    struct s_sample *sample = &timing->samples[timing->count];
+    if ((sample->command = strdup(command)) == NULL) {
+      perror("Error de memoria");
+      return;
+    }
+    sample->pid = pid;
+    sample->status = status;
+    sample->real = real;
+    sample->usage = *usage;
+    timing->count++;
+  }
+}
+
+/** Calcula los totales: lo que consumieron los hijos desde el comienzo. */
+static void totals(const struct s_timing *timing, struct s_sample *total) {
+  struct rusage after;
+  const struct rusage *before = &timing->before;
+  struct rusage *usage = &total->usage;
+
+  getrusage(RUSAGE_CHILDREN, &after);
+  timersub(&after.ru_utime, &before->ru_utime, &usage->ru_utime);
+  timersub(&after.ru_stime, &before->ru_stime, &usage->ru_stime);
+  usage->ru_minflt = after.ru_minflt - before->ru_minflt;
+  usage->ru_majflt = after.ru_majflt - before->ru_majflt;
+  usage->ru_nvcsw = after.ru_nvcsw - before->ru_nvcsw;
+  usage->ru_nivcsw = after.ru_nivcsw - before->ru_nivcsw;
+
+  // El máximo no se puede restar: es el de los procesos informados, o el de
+  // RUSAGE_CHILDREN si creció durante la medición
+  usage->ru_maxrss = after.ru_maxrss > before->ru_maxrss ? after.ru_maxrss : 0;
+  for (int i = 0; i < timing->count; i++) {
+    if (timing->samples[i].usage.ru_maxrss > usage->ru_maxrss) {
+      usage->ru_maxrss = timing->samples[i].usage.ru_maxrss;
+    }
+  }
+  total->real = timing_elapsed(&timing->started);
+}
+
+/** Agrega los números de una muestra a un objeto JSON. */
+static void add_numbers(cJSON *object, const struct s_sample *sample) {
+  const struct rusage *usage = &sample->usage;
+  cJSON_AddStringToObject(object, "command", sample->command);
+  if (sample->pid != 0) {
+    cJSON_AddNumberToObject(object, "pid", sample->pid);
+  }
+  cJSON_AddNumberToObject(object, "status", sample->status);
+  cJSON_AddNumberToObject(object, "real", sample->real);
+  cJSON_AddNumberToObject(object, "user", seconds(&usage->ru_utime));
+  cJSON_AddNumberToObject(object, "sys", seconds(&usage->ru_stime));
+  cJSON_AddNumberToObject(object, "maxrss_kb", usage->ru_maxrss);
+  cJSON_AddNumberToObject(object, "major_faults", usage->ru_majflt);
+  cJSON_AddNumberToObject(object, "minor_faults", usage->ru_minflt);
+  cJSON_AddNumberToObject(object, "voluntary_switches", usage->ru_nvcsw);
+  cJSON_AddNumberToObject(object, "involuntary_switches", usage->ru_nivcsw);
+}
+
+static void report_json(const struct s_timing *timing,
+                        const struct s_sample *total) {
+  cJSON *json = cJSON_CreateObject();
+  if (json == NULL) {
+    perror("Error de memoria");
+    return;
+  }
+  add_numbers(json, total);
+  cJSON *stages = cJSON_AddArrayToObject(json, "stages");
+  for (int i = 0; stages != NULL && i < timing->count; i++) {
+    cJSON *stage = cJSON_CreateObject();
+    if (stage != NULL) {
+      add_numbers(stage, &timing->samples[i]);
+      cJSON_AddItemToArray(stages, stage);
+    }
+  }
+
+  char *text = cJSON_PrintUnformatted(json);
+  if (text != NULL) {
+    fprintf(stderr, "%s\n", text);
+    free(text);
+  } else {
+    perror("Error de memoria");
+  }
+  cJSON_Delete(json);
+}
+
+static void report_text(const struct s_timing *timing,
+                        const struct s_sample *total) {
+  const struct rusage *usage = &total->usage;
+  fprintf(stderr,
+          "real     %.3fs\n"
+          "usuario  %.3fs\n"
+          "sistema  %.3fs\n"
+          "memoria  %ld KB máx\n"
+          "fallos   %ld mayores, %ld menores\n"
+          "cambios  %ld voluntarios, %ld involuntarios\n",
+          total->real, seconds(&usage->ru_utime), seconds(&usage->ru_stime),
+          usage->ru_maxrss, usage->ru_majflt, usage->ru_minflt,
+          usage->ru_nvcsw, usage->ru_nivcsw);
+
+  // Con un solo proceso sus números ya son los totales
+  if (timing->count < 2) {
+    return;
+  }
+  for (int i = 0; i < timing->count; i++) {
+    const struct s_sample *sample = &timing->samples[i];
+    usage = &sample->usage;
+    fprintf(stderr,
+            "  %s: real %.3fs, usuario %.3fs, sistema %.3fs, %ld KB, "
+            "fallos %ld/%ld, cambios %ld/%ld\n",
+            sample->command, sample->real, seconds(&usage->ru_utime),
+            seconds(&usage->ru_stime), usage->ru_maxrss, usage->ru_majflt,
+            usage->ru_minflt, usage->ru_nvcsw, usage->ru_nivcsw);
+  }
+}
+
+void timing_end(const char *command, int status) {
+  struct s_timing *timing = current;
+  if (timing == NULL) {
+    return;
+  }
+  current = timing->outer;
+
+  struct s_sample total = {0};
+  total.command = (char *)command;
+  total.status = status;
+  totals(timing, &total);
+  if (timing->json) {
+    report_json(timing, &total);
+  } else {
+    report_text(timing, &total);
+  }
+
+  for (int i = 0; i < timing->count; i++) {
+    free(timing->samples[i].command);
+  }
+  for (int i = 0; i < timing->label_count; i++) {
+    free(timing->labels[i].text);
+  }
+  free(timing->samples);
+  free(timing->labels);
+  free(timing);
+}
@@ -0,0 +1,387 @@
+// xargs.c
+//
+// Este archivo contiene el comando interno `xargs`, que agrupa los elementos
+// de la entrada en la menor cantidad de invocaciones que admite execve.
+
+#include "xargs.h"
+#include "commands.h"
+#include "globals.h"
+#include "jobs.h"
+#include "launcher.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define XARGS_HEADROOM 2048 // Margen que deja libre de ARG_MAX, como GNU xargs
+#define XARGS_ARG_PAGES 32  // MAX_ARG_STRLEN del kernel, en páginas
+
+extern char **environ;
+
+/**
+ * @struct s_xargs
+ * @brief Estado de una ejecución de `xargs`.
+ */
+struct s_xargs {
+  char **command;        /**< Comando y argumentos fijos. */
+  int command_count;     /**< Cantidad de argumentos fijos. */
+  size_t command_bytes;  /**< Lo que ocupan en execve, con sus punteros. */
+  FILE *input;           /**< De donde se leen los elementos. */
+  int null_separated;    /**< -0. */
+  char *line;            /**< Último bloque leído de `input`. */
+  size_t line_capacity;  /**< Capacidad de `line`. */
+  char *cursor;          /**< Próximo elemento dentro de `line`. */
+  int in_fd;             /**< Entrada de los comandos, o -1 para heredarla. */
+  size_t limit;          /**< Bytes de execve para argumentos y entorno. */
+  size_t arg_limit;      /**< Máximo de un argumento, con su '\0'. */
+  long max_items;        /**< -n, o 0 sin límite. */
+  int slots;             /**< -P. */
+  int stats;             /**< -t. */
+  char *strings;         /**< Elementos de la invocación en armado. */
+  size_t used;           /**< Bytes usados en `strings`. */
+  size_t capacity;       /**< Capacidad de `strings`. */
+  size_t *offsets;       /**< Comienzo de cada elemento en `strings`. */
+  size_t count;          /**< Elementos en la invocación en armado. */
+  size_t offsets_capacity; /**< Capacidad de `offsets`. */
+  char **argv;           /**< Argumentos de execve. */
+  size_t argv_capacity;  /**< Capacidad de `argv`. */
+  int running;           /**< Invocaciones en curso. */
+  size_t items;          /**< Elementos leídos. */
+  size_t invocations;    /**< Invocaciones lanzadas. */
+  int failed;            /**< Alguna invocación terminó con error. */
+  int not_found;         /**< El comando no pudo ejecutarse. */
+  int interrupted;       /**< Una invocación terminó por SIGINT. */
+  int stopped;           /**< El trabajo se suspendió. */
+};
+
+/** Bytes que ocupa el entorno en execve: cadenas y punteros. */
+static size_t environment_bytes(void) {
+  size_t bytes = sizeof(char *); // El NULL final
+  for (char **env = environ; env && *env; env++) {
+    bytes += strlen(*env) + 1 + sizeof(char *);
+  }
+  return bytes;
+}
+
+/**
+ * @brief Devuelve el próximo elemento, o NULL si no quedan.
+ *
+ * Sin -0 se lee una línea y se separa en blancos; el elemento apunta dentro
+ * de `line` hasta la próxima llamada.
+ */
+static char *next_item(struct s_xargs *x, size_t *length) {
+  for (;;) {
+    if (x->cursor != NULL) {
+      char *start = x->cursor + strspn(x->cursor, " \t\n");
+      if (*start != '\0') {
+        size_t n = strcspn(start, " \t\n");
+        x->cursor = start[n] != '\0' ? start + n + 1 : start + n;
+        start[n] = '\0';
+        *length = n;
+        return start;
+      }
+      x->cursor = NULL;
+    }
+
+    ssize_t n = getdelim(&x->line, &x->line_capacity,
+                         x->null_separated ? '\0' : '\n', x->input);
+    if (n == -1) {
+      clearerr(x->input); // Ctrl-D en una terminal no cierra la entrada
+      return NULL;
+    }
+    if (!x->null_separated) {
+      x->cursor = x->line;
+      continue;
+    }
+    // Con -0 cada registro es un elemento, aunque esté vacío; el último
+    // puede no terminar en '\0'
+    if (n > 0 && x->line[n - 1] == '\0') {
+      n--;
+    }
+    *length = (size_t)n;
+    return x->line;
+  }
+}
+
+/** Indica si un elemento de `length` bytes cabe en la invocación en armado. */
+static int fits(const struct s_xargs *x, size_t length) {
+  if (x->max_items > 0 && x->count >= (size_t)x->max_items) {
+    return 0;
+  }
+  size_t pointers = (x->count + 2) * sizeof(char *); // Con el NULL final
+  return x->command_bytes + x->used + length + 1 + pointers <= x->limit;
+}
+
+static int append_item(struct s_xargs *x, const char *item, size_t length) {
+  if (x->used + length + 1 > x->capacity) {
+    size_t capacity = x->capacity ? x->capacity : 4096;
+    while (capacity < x->used + length + 1) {
+      capacity *= 2;
+    }
+    char *grown = realloc(x->strings, capacity);
+    if (grown == NULL) {
+      return -1;
+    }
+    x->strings = grown;
+    x->capacity = capacity;
+  }
+  if (x->count == x->offsets_capacity) {
+    size_t capacity = x->offsets_capacity ? 2 * x->offsets_capacity : 256;
+    size_t *grown = realloc(x->offsets, capacity * sizeof(*grown));
+    if (grown == NULL) {
+      return -1;
+    }
+    x->offsets = grown;
+    x->offsets_capacity = capacity;
+  }
+  x->offsets[x->count++] = x->used;
+  memcpy(x->strings + x->used, item, length + 1);
+  x->used += length + 1;
+  return 0;
+}
+
+/** Registra el estado de una invocación que terminó. */
+static void finish_invocation(struct s_xargs *x, int status) {
+  x->running--;
+  if (WIFSIGNALED(status) && WTERMSIG(status) == SIGINT) {
+    x->interrupted = 1; // Ctrl+C: no se lanzan más
+  } else if (command_status(status) != 0) {
+    x->failed = 1;
+  }
+}
+
+/**
+ * @brief Espera a que termine una invocación.
+ *
+ * @return int 0 si terminó una, -1 si el trabajo se suspendió o no quedaban.
+ */
+static int wait_one(struct s_xargs *x, struct s_job *job) {
+  int status;
+  pid_t pid = job_wait_any(job, &status);
+  if (pid <= 0) {
+    x->stopped = pid == 0;
+    return -1;
+  }
+  finish_invocation(x, status);
+  return 0;
+}
+
+/** Lanza el comando con los elementos en armado y vacía el lote. */
+static int run_batch(struct s_xargs *x, struct s_job *job) {
+  size_t argc = (size_t)x->command_count + x->count;
+  if (argc + 1 > x->argv_capacity) {
+    char **grown = realloc(x->argv, (argc + 1) * sizeof(*grown));
+    if (grown == NULL) {
+      perror("Error de memoria");
+      return -1;
+    }
+    x->argv = grown;
+    x->argv_capacity = argc + 1;
+  }
+  memcpy(x->argv, x->command, (size_t)x->command_count * sizeof(char *));
+  for (size_t i = 0; i < x->count; i++) {
+    x->argv[x->command_count + i] = x->strings + x->offsets[i];
+  }
+  x->argv[argc] = NULL;
+
+  // Un lugar libre para la invocación nueva
+  while (x->running >= x->slots) {
+    if (wait_one(x, job) == -1) {
+      return -1;
+    }
+  }
+  if (x->interrupted) {
+    return -1;
+  }
+
+  if (x->stats) {
+    fprintf(stderr, "xargs: [%zu] %zu elementos, %zu bytes\n",
+            x->invocations + 1, x->count,
+            x->command_bytes + x->used + (x->count + 1) * sizeof(char *));
+  }
+  // El primer proceso crea el grupo del trabajo y toma la terminal, salvo si
+  // la shell la necesita para leer los elementos
+  pid_t pgid = job_pgid(job);
+  struct s_launch launch = {x->argv, x->in_fd, -1, -1, -1, pgid,
+                            pgid == 0 && job_control && x->in_fd == -1};
+  pid_t pid = launch_process(&launch);
+  x->invocations++;
+  x->used = 0;
+  x->count = 0;
+  if (pid <= 0) {
+    x->not_found = 1;
+    return -1; // Las demás invocaciones fallarían igual
+  }
+  job_add_process(job, pid); // Los errores ya se informaron
+  x->running++;
+  return 0;
+}
+
+/** Lee las opciones; devuelve el índice del comando o -1 si no son válidas. */
+static int parse_options(struct s_xargs *x, char **args, const char **file) {
+  int i = 1;
+  x->slots = 1;
+
+  for (; args[i] != NULL && args[i][0] == '-'; i++) {
+    if (strcmp(args[i], "--") == 0) {
+      i++;
+      break;
+    } else if (strcmp(args[i], "-0") == 0) {
+      x->null_separated = 1;
+    } else if (strcmp(args[i], "-t") == 0) {
+      x->stats = 1;
+    } else if (strcmp(args[i], "-a") == 0) {
+      if ((*file = args[++i]) == NULL) {
+        fprintf(stderr, "xargs: -a: falta el archivo\n");
+        return -1;
+      }
+    } else if (strncmp(args[i], "-n", 2) == 0 ||
+               strncmp(args[i], "-P", 2) == 0) {
+      char option = args[i][1];
+      const char *value = args[i][2] != '\0' ? args[i] + 2 : args[++i];
+      char *end;
+      long number = value ? strtol(value, &end, 10) : 0;
+      if (value == NULL || *end != '\0' || end == value || number <= 0 ||
+          number > INT_MAX) {
+        fprintf(stderr, "xargs: -%c: número inválido\n", option);
+        return -1;
+      }
+      if (option == 'n') {
+        x->max_items = number;
+      } else {
+        x->slots = (int)number;
+      }
+    } else {
+      fprintf(stderr, "xargs: opción inválida: %s\n", args[i]);
+      return -1;
+    }
+  }
+  return i;
+}
+
+int xargs_command(char **args) {
+  static char *default_command[] = {"echo", NULL};
+  struct s_xargs x = {0};
+  const char *file = NULL;
+  int first = parse_options(&x, args, &file);
+  if (first == -1) {
+    return 2;
+  }
+  x.command = args[first] ? &args[first] : default_command;
+  x.command_bytes = sizeof(char *); // El NULL final
+  while (x.command[x.command_count] != NULL) {
+    x.command_bytes += strlen(x.command[x.command_count]) + 1 + sizeof(char *);
+    x.command_count++;
+  }
+
+  long arg_max = sysconf(_SC_ARG_MAX);
+  long page = sysconf(_SC_PAGESIZE);
+  size_t environment = environment_bytes();
+  if (arg_max <= 0 || (size_t)arg_max < environment + XARGS_HEADROOM +
+                                           x.command_bytes) {
+    fprintf(stderr, "xargs: el entorno no deja lugar para los argumentos\n");
+    return 1;
+  }
+  x.limit = (size_t)arg_max - environment - XARGS_HEADROOM;
+  x.arg_limit = (size_t)(page > 0 ? page : 4096) * XARGS_ARG_PAGES;
+
+  if (file != NULL) {
+    if ((x.input = fopen(file, "r")) == NULL) {
+      perror(file);
+      return 1;
+    }
+    x.in_fd = -1;
+  } else {
+    // Los comandos no deben competir con la shell por la entrada que lee
+    x.input = stdin;
+    x.in_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+  }
+
+  char *text = args_text(args);
+  struct s_job *job = job_create(text ? text : "xargs");
+  free(text);
+  if (job == NULL) {
+    if (file != NULL) {
+      fclose(x.input);
+    }
+    if (x.in_fd != -1) {
+      close(x.in_fd);
+    }
+    return 1;
+  }
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  fflush(stdout); // Lo pendiente debe salir antes que los comandos
+
+  int too_long = 0, error = 0;
+  size_t length;
+  char *item;
+  while (!error && (item = next_item(&x, &length)) != NULL) {
+    if (length + 1 > x.arg_limit ||
+        x.command_bytes + length + 1 + 2 * sizeof(char *) > x.limit) {
+      fprintf(stderr, "xargs: un elemento de %zu bytes no cabe en una "
+                      "invocación\n", length);
+      too_long = 1;
+      break;
+    }
+    x.items++;
+    if (!fits(&x, length)) {
+      error = run_batch(&x, job) == -1;
+    }
+    if (!error && append_item(&x, item, length) == -1) {
+      perror("Error de memoria");
+      error = 1;
+    }
+  }
+  if (!error && x.count > 0) {
+    run_batch(&x, job);
+  }
+  while (x.running > 0 && wait_one(&x, job) == 0) {
+  }
+  x.stopped |= job_end_foreground(job);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  if (x.stats) {
+    double seconds = (double)(end.tv_sec - start.tv_sec) +
+                     (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    fprintf(stderr,
+            "xargs: %zu elementos en %zu invocaciones (%zu ahorradas), "
+            "%.3f s, %.0f elementos/s\n",
+            x.items, x.invocations,
+            x.items > x.invocations ? x.items - x.invocations : 0, seconds,
+            seconds > 0 ? (double)x.items / seconds : 0.0);
+  }
+
+  if (file != NULL) {
+    fclose(x.input);
+  }
+  if (x.in_fd != -1) {
+    close(x.in_fd);
+  }
+  free(x.line);
+  free(x.strings);
+  free(x.offsets);
+  free(x.argv);
+
+  if (x.interrupted) {
+    return 128 + SIGINT;
+  }
+  if (x.stopped) {
+    return 128 + SIGTSTP;
+  }
+  if (x.not_found) {
+    return 127;
+  }
+  if (too_long || error) {
+    return 1;
+  }
+  return x.failed ? 123 : 0;
+}
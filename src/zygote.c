@@ -0,0 +1,408 @@
+// zygote.c
+//
+// Este archivo contiene el zygote: un proceso creado al inicio de la shell
+// que lanza los comandos externos a pedido, desde su imagen pequeña.
+
+#define _GNU_SOURCE // SOCK_CLOEXEC, MSG_CMSG_CLOEXEC, pipe2, CLONE_PARENT
+
+#include "zygote.h"
+#include "globals.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
+
+extern char **environ;
+
+/** Descriptores que acompañan a un pedido: entrada, salida, error y terminal. */
+#define ZYGOTE_MAX_FDS 4
+
+/**
+ * @struct s_zygote_request
+ * @brief Cabecera de un pedido. La siguen `payload_len` bytes con la ruta
+ * del programa, el directorio actual, los argumentos y el entorno, cada uno
+ * terminado en '\0'.
+ */
+struct s_zygote_request {
+  uint32_t argc;        /**< Cantidad de argumentos. */
+  uint32_t envc;        /**< Cantidad de variables de entorno. */
+  uint32_t payload_len; /**< Bytes que siguen a la cabecera. */
+  int32_t pgid;         /**< Grupo del hijo; 0 crea uno nuevo. */
+};
+
+/**
+ * @struct s_zygote_reply
+ * @brief Respuesta a un pedido.
+ */
+struct s_zygote_reply {
+  int32_t pid; /**< PID del hijo. */
+  int32_t err; /**< errno de execve, o 0 si el programa se ejecutó. */
+};
+
+static int zygote_sock = -1;
+static pid_t zygote_pid = -1;
+
+static int write_full(int fd, const void *buf, size_t len) {
+  const char *p = buf;
+  while (len > 0) {
+    ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    p += n;
+    len -= n;
+  }
+  return 0;
+}
+
+static int read_full(int fd, void *buf, size_t len) {
+  char *p = buf;
+  while (len > 0) {
+    ssize_t n = read(fd, p, len);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return -1;
+    }
+    p += n;
+    len -= n;
+  }
+  return 0;
+}
+
+/**
+ * @brief Crea un proceso cuyo padre es el padre del zygote (la shell).
+ */
+static pid_t clone_sibling(void) {
+#ifdef __linux__
+  return (pid_t)syscall(SYS_clone, CLONE_PARENT | SIGCHLD, NULL, NULL, NULL,
+                        NULL);
+#else
+  errno = ENOSYS;
+  return -1;
+#endif
+}
+
+/** Desde acá hasta execve solo se usan llamadas al sistema. */
+static void zygote_child(const struct s_zygote_request *req, const char *path,
+                         const char *cwd, char **argv, char **envp,
+                         const int *fds, int nfds, int err_fd) {
+  setpgid(0, req->pgid);
+  if (nfds > 3 && tcsetpgrp(fds[3], req->pgid ? req->pgid : getpid()) == -1) {
+    goto fail;
+  }
+
+  for (int i = 0; i < 3; i++) {
+    if (dup2(fds[i], i) == -1) {
+      goto fail;
+    }
+  }
+  for (int i = 0; i < nfds; i++) {
+    if (fds[i] > STDERR_FILENO) {
+      close(fds[i]);
+    }
+  }
+  if (chdir(cwd) == -1) {
+    goto fail;
+  }
+
+  // Mismas señales que restablece launch_process en los hijos
+  sigset_t empty;
+  sigemptyset(&empty);
+  sigprocmask(SIG_SETMASK, &empty, NULL);
+  signal(SIGINT, SIG_DFL);
+  signal(SIGTSTP, SIG_DFL);
+  signal(SIGQUIT, SIG_DFL);
+
+  execve(path, argv, envp);
+
+fail:;
+  int err = errno;
+  if (write(err_fd, &err, sizeof(err)) < 0) {
+    // Nada más que hacer: el zygote verá EOF y lo tomará como éxito
+  }
+  _exit(127);
+}
+
+/**
+ * @brief Recibe un pedido con sus descriptores.
+ *
+ * @return int Cantidad de descriptores recibidos, o -1 si la shell cerró el
+ * socket.
+ */
+static int receive_request(int sock, struct s_zygote_request *req, int *fds) {
+  char control[CMSG_SPACE(ZYGOTE_MAX_FDS * sizeof(int))];
+  struct iovec iov = {req, sizeof(*req)};
+  struct msghdr msg = {0};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t n;
+  do {
+    n = recvmsg(sock, &msg, MSG_CMSG_CLOEXEC);
+  } while (n < 0 && errno == EINTR);
+  if (n <= 0) {
+    return -1;
+  }
+
+  int nfds = 0;
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+    nfds = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+    memcpy(fds, CMSG_DATA(cmsg), nfds * sizeof(int));
+  }
+
+  // La cabecera pudo llegar partida; el resto se lee sin descriptores
+  if ((size_t)n < sizeof(*req) &&
+      read_full(sock, (char *)req + n, sizeof(*req) - n) == -1) {
+    return -1;
+  }
+  return nfds;
+}
+
+/** Separa `count` cadenas consecutivas de `p` en un vector terminado en NULL. */
+static char **split_strings(char **p, const char *end, uint32_t count) {
+  char **vec = malloc((count + 1) * sizeof(char *));
+  if (!vec) {
+    return NULL;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    if (*p >= end) {
+      free(vec);
+      return NULL;
+    }
+    vec[i] = *p;
+    *p += strlen(*p) + 1;
+  }
+  vec[count] = NULL;
+  return vec;
+}
+
+static void serve_request(int sock, const struct s_zygote_request *req,
+                          char *payload, const int *fds, int nfds) {
+  struct s_zygote_reply reply = {-1, EINVAL};
+  char *p = payload;
+  char *end = payload + req->payload_len;
+  char *path = p;
+  p += strlen(p) + 1;
+  char *cwd = p;
+  p += strlen(p) + 1;
+  char **argv = split_strings(&p, end, req->argc);
+  char **envp = argv ? split_strings(&p, end, req->envc) : NULL;
+  int err_pipe[2];
+
+  if (envp && nfds >= 3 && pipe2(err_pipe, O_CLOEXEC) == 0) {
+    pid_t pid = clone_sibling();
+    if (pid == 0) {
+      close(err_pipe[0]);
+      zygote_child(req, path, cwd, argv, envp, fds, nfds, err_pipe[1]);
+    }
+    close(err_pipe[1]);
+
+    reply.pid = pid;
+    reply.err = pid < 0 ? errno : 0;
+    // Si execve tuvo éxito el pipe se cierra sin datos
+    if (pid > 0 && read_full(err_pipe[0], &reply.err, sizeof(reply.err)) == -1) {
+      reply.err = 0;
+    }
+    close(err_pipe[0]);
+  }
+
+  free(argv);
+  free(envp);
+  write_full(sock, &reply, sizeof(reply));
+}
+
+static void zygote_main(int sock) {
+  // Las señales de la terminal son para la shell o el trabajo en primer plano
+  signal(SIGINT, SIG_IGN);
+  signal(SIGTSTP, SIG_IGN);
+  signal(SIGQUIT, SIG_IGN);
+  signal(SIGTTIN, SIG_IGN);
+  signal(SIGTTOU, SIG_IGN);
+  signal(SIGCHLD, SIG_DFL);
+
+  for (;;) {
+    struct s_zygote_request req;
+    int fds[ZYGOTE_MAX_FDS];
+    int nfds = receive_request(sock, &req, fds);
+    if (nfds < 0) {
+      _exit(EXIT_SUCCESS); // La shell terminó
+    }
+
+    char *payload = malloc(req.payload_len + 1);
+    if (!payload || read_full(sock, payload, req.payload_len) == -1) {
+      _exit(EXIT_FAILURE);
+    }
+    payload[req.payload_len] = '\0';
+
+    serve_request(sock, &req, payload, fds, nfds);
+
+    free(payload);
+    for (int i = 0; i < nfds; i++) {
+      close(fds[i]);
+    }
+  }
+}
+
+int zygote_start(void) {
+  int sv[2];
+
+  if (zygote_sock != -1) {
+    return 0;
+  }
+#ifndef __linux__
+  errno = ENOSYS;
+  return -1;
+#endif
+  if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) == -1) {
+    perror("zygote: socketpair");
+    return -1;
+  }
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(sv[0]);
+    zygote_main(sv[1]);
+  } else if (pid < 0) {
+    perror("zygote: fork");
+    close(sv[0]);
+    close(sv[1]);
+    return -1;
+  }
+
+  close(sv[1]);
+  zygote_sock = sv[0];
+  zygote_pid = pid;
+  return 0;
+}
+
+int zygote_running(void) { return zygote_sock != -1; }
+
+void zygote_stop(void) {
+  if (zygote_sock == -1) {
+    return;
+  }
+  close(zygote_sock);
+  zygote_sock = -1;
+  waitpid(zygote_pid, NULL, 0);
+  zygote_pid = -1;
+}
+
+/** Agrega `s` con su terminador a `buf`, creciendo si hace falta. */
+static int append_string(char **buf, size_t *len, size_t *cap, const char *s) {
+  size_t n = strlen(s) + 1;
+  if (*len + n > *cap) {
+    size_t new_cap = *cap ? *cap : 4096;
+    while (*len + n > new_cap) {
+      new_cap *= 2;
+    }
+    char *grown = realloc(*buf, new_cap);
+    if (!grown) {
+      return -1;
+    }
+    *buf = grown;
+    *cap = new_cap;
+  }
+  memcpy(*buf + *len, s, n);
+  *len += n;
+  return 0;
+}
+
+int zygote_spawn(const struct s_launch *launch, const char *path, pid_t *pid) {
+  struct s_zygote_request req = {0, 0, 0, launch->pgid};
+  struct s_zygote_reply reply;
+  char cwd[PATH_MAX];
+  char *payload = NULL;
+  size_t len = 0, cap = 0;
+  int ok;
+
+  if (zygote_sock == -1) {
+    return -1;
+  }
+  if (getcwd(cwd, sizeof(cwd)) == NULL) {
+    strcpy(cwd, "/");
+  }
+
+  ok = append_string(&payload, &len, &cap, path) == 0 &&
+       append_string(&payload, &len, &cap, cwd) == 0;
+  for (char **arg = launch->argv; ok && *arg; arg++, req.argc++) {
+    ok = append_string(&payload, &len, &cap, *arg) == 0;
+  }
+  for (char **env = environ; ok && env && *env; env++, req.envc++) {
+    ok = append_string(&payload, &len, &cap, *env) == 0;
+  }
+  if (!ok) {
+    free(payload);
+    perror("zygote");
+    *pid = -1;
+    return 0;
+  }
+  req.payload_len = len;
+
+  int fds[ZYGOTE_MAX_FDS] = {
+      launch->in_fd != -1 ? launch->in_fd : STDIN_FILENO,
+      launch->out_fd != -1 ? launch->out_fd : STDOUT_FILENO,
+      launch->err_fd != -1 ? launch->err_fd : STDERR_FILENO, STDIN_FILENO};
+  int nfds = launch->foreground && isatty(STDIN_FILENO) ? 4 : 3;
+
+  char control[CMSG_SPACE(ZYGOTE_MAX_FDS * sizeof(int))];
+  memset(control, 0, sizeof(control));
+  struct iovec iov = {&req, sizeof(req)};
+  struct msghdr msg = {0};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = CMSG_SPACE(nfds * sizeof(int));
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(nfds * sizeof(int));
+  memcpy(CMSG_DATA(cmsg), fds, nfds * sizeof(int));
+
+  ssize_t sent;
+  do {
+    sent = sendmsg(zygote_sock, &msg, MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  ok = sent == (ssize_t)sizeof(req) &&
+       write_full(zygote_sock, payload, len) == 0 &&
+       read_full(zygote_sock, &reply, sizeof(reply)) == 0;
+  free(payload);
+
+  // El hijo es de la shell: si el programa no pudo ejecutarse se recoge acá.
+  // SIGCHLD queda bloqueado y solo lo atiende el bucle de eventos desde el
+  // signalfd, y este hijo no se registró con un pidfd, así que nadie más
+  // lo anuncia como trabajo terminado
+  if (ok && reply.err != 0 && reply.pid > 0) {
+    waitpid(reply.pid, NULL, 0);
+  }
+
+  if (!ok) {
+    fprintf(stderr, "zygote: el proceso auxiliar no responde\n");
+    zygote_stop();
+    return -1;
+  }
+  if (reply.err != 0) {
+    fprintf(stderr, "Error en el comando: %s\n", strerror(reply.err));
+    *pid = -1;
+    return 0;
+  }
+  *pid = reply.pid;
+  return 0;
+}